@@ -32,6 +32,23 @@ void BE_ST_StartAudioAndTimerInt(void(*funcPtr)(void));
 void BE_ST_StopAudioAndTimerInt(void);
 void BE_ST_LockAudioRecursively(void);
 void BE_ST_UnlockAudioRecursively(void);
+// Code that changes the state of the sound manager from another thread than
+// the audio callback does not lock the callback. Instead, it posts a command
+// into a lock-free single producer, single consumer queue, which the audio
+// callback executes before it fills the next buffer.
+typedef struct BE_ST_AudioCommand
+{
+	void (*handler)(const struct BE_ST_AudioCommand *command);
+	void *data;
+	uint32_t args[3];
+} BE_ST_AudioCommand;
+// Returns false if the command was not posted, in which case the caller
+// should execute it right away: this is the case within the audio callback
+// itself (including commands being executed), or without an audio device.
+bool BE_ST_PostAudioCommand(const BE_ST_AudioCommand *command);
+// Executes all posted commands and returns while the audio callback is
+// not running; use before releasing data that the callback may refer to.
+void BE_ST_FlushAudioCommands(void);
 bool BE_ST_IsEmulatedOPLChipReady(void);
 // WARNING about using BE_ST_PCSpeakerOn/Off:
 //
@@ -51,6 +68,24 @@ void BE_ST_PCSpeakerOff(void);
 // some mechanism of resampling is in use.
 void BE_ST_PlayS16SoundEffect(int16_t *data, int numOfSamples);
 void BE_ST_StopSoundEffect(void);
+bool BE_ST_IsSoundEffectPlaying(void);
+// Used for playback of pre-rendered OPL music in signed 16-bit int format,
+// at the rate of the emulated OPL chip. When the end of the data is reached,
+// playback continues at sample loopStart. As with BE_ST_PlayS16SoundEffect,
+// the data is NOT copied; You ***must*** call BE_ST_StopS16Music.
+void BE_ST_PlayS16Music(int16_t *data, int numOfSamples, int loopStart);
+void BE_ST_StopS16Music(void);
+// Used for playback of several sound effects at the same time, in the same
+// format as BE_ST_PlayS16SoundEffect. Each effect gets its own voice, with a
+// volume in the range of 0-256. When all voices are in use, the one that was
+// started first is taken over. You ***must*** call BE_ST_StopS16Voices.
+#define BE_ST_NUM_OF_S16_VOICES 8
+void BE_ST_PlayS16Voice(int16_t *data, int numOfSamples, uint16_t volume);
+void BE_ST_StopS16Voices(void);
+bool BE_ST_IsS16VoicePlaying(void);
+// While all OPL output is pre-rendered, the emulated OPL chip does not
+// need to generate samples in the audio callback.
+void BE_ST_SetOPLEmulationPaused(bool paused);
 // Safe alternatives for Borland's sound and nosound functions from Catacomb Abyss' gelib.c
 void BE_ST_BSound(uint16_t frequency);
 void BE_ST_BNoSound(void);
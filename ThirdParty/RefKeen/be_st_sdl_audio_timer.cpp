@@ -19,9 +19,11 @@
 
 #include "be_st.h"
 #include "../opl/dbopl.h"
+#include "../../src/Engine/AudioMixer.h"
 #include <SDL.h>
 #include <stdlib.h>
 #include <string.h>
+#include <atomic>
 
 #define PC_PIT_RATE 1193182
 
@@ -66,16 +68,47 @@ static uint32_t g_sdlManualAudioCallbackCallDelayedSamples;
 
 // Used for filling with samples from BE_ST_OPL2Write,
 // in addition to the SDL audio CallBack itself
-// (because waits between/after OPL writes are expected)
+// (because waits between/after OPL writes are expected).
+// This is a ring buffer; pending samples start at g_sdlALOutSamplesStart.
 static BE_ST_SndSample_T *g_sdlALOutSamples;
 static uint32_t g_sdlALOutNumOfSamples;
-static uint32_t g_sdlALOutSamplesEnd = 0;
+static uint32_t g_sdlALOutSamplesStart = 0;
+static uint32_t g_sdlALOutSamplesPending = 0;
+
+// Commands posted by the game thread, executed by the audio callback.
+// The indices are free running; only the game thread advances the tail,
+// only the thread that executes the commands advances the head.
+#define AUDIO_COMMAND_QUEUE_SIZE 256 // Must be a power of two
+#define AUDIO_COMMAND_QUEUE_MAX_DELAYS 100 // In ms, before the poster executes the commands itself
+static BE_ST_AudioCommand g_sdlAudioCommands[AUDIO_COMMAND_QUEUE_SIZE];
+static std::atomic<uint32_t> g_sdlAudioCommandsHead(0);
+static std::atomic<uint32_t> g_sdlAudioCommandsTail(0);
+// Set while a thread owns the sound state: the audio callback, or
+// BE_ST_FlushAudioCommands with the audio device locked
+static thread_local bool g_sdlOwnsAudioState = false;
 
 // PC Speaker current status
 static bool g_sdlPCSpeakerOn = false;
 static BE_ST_SndSample_T g_sdlCurrentBeepSample;
 static uint32_t g_sdlBeepHalfCycleCounter, g_sdlBeepHalfCycleCounterUpperBound;
 
+// Pre-rendered OPL output (sound effects and looping music), mixed with the emulated OPL chip
+typedef struct
+{
+    BE_ST_SndSample_T *data;
+    uint32_t numOfSamples, offset;
+    uint32_t loopStart;
+    bool loops;
+    uint16_t volume;
+    uint32_t startNumber; // For taking over the oldest voice
+} BEL_ST_S16Voice;
+
+static BEL_ST_S16Voice g_sdlS16SoundEffect;
+static BEL_ST_S16Voice g_sdlS16Music;
+static BEL_ST_S16Voice g_sdlS16Voices[BE_ST_NUM_OF_S16_VOICES];
+static uint32_t g_sdlS16VoicesStarted = 0;
+static bool g_sdlOPLEmulationPaused = false;
+
 static void BEL_ST_Simple_EmuCallBack(void *unused, Uint8 *stream, int len);
 
 static void YM3812Init(int numChips, int clock, int rate);
@@ -105,8 +138,9 @@ void BE_ST_InitAudio(void)
             spec.freq = 49716;
             spec.format = AUDIO_S16SYS;
             spec.channels = 1;
-            // Should be some power-of-two roughly proportional to the sample rate; Using 1024 for 48000Hz.
-            for (spec.samples = 1; spec.samples < 49716 / 64; spec.samples *= 2)
+            // Should be some power-of-two roughly proportional to the sample rate; Using 256 for 48000Hz (about 5ms).
+            // The callback does not wait for the game thread, so a small buffer does not lead to underruns.
+            for (spec.samples = 1; spec.samples < 49716 / 256; spec.samples *= 2)
             {
             }
             g_sdlOurAudioCallback = BEL_ST_Simple_EmuCallBack;
@@ -191,6 +225,8 @@ void BE_ST_ShutdownAudio(void)
     g_sdlCallbacksSamplesBuffer = NULL;
     free(g_sdlALOutSamples);
     g_sdlALOutSamples = NULL;
+    g_sdlALOutSamplesStart = g_sdlALOutSamplesPending = 0;
+    g_sdlAudioCommandsHead = g_sdlAudioCommandsTail.load();
 
     g_sdlTimerIntFuncPtr = 0; // Just in case this may be called after the audio subsystem was never really started (manual calls to callback)
 }
@@ -222,6 +258,52 @@ void BE_ST_UnlockAudioRecursively(void)
 {
 }
 
+bool BE_ST_PostAudioCommand(const BE_ST_AudioCommand *command)
+{
+    if (!g_sdlAudioSubsystemUp || g_sdlOwnsAudioState)
+        return false;
+
+    const uint32_t tail = g_sdlAudioCommandsTail.load(std::memory_order_relaxed);
+    // If the queue is full, the audio callback empties it within one buffer. When it does not, e.g. as the
+    // audio device is paused, the queued commands are executed right here with the audio device locked.
+    for (uint32_t delays = 0; tail - g_sdlAudioCommandsHead.load(std::memory_order_acquire) >= AUDIO_COMMAND_QUEUE_SIZE; delays++)
+    {
+        if (delays < AUDIO_COMMAND_QUEUE_MAX_DELAYS)
+            SDL_Delay(1);
+        else
+            BE_ST_FlushAudioCommands();
+    }
+
+    g_sdlAudioCommands[tail & (AUDIO_COMMAND_QUEUE_SIZE - 1)] = *command;
+    g_sdlAudioCommandsTail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+// Called by the owner of the sound state only
+static void BEL_ST_ExecuteAudioCommands(void)
+{
+    uint32_t head = g_sdlAudioCommandsHead.load(std::memory_order_relaxed);
+    const uint32_t tail = g_sdlAudioCommandsTail.load(std::memory_order_acquire);
+    while (head != tail)
+    {
+        const BE_ST_AudioCommand command = g_sdlAudioCommands[head & (AUDIO_COMMAND_QUEUE_SIZE - 1)];
+        command.handler(&command);
+        g_sdlAudioCommandsHead.store(++head, std::memory_order_release);
+    }
+}
+
+void BE_ST_FlushAudioCommands(void)
+{
+    if (!g_sdlAudioSubsystemUp || g_sdlOwnsAudioState)
+        return;
+
+    SDL_LockAudioDevice(g_sdlAudioDevice);
+    g_sdlOwnsAudioState = true;
+    BEL_ST_ExecuteAudioCommands();
+    g_sdlOwnsAudioState = false;
+    SDL_UnlockAudioDevice(g_sdlAudioDevice);
+}
+
 // Use this ONLY if audio subsystem isn't properly started up
 void BE_ST_PrepareForManualAudioCallbackCall(void)
 {
@@ -268,6 +350,106 @@ void BE_ST_PCSpeakerOff(void)
     g_sdlPCSpeakerOn = false;
 }
 
+static void BEL_ST_StartS16Voice(BEL_ST_S16Voice *voice, int16_t *data, int numOfSamples, bool loops, int loopStart, uint16_t volume)
+{
+    voice->data = (numOfSamples > 0) ? data : NULL;
+    voice->numOfSamples = (numOfSamples > 0) ? numOfSamples : 0;
+    voice->offset = 0;
+    voice->loopStart = (loopStart > 0 && loopStart < numOfSamples) ? loopStart : 0;
+    voice->loops = loops;
+    voice->volume = (volume < AudioMixer::FullVolume) ? volume : AudioMixer::FullVolume;
+    voice->startNumber = g_sdlS16VoicesStarted++;
+}
+
+void BE_ST_PlayS16SoundEffect(int16_t *data, int numOfSamples)
+{
+    BE_ST_LockAudioRecursively();
+
+    BEL_ST_StartS16Voice(&g_sdlS16SoundEffect, data, numOfSamples, false, 0, AudioMixer::FullVolume);
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+void BE_ST_StopSoundEffect(void)
+{
+    BE_ST_LockAudioRecursively();
+
+    g_sdlS16SoundEffect.data = NULL;
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+bool BE_ST_IsSoundEffectPlaying(void)
+{
+    return (g_sdlS16SoundEffect.data != NULL);
+}
+
+void BE_ST_PlayS16Music(int16_t *data, int numOfSamples, int loopStart)
+{
+    BE_ST_LockAudioRecursively();
+
+    BEL_ST_StartS16Voice(&g_sdlS16Music, data, numOfSamples, true, loopStart, AudioMixer::FullVolume);
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+void BE_ST_StopS16Music(void)
+{
+    BE_ST_LockAudioRecursively();
+
+    g_sdlS16Music.data = NULL;
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+void BE_ST_PlayS16Voice(int16_t *data, int numOfSamples, uint16_t volume)
+{
+    BE_ST_LockAudioRecursively();
+
+    // Take a free voice, or else the one that was started first
+    BEL_ST_S16Voice *voice = &g_sdlS16Voices[0];
+    for (int i = 0; i < BE_ST_NUM_OF_S16_VOICES; i++)
+    {
+        if (!g_sdlS16Voices[i].data)
+        {
+            voice = &g_sdlS16Voices[i];
+            break;
+        }
+        if ((int32_t)(g_sdlS16Voices[i].startNumber - voice->startNumber) < 0)
+            voice = &g_sdlS16Voices[i];
+    }
+    BEL_ST_StartS16Voice(voice, data, numOfSamples, false, 0, volume);
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+void BE_ST_StopS16Voices(void)
+{
+    BE_ST_LockAudioRecursively();
+
+    for (int i = 0; i < BE_ST_NUM_OF_S16_VOICES; i++)
+        g_sdlS16Voices[i].data = NULL;
+
+    BE_ST_UnlockAudioRecursively();
+}
+
+bool BE_ST_IsS16VoicePlaying(void)
+{
+    for (int i = 0; i < BE_ST_NUM_OF_S16_VOICES; i++)
+        if (g_sdlS16Voices[i].data)
+            return true;
+    return false;
+}
+
+void BE_ST_SetOPLEmulationPaused(bool paused)
+{
+    BE_ST_LockAudioRecursively();
+
+    g_sdlOPLEmulationPaused = paused;
+
+    BE_ST_UnlockAudioRecursively();
+}
+
 void BE_ST_BSound(uint16_t frequency)
 {
     BE_ST_LockAudioRecursively();
@@ -314,7 +496,7 @@ static inline void YM3812UpdateOne(Chip *which, BE_ST_SndSample_T *stream, int l
     if (length > OPL_NUM_OF_SAMPLES)
         length = OPL_NUM_OF_SAMPLES;
 
-    Chip__GenerateBlock2(which, length, buffer);
+    Chip__GenerateBlock2Vectorized(which, length, buffer);
 
     // GenerateBlock2 generates a number of "length" 32-bit mono samples
     // so we only need to convert them to 16-bit mono samples
@@ -328,6 +510,22 @@ static inline void YM3812UpdateOne(Chip *which, BE_ST_SndSample_T *stream, int l
     }
 }
 
+// Appends samples of the emulated OPL chip to the pending AL samples, wrapping around the end of the buffer
+static void BEL_ST_GenerateALSamples(uint32_t length)
+{
+    while (length)
+    {
+        const uint32_t end = (g_sdlALOutSamplesStart + g_sdlALOutSamplesPending) % g_sdlALOutNumOfSamples;
+        const uint32_t partLength = BE_Cross_TypedMin32(length, g_sdlALOutNumOfSamples - end);
+        if (g_sdlOPLEmulationPaused)
+            memset(&g_sdlALOutSamples[end], 0, sizeof(BE_ST_SndSample_T) * partLength);
+        else
+            YM3812UpdateOne(&oplChip, &g_sdlALOutSamples[end], partLength);
+        g_sdlALOutSamplesPending += partLength;
+        length -= partLength;
+    }
+}
+
 void BE_ST_OPL2Write(uint8_t reg, uint8_t val)
 {
     BE_ST_LockAudioRecursively(); // RECURSIVE lock
@@ -344,18 +542,14 @@ void BE_ST_OPL2Write(uint8_t reg, uint8_t val)
     YM3812Write(&oplChip, reg, val);
     // FIXME: For now we roughly simulate the above delays with a
     // hack, using a "magic number" that appears to make this work.
-    unsigned int length = OPL_SAMPLE_RATE / 10000;
+    unsigned int length = g_sdlOPLEmulationPaused ? 0 : OPL_SAMPLE_RATE / 10000;
 
-    if (length > g_sdlALOutNumOfSamples - g_sdlALOutSamplesEnd)
-    {
-        //BE_Cross_LogMessage(BE_LOG_MSG_WARNING, "BE_ST_OPL2Write overflow, want %u, have %u\n", length, g_sdlALOutNumOfSamples - g_sdlALOutSamplesEnd); // FIXME - Other thread
-        length = g_sdlALOutNumOfSamples - g_sdlALOutSamplesEnd;
-    }
-    if (length)
+    if (length > g_sdlALOutNumOfSamples - g_sdlALOutSamplesPending)
     {
-        YM3812UpdateOne(&oplChip, &g_sdlALOutSamples[g_sdlALOutSamplesEnd], length);
-        g_sdlALOutSamplesEnd += length;
+        //BE_Cross_LogMessage(BE_LOG_MSG_WARNING, "BE_ST_OPL2Write overflow, want %u, have %u\n", length, g_sdlALOutNumOfSamples - g_sdlALOutSamplesPending); // FIXME - Other thread
+        length = g_sdlALOutNumOfSamples - g_sdlALOutSamplesPending;
     }
+    BEL_ST_GenerateALSamples(length);
 
     BE_ST_UnlockAudioRecursively(); // RECURSIVE unlock
 }
@@ -379,6 +573,53 @@ static inline void PCSpeakerUpdateOne(BE_ST_SndSample_T *stream, int length)
     }
 }
 
+/**********************************************************************
+Pre-rendered OPL output; mixes the sound effects and music into the
+pending AL samples, clamped to the same range as YM3812UpdateOne uses.
+**********************************************************************/
+#define S16_MIX_BLOCK_SIZE 512
+
+static inline void S16MixVoice(BEL_ST_S16Voice *voice, int32_t *accumulator, uint32_t length)
+{
+    while (length && voice->data)
+    {
+        const uint32_t partLength = BE_Cross_TypedMin32(length, voice->numOfSamples - voice->offset);
+        AudioMixer::Add(accumulator, &voice->data[voice->offset], partLength, voice->volume);
+        accumulator += partLength;
+        length -= partLength;
+        voice->offset += partLength;
+        if (voice->offset >= voice->numOfSamples)
+        {
+            if (voice->loops)
+                voice->offset = voice->loopStart;
+            else
+                voice->data = NULL;
+        }
+    }
+}
+
+static inline bool S16IsAnyVoicePlaying(void)
+{
+    return g_sdlS16SoundEffect.data || g_sdlS16Music.data || BE_ST_IsS16VoicePlaying();
+}
+
+static inline void S16UpdateOne(BE_ST_SndSample_T *stream, int length)
+{
+    int32_t accumulator[S16_MIX_BLOCK_SIZE];
+    while (length > 0)
+    {
+        const uint32_t blockLength = BE_Cross_TypedMin32(length, S16_MIX_BLOCK_SIZE);
+        AudioMixer::Load(accumulator, stream, blockLength);
+        S16MixVoice(&g_sdlS16SoundEffect, accumulator, blockLength);
+        S16MixVoice(&g_sdlS16Music, accumulator, blockLength);
+        for (int i = 0; i < BE_ST_NUM_OF_S16_VOICES; i++)
+            S16MixVoice(&g_sdlS16Voices[i], accumulator, blockLength);
+        AudioMixer::Store(stream, accumulator, blockLength);
+        stream += blockLength;
+        length -= blockLength;
+    }
+}
+
 // WARNING: Possibly the wrong place to call the OPL emulator,
 // but otherwise a separate dedicated thread may be required
 static void BEL_ST_Simple_EmuCallBack(void *unused, Uint8 *stream, int len)
@@ -389,6 +630,10 @@ static void BEL_ST_Simple_EmuCallBack(void *unused, Uint8 *stream, int len)
     BE_ST_LockAudioRecursively(); // RECURSIVE lock
     /////////////////////////////
 
+    // Apply whatever the game thread requested since the previous buffer
+    g_sdlOwnsAudioState = true;
+    BEL_ST_ExecuteAudioCommands();
+
     while (len)
     {
         if (!g_sdlScaledSampleOffsetInSound)
@@ -419,24 +664,26 @@ static void BEL_ST_Simple_EmuCallBack(void *unused, Uint8 *stream, int len)
                 targetALSamples = g_sdlALOutNumOfSamples;
             }
             // TODO Output overflow warning if there's any
-            if (targetALSamples > g_sdlALOutSamplesEnd)
-            {
-                YM3812UpdateOne(&oplChip, &g_sdlALOutSamples[g_sdlALOutSamplesEnd], targetALSamples - g_sdlALOutSamplesEnd);
-                g_sdlALOutSamplesEnd = targetALSamples;
-            }
-            // Mix with AL data
-            for (uint32_t i = 0; i < targetALSamples; ++i)
-                currSamplePtr[i] = (currSamplePtr[i] + g_sdlALOutSamples[i]) / 2;
-            // Move pending AL data
-            if (targetALSamples >= g_sdlALOutSamplesEnd)
+            if (targetALSamples > g_sdlALOutSamplesPending)
+                BEL_ST_GenerateALSamples(targetALSamples - g_sdlALOutSamplesPending);
+            // Consume the pending AL data from the ring buffer, in at most two parts
+            BE_ST_SndSample_T *outSamplePtr = currSamplePtr;
+            uint32_t samplesLeft = targetALSamples;
+            while (samplesLeft)
             {
-                g_sdlALOutSamplesEnd = 0;
-            }
-            else if (targetALSamples < g_sdlALOutSamplesEnd)
-            {
-                memmove(g_sdlALOutSamples, &g_sdlALOutSamples[targetALSamples], sizeof(BE_ST_SndSample_T) * (g_sdlALOutSamplesEnd - targetALSamples));
-                g_sdlALOutSamplesEnd -= targetALSamples;
+                const uint32_t partLength = BE_Cross_TypedMin32(samplesLeft, g_sdlALOutNumOfSamples - g_sdlALOutSamplesStart);
+                BE_ST_SndSample_T *alSamplePtr = &g_sdlALOutSamples[g_sdlALOutSamplesStart];
+                // Add pre-rendered data
+                if (S16IsAnyVoicePlaying())
+                    S16UpdateOne(alSamplePtr, partLength);
+                // Mix with AL data
+                for (uint32_t i = 0; i < partLength; ++i)
+                    outSamplePtr[i] = (outSamplePtr[i] + alSamplePtr[i]) / 2;
+                outSamplePtr += partLength;
+                samplesLeft -= partLength;
+                g_sdlALOutSamplesStart = (g_sdlALOutSamplesStart + partLength) % g_sdlALOutNumOfSamples;
             }
+            g_sdlALOutSamplesPending -= targetALSamples;
         }
         // We're done for now
         currSamplePtr += currNumOfSamples;
@@ -452,6 +699,8 @@ static void BEL_ST_Simple_EmuCallBack(void *unused, Uint8 *stream, int len)
         }
     }
 
+    g_sdlOwnsAudioState = false;
+
     ///////////////////////////////
     BE_ST_UnlockAudioRecursively(); // RECURSIVE unlock
     ///////////////////////////////
@@ -18,6 +18,7 @@
 
 #include "id_sd.h"
 #include "be_st.h"
+#include <atomic>
 
 #define	SDL_SoundFinished()	{SoundNumber = SoundPriority = 0;}
 
@@ -55,11 +56,31 @@ static const uint8_t modifiers[9] = { 0, 1, 2, 8, 9,10,16,17,18 };
 //	Sequencer variables
 static	bool			sqActive;
 static	uint16_t			alFXReg;
-static	uint16_t			*sqHack, *sqHackPtr,sqHackLen,sqHackSeqLen;
+static	MusicTrack		*sqHack;
+static	uint16_t			sqHackLen,sqHackSeqLen;
 static	uint32_t			sqHackTime;
 
+//	Game thread variables; the sound state itself is owned by the audio callback
+static	SDMode			RequestedSoundMode;
+static	SMMode			RequestedMusicMode;
+static	std::atomic<int>	SoundsPending(0);
+
 //	Internal routines
 
+///////////////////////////////////////////////////////////////////////////
+//
+//	SDL_PostCommand() - Posts a call to the audio callback, which owns the
+//		sound state. Returns false if the caller already owns it, in which
+//		case the caller should do the work itself.
+//
+///////////////////////////////////////////////////////////////////////////
+static bool
+SDL_PostCommand(void (*handler)(const BE_ST_AudioCommand *), void *data = 0, uint32_t arg0 = 0, uint32_t arg1 = 0, uint32_t arg2 = 0)
+{
+	BE_ST_AudioCommand command = { handler, data, { arg0, arg1, arg2 } };
+	return BE_ST_PostAudioCommand(&command);
+}
+
 ///////////////////////////////////////////////////////////////////////////
 //
 //	SDL_SetTimer0() - Sets system timer 0 to the specified speed
@@ -96,6 +117,11 @@ SDL_SetIntsPerSec(uint16_t ints)
 void
 SDL_PCPlaySound(PCSound *sound)
 {
+	SoundsPending++;
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SDL_PCPlaySound((PCSound *)command->data); SoundsPending--; }, sound))
+		return;
+	SoundsPending--;
+
 	BE_ST_LockAudioRecursively();
 
 	pcLastSample = -1;
@@ -116,6 +142,9 @@ SDL_PCPlaySound(PCSound *sound)
 void
 SDL_PCStopSound(void)
 {
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SDL_PCStopSound(); }))
+		return;
+
 	BE_ST_LockAudioRecursively();
 
 	pcSound = 0;
@@ -205,10 +234,14 @@ alOut(uint8_t n,uint8_t b)
 void
 SDL_ALStopSound(void)
 {
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SDL_ALStopSound(); }))
+		return;
+
 	BE_ST_LockAudioRecursively();
 
 	alSound = 0;
 	alOut(alFreqH + 0,0);
+	BE_ST_StopSoundEffect();
 
 	BE_ST_UnlockAudioRecursively();
 }
@@ -240,6 +273,11 @@ SDL_AlSetFXInst(AdlibSound *inst)
 void
 SDL_ALPlaySound(AdlibSound *sound)
 {
+	SoundsPending++;
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SDL_ALPlaySound((AdlibSound *)command->data); SoundsPending--; }, sound))
+		return;
+	SoundsPending--;
+
 	SDL_ALStopSound();
 
 	BE_ST_LockAudioRecursively();
@@ -294,7 +332,7 @@ static void
 SDL_ALService(void)
 {
 	uint8_t 	a,v;
-	uint16_t	w;
+	uint16_t	delay;
 
 	if (!sqActive)
 		return;
@@ -302,11 +340,9 @@ SDL_ALService(void)
 	// REFKEEN - Looks like this the comparison is unsigned in original EXE
 	while (sqHackLen && ((uint32_t)sqHackTime <= alTimeCount))
 	{
-		w = *sqHackPtr++;
-		sqHackTime = alTimeCount + *sqHackPtr++;
-		// REFKEEN - This is the case on Little and Big Endian altogether
-		a = *((uint8_t *)&w);
-		v = *((uint8_t *)&w + 1);
+		// The register writes are expanded from the compressed track while playing
+		sqHack->ReadEvent(a,v,delay);
+		sqHackTime = alTimeCount + delay;
 
 		alOut(a,v);
 		sqHackLen -= 4;
@@ -314,7 +350,7 @@ SDL_ALService(void)
 	alTimeCount++;
 	if (!sqHackLen)
 	{
-		sqHackPtr = (uint16_t*)sqHack;
+		sqHack->Rewind();
 		sqHackLen = sqHackSeqLen;
 		alTimeCount = sqHackTime = 0;
 	}
@@ -385,6 +421,9 @@ SDL_DetectAdLib(void)
 		return false;
 	}
 
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SDL_DetectAdLib(); }))
+		return true;
+
 	alOut(4,0x60);	// Reset T1 & T2
 	alOut(4,0x80);	// Reset IRQ
 	alOut(2,0xff);	// Set timer 1
@@ -528,6 +567,10 @@ SDL_SetTimerSpeed(void)
 bool
 SD_SetSoundMode(SDMode mode)
 {
+	RequestedSoundMode = mode;
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_SetSoundMode((SDMode)command->args[0]); }, 0, mode))
+		return true;
+
 	SD_StopSound();
 
 	if (mode != SoundMode)
@@ -552,6 +595,14 @@ SD_SetMusicMode(SMMode mode)
 {
 	bool result;
 
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_SetMusicMode((SMMode)command->args[0]); }, 0, mode))
+	{
+		result = (mode == smm_Off) || ((mode == smm_AdLib) && AdLibPresent);
+		if (result)
+			RequestedMusicMode = mode;
+		return result;
+	}
+
 	switch (mode)
 	{
 	case smm_Off:
@@ -576,7 +627,7 @@ SD_SetMusicMode(SMMode mode)
 	}
 
 	if (result)
-		MusicMode = mode;
+		MusicMode = RequestedMusicMode = mode;
 
 	SDL_SetTimerSpeed();
 
@@ -586,13 +637,13 @@ SD_SetMusicMode(SMMode mode)
 SDMode
 SD_GetSoundMode()
 {
-    return SoundMode;
+    return RequestedSoundMode;
 }
 
 SMMode
 SD_GetMusicMode()
 {
-    return MusicMode;
+    return RequestedMusicMode;
 }
 
 
@@ -608,6 +659,13 @@ SD_Startup(void)
 	if (SD_Started)
 		return;
 
+	// Start up while the audio callback is not running
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_Startup(); }))
+	{
+		BE_ST_FlushAudioCommands();
+		return;
+	}
+
 	SoundUserHook = 0;
 
     BE_ST_StartAudioAndTimerInt(&SDL_t0Service);
@@ -686,6 +744,13 @@ SD_Shutdown(void)
 	if (!SD_Started)
 		return;
 
+	// Shut down while the audio callback is not running
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_Shutdown(); }))
+	{
+		BE_ST_FlushAudioCommands();
+		return;
+	}
+
     BE_ST_StopAudioAndTimerInt();
 
     SD_MusicOff();
@@ -729,13 +794,17 @@ SD_SoundPlaying(void)
 {
 	bool	result = false;
 
+	// A sound that was just started may not have reached the audio callback yet
+	if (SoundsPending > 0)
+		return true;
+
 	switch (SoundMode)
 	{
 	case sdm_PC:
 		result = pcSound? true : false;
 		break;
 	case sdm_AdLib:
-		result = alSound? true : false;
+		result = (alSound || BE_ST_IsSoundEffectPlaying() || BE_ST_IsS16VoicePlaying())? true : false;
 		break;
 	}
 
@@ -750,6 +819,9 @@ SD_SoundPlaying(void)
 void
 SD_StopSound(void)
 {
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_StopSound(); }))
+		return;
+
 	switch (SoundMode)
 	{
 	case sdm_PC:
@@ -757,6 +829,7 @@ SD_StopSound(void)
 		break;
 	case sdm_AdLib:
 		SDL_ALStopSound();
+		BE_ST_StopS16Voices();
 		break;
 	}
 
@@ -786,6 +859,9 @@ SD_WaitSoundDone(void)
 void
 SD_MusicOn(void)
 {
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_MusicOn(); }))
+		return;
+
 	sqActive = true;
 }
 
@@ -799,6 +875,8 @@ SD_MusicOff(void)
 {
 	uint16_t	i;
 
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_MusicOff(); }))
+		return;
 
 	switch (MusicMode)
 	{
@@ -809,6 +887,7 @@ SD_MusicOff(void)
 			alOut(alFreqH + i + 1,0);
 		break;
 	}
+	BE_ST_StopS16Music();
 	sqActive = false;
 }
 
@@ -818,15 +897,19 @@ SD_MusicOff(void)
 //
 ///////////////////////////////////////////////////////////////////////////
 void
-SD_StartMusic(FileChunk* music)
+SD_StartMusic(MusicTrack* music)
 {
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_StartMusic((MusicTrack *)command->data); }, music))
+		return;
+
 	SD_MusicOff();
 	BE_ST_LockAudioRecursively();
 
 	if (MusicMode == smm_AdLib)
 	{
-        sqHackPtr = sqHack = (uint16_t*)music->GetChunk();
-        sqHackSeqLen = sqHackLen = (uint16_t)music->GetSize();
+        sqHack = music;
+        sqHack->Rewind();
+        sqHackSeqLen = sqHackLen = music->GetLength();
 		sqHackTime = 0;
 		alTimeCount = 0;
 		SD_MusicOn();
@@ -834,3 +917,112 @@ SD_StartMusic(FileChunk* music)
 
 	BE_ST_UnlockAudioRecursively();
 }
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	SD_PlayPrerenderedSound() - plays a sound effect that was rendered
+//		ahead of time, instead of programming the AdLib card
+//
+///////////////////////////////////////////////////////////////////////////
+void
+SD_PlayPrerenderedSound(int16_t* samples, uint32_t numOfSamples, uint16_t priority)
+{
+	SoundsPending++;
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_PlayPrerenderedSound((int16_t *)command->data, command->args[0], (uint16_t)command->args[1]); SoundsPending--; }, samples, numOfSamples, priority))
+		return;
+	SoundsPending--;
+
+	SDL_ALStopSound();
+
+	BE_ST_LockAudioRecursively();
+
+	SoundPriority = priority;
+	BE_ST_PlayS16SoundEffect(samples, (int)numOfSamples);
+
+	BE_ST_UnlockAudioRecursively();
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	SD_MixPrerenderedSound() - plays a sound effect that was rendered ahead
+//		of time on a voice of its own, such that it can overlap with other
+//		sound effects instead of interrupting them
+//
+///////////////////////////////////////////////////////////////////////////
+void
+SD_MixPrerenderedSound(int16_t* samples, uint32_t numOfSamples, uint16_t volume)
+{
+	SoundsPending++;
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_MixPrerenderedSound((int16_t *)command->data, command->args[0], (uint16_t)command->args[1]); SoundsPending--; }, samples, numOfSamples, volume))
+		return;
+	SoundsPending--;
+
+	BE_ST_LockAudioRecursively();
+
+	BE_ST_PlayS16Voice(samples, (int)numOfSamples, volume);
+
+	BE_ST_UnlockAudioRecursively();
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	SD_StartPrerenderedMusic() - starts playing music that was rendered
+//		ahead of time, instead of running the sequencer
+//
+///////////////////////////////////////////////////////////////////////////
+void
+SD_StartPrerenderedMusic(int16_t* samples, uint32_t numOfSamples, uint32_t loopStart)
+{
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { SD_StartPrerenderedMusic((int16_t *)command->data, command->args[0], command->args[1]); }, samples, numOfSamples, loopStart))
+		return;
+
+	SD_MusicOff();
+	BE_ST_LockAudioRecursively();
+
+	if (MusicMode == smm_AdLib)
+	{
+		BE_ST_PlayS16Music(samples, (int)numOfSamples, (int)loopStart);
+	}
+
+	BE_ST_UnlockAudioRecursively();
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	SD_StopPrerendered() - stops any pre-rendered sound effect and music,
+//		such that their samples can be released when this returns
+//
+///////////////////////////////////////////////////////////////////////////
+void
+SD_StopPrerendered(void)
+{
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *) { SD_StopPrerendered(); }))
+	{
+		BE_ST_FlushAudioCommands();
+		return;
+	}
+
+	BE_ST_StopSoundEffect();
+	BE_ST_StopS16Voices();
+	BE_ST_StopS16Music();
+}
+
+///////////////////////////////////////////////////////////////////////////
+//
+//	SD_SetPrerenderedOnly() - when all AdLib output is pre-rendered, the
+//		emulated OPL chip no longer needs to generate samples
+//
+///////////////////////////////////////////////////////////////////////////
+void
+SD_SetPrerenderedOnly(bool prerenderedOnly)
+{
+	static bool requested = false;
+	if (prerenderedOnly == requested)
+		return;
+	requested = prerenderedOnly;
+
+	if (SDL_PostCommand([](const BE_ST_AudioCommand *command) { BE_ST_SetOPLEmulationPaused(command->args[0] != 0); }, 0, prerenderedOnly))
+		return;
+
+	BE_ST_SetOPLEmulationPaused(prerenderedOnly);
+}
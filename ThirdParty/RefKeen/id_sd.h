@@ -21,6 +21,7 @@
 
 #include "../../src/Engine/PCSound.h"
 #include "../../src/Engine/AdlibSound.h"
+#include "../../src/Engine/MusicTrack.h"
 
 
 #ifndef	__ID_SD__
@@ -122,7 +123,7 @@ extern	void	SD_Startup(void),
 				SD_Shutdown(void),
 				SD_Default(bool gotit,SDMode sd,SMMode sm),
 				SD_WaitSoundDone(void),
-				SD_StartMusic(FileChunk* music),
+				SD_StartMusic(MusicTrack* music),
 				SD_MusicOn(void),
 				SD_MusicOff(void),
 				SD_SetUserHook(void (*hook)(void));
@@ -132,6 +133,13 @@ extern bool    SD_SetMusicMode(SMMode mode);
 extern SMMode  SD_GetMusicMode();
 extern bool    SD_SoundPlaying(void);
 
+// Pre-rendered Adlib output (see AdlibRenderer); the samples must remain valid until stopped
+extern	void	SD_PlayPrerenderedSound(int16_t* samples, uint32_t numOfSamples, uint16_t priority),
+				SD_StartPrerenderedMusic(int16_t* samples, uint32_t numOfSamples, uint32_t loopStart),
+				SD_MixPrerenderedSound(int16_t* samples, uint32_t numOfSamples, uint16_t volume),
+				SD_StopPrerendered(void),
+				SD_SetPrerenderedOnly(bool prerenderedOnly);
+
 extern	void	SDL_PCPlaySound(PCSound* sound),
 				SDL_PCStopSound(void),
 				SDL_ALPlaySound(AdlibSound* sound),
@@ -54,6 +54,14 @@
 
 #define GCC_UNLIKELY(x) x
 
+#if defined(__AVX2__)
+#define DBOPL_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define DBOPL_SSE2
+#include <emmintrin.h>
+#endif
+
 #define TRUE 1
 #define FALSE 0
 
@@ -189,7 +197,8 @@ static Bit16u SinTable[ 512 ];
 
 //6 is just 0 shifted and masked
 
-static Bit16s WaveTable[ 8 * 512 ];
+//One entry of padding for the 32 bit gathers of the vector path
+static Bit16s WaveTable[ 8 * 512 + 1 ];
 //Distance into WaveTable the wave starts
 static const Bit16u WaveBaseTable[8] = {
 	0x000, 0x200, 0x200, 0x800,
@@ -210,7 +219,8 @@ static const Bit16u WaveStartTable[8] = {
 #endif
 
 #if ( DBOPL_WAVE == WAVE_TABLEMUL )
-static Bit16u MulTable[ 384 ];
+//One entry of padding, which stays 0, for the silent volumes of the vector path
+static Bit16u MulTable[ 384 + 1 ];
 #endif
 
 static Bit8u KslTable[ 8 * 16 ];
@@ -1060,6 +1070,249 @@ Channel* Channel__BlockTemplate(Channel *self, Chip* chip,
 	return 0;
 }
 
+/*
+	Block generation
+
+	Alternative to Channel__BlockTemplate for the two operator modes. The envelope and phase
+	of each operator are first forwarded over a block, after which the waves are looked up
+	and scaled a vector at a time. The feedback of a modulator depends on its own previous
+	output, so the modulators of all channels run a sample at a time side by side instead,
+	which keeps their dependency chains from stalling each other.
+	The output is bit-exact with Channel__BlockTemplate.
+*/
+
+#if ( DBOPL_WAVE == WAVE_TABLEMUL )
+
+//Number of samples each operator is forwarded at once
+#define VECTOR_BLOCK 64
+
+typedef struct {
+	Channel* channel;
+	SynthMode mode;
+	//Modulator state, kept out of the channel for the feedback loop
+	const Bit16s* waveBase;
+	Bit32u waveMask;
+	Bit8u feedback;
+	Bit32s old[2];
+	//Multiplier of each sample, 0 when silent, and wave index without modulation
+	Bit16u mul[2][ VECTOR_BLOCK ];
+	Bit32u index[2][ VECTOR_BLOCK ];
+	Bit32s modulator[ VECTOR_BLOCK ];
+} ChannelBlock;
+
+static const Bit32s NoModulation[ VECTOR_BLOCK ] = { 0 };
+
+//Multiplier for a volume, the entry behind the table is 0 for all silent volumes
+static inline Bit16u Operator__BlockMul( Bit32u vol ) {
+	return MulTable[ ( vol < ENV_LIMIT ? vol : ENV_LIMIT ) >> ENV_EXTRA ];
+}
+
+//Same envelope as Operator__TemplateVolume, with its state kept in locals while forwarding a block
+static void Operator__ForwardEnvelope(Operator *self, Bitu samples, Bit16u* mul ) {
+	const Bit32u level = self->currentLevel;
+	Bit32s volume = self->volume;
+	Bit32u rateIndex = self->rateIndex;
+	Bit32u add;
+	Bitu i = 0;
+	while ( i < samples ) {
+		switch ( self->state ) {
+		case OFF:
+			for ( ; i < samples; i++ )
+				mul[i] = Operator__BlockMul( level + ENV_MAX );
+			break;
+		case ATTACK:
+			add = self->attackAdd;
+			for ( ; i < samples; i++ ) {
+				Bit32s change;
+				rateIndex += add;
+				change = rateIndex >> RATE_SH;
+				rateIndex &= RATE_MASK;
+				if ( change ) {
+					volume += ( (~volume) * change ) >> 3;
+					if ( volume < ENV_MIN ) {
+						volume = ENV_MIN;
+						rateIndex = 0;
+						Operator__SetState( self, DECAY );
+						mul[i++] = Operator__BlockMul( level + ENV_MIN );
+						break;
+					}
+				}
+				mul[i] = Operator__BlockMul( level + volume );
+			}
+			break;
+		case DECAY:
+			add = self->decayAdd;
+			for ( ; i < samples; i++ ) {
+				rateIndex += add;
+				volume += rateIndex >> RATE_SH;
+				rateIndex &= RATE_MASK;
+				if ( GCC_UNLIKELY(volume >= self->sustainLevel) ) {
+					if ( GCC_UNLIKELY(volume >= ENV_MAX) ) {
+						volume = ENV_MAX;
+						Operator__SetState( self, OFF );
+					} else {
+						rateIndex = 0;
+						Operator__SetState( self, SUSTAIN );
+					}
+					mul[i++] = Operator__BlockMul( level + volume );
+					break;
+				}
+				mul[i] = Operator__BlockMul( level + volume );
+			}
+			break;
+		case SUSTAIN:
+			if ( self->reg20 & MASK_SUSTAIN ) {
+				for ( ; i < samples; i++ )
+					mul[i] = Operator__BlockMul( level + volume );
+				break;
+			}
+			//In sustain phase, but not sustaining, do regular release
+		case RELEASE:
+			add = self->releaseAdd;
+			for ( ; i < samples; i++ ) {
+				rateIndex += add;
+				volume += rateIndex >> RATE_SH;
+				rateIndex &= RATE_MASK;
+				if ( GCC_UNLIKELY(volume >= ENV_MAX) ) {
+					volume = ENV_MAX;
+					Operator__SetState( self, OFF );
+					mul[i++] = Operator__BlockMul( level + ENV_MAX );
+					break;
+				}
+				mul[i] = Operator__BlockMul( level + volume );
+			}
+			break;
+		}
+	}
+	self->volume = volume;
+	self->rateIndex = rateIndex;
+}
+
+//Forward the envelope and the phase over a block, storing the multiplier and wave index of each sample
+static void Operator__ForwardBlock(Operator *self, Bitu samples, Bit16u* mul, Bit32u* index ) {
+	Bit32u waveIndex = self->waveIndex;
+	Bit32u waveCurrent = self->waveCurrent;
+	Bitu i = 0;
+	Operator__ForwardEnvelope( self, samples, mul );
+#if defined( DBOPL_AVX2 )
+	{
+		__m256i phase = _mm256_add_epi32( _mm256_set1_epi32( (int)waveIndex ),
+		                                  _mm256_mullo_epi32( _mm256_set1_epi32( (int)waveCurrent ), _mm256_setr_epi32( 1, 2, 3, 4, 5, 6, 7, 8 ) ) );
+		const __m256i step = _mm256_set1_epi32( (int)( waveCurrent * 8 ) );
+		for ( ; i + 8 <= samples; i += 8 ) {
+			_mm256_storeu_si256( (__m256i*)( index + i ), _mm256_srli_epi32( phase, WAVE_SH ) );
+			phase = _mm256_add_epi32( phase, step );
+		}
+	}
+#elif defined( DBOPL_SSE2 )
+	{
+		__m128i phase = _mm_setr_epi32( (int)( waveIndex + waveCurrent ), (int)( waveIndex + waveCurrent * 2 ),
+		                                (int)( waveIndex + waveCurrent * 3 ), (int)( waveIndex + waveCurrent * 4 ) );
+		const __m128i step = _mm_set1_epi32( (int)( waveCurrent * 4 ) );
+		for ( ; i + 4 <= samples; i += 4 ) {
+			_mm_storeu_si128( (__m128i*)( index + i ), _mm_srli_epi32( phase, WAVE_SH ) );
+			phase = _mm_add_epi32( phase, step );
+		}
+	}
+#endif
+	for ( ; i < samples; i++ )
+		index[i] = ( waveIndex + (Bit32u)( i + 1 ) * waveCurrent ) >> WAVE_SH;
+	self->waveIndex = waveIndex + (Bit32u)samples * waveCurrent;
+}
+
+//Look up and scale the waves of a block, adding them to the output
+static void Operator__WaveBlock(const Operator *self, const Bit16u* mul, const Bit32u* index,
+                                const Bit32s* modulation, Bitu samples, Bit32s* output ) {
+	const Bit16s* waveBase = self->waveBase;
+	const Bit32u waveMask = self->waveMask;
+	Bitu i = 0;
+#if defined( DBOPL_AVX2 )
+	const __m256i mask = _mm256_set1_epi32( (int)waveMask );
+	for ( ; i + 8 <= samples; i += 8 ) {
+		__m256i idx, wave, m;
+		idx = _mm256_add_epi32( _mm256_loadu_si256( (const __m256i*)( index + i ) ),
+		                        _mm256_loadu_si256( (const __m256i*)( modulation + i ) ) );
+		idx = _mm256_and_si256( idx, mask );
+		//The gather reads 32 bits for each 16 bit entry, the wave table is padded for the last one
+		wave = _mm256_i32gather_epi32( (const int*)waveBase, idx, 2 );
+		wave = _mm256_srai_epi32( _mm256_slli_epi32( wave, 16 ), 16 );
+		m = _mm256_cvtepu16_epi32( _mm_loadu_si128( (const __m128i*)( mul + i ) ) );
+		wave = _mm256_srai_epi32( _mm256_mullo_epi32( wave, m ), MUL_SH );
+		_mm256_storeu_si256( (__m256i*)( output + i ),
+		                     _mm256_add_epi32( _mm256_loadu_si256( (const __m256i*)( output + i ) ), wave ) );
+	}
+#elif defined( DBOPL_SSE2 )
+	for ( ; i + 8 <= samples; i += 8 ) {
+		__m128i w, m, high, sign;
+		w = _mm_setr_epi16( waveBase[ ( index[i + 0] + modulation[i + 0] ) & waveMask ],
+		                    waveBase[ ( index[i + 1] + modulation[i + 1] ) & waveMask ],
+		                    waveBase[ ( index[i + 2] + modulation[i + 2] ) & waveMask ],
+		                    waveBase[ ( index[i + 3] + modulation[i + 3] ) & waveMask ],
+		                    waveBase[ ( index[i + 4] + modulation[i + 4] ) & waveMask ],
+		                    waveBase[ ( index[i + 5] + modulation[i + 5] ) & waveMask ],
+		                    waveBase[ ( index[i + 6] + modulation[i + 6] ) & waveMask ],
+		                    waveBase[ ( index[i + 7] + modulation[i + 7] ) & waveMask ] );
+		m = _mm_loadu_si128( (const __m128i*)( mul + i ) );
+		//High half of the signed wave times the unsigned multiplier, which always fits in 16 bits
+		high = _mm_sub_epi16( _mm_mulhi_epu16( w, m ), _mm_and_si128( m, _mm_srai_epi16( w, 15 ) ) );
+		sign = _mm_srai_epi16( high, 15 );
+		_mm_storeu_si128( (__m128i*)( output + i ),
+		                  _mm_add_epi32( _mm_loadu_si128( (const __m128i*)( output + i ) ), _mm_unpacklo_epi16( high, sign ) ) );
+		_mm_storeu_si128( (__m128i*)( output + i + 4 ),
+		                  _mm_add_epi32( _mm_loadu_si128( (const __m128i*)( output + i + 4 ) ), _mm_unpackhi_epi16( high, sign ) ) );
+	}
+#endif
+	for ( ; i < samples; i++ )
+		output[i] += ( waveBase[ ( index[i] + modulation[i] ) & waveMask ] * mul[i] ) >> MUL_SH;
+}
+
+//Generate a block for a set of two operator channels, adding it to the output
+static void Channel__GenerateBlocks(ChannelBlock* blocks, Bitu channels, Bitu samples, Bit32s* output ) {
+	Bitu done, count, i, c;
+
+	for ( c = 0; c < channels; c++ ) {
+		const Operator* op = Channel__Op( blocks[c].channel, 0 );
+		blocks[c].waveBase = op->waveBase;
+		blocks[c].waveMask = op->waveMask;
+		blocks[c].feedback = blocks[c].channel->feedback;
+		blocks[c].old[0] = blocks[c].channel->old[0];
+		blocks[c].old[1] = blocks[c].channel->old[1];
+	}
+	for ( done = 0; done < samples; done += count ) {
+		count = samples - done;
+		if ( count > VECTOR_BLOCK )
+			count = VECTOR_BLOCK;
+		for ( c = 0; c < channels; c++ ) {
+			Operator__ForwardBlock( Channel__Op( blocks[c].channel, 0 ), count, blocks[c].mul[0], blocks[c].index[0] );
+			Operator__ForwardBlock( Channel__Op( blocks[c].channel, 1 ), count, blocks[c].mul[1], blocks[c].index[1] );
+		}
+		for ( i = 0; i < count; i++ ) {
+			for ( c = 0; c < channels; c++ ) {
+				ChannelBlock* block = blocks + c;
+				Bit32s mod = (Bit32u)( block->old[0] + block->old[1] ) >> block->feedback;
+				block->old[0] = block->old[1];
+				block->old[1] = ( block->waveBase[ ( block->index[0][i] + mod ) & block->waveMask ] * block->mul[0][i] ) >> MUL_SH;
+				block->modulator[i] = block->old[0];
+			}
+		}
+		for ( c = 0; c < channels; c++ ) {
+			const Operator* op = Channel__Op( blocks[c].channel, 1 );
+			if ( blocks[c].mode == sm2AM ) {
+				for ( i = 0; i < count; i++ )
+					output[ done + i ] += blocks[c].modulator[i];
+				Operator__WaveBlock( op, blocks[c].mul[1], blocks[c].index[1], NoModulation, count, output + done );
+			} else {
+				Operator__WaveBlock( op, blocks[c].mul[1], blocks[c].index[1], blocks[c].modulator, count, output + done );
+			}
+		}
+	}
+	for ( c = 0; c < channels; c++ ) {
+		blocks[c].channel->old[0] = blocks[c].old[0];
+		blocks[c].channel->old[1] = blocks[c].old[1];
+	}
+}
+#endif
+
 /*
 	Chip
 */
@@ -1295,6 +1548,47 @@ void Chip__GenerateBlock2(Chip *self, Bitu total, Bit32s* output ) {
 	}
 }
 
+void Chip__GenerateBlock2Vectorized(Chip *self, Bitu total, Bit32s* output ) {
+#if ( DBOPL_WAVE == WAVE_TABLEMUL )
+	ChannelBlock blocks[9];
+	while ( total > 0 ) {
+		Channel *ch;
+		Bitu channels = 0;
+
+		Bit32u samples = Chip__ForwardLFO( self, total );
+		memset(output, 0, sizeof(Bit32s) * samples);
+		for ( ch = self->chan; ch < self->chan + 9; ) {
+			SynthMode mode;
+			if ( ch->synthHandler == Channel__BlockTemplate_sm2FM ) {
+				mode = sm2FM;
+			} else if ( ch->synthHandler == Channel__BlockTemplate_sm2AM ) {
+				mode = sm2AM;
+			} else {
+				ch = (ch->synthHandler)( ch, self, samples, output );
+				continue;
+			}
+			//Same early out as Channel__BlockTemplate
+			if ( Operator__Silent( Channel__Op( ch, 1 ) )
+			     && ( mode == sm2FM || Operator__Silent( Channel__Op( ch, 0 ) ) ) ) {
+				ch->old[0] = ch->old[1] = 0;
+			} else {
+				Operator__Prepare( Channel__Op( ch, 0 ), self );
+				Operator__Prepare( Channel__Op( ch, 1 ), self );
+				blocks[ channels ].channel = ch;
+				blocks[ channels ].mode = mode;
+				channels++;
+			}
+			ch++;
+		}
+		Channel__GenerateBlocks( blocks, channels, samples, output );
+		total -= samples;
+		output += samples;
+	}
+#else
+	Chip__GenerateBlock2( self, total, output );
+#endif
+}
+
 void Chip__GenerateBlock3(Chip *self, Bitu total, Bit32s* output  ) {
 	while ( total > 0 ) {
                 int count;
@@ -201,6 +201,8 @@ void DBOPL_InitTables( void );
 void Chip__Chip(Chip *self);
 void Chip__WriteReg(Chip *self, Bit32u reg, Bit8u val );
 void Chip__GenerateBlock2(Chip *self, Bitu total, Bit32s* output );
+// Same output as Chip__GenerateBlock2, generating the melodic channels a block at a time with SIMD
+void Chip__GenerateBlock2Vectorized(Chip *self, Bitu total, Bit32s* output );
 
 // haleyjd 09/09/10: Not standard C.
 #ifdef _MSC_VER
@@ -48,8 +48,8 @@ GameAbyss::~GameAbyss()
 {
     delete m_gameMaps;
     delete m_egaGraph;
-    delete m_audioRepository;
     delete m_audioPlayer;
+    delete m_audioRepository;
     delete m_introView;
     delete m_helpPages;
 }
@@ -20,49 +20,53 @@ namespace fs = std::filesystem;
 IntroViewAbyss::IntroViewAbyss(IRenderer& renderer, const fs::path& path) :
     IIntroView(renderer)
 {
+    std::vector<std::pair<Shape*, fs::path>> shapesToLoad;
+
     m_shapeEntering = new Shape(renderer);
     const fs::path shp05 = path / "SHP05.ABS";
-    m_shapeEntering->LoadFromFile(shp05);
+    shapesToLoad.push_back({ m_shapeEntering, shp05 });
 
     m_shapePresents = new Shape(renderer);
     const fs::path shp12 = path / "SHP12.ABS";
-    m_shapePresents->LoadFromFile(shp12);
+    shapesToLoad.push_back({ m_shapePresents, shp12 });
 
     m_shapeSoftdisk = new Shape(renderer);
     const fs::path shp01 = path / "SHP01.ABS";
-    m_shapeSoftdisk->LoadFromFile(shp01);
+    shapesToLoad.push_back({ m_shapeSoftdisk, shp01 });
 
     m_shapeTitle = new Shape(renderer);
     const fs::path shp02 = path / "SHP02.ABS";
-    m_shapeTitle->LoadFromFile(shp02);
+    shapesToLoad.push_back({ m_shapeTitle, shp02 });
 
     m_shapeCredits = new Shape(renderer);
     const fs::path shp03 = path / "SHP03.ABS";
-    m_shapeCredits->LoadFromFile(shp03);
+    shapesToLoad.push_back({ m_shapeCredits, shp03 });
 
     m_shapeTrilogy = new Shape(renderer);
     const fs::path shp11 = path / "SHP11.ABS";
-    m_shapeTrilogy->LoadFromFile(shp11);
+    shapesToLoad.push_back({ m_shapeTrilogy, shp11 });
 
     m_shapeSelectDifficulty = new Shape(renderer);
     const fs::path shp07 = path / "SHP07.ABS";
-    m_shapeSelectDifficulty->LoadFromFile(shp07);
+    shapesToLoad.push_back({ m_shapeSelectDifficulty, shp07 });
 
     m_shapeConfirmDifficulty = new Shape(renderer);
     const fs::path shp06 = path / "SHP06.ABS";
-    m_shapeConfirmDifficulty->LoadFromFile(shp06);
+    shapesToLoad.push_back({ m_shapeConfirmDifficulty, shp06 });
 
     m_shapeNovice = new Shape(renderer);
     const fs::path shp08 = path / "SHP08.ABS";
-    m_shapeNovice->LoadFromFile(shp08);
+    shapesToLoad.push_back({ m_shapeNovice, shp08 });
 
     m_shapeWarrior = new Shape(renderer);
     const fs::path shp09 = path / "SHP09.ABS";
-    m_shapeWarrior->LoadFromFile(shp09);
+    shapesToLoad.push_back({ m_shapeWarrior, shp09 });
 
     m_shapeStandBeforeGate = new Shape(renderer);
     const fs::path shp04 = path / "SHP04.ABS";
-    m_shapeStandBeforeGate->LoadFromFile(shp04);
+    shapesToLoad.push_back({ m_shapeStandBeforeGate, shp04 });
+
+    Shape::LoadFromFiles(shapesToLoad);
 
     // SHP04 = Stand before gate
     // SHP05 = Prepare
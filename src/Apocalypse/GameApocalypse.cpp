@@ -46,8 +46,8 @@ GameApocalypse::~GameApocalypse()
 {
     delete m_gameMaps;
     delete m_egaGraph;
-    delete m_audioRepository;
     delete m_audioPlayer;
+    delete m_audioRepository;
     delete m_introView;
 }
 
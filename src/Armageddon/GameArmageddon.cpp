@@ -45,8 +45,8 @@ GameArmageddon::~GameArmageddon()
 {
     delete m_gameMaps;
     delete m_egaGraph;
-    delete m_audioRepository;
     delete m_audioPlayer;
+    delete m_audioRepository;
     delete m_introView;
 }
 
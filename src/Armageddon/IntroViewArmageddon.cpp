@@ -20,57 +20,61 @@ namespace fs = std::filesystem;
 IntroViewArmageddon::IntroViewArmageddon(IRenderer& renderer, const fs::path& path) :
     IIntroView(renderer)
 {
+    std::vector<std::pair<Shape*, fs::path>> shapesToLoad;
+
     m_shapeEntering = new Shape(renderer);
     const fs::path shp8 = path / "SHP8.ARM";
-    m_shapeEntering->LoadFromFile(shp8);
+    shapesToLoad.push_back({ m_shapeEntering, shp8 });
 
     m_shapePresents = new Shape(renderer);
     const fs::path shp14 = path / "SHP14.ARM";
-    m_shapePresents->LoadFromFile(shp14);
+    shapesToLoad.push_back({ m_shapePresents, shp14 });
 
     m_shapeSoftdisk = new Shape(renderer);
     const fs::path shp1 = path / "SHP1.ARM";
-    m_shapeSoftdisk->LoadFromFile(shp1);
+    shapesToLoad.push_back({ m_shapeSoftdisk, shp1 });
 
     m_shapeTitle = new Shape(renderer);
     const fs::path shp2 = path / "SHP2.ARM";
-    m_shapeTitle->LoadFromFile(shp2);
+    shapesToLoad.push_back({ m_shapeTitle, shp2 });
 
     m_shapeCreditsProgramming = new Shape(renderer);
     const fs::path shp3 = path / "SHP3.ARM";
-    m_shapeCreditsProgramming->LoadFromFile(shp3);
+    shapesToLoad.push_back({ m_shapeCreditsProgramming, shp3 });
 
     m_shapeCreditsArt = new Shape(renderer);
     const fs::path shp4 = path / "SHP4.ARM";
-    m_shapeCreditsArt->LoadFromFile(shp4);
+    shapesToLoad.push_back({ m_shapeCreditsArt, shp4 });
 
     m_shapeCreditsQA = new Shape(renderer);
     const fs::path shp5 = path / "SHP5.ARM";
-    m_shapeCreditsQA->LoadFromFile(shp5);
+    shapesToLoad.push_back({ m_shapeCreditsQA, shp5 });
 
     m_shapeCreditsDesign = new Shape(renderer);
     const fs::path shp6 = path / "SHP6.ARM";
-    m_shapeCreditsDesign->LoadFromFile(shp6);
+    shapesToLoad.push_back({ m_shapeCreditsDesign, shp6 });
 
     m_shapeSelectDifficulty = new Shape(renderer);
     const fs::path shp10 = path / "SHP10.ARM";
-    m_shapeSelectDifficulty->LoadFromFile(shp10);
+    shapesToLoad.push_back({ m_shapeSelectDifficulty, shp10 });
 
     m_shapeConfirmDifficulty = new Shape(renderer);
     const fs::path shp9 = path / "SHP9.ARM";
-    m_shapeConfirmDifficulty->LoadFromFile(shp9);
+    shapesToLoad.push_back({ m_shapeConfirmDifficulty, shp9 });
 
     m_shapeNovice = new Shape(renderer);
     const fs::path shp11 = path / "SHP11.ARM";
-    m_shapeNovice->LoadFromFile(shp11);
+    shapesToLoad.push_back({ m_shapeNovice, shp11 });
 
     m_shapeWarrior = new Shape(renderer);
     const fs::path shp12 = path / "SHP12.ARM";
-    m_shapeWarrior->LoadFromFile(shp12);
+    shapesToLoad.push_back({ m_shapeWarrior, shp12 });
 
     m_shapeStandBeforeGate = new Shape(renderer);
     const fs::path shp7 = path / "SHP7.ARM";
-    m_shapeStandBeforeGate->LoadFromFile(shp7);
+    shapesToLoad.push_back({ m_shapeStandBeforeGate, shp7 });
+
+    Shape::LoadFromFiles(shapesToLoad);
 }
 
 IntroViewArmageddon::~IntroViewArmageddon()
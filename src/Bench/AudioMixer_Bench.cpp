@@ -0,0 +1,48 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "../Engine/AudioMixer.h"
+#include <vector>
+
+// Mixes a number of voices into one buffer of the audio callback, as the sound mixer does.
+static void BM_AudioMixer_MixVoices(benchmark::State& state)
+{
+    const uint32_t length = 256;
+    const uint32_t numberOfVoices = (uint32_t)state.range(0);
+    std::vector<int16_t> opl(length, 100);
+    std::vector<std::vector<int16_t>> voices(numberOfVoices, std::vector<int16_t>(length));
+    for (uint32_t v = 0; v < numberOfVoices; v++)
+    {
+        for (uint32_t i = 0; i < length; i++)
+        {
+            voices[v][i] = (int16_t)(((i * 37 + v * 11) % 2048) - 1024);
+        }
+    }
+    std::vector<int32_t> accumulator(length);
+
+    for (auto _ : state)
+    {
+        AudioMixer::Load(accumulator.data(), opl.data(), length);
+        for (uint32_t v = 0; v < numberOfVoices; v++)
+        {
+            AudioMixer::Add(accumulator.data(), voices[v].data(), length, (uint16_t)(128 + v));
+        }
+        AudioMixer::Store(opl.data(), accumulator.data(), length);
+        benchmark::DoNotOptimize(opl.data());
+    }
+    state.SetItemsProcessed(state.iterations() * length * numberOfVoices);
+}
+BENCHMARK(BM_AudioMixer_MixVoices)->Arg(1)->Arg(8);
@@ -0,0 +1,515 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "BenchFixtures.h"
+#include "../Engine/EgaColor.h"
+#include <cstring>
+
+namespace
+{
+    // Same LZSS and Huffman parameters as the LZH decoder
+    const int16_t lzhRingBufferSize = 4096;
+    const int16_t lzhLookAheadSize = 30;
+    const int16_t lzhThreshold = 2;
+    const int16_t lzhNumberOfChars = 256 - lzhThreshold + lzhLookAheadSize;
+    const int16_t lzhTableSize = (lzhNumberOfChars * 2) - 1;
+    const int16_t lzhRootPosition = lzhTableSize - 1;
+
+    // Codes for the upper 6 bits of a match position, aligned to the most significant bit
+    const uint8_t lzhPositionCodeLength[64] =
+    {
+        0x03, 0x04, 0x04, 0x04, 0x05, 0x05, 0x05, 0x05,
+        0x05, 0x05, 0x05, 0x05, 0x06, 0x06, 0x06, 0x06,
+        0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06, 0x06,
+        0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+        0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+        0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07, 0x07,
+        0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
+        0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08
+    };
+
+    const uint8_t lzhPositionCode[64] =
+    {
+        0x00, 0x20, 0x30, 0x40, 0x50, 0x58, 0x60, 0x68,
+        0x70, 0x78, 0x80, 0x88, 0x90, 0x94, 0x98, 0x9C,
+        0xA0, 0xA4, 0xA8, 0xAC, 0xB0, 0xB4, 0xB8, 0xBC,
+        0xC0, 0xC2, 0xC4, 0xC6, 0xC8, 0xCA, 0xCC, 0xCE,
+        0xD0, 0xD2, 0xD4, 0xD6, 0xD8, 0xDA, 0xDC, 0xDE,
+        0xE0, 0xE2, 0xE4, 0xE6, 0xE8, 0xEA, 0xEC, 0xEE,
+        0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,
+        0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF
+    };
+
+    // Encoding side of the adaptive Huffman coding in LZHUF.C. The tree is updated exactly like the decoder does.
+    class LzhEncoder
+    {
+    public:
+        LzhEncoder(std::vector<uint8_t>& output) :
+            m_output(output),
+            m_bitBuffer(0),
+            m_bitCount(0)
+        {
+            int16_t i = 0;
+            for (i = 0; i < lzhNumberOfChars; i++)
+            {
+                m_freq[i] = 1;
+                m_child[i] = i + lzhTableSize;
+                m_parent[i + lzhTableSize] = i;
+            }
+            i = 0;
+            for (int16_t j = lzhNumberOfChars; j <= lzhRootPosition; j++)
+            {
+                m_freq[j] = m_freq[i] + m_freq[i + 1];
+                m_child[j] = i;
+                m_parent[i] = m_parent[i + 1] = j;
+                i += 2;
+            }
+            m_freq[lzhTableSize] = 0xffff;
+            m_parent[lzhRootPosition] = 0;
+        }
+
+        void EncodeChar(const uint16_t c)
+        {
+            // Walk from the leaf up to the root; the second child of a node always has an odd index.
+            uint8_t path[lzhTableSize];
+            uint16_t length = 0;
+            int16_t k = m_parent[c + lzhTableSize];
+            do
+            {
+                path[length++] = (uint8_t)(k & 1);
+            } while ((k = m_parent[k]) != lzhRootPosition);
+
+            while (length > 0)
+            {
+                PutBit(path[--length]);
+            }
+            Update(c);
+        }
+
+        void EncodePosition(const uint16_t position)
+        {
+            const uint16_t upper = position >> 6;
+            for (uint8_t bit = 0; bit < lzhPositionCodeLength[upper]; bit++)
+            {
+                PutBit((lzhPositionCode[upper] >> (7 - bit)) & 1);
+            }
+            for (uint8_t bit = 0; bit < 6; bit++)
+            {
+                PutBit((position >> (5 - bit)) & 1);
+            }
+        }
+
+        void Flush()
+        {
+            if (m_bitCount > 0)
+            {
+                m_output.push_back((uint8_t)(m_bitBuffer << (8 - m_bitCount)));
+                m_bitBuffer = 0;
+                m_bitCount = 0;
+            }
+        }
+
+    private:
+        void PutBit(const uint8_t bit)
+        {
+            m_bitBuffer = (uint8_t)((m_bitBuffer << 1) | bit);
+            if (++m_bitCount == 8)
+            {
+                m_output.push_back(m_bitBuffer);
+                m_bitBuffer = 0;
+                m_bitCount = 0;
+            }
+        }
+
+        void Reconstruct()
+        {
+            int16_t j = 0;
+            for (int16_t i = 0; i < lzhTableSize; i++)
+            {
+                if (m_child[i] >= lzhTableSize)
+                {
+                    m_freq[j] = (m_freq[i] + 1) / 2;
+                    m_child[j] = m_child[i];
+                    j++;
+                }
+            }
+
+            for (int16_t i = 0, j = lzhNumberOfChars; j < lzhTableSize; i += 2, j++)
+            {
+                const uint16_t f = m_freq[j] = m_freq[i] + m_freq[i + 1];
+                int16_t k = j - 1;
+                while (f < m_freq[k])
+                {
+                    k--;
+                }
+                k++;
+                const size_t length = (size_t)(j - k) * 2;
+                std::memmove(&m_freq[k + 1], &m_freq[k], length);
+                m_freq[k] = f;
+                std::memmove(&m_child[k + 1], &m_child[k], length);
+                m_child[k] = i;
+            }
+
+            for (int16_t i = 0; i < lzhTableSize; i++)
+            {
+                const int16_t k = m_child[i];
+                if (k >= lzhTableSize)
+                {
+                    m_parent[k] = i;
+                }
+                else
+                {
+                    m_parent[k] = m_parent[k + 1] = i;
+                }
+            }
+        }
+
+        void Update(const uint16_t leaf)
+        {
+            if (m_freq[lzhRootPosition] == 0x8000)
+            {
+                Reconstruct();
+            }
+
+            int16_t c = m_parent[leaf + lzhTableSize];
+            do
+            {
+                const uint16_t k = ++m_freq[c];
+                int16_t l = c + 1;
+                if (k > m_freq[l])
+                {
+                    while (k > m_freq[++l]);
+                    l--;
+                    m_freq[c] = m_freq[l];
+                    m_freq[l] = k;
+
+                    const int16_t i = m_child[c];
+                    m_parent[i] = l;
+                    if (i < lzhTableSize)
+                    {
+                        m_parent[i + 1] = l;
+                    }
+
+                    const int16_t j = m_child[l];
+                    m_child[l] = i;
+                    m_parent[j] = c;
+                    if (j < lzhTableSize)
+                    {
+                        m_parent[j + 1] = c;
+                    }
+                    m_child[c] = j;
+                    c = l;
+                }
+            } while ((c = m_parent[c]) != 0);
+        }
+
+        std::vector<uint8_t>& m_output;
+        uint8_t m_bitBuffer;
+        uint8_t m_bitCount;
+        int16_t m_child[lzhTableSize];
+        int16_t m_parent[lzhTableSize + lzhNumberOfChars];
+        uint16_t m_freq[lzhTableSize + 1];
+    };
+
+    void PushWord(std::vector<uint8_t>& data, const uint16_t word)
+    {
+        data.push_back((uint8_t)(word & 0xFF));
+        data.push_back((uint8_t)(word >> 8));
+    }
+}
+
+std::vector<uint8_t> BenchFixtures::CreateMusicTrack(const uint16_t numberOfEvents)
+{
+    const uint16_t length = numberOfEvents * 4;
+    std::vector<uint8_t> track;
+    track.reserve(length + 2);
+    track.push_back((uint8_t)(length & 0xFF));
+    track.push_back((uint8_t)(length >> 8));
+    for (uint16_t i = 0; i < numberOfEvents; i++)
+    {
+        // Note on/off on the nine melodic channels, with short delays in between
+        const uint8_t channel = (uint8_t)(i % 9);
+        track.push_back((uint8_t)(0xB0 + channel));
+        track.push_back((uint8_t)((i & 1) ? 0x00 : 0x2A));
+        track.push_back((uint8_t)((i % 3 == 0) ? 5 : 0));
+        track.push_back(0);
+    }
+    return track;
+}
+
+std::vector<uint8_t> BenchFixtures::CreatePlanarPicture(const uint16_t width, const uint16_t height, const uint8_t numberOfPlanes)
+{
+    const uint32_t planeSize = ((uint32_t)width * height) / 8;
+    const bool masked = (numberOfPlanes == 5);
+    const uint8_t firstColorPlane = masked ? 1 : 0;
+    std::vector<uint8_t> picture(planeSize * numberOfPlanes, 0);
+    uint32_t random = 1;
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            // Rows of bricks that are shifted by half a brick, with gray mortar in between
+            random = (random * 1103515245) + 12345;
+            const bool mortar = ((y % 8) == 7) || (((x + (((y / 8) % 2) * 8)) % 16) == 15);
+            const uint8_t brickColor = ((random >> 16) % 5 == 0) ? EgaBrown : EgaRed;
+            const uint8_t color = mortar ? EgaLightGray : brickColor;
+            const uint32_t pixelOffset = ((uint32_t)y * width) + x;
+            const uint8_t bitValue = (uint8_t)(0x80 >> (pixelOffset % 8));
+            if (masked && mortar)
+            {
+                picture[pixelOffset / 8] |= bitValue;
+            }
+            for (uint8_t plane = 0; plane < 4; plane++)
+            {
+                if (color & (1 << plane))
+                {
+                    picture[((firstColorPlane + plane) * planeSize) + (pixelOffset / 8)] |= bitValue;
+                }
+            }
+        }
+    }
+    return picture;
+}
+
+std::vector<uint16_t> BenchFixtures::CreateLevelWalls(const uint16_t width, const uint16_t height)
+{
+    std::vector<uint16_t> walls((uint32_t)width * height, 0);
+    for (uint16_t y = 0; y < height; y++)
+    {
+        for (uint16_t x = 0; x < width; x++)
+        {
+            const bool border = (x == 0) || (y == 0) || (x == width - 1) || (y == height - 1);
+            // Rooms of 16 by 16 tiles, connected by doorways in the middle of each wall
+            const bool roomWall = ((x % 16) == 0 && (y % 16) != 7 && (y % 16) != 8) ||
+                                  ((y % 16) == 0 && (x % 16) != 7 && (x % 16) != 8);
+            const bool pillar = ((x % 4) == 2) && ((y % 4) == 2) && (((x / 4) + (y / 4)) % 3 != 0);
+            if (border || roomWall || pillar)
+            {
+                // The solid walls of Catacomb 3-D
+                walls[((uint32_t)y * width) + x] = 1 + (((x / 16) + (y / 16) + (pillar ? 3 : 0)) % 7);
+            }
+        }
+    }
+    return walls;
+}
+
+std::vector<uint16_t> BenchFixtures::CreateLevelObjects(const std::vector<uint16_t>& walls, const uint16_t width, const uint16_t height)
+{
+    // Bolt, nuke, potion, chest, troll, orc, bat and demon
+    const uint16_t objectTypes[] = { 5, 6, 7, 21, 22, 23, 25, 26 };
+    const uint16_t numberOfObjectTypes = sizeof(objectTypes) / sizeof(objectTypes[0]);
+
+    std::vector<uint16_t> objects((uint32_t)width * height, 0);
+    uint16_t objectIndex = 0;
+    for (uint16_t y = 1; y < height - 1; y++)
+    {
+        for (uint16_t x = 1; x < width - 1; x++)
+        {
+            const uint32_t tileIndex = ((uint32_t)y * width) + x;
+            if (walls[tileIndex] == 0 && (((x * 7) + (y * 13)) % 23) == 0)
+            {
+                objects[tileIndex] = objectTypes[objectIndex % numberOfObjectTypes];
+                objectIndex++;
+            }
+        }
+    }
+
+    // Player start facing north, on the open tile nearest to the middle of the level
+    uint32_t playerTile = ((uint32_t)(height / 2) * width) + (width / 2);
+    while (walls[playerTile] != 0)
+    {
+        playerTile++;
+    }
+    objects[playerTile] = 1;
+
+    return objects;
+}
+
+std::vector<uint8_t> BenchFixtures::RlewCompress(const std::vector<uint16_t>& words, const uint16_t rlewTag)
+{
+    std::vector<uint8_t> compressed;
+    PushWord(compressed, (uint16_t)(words.size() * sizeof(uint16_t)));
+    size_t i = 0;
+    while (i < words.size())
+    {
+        const uint16_t value = words[i];
+        uint16_t count = 1;
+        while (i + count < words.size() && words[i + count] == value && count < 0xFFFF)
+        {
+            count++;
+        }
+
+        if (count > 3 || value == rlewTag)
+        {
+            PushWord(compressed, rlewTag);
+            PushWord(compressed, count);
+            PushWord(compressed, value);
+        }
+        else
+        {
+            for (uint16_t j = 0; j < count; j++)
+            {
+                PushWord(compressed, value);
+            }
+        }
+        i += count;
+    }
+    return compressed;
+}
+
+std::vector<uint8_t> BenchFixtures::CarmackCompress(const std::vector<uint8_t>& data)
+{
+    const uint8_t nearTag = 0xa7;
+    const uint8_t farTag = 0xa8;
+    const uint16_t maxCount = 255;
+    const size_t numberOfWords = data.size() / 2;
+    const uint16_t* words = (const uint16_t*)data.data();
+
+    std::vector<uint8_t> compressed;
+    PushWord(compressed, (uint16_t)data.size());
+    size_t i = 0;
+    while (i < numberOfWords)
+    {
+        // Find the longest earlier occurrence of the words that follow. A near pointer refers to at most 255 words
+        // back, a far pointer to any word from the start.
+        uint16_t nearCount = 0;
+        uint16_t nearOffset = 0;
+        uint16_t farCount = 0;
+        uint16_t farOffset = 0;
+        for (size_t start = 0; start < i; start++)
+        {
+            uint16_t count = 0;
+            while (i + count < numberOfWords && count < maxCount && words[start + count] == words[i + count])
+            {
+                count++;
+            }
+            if (i - start <= 255 && count >= nearCount)
+            {
+                nearCount = count;
+                nearOffset = (uint16_t)(i - start);
+            }
+            if (count > farCount)
+            {
+                farCount = count;
+                farOffset = (uint16_t)start;
+            }
+        }
+
+        if (nearCount >= 2 && nearCount >= farCount)
+        {
+            compressed.push_back((uint8_t)nearCount);
+            compressed.push_back(nearTag);
+            compressed.push_back((uint8_t)nearOffset);
+            i += nearCount;
+        }
+        else if (farCount >= 3)
+        {
+            compressed.push_back((uint8_t)farCount);
+            compressed.push_back(farTag);
+            PushWord(compressed, farOffset);
+            i += farCount;
+        }
+        else
+        {
+            const uint16_t word = words[i];
+            const uint8_t high = (uint8_t)(word >> 8);
+            if (high == nearTag || high == farTag)
+            {
+                // A count of zero tells the decoder that the low byte follows
+                compressed.push_back(0);
+                compressed.push_back(high);
+                compressed.push_back((uint8_t)(word & 0xFF));
+            }
+            else
+            {
+                PushWord(compressed, word);
+            }
+            i++;
+        }
+    }
+    return compressed;
+}
+
+std::vector<uint8_t> BenchFixtures::LzhCompress(const std::vector<uint8_t>& data)
+{
+    std::vector<uint8_t> compressed;
+    LzhEncoder encoder(compressed);
+
+    // Hash chains over the previous occurrences of each three byte sequence
+    const uint32_t hashSize = 0x10000;
+    std::vector<int32_t> head(hashSize, -1);
+    std::vector<int32_t> previous(data.size(), -1);
+    auto hash = [&data](const size_t pos) { return (uint32_t)((data[pos] << 8) ^ (data[pos + 1] << 4) ^ data[pos + 2]) & (hashSize - 1); };
+    auto insert = [&](const size_t pos)
+    {
+        if (pos + 2 < data.size())
+        {
+            const uint32_t h = hash(pos);
+            previous[pos] = head[h];
+            head[h] = (int32_t)pos;
+        }
+    };
+
+    size_t i = 0;
+    while (i < data.size())
+    {
+        uint16_t bestLength = 0;
+        size_t bestDistance = 0;
+        if (i + 2 < data.size())
+        {
+            int32_t candidate = head[hash(i)];
+            uint16_t tries = 0;
+            while (candidate >= 0 && i - candidate <= (size_t)(lzhRingBufferSize - lzhLookAheadSize) && tries < 256)
+            {
+                uint16_t length = 0;
+                while (length < lzhLookAheadSize && i + length < data.size() && data[candidate + length] == data[i + length])
+                {
+                    length++;
+                }
+                if (length > bestLength)
+                {
+                    bestLength = length;
+                    bestDistance = i - candidate;
+                    if (length == lzhLookAheadSize)
+                    {
+                        break;
+                    }
+                }
+                candidate = previous[candidate];
+                tries++;
+            }
+        }
+
+        if (bestLength > lzhThreshold)
+        {
+            encoder.EncodeChar(255 - lzhThreshold + bestLength);
+            encoder.EncodePosition((uint16_t)(bestDistance - 1));
+            for (uint16_t j = 0; j < bestLength; j++)
+            {
+                insert(i + j);
+            }
+            i += bestLength;
+        }
+        else
+        {
+            encoder.EncodeChar(data[i]);
+            insert(i);
+            i++;
+        }
+    }
+    encoder.Flush();
+
+    return compressed;
+}
@@ -0,0 +1,48 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// BenchFixtures
+//
+// Synthetic data for the benchmarks, so that they can run without any game data present.
+//
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+namespace BenchFixtures
+{
+    // Adlib music track as stored in the audio repository: a length word followed by register writes with delays.
+    std::vector<uint8_t> CreateMusicTrack(const uint16_t numberOfEvents);
+
+    // Picture in the planar EGA format of the EGAGRAPH file, showing a brick wall with some noise.
+    // With five planes, the first plane is the transparency mask.
+    std::vector<uint8_t> CreatePlanarPicture(const uint16_t width, const uint16_t height, const uint8_t numberOfPlanes);
+
+    // Plane 0 of a level: a border of solid walls with rooms and pillars inside.
+    std::vector<uint16_t> CreateLevelWalls(const uint16_t width, const uint16_t height);
+
+    // Plane 2 of a Catacomb 3-D level: the player start in the middle, with monsters and bonus items on the open tiles.
+    std::vector<uint16_t> CreateLevelObjects(const std::vector<uint16_t>& walls, const uint16_t width, const uint16_t height);
+
+    // The compression of the GAMEMAPS planes: RLEW first, then Carmack on the result. Both start with the decompressed
+    // size in bytes.
+    std::vector<uint8_t> RlewCompress(const std::vector<uint16_t>& words, const uint16_t rlewTag);
+    std::vector<uint8_t> CarmackCompress(const std::vector<uint8_t>& data);
+
+    // LZH compression as done by LZHUF.C, for the CMP1 files of the Catacomb Adventure Series.
+    std::vector<uint8_t> LzhCompress(const std::vector<uint8_t>& data);
+}
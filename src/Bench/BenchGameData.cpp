@@ -0,0 +1,467 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "BenchGameData.h"
+#include "BenchFixtures.h"
+#include "../Engine/GameDetection.h"
+#include "../Test/HuffmanFixture.h"
+#include "../Test/RendererStub.h"
+#include "../Test/SavedGameInDosFormat_Data.h"
+#include "../Abyss/GameAbyss.h"
+#include "../Abyss/GameDetectionAbyss.h"
+#include "../Armageddon/GameArmageddon.h"
+#include "../Armageddon/GameDetectionArmageddon.h"
+#include "../Apocalypse/GameApocalypse.h"
+#include "../Apocalypse/GameDetectionApocalypse.h"
+#include "../Catacomb3D/GameCatacomb3D.h"
+#include "../Catacomb3D/GameDetectionCatacomb3D.h"
+#include "../Catacomb3D/EgaGraphCatacomb3D.h"
+#include "../Catacomb3D/GameMapsCatacomb3D.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+// Same game IDs as returned by IGame::GetId(); zero means synthetic data.
+static const uint8_t syntheticGameId = 0;
+static const uint8_t abyssv113GameId = 1;
+static const uint8_t abyssv124GameId = 2;
+static const uint8_t armageddonGameId = 3;
+static const uint8_t apocalypseGameId = 4;
+static const uint8_t catacomb3DGameId = 5;
+
+static const uint16_t syntheticMapWidth = 64;
+static const uint16_t syntheticMapHeight = 64;
+static const uint16_t rlewTag = 0xABCD;
+
+static BenchGameData* m_instance = nullptr;
+
+static std::vector<uint8_t> ReadFile(const fs::path& fullPath)
+{
+    std::vector<uint8_t> data;
+    std::ifstream file(fullPath, std::ifstream::binary);
+    if (file.is_open())
+    {
+        file.seekg(0, std::ios::end);
+        data.resize((size_t)file.tellg());
+        file.seekg(0, std::ios::beg);
+        file.read((char*)data.data(), data.size());
+    }
+    return data;
+}
+
+static void WriteFile(const fs::path& fullPath, const std::vector<uint8_t>& data)
+{
+    std::ofstream file(fullPath, std::ofstream::binary | std::ofstream::trunc);
+    file.write((const char*)data.data(), data.size());
+}
+
+static void PushWord(std::vector<uint8_t>& data, const uint32_t value, const uint8_t numberOfBytes)
+{
+    for (uint8_t i = 0; i < numberOfBytes; i++)
+    {
+        data.push_back((uint8_t)(value >> (i * 8)));
+    }
+}
+
+static fs::path GetTemporaryPath()
+{
+    const fs::path path = fs::temp_directory_path() / "CatacombGL_Bench";
+    fs::create_directories(path);
+    return path;
+}
+
+BenchGameData& BenchGameData::Instance()
+{
+    if (m_instance == nullptr)
+    {
+        m_instance = new BenchGameData();
+    }
+
+    return *m_instance;
+}
+
+BenchGameData::BenchGameData() :
+    m_gamePath(),
+    m_gameId(syntheticGameId),
+    m_description("Synthetic"),
+    m_loaded(false),
+    m_renderer(std::make_unique<RendererStub>()),
+    m_game(),
+    m_gameMaps(nullptr),
+    m_egaGraph(nullptr),
+    m_rawGameMaps(),
+    m_rawEgaGraph(),
+    m_lzhLoaded(false),
+    m_lzhCompressedData(),
+    m_lzhOriginalLength(0),
+    m_lzhSource(),
+    m_dosSavedGamesLoaded(false),
+    m_dosSavedGames(),
+    m_dosSavedGamesSource()
+{
+
+}
+
+BenchGameData::~BenchGameData()
+{
+
+}
+
+bool BenchGameData::SetGamePath(const fs::path& gamePath)
+{
+    const std::pair<uint8_t, const std::map<std::string, uint32_t>&> candidates[] =
+    {
+        { catacomb3DGameId, catacomb3DFiles },
+        { abyssv124GameId, abyssFilesv124 },
+        { abyssv113GameId, abyssFilesv113 },
+        { armageddonGameId, armageddonFiles },
+        { apocalypseGameId, apocalypseFiles }
+    };
+
+    GameDetection detection;
+    for (const auto& candidate : candidates)
+    {
+        if (detection.GetDetectionReport(candidate.first, gamePath, candidate.second).score == 0)
+        {
+            m_gameId = candidate.first;
+            m_gamePath = gamePath;
+            m_description = GetGame().GetName() + " at " + gamePath.string();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+const std::string& BenchGameData::GetDescription() const
+{
+    return m_description;
+}
+
+IGame& BenchGameData::GetGame()
+{
+    if (m_game == nullptr)
+    {
+        switch (m_gameId)
+        {
+        case abyssv113GameId:
+        case abyssv124GameId:
+            m_game = std::make_unique<GameAbyss>(m_gameId, m_gamePath, *m_renderer);
+            break;
+        case armageddonGameId:
+            m_game = std::make_unique<GameArmageddon>(m_gamePath, *m_renderer);
+            break;
+        case apocalypseGameId:
+            m_game = std::make_unique<GameApocalypse>(m_gamePath, *m_renderer);
+            break;
+        default:
+            // The synthetic levels are populated with the actors of Catacomb 3-D
+            m_game = std::make_unique<GameCatacomb3D>(m_gameId == syntheticGameId ? GetTemporaryPath() : m_gamePath, GetTemporaryPath(), *m_renderer);
+            break;
+        }
+    }
+
+    return *m_game;
+}
+
+GameMaps& BenchGameData::GetGameMaps()
+{
+    Load();
+    return *m_gameMaps;
+}
+
+EgaGraph& BenchGameData::GetEgaGraph()
+{
+    Load();
+    return *m_egaGraph;
+}
+
+const std::vector<uint8_t>& BenchGameData::GetRawGameMaps()
+{
+    Load();
+    return m_rawGameMaps;
+}
+
+const std::vector<uint8_t>& BenchGameData::GetRawEgaGraph()
+{
+    Load();
+    return m_rawEgaGraph;
+}
+
+Level* BenchGameData::CreateLevel()
+{
+    Level* level = GetGameMaps().GetLevelFromStart(0);
+    GetGame().SpawnActors(level, Normal);
+    return level;
+}
+
+const std::vector<uint8_t>& BenchGameData::GetLzhCompressedData(uint32_t& originalLength, std::string& source)
+{
+    if (!m_lzhLoaded)
+    {
+        LoadLzhCompressedData();
+        m_lzhLoaded = true;
+    }
+    originalLength = m_lzhOriginalLength;
+    source = m_lzhSource;
+    return m_lzhCompressedData;
+}
+
+const std::vector<std::vector<uint8_t>>& BenchGameData::GetDosSavedGames(std::string& source)
+{
+    if (!m_dosSavedGamesLoaded)
+    {
+        LoadDosSavedGames();
+        m_dosSavedGamesLoaded = true;
+    }
+    source = m_dosSavedGamesSource;
+    return m_dosSavedGames;
+}
+
+void BenchGameData::Load()
+{
+    if (m_loaded)
+    {
+        return;
+    }
+    m_loaded = true;
+
+    if (m_gameId == syntheticGameId)
+    {
+        m_gamePath = GetTemporaryPath();
+        WriteSyntheticGameData();
+        m_syntheticGameMaps = std::make_unique<GameMaps>(*m_syntheticGameMapsStaticData, m_gamePath);
+        m_syntheticEgaGraph = std::make_unique<EgaGraph>(*m_syntheticEgaGraphStaticData, m_gamePath, *m_renderer);
+        m_gameMaps = m_syntheticGameMaps.get();
+        m_egaGraph = m_syntheticEgaGraph.get();
+    }
+    else
+    {
+        m_gameMaps = GetGame().GetGameMaps();
+        m_egaGraph = GetGame().GetEgaGraph();
+    }
+
+    m_rawGameMaps = ReadFile(m_gamePath / m_gameMaps->GetStaticData().filename);
+    m_rawEgaGraph = ReadFile(m_gamePath / m_egaGraph->GetStaticData().filename);
+}
+
+void BenchGameData::WriteSyntheticGameData()
+{
+    // A single level of 64 by 64 tiles, compressed the same way as in the original GAMEMAPS files
+    const std::vector<uint16_t> walls = BenchFixtures::CreateLevelWalls(syntheticMapWidth, syntheticMapHeight);
+    const std::vector<uint16_t> objects = BenchFixtures::CreateLevelObjects(walls, syntheticMapWidth, syntheticMapHeight);
+    const std::vector<uint8_t> plane0 = BenchFixtures::CarmackCompress(BenchFixtures::RlewCompress(walls, rlewTag));
+    const std::vector<uint8_t> plane2 = BenchFixtures::CarmackCompress(BenchFixtures::RlewCompress(objects, rlewTag));
+    const uint32_t headerSize = 38;
+    std::vector<uint8_t> gameMaps;
+    PushWord(gameMaps, headerSize, 4);
+    PushWord(gameMaps, 0, 4);
+    PushWord(gameMaps, headerSize + (uint32_t)plane0.size(), 4);
+    PushWord(gameMaps, (uint32_t)plane0.size(), 2);
+    PushWord(gameMaps, 0, 2);
+    PushWord(gameMaps, (uint32_t)plane2.size(), 2);
+    PushWord(gameMaps, syntheticMapWidth, 2);
+    PushWord(gameMaps, syntheticMapHeight, 2);
+    gameMaps.resize(headerSize, 0);
+    gameMaps.insert(gameMaps.end(), plane0.begin(), plane0.end());
+    gameMaps.insert(gameMaps.end(), plane2.begin(), plane2.end());
+    WriteFile(m_gamePath / "GAMEMAPS.BNC", gameMaps);
+
+    m_syntheticGameMapsStaticData = std::make_unique<gameMapsStaticData>(gameMapsStaticData{
+        "GAMEMAPS.BNC",
+        { 0, (int32_t)gameMaps.size() },
+        { gameMapsInfoCatacomb3D.at(0) },
+        wallsInfoCatacomb3D,
+        gameMapsCatacomb3D.tileWallExplosion,
+        gameMapsCatacomb3D.tileWaterExplosion });
+
+    // EGAGRAPH with the same chunks as the one of Catacomb 3-D, so that the walls and actors refer to existing
+    // pictures. All pictures are 64 by 64 pixels and the Huffman table is balanced, which stores each byte in 8 bits.
+    HuffmanFixture::CreateBalancedHuffmanTable(m_syntheticHuffmanTable);
+    const egaGraphStaticData& layout = egaGraphCatacomb3D;
+    const uint16_t numberOfChunks = (uint16_t)(egaGraphOffsetsCatacomb3D.size() - 1);
+    std::vector<uint8_t> egaGraph;
+    m_syntheticEgaGraphOffsets.clear();
+    auto addChunk = [&](const std::vector<uint8_t>& data, const bool storeSize)
+    {
+        m_syntheticEgaGraphOffsets.push_back((int32_t)egaGraph.size());
+        if (storeSize)
+        {
+            PushWord(egaGraph, (uint32_t)data.size(), 4);
+        }
+        const std::vector<uint8_t> compressed = HuffmanFixture::Compress(data);
+        egaGraph.insert(egaGraph.end(), compressed.begin(), compressed.end());
+    };
+    auto createPictureTable = [](const uint16_t count, const uint16_t width, const uint16_t height, const uint16_t entrySize)
+    {
+        std::vector<uint8_t> table;
+        for (uint16_t i = 0; i < count; i++)
+        {
+            PushWord(table, width / 8, 2);
+            PushWord(table, height, 2);
+            table.resize(table.size() + entrySize - 4, 0);
+        }
+        return table;
+    };
+
+    const std::vector<uint8_t> picture = BenchFixtures::CreatePlanarPicture(64, 64, 4);
+    const std::vector<uint8_t> maskedPicture = BenchFixtures::CreatePlanarPicture(64, 64, 5);
+    const std::vector<uint8_t> sprite = BenchFixtures::CreatePlanarPicture(16, 16, 5);
+    for (uint16_t index = 0; index < numberOfChunks; index++)
+    {
+        if (index == 0)
+        {
+            addChunk(createPictureTable(layout.indexOfFirstMaskedPicture - layout.indexOfFirstPicture, 64, 64, 4), true);
+        }
+        else if (index == 1)
+        {
+            addChunk(createPictureTable(layout.indexOfFirstSprite - layout.indexOfFirstMaskedPicture, 64, 64, 4), true);
+        }
+        else if (index == 2)
+        {
+            addChunk(createPictureTable(layout.indexOfTileSize8 - layout.indexOfFirstSprite, 16, 16, 16), true);
+        }
+        else if (index >= layout.indexOfFirstPicture && index < layout.indexOfFirstMaskedPicture)
+        {
+            addChunk(picture, true);
+        }
+        else if (index >= layout.indexOfFirstMaskedPicture && index < layout.indexOfFirstSprite)
+        {
+            addChunk(maskedPicture, true);
+        }
+        else if (index >= layout.indexOfFirstSprite && index < layout.indexOfTileSize8)
+        {
+            addChunk(sprite, true);
+        }
+        else if (index == layout.indexOfTileSize8)
+        {
+            addChunk(BenchFixtures::CreatePlanarPicture(8, 8 * 104, 4), false);
+        }
+        else if (index == layout.indexOfTileSize8Masked)
+        {
+            addChunk(BenchFixtures::CreatePlanarPicture(8, 8 * 12, 5), false);
+        }
+        else if (index >= layout.indexOfFirstTileSize16 && index <= layout.indexOfLastTileSize16)
+        {
+            addChunk(BenchFixtures::CreatePlanarPicture(16, 16, 4), false);
+        }
+        else if (index >= layout.indexOfFirstTileSize16Masked && index <= layout.indexOfLastTileSize16Masked)
+        {
+            addChunk(BenchFixtures::CreatePlanarPicture(16, 16, 5), false);
+        }
+        else
+        {
+            // Fonts and texts are not used by the benchmarks
+            addChunk({}, true);
+        }
+    }
+    m_syntheticEgaGraphOffsets.push_back((int32_t)egaGraph.size());
+    WriteFile(m_gamePath / "EGAGRAPH.BNC", egaGraph);
+
+    m_syntheticEgaGraphStaticData = std::make_unique<egaGraphStaticData>(egaGraphStaticData{
+        "EGAGRAPH.BNC",
+        m_syntheticEgaGraphOffsets,
+        m_syntheticHuffmanTable,
+        layout.indexOfFirstPicture,
+        layout.indexOfFirstScaledPicture,
+        layout.indexOfFirstWallPicture,
+        layout.indexOfFirstMaskedPicture,
+        layout.indexOfFirstSprite,
+        layout.indexOfTileSize8,
+        layout.indexOfTileSize8Masked,
+        layout.indexOfFirstTileSize16,
+        layout.indexOfLastTileSize16,
+        layout.indexOfFirstTileSize16Masked,
+        layout.indexOfLastTileSize16Masked,
+        layout.indexOfFirstWorldLocationNames,
+        layout.indexOfLastWorldLocationNames,
+        layout.indexOfHandPicture });
+}
+
+void BenchGameData::LoadLzhCompressedData()
+{
+    // The intro screens of the Catacomb Adventure Series are stored in CMP1 files
+    if (m_gameId != syntheticGameId)
+    {
+        for (const auto& entry : fs::directory_iterator(m_gamePath))
+        {
+            const std::vector<uint8_t> data = entry.is_regular_file() ? ReadFile(entry.path()) : std::vector<uint8_t>();
+            const uint32_t headerSize = 14;
+            if (data.size() < headerSize || std::memcmp(data.data(), "CMP1", 4) != 0 || *(uint16_t*)&data[4] != 2)
+            {
+                continue;
+            }
+            const uint32_t originalLength = *(uint32_t*)&data[6];
+            const uint32_t compressedLength = std::min(*(uint32_t*)&data[10], (uint32_t)data.size() - headerSize);
+            if (compressedLength > m_lzhCompressedData.size())
+            {
+                m_lzhCompressedData.assign(data.begin() + headerSize, data.begin() + headerSize + compressedLength);
+                m_lzhOriginalLength = originalLength;
+                m_lzhSource = entry.path().filename().string();
+            }
+        }
+    }
+
+    if (m_lzhCompressedData.empty())
+    {
+        const std::vector<uint8_t> screen = BenchFixtures::CreatePlanarPicture(320, 200, 4);
+        m_lzhCompressedData = BenchFixtures::LzhCompress(screen);
+        m_lzhOriginalLength = (uint32_t)screen.size();
+        m_lzhSource = "Synthetic";
+    }
+}
+
+void BenchGameData::LoadDosSavedGames()
+{
+    if (m_gameId != syntheticGameId)
+    {
+        for (const auto& entry : fs::directory_iterator(m_gamePath))
+        {
+            std::string filename = entry.path().filename().string();
+            std::transform(filename.begin(), filename.end(), filename.begin(), ::toupper);
+            const bool isSavedGame = (m_gameId == catacomb3DGameId) ?
+                (filename.size() == 12 && filename.rfind("SAVEGAM", 0) == 0 && filename.substr(8) == ".C3D") :
+                (filename.size() > 4 && filename.substr(filename.size() - 4) == ".SAV");
+            if (entry.is_regular_file() && isSavedGame)
+            {
+                m_dosSavedGames.push_back(ReadFile(entry.path()));
+                m_dosSavedGamesSource += (m_dosSavedGamesSource.empty() ? "" : ", ") + entry.path().filename().string();
+            }
+        }
+    }
+
+    if (m_dosSavedGames.empty())
+    {
+        switch (m_gameId)
+        {
+        case abyssv113GameId:
+        case abyssv124GameId:
+            m_dosSavedGames.emplace_back(std::begin(rawSavedGameDataCatacombAbyss), std::end(rawSavedGameDataCatacombAbyss));
+            break;
+        case armageddonGameId:
+            m_dosSavedGames.emplace_back(std::begin(rawSavedGameDataCatacombArmageddon), std::end(rawSavedGameDataCatacombArmageddon));
+            break;
+        case apocalypseGameId:
+            m_dosSavedGames.emplace_back(std::begin(rawSavedGameDataCatacombApocalypse), std::end(rawSavedGameDataCatacombApocalypse));
+            break;
+        default:
+            m_dosSavedGames.emplace_back(std::begin(rawSavedGameDataCatacomb3D), std::end(rawSavedGameDataCatacomb3D));
+            break;
+        }
+        m_dosSavedGamesSource = "Unit test data";
+    }
+}
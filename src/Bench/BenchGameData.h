@@ -0,0 +1,94 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// BenchGameData
+//
+// Game data for the benchmarks. When a game path is given, the game that is detected in that path is loaded.
+// Otherwise synthetic GAMEMAPS and EGAGRAPH files are written to a temporary folder and loaded along with the
+// walls and actors of Catacomb 3-D, so that the same benchmarks can run without any game data present.
+//
+#pragma once
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Engine/EgaGraph.h"
+#include "../Engine/GameMaps.h"
+#include "../Engine/IGame.h"
+
+class BenchGameData
+{
+public:
+    static BenchGameData& Instance();
+
+    // Returns false if no supported game is found at the given path.
+    bool SetGamePath(const std::filesystem::path& gamePath);
+    const std::string& GetDescription() const;
+
+    IGame& GetGame();
+    GameMaps& GetGameMaps();
+    EgaGraph& GetEgaGraph();
+    const std::vector<uint8_t>& GetRawGameMaps();
+    const std::vector<uint8_t>& GetRawEgaGraph();
+
+    // First level of the game, with its actors spawned. The caller owns the level.
+    Level* CreateLevel();
+
+    // The CMP1 file with the most LZH compressed data in the game path, or synthetic data if there is none.
+    const std::vector<uint8_t>& GetLzhCompressedData(uint32_t& originalLength, std::string& source);
+
+    // Saved games in DOS format from the game path, or the saved game of the unit tests if there are none.
+    const std::vector<std::vector<uint8_t>>& GetDosSavedGames(std::string& source);
+
+private:
+    BenchGameData();
+    ~BenchGameData();
+
+    void Load();
+    void WriteSyntheticGameData();
+    void LoadLzhCompressedData();
+    void LoadDosSavedGames();
+
+    std::filesystem::path m_gamePath;
+    uint8_t m_gameId;
+    std::string m_description;
+    bool m_loaded;
+
+    std::unique_ptr<IRenderer> m_renderer;
+    std::unique_ptr<IGame> m_game;
+    GameMaps* m_gameMaps;
+    EgaGraph* m_egaGraph;
+    std::vector<uint8_t> m_rawGameMaps;
+    std::vector<uint8_t> m_rawEgaGraph;
+
+    // Only used with synthetic data
+    std::unique_ptr<gameMapsStaticData> m_syntheticGameMapsStaticData;
+    std::vector<int32_t> m_syntheticEgaGraphOffsets;
+    huffmanTable m_syntheticHuffmanTable;
+    std::unique_ptr<egaGraphStaticData> m_syntheticEgaGraphStaticData;
+    std::unique_ptr<GameMaps> m_syntheticGameMaps;
+    std::unique_ptr<EgaGraph> m_syntheticEgaGraph;
+
+    bool m_lzhLoaded;
+    std::vector<uint8_t> m_lzhCompressedData;
+    uint32_t m_lzhOriginalLength;
+    std::string m_lzhSource;
+
+    bool m_dosSavedGamesLoaded;
+    std::vector<std::vector<uint8_t>> m_dosSavedGames;
+    std::string m_dosSavedGamesSource;
+};
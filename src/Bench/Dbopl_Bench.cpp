@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "../../ThirdParty/opl/dbopl.h"
+
+typedef void (*GenerateBlock)(Chip* self, Bitu total, Bit32s* output);
+
+static const Bit32u sampleRate = 49716;
+static const uint32_t musicTicksPerSecond = 560;
+
+// Plays a synthetic music track on all nine melodic channels, as the emulated chip does while music is playing.
+static void Dbopl_GenerateMusic(benchmark::State& state, GenerateBlock generateBlock)
+{
+    DBOPL_InitTables();
+    Chip chip;
+    Chip__Chip(&chip);
+    Chip__Setup(&chip, sampleRate);
+    Chip__WriteReg(&chip, 0x01, 0x20);
+
+    // A plucked FM instrument with feedback on every channel
+    for (uint8_t channel = 0; channel < 9; channel++)
+    {
+        const uint8_t modulator = (channel % 3) + (channel / 3) * 8;
+        const uint8_t carrier = modulator + 3;
+        Chip__WriteReg(&chip, 0x20 + modulator, 0x01);
+        Chip__WriteReg(&chip, 0x40 + modulator, 0x10);
+        Chip__WriteReg(&chip, 0x60 + modulator, 0xF2);
+        Chip__WriteReg(&chip, 0x80 + modulator, 0x74);
+        Chip__WriteReg(&chip, 0x20 + carrier, 0x21);
+        Chip__WriteReg(&chip, 0x40 + carrier, 0x00);
+        Chip__WriteReg(&chip, 0x60 + carrier, 0xF4);
+        Chip__WriteReg(&chip, 0x80 + carrier, 0x56);
+        Chip__WriteReg(&chip, 0xE0 + carrier, 0x01);
+        Chip__WriteReg(&chip, 0xA0 + channel, (uint8_t)(0x40 + channel * 16));
+        Chip__WriteReg(&chip, 0xC0 + channel, 0x06);
+    }
+
+    const uint16_t numberOfEvents = 2000;
+    const std::vector<uint8_t> track = BenchFixtures::CreateMusicTrack(numberOfEvents);
+    const uint32_t samplesPerTick = sampleRate / musicTicksPerSecond;
+    Bit32s buffer[1024];
+    int64_t samples = 0;
+
+    for (auto _ : state)
+    {
+        for (uint16_t i = 0; i < numberOfEvents; i++)
+        {
+            const uint8_t* event = &track[2 + i * 4];
+            Chip__WriteReg(&chip, event[0], event[1]);
+            const uint32_t length = (1 + event[2]) * samplesPerTick;
+            generateBlock(&chip, length, buffer);
+            benchmark::DoNotOptimize(buffer[0]);
+            samples += length;
+        }
+    }
+    state.SetItemsProcessed(samples);
+}
+BENCHMARK_CAPTURE(Dbopl_GenerateMusic, SampleBySample, Chip__GenerateBlock2);
+BENCHMARK_CAPTURE(Dbopl_GenerateMusic, Vectorized, Chip__GenerateBlock2Vectorized);
@@ -0,0 +1,109 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include "../Engine/Decompressor.h"
+
+static const uint16_t rlewTag = 0xABCD;
+
+// Plane 0 of the first level, as stored in the GAMEMAPS file.
+static const uint8_t* GetCompressedPlane0(uint32_t& decompressedSize)
+{
+    const std::vector<uint8_t>& rawGameMaps = BenchGameData::Instance().GetRawGameMaps();
+    const uint32_t headerOffset = BenchGameData::Instance().GetGameMaps().GetStaticData().offsets.at(0);
+    const uint32_t plane0Offset = *(uint32_t*)&rawGameMaps[headerOffset];
+    const uint16_t mapWidth = *(uint16_t*)&rawGameMaps[headerOffset + 18];
+    const uint16_t mapHeight = *(uint16_t*)&rawGameMaps[headerOffset + 20];
+    decompressedSize = mapWidth * mapHeight * sizeof(uint16_t);
+    return &rawGameMaps[plane0Offset];
+}
+
+// Carmack expansion of a map plane, the first step of loading a level.
+static void Decompressor_CarmackExpand(benchmark::State& state)
+{
+    uint32_t decompressedSize = 0;
+    const uint8_t* plane0 = GetCompressedPlane0(decompressedSize);
+
+    for (auto _ : state)
+    {
+        FileChunk* chunk = Decompressor::CarmackExpand(plane0);
+        benchmark::DoNotOptimize(chunk->GetChunk());
+        delete chunk;
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)decompressedSize);
+    state.SetLabel(BenchGameData::Instance().GetGameMaps().GetStaticData().filename);
+}
+BENCHMARK(Decompressor_CarmackExpand);
+
+// RLEW decompression of a Carmack expanded map plane, the second step of loading a level.
+static void Decompressor_RLEW(benchmark::State& state)
+{
+    uint32_t decompressedSize = 0;
+    const uint8_t* plane0 = GetCompressedPlane0(decompressedSize);
+    FileChunk* carmackExpandedChunk = Decompressor::CarmackExpand(plane0);
+
+    for (auto _ : state)
+    {
+        FileChunk* chunk = Decompressor::RLEW_Decompress(carmackExpandedChunk->GetChunk(), rlewTag);
+        benchmark::DoNotOptimize(chunk->GetChunk());
+        delete chunk;
+    }
+    delete carmackExpandedChunk;
+    state.SetBytesProcessed(state.iterations() * (int64_t)decompressedSize);
+    state.SetLabel(BenchGameData::Instance().GetGameMaps().GetStaticData().filename);
+}
+BENCHMARK(Decompressor_RLEW);
+
+// Both steps of loading a map plane in a single pass, straight into the plane storage.
+static void Decompressor_CarmackRLEWExpand(benchmark::State& state)
+{
+    uint32_t decompressedSize = 0;
+    const uint8_t* plane0 = GetCompressedPlane0(decompressedSize);
+    const std::vector<uint8_t>& rawGameMaps = BenchGameData::Instance().GetRawGameMaps();
+    const uint32_t compressedSize = (uint32_t)(rawGameMaps.data() + rawGameMaps.size() - plane0);
+    std::vector<uint16_t> history;
+    std::vector<uint16_t> plane(decompressedSize / sizeof(uint16_t));
+
+    for (auto _ : state)
+    {
+        const bool expanded = Decompressor::CarmackRLEWExpand(plane0, compressedSize, rlewTag, history, plane.data(), (uint32_t)plane.size());
+        benchmark::DoNotOptimize(expanded);
+        benchmark::DoNotOptimize(plane.data());
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)decompressedSize);
+    state.SetLabel(BenchGameData::Instance().GetGameMaps().GetStaticData().filename);
+}
+BENCHMARK(Decompressor_CarmackRLEWExpand);
+
+// LZH decompression of a full screen picture, as shown in the intro of the Catacomb Adventure Series.
+static void Decompressor_LZH(benchmark::State& state)
+{
+    uint32_t originalLength = 0;
+    std::string source;
+    std::vector<uint8_t> compressed = BenchGameData::Instance().GetLzhCompressedData(originalLength, source);
+    std::vector<uint8_t> decompressed(originalLength);
+
+    for (auto _ : state)
+    {
+        Decompressor::lzhDecompress(compressed.data(), decompressed.data(), originalLength, (uint32_t)compressed.size());
+        benchmark::DoNotOptimize(decompressed.data());
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)originalLength);
+    state.SetLabel(source);
+}
+BENCHMARK(Decompressor_LZH);
+// The same on several threads at once, as the intro shapes are decoded; the throughput should scale with the threads.
+BENCHMARK(Decompressor_LZH)->Threads(4)->UseRealTime();
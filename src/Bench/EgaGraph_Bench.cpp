@@ -0,0 +1,118 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include "../Engine/Picture.h"
+#include "../Engine/PictureTable.h"
+#include <algorithm>
+
+// The wall pictures of the EGAGRAPH file, still Huffman compressed.
+struct CompressedPicture
+{
+    const uint8_t* data;
+    uint32_t compressedSize;
+    uint32_t uncompressedSize;
+    uint16_t width;
+    uint16_t height;
+};
+
+static std::vector<CompressedPicture> GetCompressedWallPictures()
+{
+    BenchGameData& gameData = BenchGameData::Instance();
+    const egaGraphStaticData& staticData = gameData.GetEgaGraph().GetStaticData();
+    const std::vector<uint8_t>& rawEgaGraph = gameData.GetRawEgaGraph();
+    Huffman huffman(staticData.table);
+
+    const uint8_t* compressedTable = &rawEgaGraph[staticData.offsets.at(0)];
+    const uint32_t compressedTableSize = staticData.offsets.at(1) - staticData.offsets.at(0) - sizeof(uint32_t);
+    FileChunk* tableChunk = huffman.Decompress((uint8_t*)&compressedTable[sizeof(uint32_t)], compressedTableSize, *(uint32_t*)compressedTable);
+    PictureTable pictureTable(tableChunk);
+    delete tableChunk;
+
+    std::vector<CompressedPicture> pictures;
+    for (uint16_t index = staticData.indexOfFirstWallPicture; index < staticData.indexOfFirstMaskedPicture; index++)
+    {
+        const uint32_t chunkSize = staticData.offsets.at(index + 1) - staticData.offsets.at(index);
+        if (chunkSize <= sizeof(uint32_t))
+        {
+            continue;
+        }
+        const uint8_t* chunk = &rawEgaGraph[staticData.offsets.at(index)];
+        const uint16_t pictureIndex = index - staticData.indexOfFirstPicture;
+        pictures.push_back({ &chunk[sizeof(uint32_t)], chunkSize - (uint32_t)sizeof(uint32_t), *(uint32_t*)chunk,
+            pictureTable.GetWidth(pictureIndex), pictureTable.GetHeight(pictureIndex) });
+    }
+    return pictures;
+}
+
+// Huffman decompression of all wall pictures.
+static void EgaGraph_HuffmanDecompressWalls(benchmark::State& state)
+{
+    const std::vector<CompressedPicture> pictures = GetCompressedWallPictures();
+    Huffman huffman(BenchGameData::Instance().GetEgaGraph().GetStaticData().table);
+    int64_t bytesPerIteration = 0;
+    for (const CompressedPicture& picture : pictures)
+    {
+        bytesPerIteration += picture.uncompressedSize;
+    }
+
+    for (auto _ : state)
+    {
+        for (const CompressedPicture& picture : pictures)
+        {
+            FileChunk* chunk = huffman.Decompress((uint8_t*)picture.data, picture.compressedSize, picture.uncompressedSize);
+            benchmark::DoNotOptimize(chunk->GetChunk());
+            delete chunk;
+        }
+    }
+    state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(EgaGraph_HuffmanDecompressWalls);
+
+// Conversion of all decompressed wall pictures from planar EGA to palettized textures.
+static void EgaGraph_ConvertWallsToIndices(benchmark::State& state)
+{
+    const std::vector<CompressedPicture> pictures = GetCompressedWallPictures();
+    Huffman huffman(BenchGameData::Instance().GetEgaGraph().GetStaticData().table);
+    std::vector<FileChunk*> chunks;
+    uint32_t maxTextureSize = 0;
+    for (const CompressedPicture& picture : pictures)
+    {
+        chunks.push_back(huffman.Decompress((uint8_t*)picture.data, picture.compressedSize, picture.uncompressedSize));
+        const uint32_t textureSize = Picture::GetNearestPowerOfTwo(picture.width) * Picture::GetNearestPowerOfTwo(picture.height);
+        maxTextureSize = std::max(maxTextureSize, textureSize);
+    }
+    std::vector<uint8_t> textureImage(maxTextureSize);
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < pictures.size(); i++)
+        {
+            const CompressedPicture& picture = pictures.at(i);
+            EgaGraph::ConvertPictureToIndices(chunks.at(i), picture.width, picture.height,
+                Picture::GetNearestPowerOfTwo(picture.width), Picture::GetNearestPowerOfTwo(picture.height), false, textureImage.data());
+            benchmark::DoNotOptimize(textureImage.data());
+        }
+    }
+    for (FileChunk* chunk : chunks)
+    {
+        delete chunk;
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t)pictures.size());
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(EgaGraph_ConvertWallsToIndices);
@@ -0,0 +1,186 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include "../Engine/Level.h"
+#include "../Engine/MemoryStreamBuffer.h"
+#include "../Engine/Renderable3DScene.h"
+#include "../Engine/SavedGameChunks.h"
+#include <istream>
+#include <ostream>
+
+static const float angles[] = { 0.0f, 45.0f, 90.0f, 135.0f, 180.0f, 225.0f, 270.0f, 315.0f };
+
+// Loading the first level from the GAMEMAPS file, including the decompression of its planes.
+static void Level_LoadFromGameMaps(benchmark::State& state)
+{
+    GameMaps& gameMaps = BenchGameData::Instance().GetGameMaps();
+
+    for (auto _ : state)
+    {
+        Level* level = gameMaps.GetLevelFromStart(0);
+        benchmark::DoNotOptimize(level);
+        delete level;
+    }
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(Level_LoadFromGameMaps);
+
+// Ray casting of the visibility map from the player start, looking in eight directions.
+static void Level_UpdateVisibilityMap(benchmark::State& state)
+{
+    Level* level = BenchGameData::Instance().CreateLevel();
+    Actor* player = level->GetPlayerActor();
+    uint32_t frame = 0;
+
+    for (auto _ : state)
+    {
+        player->SetAngle(angles[frame++ % 8]);
+        level->UpdateVisibilityMap();
+    }
+    delete level;
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(Level_UpdateVisibilityMap);
+
+// Collecting the walls, tiles and sprites of a frame, as done by the engine before rendering the 3D scene.
+static void Level_Setup3DScene(benchmark::State& state)
+{
+    BenchGameData& gameData = BenchGameData::Instance();
+    Level* level = gameData.CreateLevel();
+    Actor* player = level->GetPlayerActor();
+    EgaGraph& egaGraph = gameData.GetEgaGraph();
+    Renderable3DScene renderable3DScene(gameData.GetGame().GetOriginal3DViewArea());
+    uint32_t frame = 0;
+
+    for (auto _ : state)
+    {
+        player->SetAngle(angles[frame % 8]);
+        state.PauseTiming();
+        level->UpdateVisibilityMap();
+        state.ResumeTiming();
+        renderable3DScene.PrepareFrame(16.0f / 9.0f, player->GetX(), player->GetY(), player->GetAngle(), true, 25, false);
+        level->Setup3DScene(egaGraph, renderable3DScene, frame * 14, frame);
+        renderable3DScene.FinalizeFrame();
+        frame++;
+    }
+    delete level;
+    state.SetLabel(gameData.GetDescription());
+}
+BENCHMARK(Level_Setup3DScene);
+
+// Writing the level with its actors into a reused memory buffer, as done for the snapshots for quick saving and rewinding.
+static void Level_StoreToMemory(benchmark::State& state)
+{
+    Level* level = BenchGameData::Instance().CreateLevel();
+    std::vector<uint8_t> snapshot;
+
+    for (auto _ : state)
+    {
+        snapshot.clear();
+        MemoryStreamBuffer buffer(snapshot);
+        std::ostream stream(&buffer);
+        level->StoreToFile(stream);
+        benchmark::DoNotOptimize(snapshot.data());
+    }
+    delete level;
+    state.counters["bytes"] = (double)snapshot.size();
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(Level_StoreToMemory);
+
+// Rebuilding the level with its actors from a snapshot in memory.
+static void Level_LoadFromMemory(benchmark::State& state)
+{
+    BenchGameData& gameData = BenchGameData::Instance();
+    Level* level = gameData.CreateLevel();
+    std::vector<uint8_t> snapshot;
+    {
+        MemoryStreamBuffer buffer(snapshot);
+        std::ostream stream(&buffer);
+        level->StoreToFile(stream);
+    }
+    delete level;
+
+    for (auto _ : state)
+    {
+        MemoryStreamBuffer buffer(static_cast<const std::vector<uint8_t>&>(snapshot));
+        std::istream stream(&buffer);
+        Level* loadedLevel = gameData.GetGameMaps().GetLevelFromSavedGame(stream);
+        loadedLevel->LoadActorsFromFile(stream, gameData.GetGame().GetDecorateActors());
+        loadedLevel->LoadFogOfWarFromFile(stream);
+        benchmark::DoNotOptimize(loadedLevel);
+        delete loadedLevel;
+    }
+    state.SetLabel(gameData.GetDescription());
+}
+BENCHMARK(Level_LoadFromMemory);
+
+static void StoreLevelToSavedGame(const Level& level, std::vector<uint8_t>& data)
+{
+    SavedGameChunks chunks;
+    MemoryStreamBuffer buffer(chunks.AddChunk("LEVL"));
+    std::ostream stream(&buffer);
+    level.StoreToFile(stream);
+    chunks.Serialize(data, true);
+}
+
+// Writing the level with its actors as a compressed chunk of a saved game, which is what the game loop waits for
+// before the file is written in the background.
+static void Level_StoreToSavedGame(benchmark::State& state)
+{
+    Level* level = BenchGameData::Instance().CreateLevel();
+    std::vector<uint8_t> data;
+
+    for (auto _ : state)
+    {
+        StoreLevelToSavedGame(*level, data);
+        benchmark::DoNotOptimize(data.data());
+    }
+    delete level;
+    state.counters["bytes"] = (double)data.size();
+    state.SetLabel(BenchGameData::Instance().GetDescription());
+}
+BENCHMARK(Level_StoreToSavedGame);
+
+// Checking and expanding the chunk of a saved game and rebuilding the level from it.
+static void Level_LoadFromSavedGame(benchmark::State& state)
+{
+    BenchGameData& gameData = BenchGameData::Instance();
+    Level* level = gameData.CreateLevel();
+    std::vector<uint8_t> data;
+    StoreLevelToSavedGame(*level, data);
+    delete level;
+
+    for (auto _ : state)
+    {
+        SavedGameChunks chunks;
+        if (!chunks.Deserialize(data))
+        {
+            state.SkipWithError("Saved game could not be read back");
+            break;
+        }
+        MemoryStreamBuffer buffer(*chunks.GetChunk("LEVL"));
+        std::istream stream(&buffer);
+        Level* loadedLevel = gameData.GetGameMaps().GetLevelFromSavedGame(stream);
+        loadedLevel->LoadActorsFromFile(stream, gameData.GetGame().GetDecorateActors());
+        loadedLevel->LoadFogOfWarFromFile(stream);
+        benchmark::DoNotOptimize(loadedLevel);
+        delete loadedLevel;
+    }
+    state.SetLabel(gameData.GetDescription());
+}
+BENCHMARK(Level_LoadFromSavedGame);
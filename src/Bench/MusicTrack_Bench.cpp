@@ -0,0 +1,83 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchFixtures.h"
+#include "../Engine/MusicTrack.h"
+#include "../Test/HuffmanFixture.h"
+
+// Track start latency when the whole track is expanded up front, as was done before music was streamed.
+static void MusicTrack_StartWithFullDecompression(benchmark::State& state)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> track = BenchFixtures::CreateMusicTrack((uint16_t)state.range(0));
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(track);
+
+    for (auto _ : state)
+    {
+        FileChunk* chunk = huffman.Decompress(compressed.data(), (unsigned long)compressed.size(), (unsigned long)track.size());
+        benchmark::DoNotOptimize(chunk->GetChunk());
+        delete chunk;
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)track.size());
+}
+BENCHMARK(MusicTrack_StartWithFullDecompression)->Arg(2000)->Arg(16000);
+
+// Track start latency of the streaming decoder, which only expands the first blocks.
+static void MusicTrack_StartStreaming(benchmark::State& state)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> track = BenchFixtures::CreateMusicTrack((uint16_t)state.range(0));
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(track);
+    MusicTrack musicTrack(huffman, compressed.data(), (uint32_t)compressed.size(), (uint32_t)track.size());
+
+    for (auto _ : state)
+    {
+        musicTrack.Rewind();
+        benchmark::DoNotOptimize(musicTrack.GetLength());
+    }
+}
+BENCHMARK(MusicTrack_StartStreaming)->Arg(2000)->Arg(16000);
+
+// Throughput of the sequencer reading events from the streaming decoder, over a complete track.
+static void MusicTrack_ReadAllEvents(benchmark::State& state)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    const uint16_t numberOfEvents = (uint16_t)state.range(0);
+    std::vector<uint8_t> track = BenchFixtures::CreateMusicTrack(numberOfEvents);
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(track);
+    MusicTrack musicTrack(huffman, compressed.data(), (uint32_t)compressed.size(), (uint32_t)track.size());
+
+    for (auto _ : state)
+    {
+        musicTrack.Rewind();
+        uint8_t reg = 0;
+        uint8_t value = 0;
+        uint16_t delay = 0;
+        for (uint16_t i = 0; i < numberOfEvents; i++)
+        {
+            musicTrack.ReadEvent(reg, value, delay);
+        }
+        benchmark::DoNotOptimize(reg);
+    }
+    state.SetBytesProcessed(state.iterations() * (int64_t)track.size());
+}
+BENCHMARK(MusicTrack_ReadAllEvents)->Arg(16000);
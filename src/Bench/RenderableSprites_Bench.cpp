@@ -0,0 +1,117 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include "../Engine/Level.h"
+#include "../Engine/RenderableSprites.h"
+
+// Sprites at the positions of the actors in the first level, seen from the player start.
+static std::vector<std::pair<float, float>> GetSpritePositions(const uint16_t count, float& playerX, float& playerY)
+{
+    Level* level = BenchGameData::Instance().CreateLevel();
+    playerX = level->GetPlayerActor()->GetX();
+    playerY = level->GetPlayerActor()->GetY();
+    std::vector<std::pair<float, float>> positions;
+    Actor** actors = level->GetBlockingActors();
+    const uint32_t mapSize = level->GetLevelWidth() * level->GetLevelHeight();
+    for (uint32_t i = 0; i < mapSize; i++)
+    {
+        if (actors[i] != nullptr && actors[i] != level->GetPlayerActor())
+        {
+            positions.emplace_back(actors[i]->GetX(), actors[i]->GetY());
+        }
+    }
+    delete level;
+
+    // Fill up with positions around the player when the level has fewer actors
+    for (uint16_t i = (uint16_t)positions.size(); i < count; i++)
+    {
+        positions.emplace_back(playerX + (float)((i * 7) % 13) - 6.0f, playerY + (float)((i * 11) % 17) - 8.0f);
+    }
+    positions.resize(count);
+    return positions;
+}
+
+// Adding the sprites of a frame, without sorting them.
+static void RenderableSprites_Add(benchmark::State& state)
+{
+    float playerX = 0.0f;
+    float playerY = 0.0f;
+    const std::vector<std::pair<float, float>> positions = GetSpritePositions((uint16_t)state.range(0), playerX, playerY);
+    Picture* picture = BenchGameData::Instance().GetEgaGraph().GetMaskedPicture(BenchGameData::Instance().GetEgaGraph().GetStaticData().indexOfFirstMaskedPicture);
+    RenderableSprites sprites;
+
+    for (auto _ : state)
+    {
+        sprites.Reset(playerX, playerY, 0.0f);
+        for (const auto& position : positions)
+        {
+            sprites.AddSprite(picture, position.first, position.second, RenderableSprites::RotatedTowardsPlayer);
+        }
+        benchmark::DoNotOptimize(sprites.GetSprites().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RenderableSprites_Add)->Arg(16)->Arg(64)->Arg(100)->Arg(1024);
+
+// Adding and sorting the sprites of a frame, as done by Renderable3DScene::FinalizeFrame.
+static void RenderableSprites_AddAndSort(benchmark::State& state)
+{
+    float playerX = 0.0f;
+    float playerY = 0.0f;
+    const std::vector<std::pair<float, float>> positions = GetSpritePositions((uint16_t)state.range(0), playerX, playerY);
+    Picture* picture = BenchGameData::Instance().GetEgaGraph().GetMaskedPicture(BenchGameData::Instance().GetEgaGraph().GetStaticData().indexOfFirstMaskedPicture);
+    RenderableSprites sprites;
+
+    for (auto _ : state)
+    {
+        sprites.Reset(playerX, playerY, 0.0f);
+        for (const auto& position : positions)
+        {
+            sprites.AddSprite(picture, position.first, position.second, RenderableSprites::RotatedTowardsPlayer);
+        }
+        sprites.SortSpritesBackToFront();
+        benchmark::DoNotOptimize(sprites.GetSprites().data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RenderableSprites_AddAndSort)->Arg(16)->Arg(64)->Arg(100)->Arg(1024);
+
+// Adding and sorting the sprites of a frame while the player turns one degree per frame, such that the order
+// of the sprites changes gradually between frames.
+static void RenderableSprites_AddAndSortWhileTurning(benchmark::State& state)
+{
+    float playerX = 0.0f;
+    float playerY = 0.0f;
+    const std::vector<std::pair<float, float>> positions = GetSpritePositions((uint16_t)state.range(0), playerX, playerY);
+    Picture* picture = BenchGameData::Instance().GetEgaGraph().GetMaskedPicture(BenchGameData::Instance().GetEgaGraph().GetStaticData().indexOfFirstMaskedPicture);
+    RenderableSprites sprites;
+    uint16_t angle = 0;
+
+    for (auto _ : state)
+    {
+        sprites.Reset(playerX, playerY, (float)angle);
+        for (const auto& position : positions)
+        {
+            sprites.AddSprite(picture, position.first, position.second, RenderableSprites::RotatedTowardsPlayer);
+        }
+        sprites.SortSpritesBackToFront();
+        benchmark::DoNotOptimize(sprites.GetSprites().data());
+        angle = (angle + 1) % 360;
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(RenderableSprites_AddAndSortWhileTurning)->Arg(100)->Arg(1024);
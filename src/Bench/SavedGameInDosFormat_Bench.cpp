@@ -0,0 +1,53 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include "../Engine/SavedGameInDosFormat.h"
+#include <cstring>
+
+// Parsing saved games in the format of the original DOS executables, including the decompression of the map planes.
+static void SavedGameInDosFormat_Load(benchmark::State& state)
+{
+    BenchGameData& gameData = BenchGameData::Instance();
+    std::string source;
+    const std::vector<std::vector<uint8_t>>& savedGames = gameData.GetDosSavedGames(source);
+    const SavedGameInDosFormatConfig& config = gameData.GetGame().GetSavedGameInDosFormatConfig();
+    std::vector<FileChunk*> chunks;
+    int64_t bytesPerIteration = 0;
+    for (const std::vector<uint8_t>& savedGame : savedGames)
+    {
+        FileChunk* chunk = new FileChunk((uint32_t)savedGame.size());
+        std::memcpy(chunk->GetChunk(), savedGame.data(), savedGame.size());
+        chunks.push_back(chunk);
+        bytesPerIteration += savedGame.size();
+    }
+
+    for (auto _ : state)
+    {
+        for (const FileChunk* chunk : chunks)
+        {
+            SavedGameInDosFormat savedGame(chunk, config);
+            benchmark::DoNotOptimize(savedGame.Load());
+        }
+    }
+    for (FileChunk* chunk : chunks)
+    {
+        delete chunk;
+    }
+    state.SetBytesProcessed(state.iterations() * bytesPerIteration);
+    state.SetLabel(source);
+}
+BENCHMARK(SavedGameInDosFormat_Load);
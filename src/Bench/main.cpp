@@ -0,0 +1,54 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include <benchmark/benchmark.h>
+#include "BenchGameData.h"
+#include <cstring>
+#include <iostream>
+
+// Besides the options of Google Benchmark, CatacombGL_Bench accepts --game_path=<folder> to run the benchmarks on
+// the data of an installed game. Results are written as JSON with --benchmark_out=<file> --benchmark_out_format=json.
+int main(int argc, char** argv)
+{
+    const char* gamePathOption = "--game_path=";
+    int remainingArgc = 0;
+    for (int i = 0; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], gamePathOption, std::strlen(gamePathOption)) == 0)
+        {
+            const std::string gamePath = argv[i] + std::strlen(gamePathOption);
+            if (!BenchGameData::Instance().SetGamePath(gamePath))
+            {
+                std::cerr << "No supported game found in " << gamePath << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            argv[remainingArgc++] = argv[i];
+        }
+    }
+    argc = remainingArgc;
+
+    benchmark::AddCustomContext("game_data", BenchGameData::Instance().GetDescription());
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -54,8 +54,8 @@ GameCatacomb3D::~GameCatacomb3D()
     m_highScores->StoreToFile(m_configPath);
     delete m_gameMaps;
     delete m_egaGraph;
-    delete m_audioRepository;
     delete m_audioPlayer;
+    delete m_audioRepository;
     delete m_introView;
 }
 
@@ -41,7 +41,7 @@ Actor::Actor(const float x, const float y, const uint32_t timestamp, const Decor
     m_solid = (m_stateId != StateIdHidden && m_stateId != StateIdWaitForPickup && m_stateId != StateIdArch && m_stateId != StateIdPeek && m_stateId != StateIdPeekAlternative);
 }
 
-Actor::Actor(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) :
+Actor::Actor(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) :
     m_decorateActor(GetDecorateActorFromFile(file, decorateActors))
 {
     file.read((char*)&m_x, sizeof(m_x));
@@ -71,7 +71,7 @@ Actor::~Actor()
 
 }
 
-const DecorateActor& Actor::GetDecorateActorFromFile(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) const
+const DecorateActor& Actor::GetDecorateActorFromFile(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) const
 {
     uint16_t actorId = 0;
     file.read((char*)&actorId, sizeof(actorId));
@@ -335,7 +335,7 @@ void Actor::SetAnimationFrame(const uint16_t frame)
     }
 }
 
-void Actor::StoreToFile(std::ofstream& file) const
+void Actor::StoreToFile(std::ostream& file) const
 {
     const uint16_t id = m_decorateActor.id;
     file.write((const char*)&id, sizeof(id));
@@ -29,10 +29,10 @@ class Actor
 {
 public:
     Actor(const float x, const float y, const uint32_t timestamp, const DecorateActor& decorateActor);
-    Actor(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors);
+    Actor(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors);
     ~Actor();
 
-    const DecorateActor& GetDecorateActorFromFile(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) const;
+    const DecorateActor& GetDecorateActorFromFile(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors) const;
 
     float GetX() const;
     void SetX(const float x);
@@ -75,7 +75,7 @@ public:
     void SetAnimationFrame(const uint16_t frame);
 
     const DecorateActor& GetDecorateActor() const;
-    void StoreToFile(std::ofstream& file) const;
+    void StoreToFile(std::ostream& file) const;
 
     bool IsMonsterAndAlive() const;
     bool IsItem() const;
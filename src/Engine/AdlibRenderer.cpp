@@ -0,0 +1,219 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AdlibRenderer.h"
+#include "AdlibSound.h"
+#include "MusicTrack.h"
+#include "../../ThirdParty/opl/dbopl.h"
+#include <cstddef>
+
+// Timing as programmed by id_sd: the music sequencer runs at 8 * 70 Hz, sound effects at 2 * 70 Hz.
+const uint32_t pitRate = 1193182;
+const uint32_t musicTicksPerSecond = 560;
+const uint32_t soundTicksPerSecond = 140;
+
+// Number of samples generated after each register write, as BE_ST_OPL2Write does to simulate the AdLib delays.
+const uint32_t samplesPerWrite = AdlibRenderer::SampleRate / 10000;
+
+// Sound effects are rendered until their release has faded out, up to this many samples.
+const uint32_t maxSoundTailSamples = AdlibRenderer::SampleRate / 2;
+
+const uint8_t alChar = 0x20;
+const uint8_t alScale = 0x40;
+const uint8_t alAttack = 0x60;
+const uint8_t alSus = 0x80;
+const uint8_t alWave = 0xe0;
+const uint8_t alFreqL = 0xa0;
+const uint8_t alFreqH = 0xb0;
+const uint8_t alEffects = 0xbd;
+
+class OplTimeline
+{
+public:
+    OplTimeline(const uint32_t ticksPerSecond, std::vector<int16_t>& samples) :
+        m_samples(samples),
+        m_samplesPerPartTimesPitRate((uint64_t)(1192030 / ticksPerSecond) * AdlibRenderer::SampleRate),
+        m_partNumber(0),
+        m_samplesLeftInTick(0)
+    {
+        Chip__Chip(&m_chip);
+        Chip__Setup(&m_chip, AdlibRenderer::SampleRate);
+
+        // Same initial state as SDL_DetectAdLib leaves behind
+        for (uint16_t reg = 1; reg <= 0xf5; reg++)
+        {
+            Chip__WriteReg(&m_chip, reg, 0);
+        }
+        Chip__WriteReg(&m_chip, 1, 0x20);
+        Chip__WriteReg(&m_chip, 8, 0);
+
+        StartTick();
+    }
+
+    void Write(const uint8_t reg, const uint8_t value)
+    {
+        Chip__WriteReg(&m_chip, reg, value);
+        const uint32_t length = (samplesPerWrite < m_samplesLeftInTick) ? samplesPerWrite : m_samplesLeftInTick;
+        Generate(length);
+        m_samplesLeftInTick -= length;
+    }
+
+    // Generates the remaining samples of the current tick; returns whether they were all silent.
+    bool EndTick()
+    {
+        const std::size_t start = m_samples.size();
+        Generate(m_samplesLeftInTick);
+        StartTick();
+
+        for (std::size_t i = start; i < m_samples.size(); i++)
+        {
+            if (m_samples[i] != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+private:
+    void StartTick()
+    {
+        // Same distribution of samples over the timer ticks as BE_ST_SetTimer and the audio callback use
+        m_samplesLeftInTick = (uint32_t)(((m_partNumber + 1) * m_samplesPerPartTimesPitRate / pitRate) - (m_partNumber * m_samplesPerPartTimesPitRate / pitRate));
+        if (++m_partNumber == pitRate)
+        {
+            m_partNumber = 0;
+        }
+    }
+
+    void Generate(const uint32_t length)
+    {
+        Bit32s buffer[512];
+        uint32_t samplesLeft = length;
+        while (samplesLeft > 0)
+        {
+            const uint32_t blockLength = (samplesLeft < 512) ? samplesLeft : 512;
+            Chip__GenerateBlock2Vectorized(&m_chip, blockLength, buffer);
+            for (uint32_t i = 0; i < blockLength; i++)
+            {
+                // Same scaling as YM3812UpdateOne
+                Bit32s sample = 2 * buffer[i];
+                if (sample > 16383) sample = 16383;
+                else if (sample < -16384) sample = -16384;
+                m_samples.push_back((int16_t)sample);
+            }
+            samplesLeft -= blockLength;
+        }
+    }
+
+    Chip m_chip;
+    std::vector<int16_t>& m_samples;
+    const uint64_t m_samplesPerPartTimesPitRate;
+    uint64_t m_partNumber;
+    uint32_t m_samplesLeftInTick;
+};
+
+void AdlibRenderer::RenderMusicTrack(MusicTrack& track, std::vector<int16_t>& samples, uint32_t& loopStart)
+{
+    DBOPL_InitTables();
+    samples.clear();
+    loopStart = 0;
+    OplTimeline timeline(musicTicksPerSecond, samples);
+
+    timeline.Write(alEffects, 0);
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            loopStart = (uint32_t)samples.size();
+        }
+
+        // Equivalent of SDL_ALService
+        track.Rewind();
+        uint16_t lengthLeft = track.GetLength();
+        uint32_t tick = 0;
+        uint32_t nextEventTick = 0;
+        while (lengthLeft)
+        {
+            while (lengthLeft && nextEventTick <= tick)
+            {
+                uint8_t reg = 0;
+                uint8_t value = 0;
+                uint16_t delay = 0;
+                track.ReadEvent(reg, value, delay);
+                nextEventTick = tick + delay;
+                timeline.Write(reg, value);
+                lengthLeft = (lengthLeft >= 4) ? lengthLeft - 4 : 0;
+            }
+            tick++;
+            timeline.EndTick();
+        }
+    }
+}
+
+void AdlibRenderer::RenderSound(const AdlibSound& sound, std::vector<int16_t>& samples)
+{
+    DBOPL_InitTables();
+    samples.clear();
+    OplTimeline timeline(soundTicksPerSecond, samples);
+
+    // Equivalent of SDL_ALPlaySound
+    const uint8_t block = ((sound.GetOctave() & 7) << 2) | 0x20;
+    timeline.Write(alFreqH + 0, 0);
+    const uint8_t m = 0;
+    const uint8_t c = 3;
+    timeline.Write(m + alChar, sound.GetmChar());
+    timeline.Write(m + alScale, sound.GetmScale());
+    timeline.Write(m + alAttack, sound.GetmAttack());
+    timeline.Write(m + alSus, sound.GetmSus());
+    timeline.Write(m + alWave, sound.GetmWave());
+    timeline.Write(c + alChar, sound.GetcChar());
+    timeline.Write(c + alScale, sound.GetcScale());
+    timeline.Write(c + alAttack, sound.GetcAttack());
+    timeline.Write(c + alSus, sound.GetcSus());
+    timeline.Write(c + alWave, sound.GetcWave());
+
+    // Equivalent of SDL_ALSoundService
+    const uint8_t* data = sound.GetData();
+    const uint32_t length = sound.GetLength();
+    for (uint32_t i = 0; i < length; i++)
+    {
+        const uint8_t s = data[i];
+        if (!s)
+        {
+            timeline.Write(alFreqH + 0, 0);
+        }
+        else
+        {
+            timeline.Write(alFreqL + 0, s);
+            timeline.Write(alFreqH + 0, block);
+        }
+
+        if (i == length - 1)
+        {
+            // The note is switched off in the same tick as the last sample is played
+            timeline.Write(alFreqH + 0, 0);
+        }
+        timeline.EndTick();
+    }
+
+    // Let the release of the note fade out
+    const std::size_t soundEnd = samples.size();
+    bool silent = false;
+    while (!silent && samples.size() - soundEnd < maxSoundTailSamples)
+    {
+        silent = timeline.EndTick();
+    }
+}
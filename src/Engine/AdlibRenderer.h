@@ -0,0 +1,42 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// AdlibRenderer
+//
+// Renders Adlib music tracks and sound effects to 16-bit PCM ahead of time, with a private instance of the OPL emulator.
+// The register writes are timed exactly as the sequencer and sound effect service in id_sd do in real time.
+//
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+
+class AdlibSound;
+class MusicTrack;
+
+class AdlibRenderer
+{
+public:
+    static const uint32_t SampleRate = 49716;
+
+    // Increase when the rendered output changes, such that samples cached on disk are rendered again.
+    static const uint32_t Version = 1;
+
+    // The track is rendered twice; playback can loop back to loopStart, where the second pass starts with
+    // the OPL state that remained after the first pass.
+    static void RenderMusicTrack(MusicTrack& track, std::vector<int16_t>& samples, uint32_t& loopStart);
+    static void RenderSound(const AdlibSound& sound, std::vector<int16_t>& samples);
+};
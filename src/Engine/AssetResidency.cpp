@@ -0,0 +1,183 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AssetResidency.h"
+#include "Logging.h"
+#include <algorithm>
+
+// All asset residencies that exist, for reporting their usage. They are created and destroyed on the main thread.
+static std::vector<const AssetResidency*> assetResidencies;
+
+AssetResidency::AssetResidency(const std::string& name, const uint64_t budgetInBytes) :
+    m_name(name),
+    m_budgetInBytes(budgetInBytes),
+    m_frame(0),
+    m_assets(),
+    m_unloadedAssets(),
+    m_usageInBytes(0),
+    m_peakUsageInBytes(0),
+    m_numberOfUnloads(0),
+    m_numberOfReloads(0)
+{
+    assetResidencies.push_back(this);
+}
+
+AssetResidency::~AssetResidency()
+{
+    assetResidencies.erase(std::remove(assetResidencies.begin(), assetResidencies.end(), this), assetResidencies.end());
+}
+
+void AssetResidency::SetBudget(const uint64_t budgetInBytes)
+{
+    m_budgetInBytes = budgetInBytes;
+}
+
+uint64_t AssetResidency::GetBudget() const
+{
+    return m_budgetInBytes;
+}
+
+void AssetResidency::AddAsset(const uint32_t assetId, const uint64_t sizeInBytes)
+{
+    const auto it = m_assets.find(assetId);
+    if (it != m_assets.end())
+    {
+        m_usageInBytes -= it->second.sizeInBytes;
+        it->second = residentAsset{ sizeInBytes, m_frame };
+    }
+    else
+    {
+        if (m_unloadedAssets.erase(assetId) > 0)
+        {
+            m_numberOfReloads++;
+        }
+        m_assets.insert(std::make_pair(assetId, residentAsset{ sizeInBytes, m_frame }));
+    }
+    m_usageInBytes += sizeInBytes;
+    m_peakUsageInBytes = std::max(m_peakUsageInBytes, m_usageInBytes);
+}
+
+void AssetResidency::TouchAsset(const uint32_t assetId)
+{
+    const auto it = m_assets.find(assetId);
+    if (it != m_assets.end())
+    {
+        it->second.lastUsedFrame = m_frame;
+    }
+}
+
+void AssetResidency::RemoveAsset(const uint32_t assetId)
+{
+    const auto it = m_assets.find(assetId);
+    if (it != m_assets.end())
+    {
+        m_usageInBytes -= it->second.sizeInBytes;
+        m_assets.erase(it);
+        m_unloadedAssets.insert(assetId);
+        m_numberOfUnloads++;
+    }
+}
+
+bool AssetResidency::IsResident(const uint32_t assetId) const
+{
+    return m_assets.find(assetId) != m_assets.end();
+}
+
+bool AssetResidency::IsUnloaded(const uint32_t assetId) const
+{
+    return m_unloadedAssets.find(assetId) != m_unloadedAssets.end();
+}
+
+std::vector<uint32_t> AssetResidency::GetAssetsToUnload() const
+{
+    std::vector<uint32_t> assetsToUnload;
+    if (m_usageInBytes <= m_budgetInBytes)
+    {
+        return assetsToUnload;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> candidates;
+    for (const auto& asset : m_assets)
+    {
+        if (asset.second.lastUsedFrame != m_frame)
+        {
+            candidates.push_back(std::make_pair(asset.second.lastUsedFrame, asset.first));
+        }
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    uint64_t usageInBytes = m_usageInBytes;
+    for (const auto& candidate : candidates)
+    {
+        if (usageInBytes <= m_budgetInBytes)
+        {
+            break;
+        }
+        assetsToUnload.push_back(candidate.second);
+        usageInBytes -= m_assets.at(candidate.second).sizeInBytes;
+    }
+
+    return assetsToUnload;
+}
+
+void AssetResidency::NextFrame()
+{
+    m_frame++;
+}
+
+uint32_t AssetResidency::GetFrame() const
+{
+    return m_frame;
+}
+
+uint32_t AssetResidency::GetNumberOfAssets() const
+{
+    return (uint32_t)m_assets.size();
+}
+
+uint64_t AssetResidency::GetUsageInBytes() const
+{
+    return m_usageInBytes;
+}
+
+uint64_t AssetResidency::GetPeakUsageInBytes() const
+{
+    return m_peakUsageInBytes;
+}
+
+uint32_t AssetResidency::GetNumberOfUnloads() const
+{
+    return m_numberOfUnloads;
+}
+
+uint32_t AssetResidency::GetNumberOfReloads() const
+{
+    return m_numberOfReloads;
+}
+
+std::string AssetResidency::GetUsageReport() const
+{
+    return m_name + ": " + std::to_string(m_assets.size()) + " loaded, " +
+        std::to_string(m_usageInBytes / 1024) + " of " + std::to_string(m_budgetInBytes / 1024) + " KB (peak " + std::to_string(m_peakUsageInBytes / 1024) + " KB), " +
+        std::to_string(m_numberOfUnloads) + " unloaded, " + std::to_string(m_numberOfReloads) + " reloaded";
+}
+
+void AssetResidency::LogUsage()
+{
+    for (const AssetResidency* assetResidency : assetResidencies)
+    {
+        Logging::Instance().AddLogMessage(assetResidency->GetUsageReport());
+    }
+}
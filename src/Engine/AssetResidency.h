@@ -0,0 +1,79 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// AssetResidency
+//
+// Keeps track of the assets that are loaded, how much memory they take and in which frame each of them was last used.
+// When the loaded assets exceed the memory budget, the assets that were used least recently are the ones to unload.
+// The owner of the assets unloads them and loads them again on next use, such that the users of the assets do not
+// notice. The usage of all asset residencies is added to the log when the console is opened.
+//
+#pragma once
+
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class AssetResidency
+{
+public:
+    AssetResidency(const std::string& name, const uint64_t budgetInBytes);
+    ~AssetResidency();
+
+    void SetBudget(const uint64_t budgetInBytes);
+    uint64_t GetBudget() const;
+
+    // Registers an asset that was loaded, as being used in the current frame.
+    void AddAsset(const uint32_t assetId, const uint64_t sizeInBytes);
+    void TouchAsset(const uint32_t assetId);
+    void RemoveAsset(const uint32_t assetId);
+    bool IsResident(const uint32_t assetId) const;
+    bool IsUnloaded(const uint32_t assetId) const;
+
+    // Returns the assets to unload to get within the budget, least recently used first. Assets that are used in the
+    // current frame are never returned, so the budget may still be exceeded after unloading.
+    std::vector<uint32_t> GetAssetsToUnload() const;
+    void NextFrame();
+    uint32_t GetFrame() const;
+
+    uint32_t GetNumberOfAssets() const;
+    uint64_t GetUsageInBytes() const;
+    uint64_t GetPeakUsageInBytes() const;
+    uint32_t GetNumberOfUnloads() const;
+    uint32_t GetNumberOfReloads() const;
+    std::string GetUsageReport() const;
+
+    static void LogUsage();
+
+private:
+    typedef struct
+    {
+        uint64_t sizeInBytes;
+        uint32_t lastUsedFrame;
+    } residentAsset;
+
+    const std::string m_name;
+    uint64_t m_budgetInBytes;
+    uint32_t m_frame;
+    std::unordered_map<uint32_t, residentAsset> m_assets;
+    std::set<uint32_t> m_unloadedAssets;
+    uint64_t m_usageInBytes;
+    uint64_t m_peakUsageInBytes;
+    uint32_t m_numberOfUnloads;
+    uint32_t m_numberOfReloads;
+};
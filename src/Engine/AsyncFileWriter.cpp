@@ -0,0 +1,118 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AsyncFileWriter.h"
+#include "Logging.h"
+#include <cstdio>
+#include <utility>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+static FILE* OpenForWriting(const std::filesystem::path& filename)
+{
+#ifdef _WIN32
+    return _wfopen(filename.c_str(), L"wb");
+#else
+    return std::fopen(filename.c_str(), "wb");
+#endif
+}
+
+// Flushes the file all the way to the disk, such that it is complete before it replaces the previous version.
+static bool Synchronize(FILE* file)
+{
+    if (std::fflush(file) != 0)
+    {
+        return false;
+    }
+#ifdef _WIN32
+    return _commit(_fileno(file)) == 0;
+#else
+    return fsync(fileno(file)) == 0;
+#endif
+}
+
+AsyncFileWriter::AsyncFileWriter() :
+    m_filename(),
+    m_data(),
+    m_succeeded(true),
+    m_worker()
+{
+
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    Wait();
+}
+
+void AsyncFileWriter::Write(const std::filesystem::path& filename, const std::vector<uint8_t>& data)
+{
+    Wait();
+    m_filename = filename;
+    m_data.assign(data.begin(), data.end());
+    m_succeeded = false;
+    m_worker = std::thread(&AsyncFileWriter::WriteFile, this);
+}
+
+void AsyncFileWriter::Write(const std::filesystem::path& filename, std::vector<uint8_t>&& data)
+{
+    Wait();
+    m_filename = filename;
+    m_data = std::move(data);
+    m_succeeded = false;
+    m_worker = std::thread(&AsyncFileWriter::WriteFile, this);
+}
+
+bool AsyncFileWriter::Wait()
+{
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+    return m_succeeded;
+}
+
+void AsyncFileWriter::WriteFile()
+{
+    std::filesystem::path temporaryFilename = m_filename;
+    temporaryFilename += ".tmp";
+
+    FILE* file = OpenForWriting(temporaryFilename);
+    if (file != nullptr)
+    {
+        const bool written = std::fwrite(m_data.data(), 1, m_data.size(), file) == m_data.size() && Synchronize(file);
+        const bool closed = std::fclose(file) == 0;
+        if (written && closed)
+        {
+            std::error_code errorCode;
+            std::filesystem::rename(temporaryFilename, m_filename, errorCode);
+            m_succeeded = !errorCode;
+        }
+
+        if (!m_succeeded)
+        {
+            std::error_code errorCode;
+            std::filesystem::remove(temporaryFilename, errorCode);
+        }
+    }
+
+    if (!m_succeeded)
+    {
+        Logging::Instance().AddLogMessage("WARNING: Unable to write to file " + m_filename.string());
+    }
+}
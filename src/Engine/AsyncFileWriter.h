@@ -0,0 +1,51 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// AsyncFileWriter
+//
+// Writes files on a worker thread, such that the game does not stall on disk access. One file is written at a time;
+// a new write first waits until the previous one has completed. The data is first written to a temporary file and
+// flushed to disk, after which it replaces the file in one rename. A crash during the write thus leaves the previous
+// version of the file intact.
+//
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+class AsyncFileWriter
+{
+public:
+    AsyncFileWriter();
+    ~AsyncFileWriter();
+
+    // The data is copied, such that the caller can reuse it right away.
+    void Write(const std::filesystem::path& filename, const std::vector<uint8_t>& data);
+    void Write(const std::filesystem::path& filename, std::vector<uint8_t>&& data);
+    // Blocks until the current write has completed; returns whether it succeeded.
+    bool Wait();
+
+private:
+    void WriteFile();
+
+    std::filesystem::path m_filename;
+    std::vector<uint8_t> m_data;
+    std::atomic<bool> m_succeeded;
+    std::thread m_worker;
+};
@@ -0,0 +1,90 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AudioMixer.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AUDIOMIXER_SSE2
+#include <emmintrin.h>
+#endif
+
+const uint16_t AudioMixer::FullVolume;
+const int32_t AudioMixer::MinSample;
+const int32_t AudioMixer::MaxSample;
+
+void AudioMixer::Load(int32_t* accumulator, const int16_t* samples, const uint32_t length)
+{
+    uint32_t i = 0;
+#ifdef AUDIOMIXER_SSE2
+    for (; i + 8 <= length; i += 8)
+    {
+        // Sign extend to 32 bits by placing each sample in the upper half and shifting it back
+        const __m128i s = _mm_loadu_si128((const __m128i*)&samples[i]);
+        _mm_storeu_si128((__m128i*)&accumulator[i], _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16));
+        _mm_storeu_si128((__m128i*)&accumulator[i + 4], _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16));
+    }
+#endif
+    for (; i < length; i++)
+    {
+        accumulator[i] = samples[i];
+    }
+}
+
+void AudioMixer::Add(int32_t* accumulator, const int16_t* samples, const uint32_t length, const uint16_t volume)
+{
+    uint32_t i = 0;
+#ifdef AUDIOMIXER_SSE2
+    const __m128i v = _mm_set1_epi16((int16_t)volume);
+    for (; i + 8 <= length; i += 8)
+    {
+        // The low and high halves of the 16x16 bit products combine into exact 32-bit products
+        const __m128i s = _mm_loadu_si128((const __m128i*)&samples[i]);
+        const __m128i productLow = _mm_mullo_epi16(s, v);
+        const __m128i productHigh = _mm_mulhi_epi16(s, v);
+        const __m128i scaled0 = _mm_srai_epi32(_mm_unpacklo_epi16(productLow, productHigh), 8);
+        const __m128i scaled1 = _mm_srai_epi32(_mm_unpackhi_epi16(productLow, productHigh), 8);
+        const __m128i a0 = _mm_loadu_si128((const __m128i*)&accumulator[i]);
+        const __m128i a1 = _mm_loadu_si128((const __m128i*)&accumulator[i + 4]);
+        _mm_storeu_si128((__m128i*)&accumulator[i], _mm_add_epi32(a0, scaled0));
+        _mm_storeu_si128((__m128i*)&accumulator[i + 4], _mm_add_epi32(a1, scaled1));
+    }
+#endif
+    for (; i < length; i++)
+    {
+        accumulator[i] += (samples[i] * (int32_t)volume) >> 8;
+    }
+}
+
+void AudioMixer::Store(int16_t* samples, const int32_t* accumulator, const uint32_t length)
+{
+    uint32_t i = 0;
+#ifdef AUDIOMIXER_SSE2
+    const __m128i minSample = _mm_set1_epi16((int16_t)MinSample);
+    const __m128i maxSample = _mm_set1_epi16((int16_t)MaxSample);
+    for (; i + 8 <= length; i += 8)
+    {
+        // Saturation to 16 bits does not affect the result, as the OPL range is narrower
+        const __m128i a0 = _mm_loadu_si128((const __m128i*)&accumulator[i]);
+        const __m128i a1 = _mm_loadu_si128((const __m128i*)&accumulator[i + 4]);
+        const __m128i packed = _mm_packs_epi32(a0, a1);
+        _mm_storeu_si128((__m128i*)&samples[i], _mm_min_epi16(_mm_max_epi16(packed, minSample), maxSample));
+    }
+#endif
+    for (; i < length; i++)
+    {
+        const int32_t sample = accumulator[i];
+        samples[i] = (int16_t)((sample < MinSample) ? MinSample : (sample > MaxSample) ? MaxSample : sample);
+    }
+}
@@ -0,0 +1,44 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// AudioMixer
+//
+// Mixes blocks of 16-bit PCM samples, each at its own volume, into a 32-bit accumulator.
+// Used by the audio callback to mix pre-rendered sound effects and music with the emulated OPL output.
+// The loops are vectorized with SSE2 where available.
+//
+#pragma once
+
+#include <stdint.h>
+
+class AudioMixer
+{
+public:
+    static const uint16_t FullVolume = 256;
+
+    // Same range as the output of the emulated OPL chip
+    static const int32_t MinSample = -16384;
+    static const int32_t MaxSample = 16383;
+
+    // Initializes the accumulator with the given samples.
+    static void Load(int32_t* accumulator, const int16_t* samples, const uint32_t length);
+
+    // Adds the samples to the accumulator, scaled by volume / FullVolume.
+    static void Add(int32_t* accumulator, const int16_t* samples, const uint32_t length, const uint16_t volume);
+
+    // Stores the accumulated samples, clamped to the range of the OPL output.
+    static void Store(int16_t* samples, const int32_t* accumulator, const uint32_t length);
+};
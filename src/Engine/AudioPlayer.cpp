@@ -14,27 +14,55 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/ 
 
 #include "AudioPlayer.h"
+#include "MusicTrack.h"
+#include "AudioPrerenderer.h"
+#include "AudioMixer.h"
 #include <stdlib.h>
 #include "../../ThirdParty/RefKeen/id_sd.h"
 
 AudioPlayer::AudioPlayer(AudioRepository* audioRepository) :
-    m_audioRepository(audioRepository)
+    m_audioRepository(audioRepository),
+    m_musicIndex(-1),
+    m_realtimeMusicActive(false),
+    m_soundMixerEnabled(false)
 {
 
 }
 
 AudioPlayer::~AudioPlayer()
 {
-
+    // The audio callback must no longer refer to the pre-rendered samples in the audio repository
+    SD_StopPrerendered();
+    SD_SetPrerenderedOnly(false);
 }
 
 void AudioPlayer::Play(const uint16_t index)
 {
     if (SD_GetSoundMode() == sdm_AdLib)
     {
+        const prerenderedAudio* prerenderedSound = m_audioRepository->GetPrerenderedAdlibSound(index);
+        if (prerenderedSound != nullptr)
+        {
+            if (prerenderedSound->samples.empty())
+            {
+                return;
+            }
+
+            if (m_soundMixerEnabled)
+            {
+                SD_MixPrerenderedSound((int16_t*)prerenderedSound->samples.data(), (uint32_t)prerenderedSound->samples.size(), AudioMixer::FullVolume);
+            }
+            else
+            {
+                SD_PlayPrerenderedSound((int16_t*)prerenderedSound->samples.data(), (uint32_t)prerenderedSound->samples.size(), prerenderedSound->priority);
+            }
+            return;
+        }
+
         AdlibSound* sound = m_audioRepository->GetAdlibSound(index);
         if (sound != nullptr)
         {
+            StopRealtimeOnlyMode();
             SDL_ALPlaySound(sound);
         }
     }
@@ -50,19 +78,73 @@ void AudioPlayer::Play(const uint16_t index)
 
 void AudioPlayer::StartMusic(const uint16_t index)
 {
-    FileChunk* musicTrack = m_audioRepository->GetMusicTrack(index);
+    m_musicIndex = index;
+    const prerenderedAudio* prerenderedTrack = m_audioRepository->GetPrerenderedMusicTrack(index);
+    if (prerenderedTrack != nullptr)
+    {
+        m_realtimeMusicActive = false;
+        SD_StartPrerenderedMusic((int16_t*)prerenderedTrack->samples.data(), (uint32_t)prerenderedTrack->samples.size(), prerenderedTrack->loopStart);
+        return;
+    }
+
+    MusicTrack* musicTrack = m_audioRepository->GetMusicTrack(index);
     if (musicTrack != nullptr)
     {
+        StopRealtimeOnlyMode();
+        m_realtimeMusicActive = true;
         SD_StartMusic(musicTrack);
     }
 }
 
 void AudioPlayer::StopMusic()
 {
+    m_musicIndex = -1;
+    m_realtimeMusicActive = false;
     SD_MusicOff();
 }
 
 bool AudioPlayer::IsPlaying()
 {
     return SD_SoundPlaying();
+}
+
+void AudioPlayer::UpdatePrerendering(const bool enabled, const std::filesystem::path& cachePath)
+{
+    if (enabled && !m_audioRepository->IsPrerendering())
+    {
+        m_audioRepository->StartPrerendering(cachePath);
+    }
+    else if (!enabled && m_audioRepository->IsPrerendering())
+    {
+        // Stop playback before the pre-rendered samples are released
+        const bool musicWasPrerendered = !m_realtimeMusicActive && m_musicIndex >= 0;
+        SD_StopPrerendered();
+        StopRealtimeOnlyMode();
+        m_audioRepository->StopPrerendering();
+        if (musicWasPrerendered)
+        {
+            StartMusic((uint16_t)m_musicIndex);
+        }
+    }
+
+    // Once everything is pre-rendered, the emulated OPL chip is only needed by sounds that were started before.
+    if (m_audioRepository->IsPrerenderingComplete() && !m_realtimeMusicActive && !SD_SoundPlaying())
+    {
+        SD_SetPrerenderedOnly(true);
+    }
+}
+
+void AudioPlayer::UpdateResidency(const uint64_t budgetInBytes)
+{
+    m_audioRepository->UpdateResidency(budgetInBytes, SD_SoundPlaying());
+}
+
+void AudioPlayer::StopRealtimeOnlyMode()
+{
+    SD_SetPrerenderedOnly(false);
+}
+
+void AudioPlayer::SetSoundMixerEnabled(const bool enabled)
+{
+    m_soundMixerEnabled = enabled;
 }
\ No newline at end of file
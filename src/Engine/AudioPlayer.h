@@ -15,6 +15,7 @@
 #pragma once
 
 #include "AudioRepository.h"
+#include <filesystem>
 
 class AudioPlayer
 {
@@ -27,6 +28,20 @@ public:
     void StopMusic();
     bool IsPlaying();
 
+    // Keeps the pre-rendering of Adlib sounds and music in line with the given setting; to be called every frame.
+    void UpdatePrerendering(const bool enabled, const std::filesystem::path& cachePath);
+
+    // Keeps the decoded sounds within the given budget; to be called every frame.
+    void UpdateResidency(const uint64_t budgetInBytes);
+
+    // When enabled, pre-rendered sound effects are mixed on voices of their own instead of interrupting each other.
+    void SetSoundMixerEnabled(const bool enabled);
+
 private:
+    void StopRealtimeOnlyMode();
+
     AudioRepository* m_audioRepository;
+    int32_t m_musicIndex;
+    bool m_realtimeMusicActive;
+    bool m_soundMixerEnabled;
 };
@@ -0,0 +1,290 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AudioPrerenderer.h"
+#include "AdlibRenderer.h"
+#include "AdlibSound.h"
+#include "MusicTrack.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace fs = std::filesystem;
+
+const char cacheFileSignature[4] = { 'C', 'G', 'L', 'A' };
+
+AudioPrerenderer::AudioPrerenderer(const Huffman& huffman, const fs::path& cachePath) :
+    m_huffman(huffman),
+    m_cachePath(cachePath),
+    m_jobs(),
+    m_adlibSounds(),
+    m_musicTracks(),
+    m_mutex(),
+    m_stopRequested(false),
+    m_complete(false),
+    m_worker()
+{
+
+}
+
+AudioPrerenderer::~AudioPrerenderer()
+{
+    m_stopRequested = true;
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+
+    for (auto& adlibSound : m_adlibSounds)
+    {
+        delete adlibSound.second;
+    }
+    for (auto& musicTrack : m_musicTracks)
+    {
+        delete musicTrack.second;
+    }
+}
+
+void AudioPrerenderer::AddAdlibSound(const uint16_t index, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize)
+{
+    m_jobs.push_back({ false, index, compressedData, compressedSize, decompressedSize });
+}
+
+void AudioPrerenderer::AddMusicTrack(const uint16_t index, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize)
+{
+    m_jobs.push_back({ true, index, compressedData, compressedSize, decompressedSize });
+}
+
+void AudioPrerenderer::Start()
+{
+    if (!m_worker.joinable())
+    {
+        m_worker = std::thread(&AudioPrerenderer::RenderAll, this);
+    }
+}
+
+const prerenderedAudio* AudioPrerenderer::GetAdlibSound(const uint16_t index) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_adlibSounds.find(index);
+    return (it != m_adlibSounds.end()) ? it->second : nullptr;
+}
+
+const prerenderedAudio* AudioPrerenderer::GetMusicTrack(const uint16_t index) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto it = m_musicTracks.find(index);
+    return (it != m_musicTracks.end()) ? it->second : nullptr;
+}
+
+bool AudioPrerenderer::IsComplete() const
+{
+    return m_complete;
+}
+
+void AudioPrerenderer::RenderAll()
+{
+    // Music tracks take longest to render; start with the sound effects, which are needed first.
+    for (const bool music : { false, true })
+    {
+        for (const renderJob& job : m_jobs)
+        {
+            if (m_stopRequested)
+            {
+                return;
+            }
+
+            if (job.isMusic != music)
+            {
+                continue;
+            }
+
+            prerenderedAudio* audio = Render(job);
+            if (audio != nullptr)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (job.isMusic)
+                {
+                    m_musicTracks.insert(std::make_pair(job.index, audio));
+                }
+                else
+                {
+                    m_adlibSounds.insert(std::make_pair(job.index, audio));
+                }
+            }
+        }
+    }
+
+    m_complete = true;
+}
+
+prerenderedAudio* AudioPrerenderer::Render(const renderJob& job) const
+{
+    const uint64_t hash = GetHash(job);
+    prerenderedAudio* audio = LoadFromCache(hash);
+    if (audio != nullptr)
+    {
+        return audio;
+    }
+
+    if (job.isMusic)
+    {
+        MusicTrack track(m_huffman, job.compressedData, job.compressedSize, job.decompressedSize);
+        if (track.GetLength() == 0)
+        {
+            return nullptr;
+        }
+
+        audio = new prerenderedAudio();
+        audio->priority = 0;
+        AdlibRenderer::RenderMusicTrack(track, audio->samples, audio->loopStart);
+    }
+    else
+    {
+        FileChunk* soundChunk = m_huffman.Decompress((unsigned char*)job.compressedData, job.compressedSize, job.decompressedSize);
+        const AdlibSound sound(soundChunk);
+        delete soundChunk;
+        if (sound.GetLength() == 0)
+        {
+            return nullptr;
+        }
+
+        audio = new prerenderedAudio();
+        audio->priority = sound.GetPriority();
+        audio->loopStart = 0;
+        AdlibRenderer::RenderSound(sound, audio->samples);
+    }
+
+    StoreInCache(hash, *audio);
+
+    return audio;
+}
+
+uint64_t AudioPrerenderer::GetHash(const renderJob& job) const
+{
+    // FNV-1a over the compressed chunk, the kind of chunk and the version of the renderer
+    uint64_t hash = 14695981039346656037ull;
+    const auto addByte = [&hash](const uint8_t value)
+    {
+        hash ^= value;
+        hash *= 1099511628211ull;
+    };
+
+    addByte(job.isMusic ? 1 : 0);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        addByte((uint8_t)(AdlibRenderer::Version >> (i * 8)));
+        addByte((uint8_t)(job.decompressedSize >> (i * 8)));
+    }
+    for (uint32_t i = 0; i < job.compressedSize; i++)
+    {
+        addByte(job.compressedData[i]);
+    }
+
+    return hash;
+}
+
+prerenderedAudio* AudioPrerenderer::LoadFromCache(const uint64_t hash) const
+{
+    if (m_cachePath.empty())
+    {
+        return nullptr;
+    }
+
+    char filename[32];
+    snprintf(filename, sizeof(filename), "%016llx.pcm", (unsigned long long)hash);
+    std::ifstream file;
+    file.open(m_cachePath / filename, std::ifstream::in | std::ifstream::binary);
+    if (!file.is_open())
+    {
+        return nullptr;
+    }
+
+    char signature[4] = { 0 };
+    uint32_t numberOfSamples = 0;
+    prerenderedAudio* audio = new prerenderedAudio();
+    file.read(signature, sizeof(signature));
+    file.read((char*)&audio->loopStart, sizeof(audio->loopStart));
+    file.read((char*)&audio->priority, sizeof(audio->priority));
+    file.read((char*)&numberOfSamples, sizeof(numberOfSamples));
+    if (file.fail() || memcmp(signature, cacheFileSignature, sizeof(signature)) != 0 || audio->loopStart > numberOfSamples)
+    {
+        delete audio;
+        return nullptr;
+    }
+
+    // A sample count that does not fit in the file means the cache entry is damaged; it is rendered again then
+    std::error_code errorCode;
+    const uint64_t fileSize = fs::file_size(m_cachePath / filename, errorCode);
+    const uint64_t headerSize = sizeof(signature) + sizeof(audio->loopStart) + sizeof(audio->priority) + sizeof(numberOfSamples);
+    if (errorCode || (uint64_t)numberOfSamples * sizeof(int16_t) > fileSize - headerSize)
+    {
+        delete audio;
+        return nullptr;
+    }
+
+    audio->samples.resize(numberOfSamples);
+    file.read((char*)audio->samples.data(), numberOfSamples * sizeof(int16_t));
+    if (file.fail())
+    {
+        delete audio;
+        return nullptr;
+    }
+
+    return audio;
+}
+
+void AudioPrerenderer::StoreInCache(const uint64_t hash, const prerenderedAudio& audio) const
+{
+    if (m_cachePath.empty())
+    {
+        return;
+    }
+
+    std::error_code errorCode;
+    fs::create_directories(m_cachePath, errorCode);
+
+    // Write to a temporary file first, such that an interrupted write never leaves a truncated cache entry behind
+    char filename[32];
+    snprintf(filename, sizeof(filename), "%016llx.pcm", (unsigned long long)hash);
+    const fs::path fullPath = m_cachePath / filename;
+    fs::path temporaryPath = fullPath;
+    temporaryPath += ".tmp";
+
+    std::ofstream file;
+    file.open(temporaryPath, std::ofstream::out | std::ofstream::binary);
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    const uint32_t numberOfSamples = (uint32_t)audio.samples.size();
+    file.write(cacheFileSignature, sizeof(cacheFileSignature));
+    file.write((const char*)&audio.loopStart, sizeof(audio.loopStart));
+    file.write((const char*)&audio.priority, sizeof(audio.priority));
+    file.write((const char*)&numberOfSamples, sizeof(numberOfSamples));
+    file.write((const char*)audio.samples.data(), numberOfSamples * sizeof(int16_t));
+    const bool writeSucceeded = !file.fail();
+    file.close();
+
+    if (writeSucceeded)
+    {
+        fs::rename(temporaryPath, fullPath, errorCode);
+    }
+    else
+    {
+        fs::remove(temporaryPath, errorCode);
+    }
+}
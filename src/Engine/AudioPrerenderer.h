@@ -0,0 +1,80 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// AudioPrerenderer
+//
+// Renders all Adlib sound effects and music tracks of an audio repository to PCM on a worker thread.
+// When a cache folder is given, rendered audio is stored on disk, keyed by a hash of the compressed chunk,
+// such that it only needs to be rendered once.
+//
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+#include "Huffman.h"
+
+typedef struct prerenderedAudio
+{
+    std::vector<int16_t> samples;
+    uint32_t loopStart;
+    uint16_t priority;
+} prerenderedAudio;
+
+class AudioPrerenderer
+{
+public:
+    AudioPrerenderer(const Huffman& huffman, const std::filesystem::path& cachePath);
+    ~AudioPrerenderer();
+
+    void AddAdlibSound(const uint16_t index, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize);
+    void AddMusicTrack(const uint16_t index, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize);
+    void Start();
+
+    const prerenderedAudio* GetAdlibSound(const uint16_t index) const;
+    const prerenderedAudio* GetMusicTrack(const uint16_t index) const;
+    bool IsComplete() const;
+
+private:
+    typedef struct renderJob
+    {
+        bool isMusic;
+        uint16_t index;
+        const uint8_t* compressedData;
+        uint32_t compressedSize;
+        uint32_t decompressedSize;
+    } renderJob;
+
+    void RenderAll();
+    prerenderedAudio* Render(const renderJob& job) const;
+    uint64_t GetHash(const renderJob& job) const;
+    prerenderedAudio* LoadFromCache(const uint64_t hash) const;
+    void StoreInCache(const uint64_t hash, const prerenderedAudio& audio) const;
+
+    const Huffman& m_huffman;
+    const std::filesystem::path m_cachePath;
+    std::vector<renderJob> m_jobs;
+    std::map<uint16_t, prerenderedAudio*> m_adlibSounds;
+    std::map<uint16_t, prerenderedAudio*> m_musicTracks;
+    mutable std::mutex m_mutex;
+    std::atomic<bool> m_stopRequested;
+    std::atomic<bool> m_complete;
+    std::thread m_worker;
+};
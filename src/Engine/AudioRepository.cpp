@@ -16,13 +16,19 @@
 #include "AudioRepository.h"
 #include "AdlibSound.h"
 #include "PCSound.h"
+#include "MusicTrack.h"
+#include "AudioPrerenderer.h"
 #include <cstring>
 #include <fstream>
 
 namespace fs = std::filesystem;
 
+static const uint64_t defaultSoundBudgetInBytes = 1024 * 1024;
+
 AudioRepository::AudioRepository(const audioRepositoryStaticData& staticData, const fs::path& path) :
-    m_staticData(staticData)
+    m_staticData(staticData),
+    m_prerenderer(nullptr),
+    m_soundResidency("Decoded sounds", defaultSoundBudgetInBytes)
 {
     Logging::Instance().AddLogMessage("Loading " + m_staticData.filename);
 
@@ -59,7 +65,7 @@ AudioRepository::AudioRepository(const audioRepositoryStaticData& staticData, co
     // Initialize PC and Adlib sounds
     m_pcSounds = new PCSound*[staticData.lastSound];
     m_adlibSounds = new AdlibSound*[staticData.lastSound];
-    m_musicTracks = new FileChunk*[staticData.lastSound];
+    m_musicTracks = new MusicTrack*[staticData.lastSound];
     for (uint16_t i = 0; i < staticData.lastSound; i++)
     {
         m_pcSounds[i] = nullptr;
@@ -70,6 +76,9 @@ AudioRepository::AudioRepository(const audioRepositoryStaticData& staticData, co
 
 AudioRepository::~AudioRepository()
 {
+    delete m_prerenderer;
+    m_prerenderer = nullptr;
+
     for (uint16_t i = 0; i < m_staticData.lastSound; i++)
     {
         delete m_pcSounds[i];
@@ -102,6 +111,11 @@ PCSound* AudioRepository::GetPCSound(const uint16_t index)
         FileChunk* soundChunk = m_huffman->Decompress(&compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
         m_pcSounds[index] = new PCSound(soundChunk);
         delete soundChunk;
+        m_soundResidency.AddAsset(index, uncompressedSize);
+    }
+    else
+    {
+        m_soundResidency.TouchAsset(index);
     }
 
     return m_pcSounds[index]; 
@@ -122,12 +136,17 @@ AdlibSound* AudioRepository::GetAdlibSound(const uint16_t index)
         FileChunk* soundChunk = m_huffman->Decompress(&compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
         m_adlibSounds[index] = new AdlibSound(soundChunk);
         delete soundChunk;
+        m_soundResidency.AddAsset(index + m_staticData.lastSound, uncompressedSize);
+    }
+    else
+    {
+        m_soundResidency.TouchAsset(index + m_staticData.lastSound);
     }
 
     return m_adlibSounds[index]; 
 }
 
-FileChunk* AudioRepository::GetMusicTrack(const uint16_t index)
+MusicTrack* AudioRepository::GetMusicTrack(const uint16_t index)
 {
     if (index >= m_staticData.lastSound)
     {
@@ -136,19 +155,140 @@ FileChunk* AudioRepository::GetMusicTrack(const uint16_t index)
 
     if (m_musicTracks[index] == nullptr)
     {
+        // The music track is not decompressed here; it refers to the compressed data and is expanded while playing.
         uint8_t* compressedSound = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(index + (m_staticData.lastSound * 3))];
         uint32_t compressedSize = GetChunkSize(index + (m_staticData.lastSound * 3)) - sizeof(uint32_t);
         uint32_t uncompressedSize = *(uint32_t*)compressedSound;
-        FileChunk* soundChunk = m_huffman->Decompress(&compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
-        const uint16_t musicTrackLength = *(uint16_t*)soundChunk->GetChunk();
-        m_musicTracks[index] = new FileChunk(musicTrackLength);
-        memcpy(m_musicTracks[index]->GetChunk(), soundChunk->GetChunk() + sizeof(uint16_t), musicTrackLength);
-        delete soundChunk;
+        m_musicTracks[index] = new MusicTrack(*m_huffman, &compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
     }
 
     return m_musicTracks[index];
 }
 
+uint16_t AudioRepository::LoadSounds(const std::set<uint16_t>& indices)
+{
+    uint16_t soundsLoaded = 0;
+    for (const uint16_t index : indices)
+    {
+        if (index >= m_staticData.lastSound)
+        {
+            continue;
+        }
+
+        // Sounds without data are skipped
+        bool loaded = false;
+        if (m_pcSounds[index] == nullptr && GetChunkSize(index) > sizeof(uint32_t))
+        {
+            GetPCSound(index);
+            loaded = true;
+        }
+        if (m_adlibSounds[index] == nullptr && GetChunkSize(index + m_staticData.lastSound) > sizeof(uint32_t))
+        {
+            GetAdlibSound(index);
+            loaded = true;
+        }
+        if (loaded)
+        {
+            soundsLoaded++;
+        }
+    }
+    return soundsLoaded;
+}
+
+void AudioRepository::UpdateResidency(const uint64_t budgetInBytes, const bool soundPlaying)
+{
+    m_soundResidency.SetBudget(budgetInBytes);
+    if (!soundPlaying && m_staticData.lastSound >= 0)
+    {
+        // The PC sounds come first, followed by the adlib sounds
+        const uint32_t lastSound = (uint32_t)m_staticData.lastSound;
+        for (const uint32_t chunkIndex : m_soundResidency.GetAssetsToUnload())
+        {
+            if (chunkIndex < lastSound)
+            {
+                delete m_pcSounds[chunkIndex];
+                m_pcSounds[chunkIndex] = nullptr;
+            }
+            else
+            {
+                delete m_adlibSounds[chunkIndex - lastSound];
+                m_adlibSounds[chunkIndex - lastSound] = nullptr;
+            }
+            m_soundResidency.RemoveAsset(chunkIndex);
+        }
+    }
+    m_soundResidency.NextFrame();
+}
+
+const AssetResidency& AudioRepository::GetSoundResidency() const
+{
+    return m_soundResidency;
+}
+
+void AudioRepository::StartPrerendering(const fs::path& cachePath)
+{
+    if (m_prerenderer != nullptr)
+    {
+        return;
+    }
+
+    Logging::Instance().AddLogMessage("Prerendering Adlib sounds and music of " + m_staticData.filename);
+    m_prerenderer = new AudioPrerenderer(*m_huffman, cachePath);
+
+    // Chunks in the audio repository: PC sounds, Adlib sounds, digitized sounds and music tracks
+    const uint16_t numberOfChunks = (uint16_t)(m_staticData.offsets.size() - 1);
+    for (uint16_t chunkIndex = m_staticData.lastSound; chunkIndex < numberOfChunks; chunkIndex++)
+    {
+        const bool isAdlibSound = chunkIndex < m_staticData.lastSound * 2;
+        const bool isMusicTrack = chunkIndex >= m_staticData.lastSound * 3;
+        const uint32_t chunkSize = GetChunkSize(chunkIndex);
+        if ((!isAdlibSound && !isMusicTrack) || chunkSize <= sizeof(uint32_t))
+        {
+            continue;
+        }
+
+        uint8_t* compressedSound = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(chunkIndex)];
+        const uint32_t compressedSize = chunkSize - sizeof(uint32_t);
+        const uint32_t uncompressedSize = *(uint32_t*)compressedSound;
+        if (isAdlibSound)
+        {
+            m_prerenderer->AddAdlibSound(chunkIndex - m_staticData.lastSound, &compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
+        }
+        else
+        {
+            m_prerenderer->AddMusicTrack(chunkIndex - (m_staticData.lastSound * 3), &compressedSound[sizeof(uint32_t)], compressedSize, uncompressedSize);
+        }
+    }
+
+    m_prerenderer->Start();
+}
+
+void AudioRepository::StopPrerendering()
+{
+    delete m_prerenderer;
+    m_prerenderer = nullptr;
+}
+
+bool AudioRepository::IsPrerendering() const
+{
+    return m_prerenderer != nullptr;
+}
+
+bool AudioRepository::IsPrerenderingComplete() const
+{
+    return m_prerenderer != nullptr && m_prerenderer->IsComplete();
+}
+
+const prerenderedAudio* AudioRepository::GetPrerenderedAdlibSound(const uint16_t index) const
+{
+    return (m_prerenderer != nullptr) ? m_prerenderer->GetAdlibSound(index) : nullptr;
+}
+
+const prerenderedAudio* AudioRepository::GetPrerenderedMusicTrack(const uint16_t index) const
+{
+    return (m_prerenderer != nullptr) ? m_prerenderer->GetMusicTrack(index) : nullptr;
+}
+
 uint32_t AudioRepository::GetChunkSize(const uint16_t index)
 {
     if (index > m_staticData.offsets.size() - 1)
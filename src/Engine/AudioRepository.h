@@ -15,14 +15,19 @@
 #pragma once
 
 #include <filesystem>
+#include <set>
 #include <stdint.h>
 #include <vector>
 #include <string>
+#include "AssetResidency.h"
 #include "Huffman.h"
 #include "Logging.h"
 
 class AdlibSound;
 class PCSound;
+class MusicTrack;
+class AudioPrerenderer;
+struct prerenderedAudio;
 
 typedef struct audioRepositoryStaticData
 {
@@ -40,7 +45,20 @@ public:
 
     PCSound* GetPCSound(const uint16_t index);
     AdlibSound* GetAdlibSound(const uint16_t index);
-    FileChunk* GetMusicTrack(const uint16_t index);
+    MusicTrack* GetMusicTrack(const uint16_t index);
+    // Decodes both the PC and the Adlib variant of the sounds that are not decoded yet. Returns the number of sounds decoded.
+    uint16_t LoadSounds(const std::set<uint16_t>& indices);
+    // Unloads the decoded PC and Adlib sounds that were used least recently, while they exceed the given budget. As the
+    // sound manager refers to the sound that is playing, nothing is unloaded while a sound plays. To be called every frame.
+    void UpdateResidency(const uint64_t budgetInBytes, const bool soundPlaying);
+    const AssetResidency& GetSoundResidency() const;
+
+    void StartPrerendering(const std::filesystem::path& cachePath);
+    void StopPrerendering();
+    bool IsPrerendering() const;
+    bool IsPrerenderingComplete() const;
+    const prerenderedAudio* GetPrerenderedAdlibSound(const uint16_t index) const;
+    const prerenderedAudio* GetPrerenderedMusicTrack(const uint16_t index) const;
 
 private:
     uint32_t GetChunkSize(const uint16_t index);
@@ -50,7 +68,9 @@ private:
     FileChunk* m_rawData;
     PCSound** m_pcSounds;
     AdlibSound** m_adlibSounds;
-    FileChunk** m_musicTracks;
+    MusicTrack** m_musicTracks;
     Huffman* m_huffman;
+    AudioPrerenderer* m_prerenderer;
+    AssetResidency m_soundResidency;
 };
 
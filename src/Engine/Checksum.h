@@ -0,0 +1,29 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+//
+// Checksum
+//
+// CRC-32 as used by both PNG images and zlib, shared by the screenshots and the chunks of the saved games.
+//
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+class Checksum
+{
+public:
+    static uint32_t Crc32(const uint8_t* data, const size_t length);
+};
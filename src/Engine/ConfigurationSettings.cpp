@@ -32,6 +32,9 @@ ConfigurationSettings::ConfigurationSettings() :
     m_manaBar("Mana Bar", "manaBar", false),
     m_preventSoftlock("Prevent Softlock", "preventSoftlock", true),
     m_stickyWalls("Sticky Walls", "stickyWalls", false),
+    m_prerenderAdlib("Prerender Adlib", "prerenderAdlib", false),
+    m_soundMixer("Mix Sounds", "soundMixer", false),
+    m_palettizedTextures("Palettized Textures", "palettizedTextures", false),
     m_cvarsBool(
         {
             std::make_pair(CVarIdDepthShading, &m_depthShading),
@@ -41,7 +44,10 @@ ConfigurationSettings::ConfigurationSettings() :
             std::make_pair(CVarIdAutoFire, &m_autoFire),
             std::make_pair(CVarIdManaBar, &m_manaBar),
             std::make_pair(CVarIdPreventSoftlock, &m_preventSoftlock),
-            std::make_pair(CVarIdStickyWalls, &m_stickyWalls)
+            std::make_pair(CVarIdStickyWalls, &m_stickyWalls),
+            std::make_pair(CVarIdPrerenderAdlib, &m_prerenderAdlib),
+            std::make_pair(CVarIdSoundMixer, &m_soundMixer),
+            std::make_pair(CVarIdPalettizedTextures, &m_palettizedTextures)
         }),
     m_dummyCvarString("Dummy", "Dummy", ""),
     m_pathAbyssv113("", "pathabyssv113", ""),
@@ -111,6 +117,12 @@ ConfigurationSettings::ConfigurationSettings() :
             {"Fit to window", "FitToScreen", ""}
         },
         CVarItemIdAspectRatioFitToWindow),
+    m_renderer("Renderer", "renderer",
+        {
+            {"OpenGL", "OpenGL", ""},
+            {"Software", "Software", ""}
+        },
+        CVarItemIdRendererOpenGL),
     m_cvarsEnum(
         {
             std::make_pair(CVarIdScreenMode, &m_screenMode),
@@ -120,17 +132,22 @@ ConfigurationSettings::ConfigurationSettings() :
             std::make_pair(CVarIdSoundMode, &m_soundMode),
             std::make_pair(CVarIdMusicMode, &m_musicMode),
             std::make_pair(CVarIdTextureFilter, &m_textureFilter),
-            std::make_pair(CVarIdAspectRatio, &m_aspectRatio)
+            std::make_pair(CVarIdAspectRatio, &m_aspectRatio),
+            std::make_pair(CVarIdRenderer, &m_renderer)
         }),
     m_dummyCvarInt("Dummy", "Dummy", 0, 0, 0),
     m_fov("Field Of View (Y)", "fov", 25, 45, 25),
     m_mouseSensitivity("Mouse Sensitiv.", "mouseSensitivity", 1, 20, 10),
     m_turnSpeed("Turn Speed", "turnSpeed", 100, 250, 100),
+    m_textureBudget("Texture Budget (MB)", "textureBudgetMB", 16, 2048, 256),
+    m_soundBudget("Sound Budget (KB)", "soundBudgetKB", 64, 65536, 1024),
     m_cvarsInt(
         {
             std::make_pair(CVarIdFov, &m_fov),
             std::make_pair(CVarIdMouseSensitivity, &m_mouseSensitivity),
-            std::make_pair(CVarIdTurnSpeed, &m_turnSpeed)
+            std::make_pair(CVarIdTurnSpeed, &m_turnSpeed),
+            std::make_pair(CVarIdTextureBudget, &m_textureBudget),
+            std::make_pair(CVarIdSoundBudget, &m_soundBudget)
         })
 {
 
@@ -163,16 +180,22 @@ void ConfigurationSettings::LoadFromFile(const fs::path& configurationFile)
         DeserializeCVar(keyValuePairs, CVarIdPathApocalypsev101);
         DeserializeCVar(keyValuePairs, CVarIdPathCatacomb3Dv122);
 
+        DeserializeCVar(keyValuePairs, CVarIdRenderer);
         DeserializeCVar(keyValuePairs, CVarIdScreenMode);
         DeserializeCVar(keyValuePairs, CVarIdDepthShading);
         DeserializeCVar(keyValuePairs, CVarIdShowFpsMode);
         DeserializeCVar(keyValuePairs, CVarIdVSync);
         DeserializeCVar(keyValuePairs, CVarIdAspectRatio);
         DeserializeCVar(keyValuePairs, CVarIdTextureFilter);
+        DeserializeCVar(keyValuePairs, CVarIdPalettizedTextures);
+        DeserializeCVar(keyValuePairs, CVarIdTextureBudget);
         DeserializeCVar(keyValuePairs, CVarIdFov);
         DeserializeCVar(keyValuePairs, CVarIdScreenResolution);
         DeserializeCVar(keyValuePairs, CVarIdSoundMode);
         DeserializeCVar(keyValuePairs, CVarIdMusicMode);
+        DeserializeCVar(keyValuePairs, CVarIdPrerenderAdlib);
+        DeserializeCVar(keyValuePairs, CVarIdSoundMixer);
+        DeserializeCVar(keyValuePairs, CVarIdSoundBudget);
         DeserializeCVar(keyValuePairs, CVarIdMouseLook);
         DeserializeCVar(keyValuePairs, CVarIdMouseSensitivity);
         DeserializeCVar(keyValuePairs, CVarIdTurnSpeed);
@@ -224,6 +247,7 @@ void ConfigurationSettings::StoreToFile(const fs::path& configurationFile) const
         SerializeCVar(file, CVarIdPathApocalypsev101);
         SerializeCVar(file, CVarIdPathCatacomb3Dv122);
         file << "# Video settings\n";
+        SerializeCVar(file, CVarIdRenderer);
         SerializeCVar(file, CVarIdScreenMode);
         SerializeCVar(file, CVarIdScreenResolution);
         SerializeCVar(file, CVarIdAspectRatio);
@@ -231,11 +255,16 @@ void ConfigurationSettings::StoreToFile(const fs::path& configurationFile) const
         SerializeCVar(file, CVarIdShowFpsMode);
         SerializeCVar(file, CVarIdVSync);
         SerializeCVar(file, CVarIdTextureFilter);
+        SerializeCVar(file, CVarIdPalettizedTextures);
+        SerializeCVar(file, CVarIdTextureBudget);
         SerializeCVar(file, CVarIdFov);
         SerializeCVar(file, CVarIdAutoMapMode);
         file << "# Sound settings\n";
         SerializeCVar(file, CVarIdSoundMode);
         SerializeCVar(file, CVarIdMusicMode);
+        SerializeCVar(file, CVarIdPrerenderAdlib);
+        SerializeCVar(file, CVarIdSoundMixer);
+        SerializeCVar(file, CVarIdSoundBudget);
         file << "# Controls settings\n";
         SerializeCVar(file, CVarIdMouseLook);
         SerializeCVar(file, CVarIdMouseSensitivity);
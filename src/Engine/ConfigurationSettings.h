@@ -47,11 +47,17 @@ static const uint8_t CVarIdSoundMode = 24;
 static const uint8_t CVarIdMusicMode = 25;
 static const uint8_t CVarIdTextureFilter = 26;
 static const uint8_t CVarIdAspectRatio = 27;
+static const uint8_t CVarIdRenderer = 28;
 static const uint8_t CVarIdFov = 40;
 static const uint8_t CVarIdMouseSensitivity = 41;
 static const uint8_t CVarIdTurnSpeed = 42;
 static const uint8_t CVarIdPreventSoftlock = 43;
 static const uint8_t CVarIdStickyWalls = 44;
+static const uint8_t CVarIdPrerenderAdlib = 45;
+static const uint8_t CVarIdSoundMixer = 46;
+static const uint8_t CVarIdPalettizedTextures = 47;
+static const uint8_t CVarIdTextureBudget = 48;
+static const uint8_t CVarIdSoundBudget = 49;
 
 static const uint8_t CVarItemIdScreenModeWindowed = 0;
 static const uint8_t CVarItemIdScreenModeFullscreen = 1;
@@ -82,6 +88,9 @@ static const uint8_t CVarItemIdTextureFilterLinear = 1;
 static const uint8_t CVarItemIdAspectRatioOriginal = 0;
 static const uint8_t CVarItemIdAspectRatioFitToWindow = 1;
 
+static const uint8_t CVarItemIdRendererOpenGL = 0;
+static const uint8_t CVarItemIdRendererSoftware = 1;
+
 class ConfigurationSettings
 {
 public:
@@ -113,17 +122,7 @@ private:
 
     ControlsMap m_controlsMap;
 
-    std::map<const uint8_t, ConsoleVariableBool* const> m_cvarsBool;
     std::map<const uint8_t, ConsoleVariableString* const> m_cvarsString;
-    std::map<const uint8_t, ConsoleVariableEnum* const> m_cvarsEnum;
-    std::map<const uint8_t, ConsoleVariableInt* const> m_cvarsInt;
-
-    ConsoleVariableString m_dummyCvarString;
-    ConsoleVariableString m_pathAbyssv113;
-    ConsoleVariableString m_pathAbyssv124;
-    ConsoleVariableString m_pathArmageddonv102;
-    ConsoleVariableString m_pathApocalypsev101;
-    ConsoleVariableString m_pathCatacomb3Dv122;
 
     ConsoleVariableBool m_dummyCvarBool;
     ConsoleVariableBool m_depthShading;
@@ -134,6 +133,17 @@ private:
     ConsoleVariableBool m_manaBar;
     ConsoleVariableBool m_preventSoftlock;
     ConsoleVariableBool m_stickyWalls;
+    ConsoleVariableBool m_prerenderAdlib;
+    ConsoleVariableBool m_soundMixer;
+    ConsoleVariableBool m_palettizedTextures;
+    std::map<const uint8_t, ConsoleVariableBool* const> m_cvarsBool;
+
+    ConsoleVariableString m_dummyCvarString;
+    ConsoleVariableString m_pathAbyssv113;
+    ConsoleVariableString m_pathAbyssv124;
+    ConsoleVariableString m_pathArmageddonv102;
+    ConsoleVariableString m_pathApocalypsev101;
+    ConsoleVariableString m_pathCatacomb3Dv122;
 
     ConsoleVariableEnum m_dummyCvarEnum;
     ConsoleVariableEnum m_screenMode;
@@ -144,9 +154,14 @@ private:
     ConsoleVariableEnum m_musicMode;
     ConsoleVariableEnum m_textureFilter;
     ConsoleVariableEnum m_aspectRatio;
+    ConsoleVariableEnum m_renderer;
+    std::map<const uint8_t, ConsoleVariableEnum* const> m_cvarsEnum;
 
     ConsoleVariableInt m_dummyCvarInt;
     ConsoleVariableInt m_fov;
     ConsoleVariableInt m_mouseSensitivity;
     ConsoleVariableInt m_turnSpeed;
+    ConsoleVariableInt m_textureBudget;
+    ConsoleVariableInt m_soundBudget;
+    std::map<const uint8_t, ConsoleVariableInt* const> m_cvarsInt;
 };
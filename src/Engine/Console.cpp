@@ -14,11 +14,14 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/ 
 
 #include "Console.h"
+#include "AssetResidency.h"
 #include "DefaultFont.h"
+#include "FrameProfiler.h"
 #include <SDL_timer.h>
 
 Console::Console(const std::string& label) :
     m_active(false),
+    m_frameProfilerOverlay(false),
     m_label(label),
     m_openTimestamp(0),
     m_closeTimestamp(0)
@@ -32,6 +35,11 @@ Console::~Console()
 
 void Console::Draw(IRenderer& renderer)
 {
+    if (m_frameProfilerOverlay)
+    {
+        FrameProfiler::Instance().Draw(renderer);
+    }
+
     const uint32_t timestamp = SDL_GetTicks();
     const uint32_t animationDurationInMs = 300;
     const uint32_t maxNumberOfLinesShown = 16;
@@ -75,7 +83,20 @@ void Console::ProcessInput(PlayerInput& playerInput)
         else
         {
             m_openTimestamp = timestamp;
+            AssetResidency::LogUsage();
         }
         m_active = !m_active;
     }
+
+#ifdef FRAMEPROFILER
+    // While the console is open, F11 toggles the frame profiler overlay and F12 writes the frame profile to file
+    if (m_active && playerInput.IsKeyJustPressed(SDLK_F11))
+    {
+        m_frameProfilerOverlay = !m_frameProfilerOverlay;
+    }
+    if (m_active && playerInput.IsKeyJustPressed(SDLK_F12))
+    {
+        FrameProfiler::Instance().WriteTraceFile();
+    }
+#endif
 }
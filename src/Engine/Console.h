@@ -29,6 +29,7 @@ public:
 
 private:
     bool m_active;
+    bool m_frameProfilerOverlay;
     const std::string m_label;
     uint32_t m_openTimestamp;
     uint32_t m_closeTimestamp;
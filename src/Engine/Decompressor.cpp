@@ -20,13 +20,13 @@
 #include "Decompressor.h"
 #include <string.h>
 #include <cstring>
+#include <algorithm>
 
 //===========================================================================
 //
-//											GLOBAL VARIABLES
+//											CONSTANTS
 //
 //===========================================================================
-/* pointing children nodes (child[], child[] + 1)*/
 
 /* LZSS Parameters */
 
@@ -40,18 +40,7 @@
 #define RootPosition 	(TableSize - 1)							/* root position */
 /* reaches to this value */
 
-static int16_t child[TableSize];
-
-//
-// pointing parent nodes.
-// area [T..(T + N_CHAR - 1)] are pointers for leaves
-//
-
-static int16_t parent[TableSize + N_CHAR];
-
-static uint16_t freq[TableSize + 1];	/* cumulative freq table */
-
-static uint8_t d_code[256] = {
+static const uint8_t d_code[256] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
     0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
@@ -86,7 +75,7 @@ static uint8_t d_code[256] = {
     0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x3E, 0x3F,
 };
 
-static uint8_t d_len[256] = {
+static const uint8_t d_len[256] = {
     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
     0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03,
@@ -121,14 +110,60 @@ static uint8_t d_len[256] = {
     0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08,
 };
 
-static uint16_t getbuf = 0;
-static uint8_t getlen = 0;
+static const uint16_t N = 4096;	// Size of string buffer
+
+//
+// The state of the decoder, which used to be in global variables. Each call of lzhDecompress has its own
+// decoder, such that LZH data can be decompressed on several threads at the same time.
+//
+class LzhDecoder
+{
+public:
+    LzhDecoder(uint8_t* infile, uint32_t compressLength);
+    uint32_t Decompress(uint8_t* outfile, const uint32_t OrginalLength);
+
+private:
+    void StartHuff();
+    void reconst();
+    void update(int16_t c);
+    int16_t GetByte();
+    int16_t GetBit();
+    int16_t DecodeChar();
+    int16_t DecodePosition();
+
+    // pointing children nodes (child[], child[] + 1)
+    int16_t child[TableSize];
+
+    //
+    // pointing parent nodes.
+    // area [T..(T + N_CHAR - 1)] are pointers for leaves
+    //
+    int16_t parent[TableSize + N_CHAR];
+
+    uint16_t freq[TableSize + 1];	/* cumulative freq table */
+
+    uint8_t text_buf[N + F - 1];
+
+    uint16_t getbuf;
+    uint8_t getlen;
+    uint8_t* infile_ptr;
+    uint32_t CompressLength;
+};
+
+LzhDecoder::LzhDecoder(uint8_t* infile, uint32_t compressLength) :
+    getbuf(0),
+    getlen(0),
+    infile_ptr(infile),
+    CompressLength(compressLength)
+{
+
+}
 
 
 //---------------------------------------------------------------------------
 //  StartHuff    /* initialize freq tree */
 //---------------------------------------------------------------------------
-static void StartHuff()
+void LzhDecoder::StartHuff()
 {
     int16_t i, j;
 
@@ -151,7 +186,7 @@ static void StartHuff()
 //---------------------------------------------------------------------------
 //   reconst        /* reconstruct freq tree */
 //---------------------------------------------------------------------------
-static void reconst()
+void LzhDecoder::reconst()
 {
     uint16_t k;
     int16_t i, j;
@@ -209,7 +244,7 @@ static void reconst()
 //---------------------------------------------------------------------------
 //  update()	 update freq tree
 //---------------------------------------------------------------------------
-static void update(int16_t c)
+void LzhDecoder::update(int16_t c)
 {
     const uint16_t MAX_FREQ = 0x8000;  // update when cumulative frequency
     if (freq[RootPosition] == MAX_FREQ)
@@ -256,16 +291,16 @@ static void update(int16_t c)
 //---------------------------------------------------------------------------
 // GetByte
 //---------------------------------------------------------------------------
-static int16_t GetByte(uint8_t **infile_ptr, uint32_t *CompressLength)
+int16_t LzhDecoder::GetByte()
 {
     uint16_t i;
 
     while (getlen <= 8)
     {
-        if (*CompressLength)
+        if (CompressLength)
         {
-            i = (uint8_t)*((*infile_ptr)++);
-            (*CompressLength)--;
+            i = (uint8_t)*(infile_ptr++);
+            CompressLength--;
         }
         else
             i = 0;
@@ -283,16 +318,16 @@ static int16_t GetByte(uint8_t **infile_ptr, uint32_t *CompressLength)
 //---------------------------------------------------------------------------
 // GetBit
 //---------------------------------------------------------------------------
-static int16_t GetBit(uint8_t **infile_ptr, uint32_t *CompressLength)	/* get one bit */
+int16_t LzhDecoder::GetBit()	/* get one bit */
 {
     int16_t i;
 
     while (getlen <= 8)
     {
-        if (*CompressLength)
+        if (CompressLength)
         {
-            i = (uint8_t)*((*infile_ptr)++);
-            (*CompressLength)--;
+            i = (uint8_t)*(infile_ptr++);
+            CompressLength--;
         }
         else
             i = 0;
@@ -310,7 +345,7 @@ static int16_t GetBit(uint8_t **infile_ptr, uint32_t *CompressLength)	/* get one
 //---------------------------------------------------------------------------
 // DecodeChar
 //---------------------------------------------------------------------------
-static int16_t DecodeChar(uint8_t **infile_ptr, uint32_t *CompressLength)
+int16_t LzhDecoder::DecodeChar()
 {
 	uint16_t c = child[RootPosition];
 
@@ -322,7 +357,7 @@ static int16_t DecodeChar(uint8_t **infile_ptr, uint32_t *CompressLength)
 
 	while (c < TableSize)
 	{
-		c += GetBit(infile_ptr,CompressLength);
+		c += GetBit();
 		c = child[c];
 	}
 
@@ -334,13 +369,13 @@ static int16_t DecodeChar(uint8_t **infile_ptr, uint32_t *CompressLength)
 //---------------------------------------------------------------------------
 // DecodePosition
 //---------------------------------------------------------------------------
-static int16_t DecodePosition(uint8_t **infile_ptr,uint32_t *CompressLength)
+int16_t LzhDecoder::DecodePosition()
 {
 	//
 	// decode upper 6 bits from given table
 	//
 
-	uint16_t i = GetByte(infile_ptr, CompressLength);
+	uint16_t i = GetByte();
 	const uint16_t c = (uint16_t)d_code[i] << 6;
 	uint8_t j = d_len[i] - 2;
 
@@ -350,7 +385,7 @@ static int16_t DecodePosition(uint8_t **infile_ptr,uint32_t *CompressLength)
 
 	while (j--)
 	{
-		i = (i << 1) + GetBit(infile_ptr, CompressLength);
+		i = (i << 1) + GetBit();
 	}
 
 	return c | i & 0x3f;
@@ -361,10 +396,16 @@ static int16_t DecodePosition(uint8_t **infile_ptr,uint32_t *CompressLength)
 //---------------------------------------------------------------------------
 uint32_t Decompressor::lzhDecompress(uint8_t* infile, uint8_t* outfile, uint32_t OrginalLength, uint32_t CompressLength)
 {
-    uint32_t count;
+    LzhDecoder decoder(infile, CompressLength);
+    return decoder.Decompress(outfile, OrginalLength);
+}
 
-    getbuf = 0;
-    getlen = 0;
+//---------------------------------------------------------------------------
+// LzhDecoder::Decompress()
+//---------------------------------------------------------------------------
+uint32_t LzhDecoder::Decompress(uint8_t* outfile, const uint32_t OrginalLength)
+{
+    uint32_t count;
 
     if (OrginalLength == 0)
     {
@@ -373,15 +414,13 @@ uint32_t Decompressor::lzhDecompress(uint8_t* infile, uint8_t* outfile, uint32_t
 
     StartHuff();
 
-    const uint16_t N = 4096;	// Size of string buffer
-    uint8_t text_buf[N + F - 1];
     memset(text_buf, ' ', N - F);
 
     int16_t r = N - F;
 
     for (count = 0; count < OrginalLength; )
     {
-        const int16_t c = DecodeChar(&infile,&CompressLength);
+        const int16_t c = DecodeChar();
 
         if (c < 256)
         {
@@ -393,7 +432,7 @@ uint32_t Decompressor::lzhDecompress(uint8_t* infile, uint8_t* outfile, uint32_t
         }
         else
         {
-            const int16_t position = (r - DecodePosition(&infile,&CompressLength) - 1) & (N - 1);
+            const int16_t position = (r - DecodePosition() - 1) & (N - 1);
             const int16_t j = c - 255 + THRESHOLD;
 
             for (int16_t k = 0; k < j; k++)
@@ -550,4 +589,149 @@ FileChunk* Decompressor::CarmackExpand(const uint8_t* compressedChunk)
     }
 
     return decompressedChunk;
-}
\ No newline at end of file
+}
+
+static uint16_t ReadWord(const uint8_t* data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+bool Decompressor::CarmackRLEWExpand(
+    const uint8_t* compressedChunk,
+    const uint32_t compressedSize,
+    const uint16_t rlewtag,
+    std::vector<uint16_t>& history,
+    uint16_t* destination,
+    const uint32_t destinationLengthInWords)
+{
+    const uint8_t NEARTAG = 0xa7;
+    const uint8_t FARTAG = 0xa8;
+
+    // Number of words that the Carmack stage expands ahead of the RLEW stage
+    const uint32_t batchSize = 256;
+
+    if (compressedSize < 2)
+    {
+        return false;
+    }
+    const uint32_t expandedLengthInWords = ReadWord(compressedChunk) / 2;
+    history.resize(expandedLengthInWords);
+    uint16_t* expanded = history.data();
+
+    uint32_t inputPos = 2;
+    uint32_t expandedWords = 0;
+    uint32_t rlewPos = 0;
+    uint32_t outputPos = 0;
+
+    while (outputPos < destinationLengthInWords)
+    {
+        if (expandedWords == expandedLengthInWords)
+        {
+            return false;
+        }
+
+        // Carmack stage: expand a batch of tokens into the history
+        const uint32_t batchEnd = std::min(expandedWords + batchSize, expandedLengthInWords);
+        while (expandedWords < batchEnd)
+        {
+            if (inputPos + 2 > compressedSize)
+            {
+                return false;
+            }
+            uint16_t ch = ReadWord(compressedChunk + inputPos);
+            inputPos += 2;
+            const uint8_t chhigh = ch >> 8;
+            if (chhigh != NEARTAG && chhigh != FARTAG)
+            {
+                expanded[expandedWords++] = ch;
+                continue;
+            }
+
+            const uint16_t count = ch & 0xff;
+            if (count == 0)
+            {
+                // A word containing the tag byte
+                if (inputPos + 1 > compressedSize)
+                {
+                    return false;
+                }
+                ch |= compressedChunk[inputPos];
+                inputPos += 1;
+                expanded[expandedWords++] = ch;
+                continue;
+            }
+
+            uint32_t copyPos = 0;
+            if (chhigh == NEARTAG)
+            {
+                if (inputPos + 1 > compressedSize || compressedChunk[inputPos] == 0 || compressedChunk[inputPos] > expandedWords)
+                {
+                    return false;
+                }
+                copyPos = expandedWords - compressedChunk[inputPos];
+                inputPos += 1;
+            }
+            else
+            {
+                if (inputPos + 2 > compressedSize || ReadWord(compressedChunk + inputPos) >= expandedWords)
+                {
+                    return false;
+                }
+                copyPos = ReadWord(compressedChunk + inputPos);
+                inputPos += 2;
+            }
+            if (count > expandedLengthInWords - expandedWords)
+            {
+                return false;
+            }
+
+            // Copied forward word by word, as a copy that overlaps with its own output repeats the copied words.
+            // The copies are too short for memcpy to pay off.
+            const uint16_t* copyPtr = expanded + copyPos;
+            uint16_t* outputPtr = expanded + expandedWords;
+            for (uint16_t i = 0; i < count; i++)
+            {
+                outputPtr[i] = copyPtr[i];
+            }
+            expandedWords += count;
+        }
+
+        // RLEW stage: the first word is the decompressed size in bytes
+        if (rlewPos == 0)
+        {
+            if (expanded[0] / 2 < destinationLengthInWords)
+            {
+                return false;
+            }
+            rlewPos = 1;
+        }
+        while (rlewPos < expandedWords && outputPos < destinationLengthInWords)
+        {
+            if (expanded[rlewPos] == rlewtag)
+            {
+                if (rlewPos + 3 > expandedWords)
+                {
+                    // Wait for the Carmack stage to expand the rest of the run
+                    break;
+                }
+                // Fill the whole run at once
+                const uint32_t runLength = std::min((uint32_t)expanded[rlewPos + 1], destinationLengthInWords - outputPos);
+                const uint16_t value = expanded[rlewPos + 2];
+                uint16_t* outputPtr = destination + outputPos;
+                for (uint32_t i = 0; i < runLength; i++)
+                {
+                    outputPtr[i] = value;
+                }
+                outputPos += runLength;
+                rlewPos += 3;
+            }
+            else
+            {
+                // Uncompressed
+                destination[outputPos++] = expanded[rlewPos++];
+            }
+        }
+    }
+
+    return true;
+}
@@ -21,10 +21,12 @@
 #pragma once
 
 #include "FileChunk.h"
+#include <vector>
 
 class Decompressor
 {
 public:
+    // Reentrant; LZH data can be decompressed on several threads at the same time.
     static uint32_t lzhDecompress(uint8_t* infile, uint8_t* outfile, uint32_t OrginalLength, uint32_t CompressLength);
     static FileChunk* RLEW_Decompress(const uint8_t* compressedChunk, const uint16_t rlewtag);
     static FileChunk* RLEW_DecompressFromSavedGame(
@@ -34,6 +36,18 @@ public:
         uint16_t& compressedSize);
     static FileChunk* CarmackExpand (const uint8_t* compressedChunk);
 
+    // Expands a map plane that was compressed with RLEW and then with Carmack, in a single pass. The RLEW stage consumes
+    // the Carmack output as it is produced and writes straight into the destination. The history buffer keeps the Carmack
+    // output for its back-references; it can be reused between planes. Returns false if the compressed data is corrupt
+    // or expands to fewer words than the destination length.
+    static bool CarmackRLEWExpand(
+        const uint8_t* compressedChunk,
+        const uint32_t compressedSize,
+        const uint16_t rlewtag,
+        std::vector<uint16_t>& history,
+        uint16_t* destination,
+        const uint32_t destinationLengthInWords);
+
 private:
 
 };
@@ -81,3 +81,7 @@ constexpr rgbColor EgaToRgb(const egaColor ega)
     }
 };
 
+// Palettized pixel data holds one byte per pixel: an egaColor, or the index below for a transparent pixel.
+constexpr uint8_t EgaTransparentIndex = EgaRange;
+constexpr uint8_t EgaPaletteSize = EgaRange + 1;
+
@@ -20,21 +20,33 @@
 #include "Font.h"
 #include "LevelLocationNames.h"
 #include "Picture.h"
+#include "PictureAtlas.h"
 #include "PictureTable.h"
 #include "SpriteTable.h"
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 namespace fs = std::filesystem;
 
 static const uint16_t numTilesSize8 = 104;
 static const uint16_t numTilesSize8Masked = 12;
+static const uint16_t pictureAtlasSize = 1024;
+static const uint16_t pictureAtlasPadding = 1;
+static const uint64_t defaultTextureBudgetInBytes = 256 * 1024 * 1024;
+
+// The renderer may expand the color indices of a texture to RGBA
+static const uint64_t bytesPerTexel = 4;
 
 EgaGraph::EgaGraph(const egaGraphStaticData& staticData, const fs::path& path, IRenderer& renderer) :
     m_staticData(staticData),
-    m_renderer(renderer)
+    m_renderer(renderer),
+    m_pictureTextureIds(staticData.offsets.size(), 0),
+    m_textureResidency("Picture textures", defaultTextureBudgetInBytes)
 {
     Logging::Instance().AddLogMessage("Loading " + m_staticData.filename);
 
@@ -163,6 +175,8 @@ EgaGraph::EgaGraph(const egaGraphStaticData& staticData, const fs::path& path, I
 
     m_tilesSize16TextureAtlas = CreateTextureAtlasForTilesSize16(false);
     m_tilesSize16MaskedTextureAtlas = CreateTextureAtlasForTilesSize16(true);
+
+    CreatePictureAtlases();
 }
 
 EgaGraph::~EgaGraph()
@@ -230,23 +244,89 @@ Picture* EgaGraph::GetPicture(const uint16_t index)
 
     if (m_pictures[pictureIndex] == nullptr)
     {
-        const bool transparent = ((index > m_staticData.indexOfFirstScaledPicture) && (index < m_staticData.indexOfFirstWallPicture));
-        uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(index)];
-        uint32_t compressedSize = GetChunkSize(index) - sizeof(uint32_t);
-        uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
-        FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
-        const uint16_t imageWidth = m_pictureTable->GetWidth(pictureIndex);
-        const uint16_t imageHeight = m_pictureTable->GetHeight(pictureIndex);
-        const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(imageWidth);
-        const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(imageHeight);
-        const unsigned int textureId = LoadFileChunkIntoTexture(pictureChunk, imageWidth, imageHeight, textureWidth, textureHeight, transparent);
-        m_pictures[pictureIndex] = new Picture(textureId, imageWidth, imageHeight, textureWidth, textureHeight);
-        delete pictureChunk;
+        m_pictures[pictureIndex] = CreatePictureWithSource(index, m_pictureTable->GetWidth(pictureIndex), m_pictureTable->GetHeight(pictureIndex));
     }
 
     return m_pictures[pictureIndex]; 
 }
 
+uint16_t EgaGraph::LoadPictures(const std::set<uint16_t>& indices)
+{
+    typedef struct
+    {
+        uint16_t index;
+        uint16_t imageWidth;
+        uint16_t imageHeight;
+        uint16_t textureWidth;
+        uint16_t textureHeight;
+        std::vector<uint8_t> textureImage;
+    } decodedPicture;
+
+    std::vector<decodedPicture> pictures;
+    for (const uint16_t index : indices)
+    {
+        const uint16_t pictureIndex = index - m_staticData.indexOfFirstPicture;
+        // Pictures of which the texture was unloaded are loaded again as well
+        const bool toBeLoaded =
+            pictureIndex < m_pictureTable->GetCount() &&
+            (m_pictures[pictureIndex] == nullptr || m_textureResidency.IsUnloaded(index));
+        if (toBeLoaded && GetChunkSize(index) > sizeof(uint32_t))
+        {
+            const uint16_t imageWidth = m_pictureTable->GetWidth(pictureIndex);
+            const uint16_t imageHeight = m_pictureTable->GetHeight(pictureIndex);
+            pictures.push_back({ index, imageWidth, imageHeight, Picture::GetNearestPowerOfTwo(imageWidth), Picture::GetNearestPowerOfTwo(imageHeight), {} });
+        }
+    }
+
+    // Each worker takes the next picture that is not yet taken, until all pictures are decoded.
+    std::atomic<size_t> nextPicture(0);
+    const auto decodePictures = [this, &pictures, &nextPicture]()
+    {
+        size_t i = nextPicture++;
+        while (i < pictures.size())
+        {
+            decodedPicture& picture = pictures.at(i);
+            const bool transparent = ((picture.index > m_staticData.indexOfFirstScaledPicture) && (picture.index < m_staticData.indexOfFirstWallPicture));
+            uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(picture.index)];
+            const uint32_t compressedSize = GetChunkSize(picture.index) - sizeof(uint32_t);
+            const uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
+            FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
+            picture.textureImage.resize(picture.textureWidth * picture.textureHeight);
+            ConvertPictureToIndices(pictureChunk, picture.imageWidth, picture.imageHeight, picture.textureWidth, picture.textureHeight, transparent, picture.textureImage.data());
+            delete pictureChunk;
+            i = nextPicture++;
+        }
+    };
+
+    // The calling thread decodes pictures as well
+    const size_t numberOfWorkers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), pictures.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numberOfWorkers; i++)
+    {
+        workers.emplace_back(decodePictures);
+    }
+    decodePictures();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (decodedPicture& picture : pictures)
+    {
+        const unsigned int textureId = m_renderer.GenerateTextureId();
+        m_renderer.LoadIndexedPixelDataIntoTexture(picture.textureWidth, picture.textureHeight, picture.textureImage.data(), textureId);
+        Picture*& loadedPicture = m_pictures[picture.index - m_staticData.indexOfFirstPicture];
+        if (loadedPicture == nullptr)
+        {
+            loadedPicture = new Picture(0, picture.imageWidth, picture.imageHeight, picture.textureWidth, picture.textureHeight);
+            loadedPicture->SetSource(this, picture.index);
+        }
+        SetPictureTexture(picture.index, *loadedPicture, textureId);
+    }
+
+    return (uint16_t)pictures.size();
+}
+
 Picture* EgaGraph::GetMaskedPicture(const uint16_t index)
 {
     const uint16_t pictureIndex = index - m_staticData.indexOfFirstMaskedPicture;
@@ -257,17 +337,7 @@ Picture* EgaGraph::GetMaskedPicture(const uint16_t index)
 
     if (m_maskedPictures[pictureIndex] == nullptr)
     {
-        uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(index)];
-        uint32_t compressedSize = GetChunkSize(index) - sizeof(uint32_t);
-        uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
-        FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
-        const uint16_t imageWidth = m_maskedPictureTable->GetWidth(pictureIndex);
-        const uint16_t imageHeight = m_maskedPictureTable->GetHeight(pictureIndex);
-        const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(imageWidth);
-        const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(imageHeight);
-        const unsigned int textureId = LoadMaskedFileChunkIntoTexture(pictureChunk, imageWidth, imageHeight, textureWidth, textureHeight);
-        m_maskedPictures[pictureIndex] = new Picture(textureId, imageWidth, imageHeight, textureWidth, textureHeight);
-        delete pictureChunk;
+        m_maskedPictures[pictureIndex] = CreatePictureWithSource(index, m_maskedPictureTable->GetWidth(pictureIndex), m_maskedPictureTable->GetHeight(pictureIndex));
     }
 
     return m_maskedPictures[pictureIndex]; 
@@ -283,22 +353,76 @@ Picture* EgaGraph::GetSprite(const uint16_t index)
 
     if (m_sprites[pictureIndex] == nullptr)
     {
-        uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(index)];
-        uint32_t compressedSize = GetChunkSize(index) - sizeof(uint32_t);
-        uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
-        FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
-        const uint16_t imageWidth = m_spriteTable->GetWidth(pictureIndex);
-        const uint16_t imageHeight = m_spriteTable->GetHeight(pictureIndex);
-        const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(imageWidth);
-        const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(imageHeight);
-        const unsigned int textureId = LoadMaskedFileChunkIntoTexture(pictureChunk, imageWidth, imageHeight, textureWidth, textureHeight);
-        m_sprites[pictureIndex] = new Picture(textureId, imageWidth, imageHeight, textureWidth, textureHeight);
-        delete pictureChunk;
+        m_sprites[pictureIndex] = CreatePictureWithSource(index, m_spriteTable->GetWidth(pictureIndex), m_spriteTable->GetHeight(pictureIndex));
     }
 
     return m_sprites[pictureIndex]; 
 }
 
+unsigned int EgaGraph::GetPictureTextureId(const uint16_t index)
+{
+    if (m_textureResidency.IsResident(index))
+    {
+        m_textureResidency.TouchAsset(index);
+    }
+    else
+    {
+        const Picture* picture =
+            (index >= m_staticData.indexOfFirstSprite) ? m_sprites[index - m_staticData.indexOfFirstSprite] :
+            (index >= m_staticData.indexOfFirstMaskedPicture) ? m_maskedPictures[index - m_staticData.indexOfFirstMaskedPicture] :
+            m_pictures[index - m_staticData.indexOfFirstPicture];
+        LoadPictureTexture(index, *picture);
+    }
+
+    return m_pictureTextureIds.at(index);
+}
+
+void EgaGraph::UpdateResidency(const uint64_t textureBudgetInBytes)
+{
+    m_textureResidency.SetBudget(textureBudgetInBytes);
+    for (const uint32_t index : m_textureResidency.GetAssetsToUnload())
+    {
+        m_renderer.DeleteTexture(m_pictureTextureIds.at(index));
+        m_pictureTextureIds.at(index) = 0;
+        m_textureResidency.RemoveAsset(index);
+    }
+    m_textureResidency.NextFrame();
+}
+
+const AssetResidency& EgaGraph::GetTextureResidency() const
+{
+    return m_textureResidency;
+}
+
+Picture* EgaGraph::CreatePictureWithSource(const uint16_t index, const uint16_t imageWidth, const uint16_t imageHeight)
+{
+    Picture* picture = new Picture(0, imageWidth, imageHeight, Picture::GetNearestPowerOfTwo(imageWidth), Picture::GetNearestPowerOfTwo(imageHeight));
+    picture->SetSource(this, index);
+    LoadPictureTexture(index, *picture);
+    return picture;
+}
+
+void EgaGraph::LoadPictureTexture(const uint16_t index, const Picture& picture)
+{
+    uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(index)];
+    uint32_t compressedSize = GetChunkSize(index) - sizeof(uint32_t);
+    uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
+    FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
+    const bool masked = (index >= m_staticData.indexOfFirstMaskedPicture);
+    const bool transparent = ((index > m_staticData.indexOfFirstScaledPicture) && (index < m_staticData.indexOfFirstWallPicture));
+    const unsigned int textureId = masked ?
+        LoadMaskedFileChunkIntoTexture(pictureChunk, picture.GetImageWidth(), picture.GetImageHeight(), picture.GetTextureWidth(), picture.GetTextureHeight()) :
+        LoadFileChunkIntoTexture(pictureChunk, picture.GetImageWidth(), picture.GetImageHeight(), picture.GetTextureWidth(), picture.GetTextureHeight(), transparent);
+    delete pictureChunk;
+    SetPictureTexture(index, picture, textureId);
+}
+
+void EgaGraph::SetPictureTexture(const uint16_t index, const Picture& picture, const unsigned int textureId)
+{
+    m_pictureTextureIds.at(index) = textureId;
+    m_textureResidency.AddAsset(index, (uint64_t)picture.GetTextureWidth() * picture.GetTextureHeight() * bytesPerTexel);
+}
+
 Font* EgaGraph::GetFont(const uint16_t index)
 {
     const uint16_t numFonts = m_staticData.indexOfFirstPicture - 3;
@@ -443,8 +567,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize8(const FileChunk* decompr
     const uint16_t numberOfColumns = (masked) ? 3 : 8;
     const uint16_t numberOfRows = (masked) ? 4 : 13;
     const unsigned int textureId = m_renderer.GenerateTextureId();
-    TextureAtlas* textureAtlas = new TextureAtlas(textureId, 8, 8, numberOfColumns, numberOfRows, 2, 2);
-    const uint32_t bytesPerOutputPixel = 4;
+    TextureAtlas* textureAtlas = new TextureAtlas(textureId, 8, 8, numberOfColumns, numberOfRows, 2, 2, 1);
+    const uint32_t bytesPerOutputPixel = 1;
     const uint32_t inputSizeOfTileInBytes = masked ? 40 : 32;
     const uint32_t numberOfPixelsInTile = 64; // 8 x 8
     uint8_t* textureImage = new uint8_t[numberOfPixelsInTile * bytesPerOutputPixel];
@@ -472,12 +596,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize8(const FileChunk* decompr
                         (redplane ? EgaRed : EgaBlack) +
                             (greenplane ? EgaGreen : EgaBlack) +
                             (blueplane ? EgaBlue : EgaBlack));
-                    const rgbColor outputColor = EgaToRgb(transparencyplane ? EgaBlack : colorIndex);
                     const uint32_t outputPixelOffset = ((i * 8) + 7 - j) * bytesPerOutputPixel;
-                    textureImage[outputPixelOffset] = outputColor.red;
-                    textureImage[outputPixelOffset + 1] = outputColor.green;
-                    textureImage[outputPixelOffset + 2] = outputColor.blue;
-                    textureImage[outputPixelOffset + 3] = transparencyplane ? 0 : 255;
+                    textureImage[outputPixelOffset] = transparencyplane ? EgaTransparentIndex : colorIndex;
                 }
                 else
                 {
@@ -491,12 +611,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize8(const FileChunk* decompr
                         (redplane ? EgaRed : EgaBlack) +
                             (greenplane ? EgaGreen : EgaBlack) +
                             (blueplane ? EgaBlue : EgaBlack));
-                    const rgbColor outputColor = EgaToRgb(colorIndex);
                     const uint32_t outputPixelOffset = ((i * 8) + 7 - j) * bytesPerOutputPixel;
-                    textureImage[outputPixelOffset] = outputColor.red;
-                    textureImage[outputPixelOffset + 1] = outputColor.green;
-                    textureImage[outputPixelOffset + 2] = outputColor.blue;
-                    textureImage[outputPixelOffset + 3] = 255;
+                    textureImage[outputPixelOffset] = colorIndex;
                 }
             }
         }
@@ -505,7 +621,7 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize8(const FileChunk* decompr
 
     delete[] textureImage;
 
-    m_renderer.LoadPixelDataIntoTexture(
+    m_renderer.LoadIndexedPixelDataIntoTexture(
         textureAtlas->GetTextureWidth(),
         textureAtlas->GetTextureHeight(),
         textureAtlas->GetTexturePixelData(),
@@ -520,8 +636,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize16(const bool masked) cons
     const uint16_t numberOfColumns = 512 / 18;
     const uint16_t numberOfRows = 512 / 18;
     const unsigned int textureId = m_renderer.GenerateTextureId();
-    TextureAtlas* textureAtlas = new TextureAtlas(textureId, 16, 16, numberOfColumns, numberOfRows, 2, 2);
-    const uint32_t bytesPerOutputPixel = 4;
+    TextureAtlas* textureAtlas = new TextureAtlas(textureId, 16, 16, numberOfColumns, numberOfRows, 2, 2, 1);
+    const uint32_t bytesPerOutputPixel = 1;
     const uint32_t inputSizeOfTileInBytes = masked ? 160 : 128;
     const uint32_t numberOfPixelsInTile = 256; // 16 x 16
     uint8_t* textureImage = new uint8_t[numberOfPixelsInTile * bytesPerOutputPixel];
@@ -555,12 +671,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize16(const bool masked) cons
                         (redplane ? EgaRed : EgaBlack) +
                             (greenplane ? EgaGreen : EgaBlack) +
                             (blueplane ? EgaBlue : EgaBlack));
-                    const rgbColor outputColor = EgaToRgb(transparencyplane ? EgaBlack : colorIndex);
                     const uint32_t outputPixelOffset = ((i * 8) + 7 - j) * bytesPerOutputPixel;
-                    textureImage[outputPixelOffset] = outputColor.red;
-                    textureImage[outputPixelOffset + 1] = outputColor.green;
-                    textureImage[outputPixelOffset + 2] = outputColor.blue;
-                    textureImage[outputPixelOffset + 3] = transparencyplane ? 0 : 255;
+                    textureImage[outputPixelOffset] = transparencyplane ? EgaTransparentIndex : colorIndex;
                 }
                 else
                 {
@@ -574,12 +686,8 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize16(const bool masked) cons
                         (redplane ? EgaRed : EgaBlack) +
                             (greenplane ? EgaGreen : EgaBlack) +
                             (blueplane ? EgaBlue : EgaBlack));
-                    const rgbColor outputColor = EgaToRgb(colorIndex);
                     const uint32_t outputPixelOffset = ((i * 8) + 7 - j) * bytesPerOutputPixel;
-                    textureImage[outputPixelOffset] = outputColor.red;
-                    textureImage[outputPixelOffset + 1] = outputColor.green;
-                    textureImage[outputPixelOffset + 2] = outputColor.blue;
-                    textureImage[outputPixelOffset + 3] = 255;
+                    textureImage[outputPixelOffset] = colorIndex;
                 }
             }
         }
@@ -590,7 +698,7 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForTilesSize16(const bool masked) cons
 
     delete[] textureImage;
 
-    m_renderer.LoadPixelDataIntoTexture(
+    m_renderer.LoadIndexedPixelDataIntoTexture(
         textureAtlas->GetTextureWidth(),
         textureAtlas->GetTextureHeight(),
         textureAtlas->GetTexturePixelData(),
@@ -638,6 +746,93 @@ TextureAtlas* EgaGraph::CreateTextureAtlasForFont(const bool* fontPicture, const
     return textureAtlas;
 }
 
+// Packs the scaled pictures (actors, projectiles, etc.) and the wall pictures into a few large textures, such that
+// the 3D scene can be rendered with a handful of texture binds. The other pictures are still loaded on demand.
+void EgaGraph::CreatePictureAtlases()
+{
+    typedef struct
+    {
+        uint16_t index;
+        uint16_t imageWidth;
+        uint16_t imageHeight;
+        uint16_t atlasIndex;
+        uint16_t offsetX;
+        uint16_t offsetY;
+    } atlasPicture;
+
+    std::vector<atlasPicture> atlasPictures;
+    const uint16_t endIndex = (uint16_t)std::min<uint32_t>(m_staticData.indexOfFirstMaskedPicture, m_staticData.indexOfFirstPicture + m_pictureTable->GetCount());
+    for (uint16_t index = m_staticData.indexOfFirstScaledPicture; index < endIndex; index++)
+    {
+        const uint16_t pictureIndex = index - m_staticData.indexOfFirstPicture;
+        const uint16_t imageWidth = m_pictureTable->GetWidth(pictureIndex);
+        const uint16_t imageHeight = m_pictureTable->GetHeight(pictureIndex);
+        const bool fitsInAtlas =
+            imageWidth > 0 && imageWidth + (2 * pictureAtlasPadding) <= pictureAtlasSize &&
+            imageHeight > 0 && imageHeight + (2 * pictureAtlasPadding) <= pictureAtlasSize;
+        if (fitsInAtlas && GetChunkSize(index) > sizeof(uint32_t))
+        {
+            atlasPictures.push_back({ index, imageWidth, imageHeight, 0, 0, 0 });
+        }
+    }
+
+    // The shelves of the atlas are filled best with the tallest pictures first
+    std::stable_sort(atlasPictures.begin(), atlasPictures.end(), [](const atlasPicture& p, const atlasPicture& q) { return p.imageHeight > q.imageHeight; });
+
+    std::vector<PictureAtlas*> atlases;
+    for (atlasPicture& picture : atlasPictures)
+    {
+        if (atlases.empty() || !atlases.back()->ReserveImage(picture.imageWidth, picture.imageHeight, picture.offsetX, picture.offsetY))
+        {
+            atlases.push_back(new PictureAtlas(pictureAtlasSize, pictureAtlasSize, pictureAtlasPadding, 1));
+            atlases.back()->ReserveImage(picture.imageWidth, picture.imageHeight, picture.offsetX, picture.offsetY);
+        }
+        picture.atlasIndex = (uint16_t)(atlases.size() - 1);
+    }
+
+    std::vector<uint8_t> image;
+    for (const atlasPicture& picture : atlasPictures)
+    {
+        const bool transparent = ((picture.index > m_staticData.indexOfFirstScaledPicture) && (picture.index < m_staticData.indexOfFirstWallPicture));
+        uint8_t* compressedPicture = (uint8_t*)&m_rawData->GetChunk()[m_staticData.offsets.at(picture.index)];
+        uint32_t compressedSize = GetChunkSize(picture.index) - sizeof(uint32_t);
+        uint32_t uncompressedSize = *(uint32_t*)compressedPicture;
+        FileChunk* pictureChunk = m_huffman->Decompress(&compressedPicture[sizeof(uint32_t)], compressedSize, uncompressedSize);
+        image.resize(picture.imageWidth * picture.imageHeight);
+        ConvertPictureToIndices(pictureChunk, picture.imageWidth, picture.imageHeight, picture.imageWidth, picture.imageHeight, transparent, image.data());
+        atlases.at(picture.atlasIndex)->StoreImage(picture.offsetX, picture.offsetY, picture.imageWidth, picture.imageHeight, image.data());
+        delete pictureChunk;
+    }
+
+    std::vector<unsigned int> textureIds;
+    for (PictureAtlas* atlas : atlases)
+    {
+        const unsigned int textureId = m_renderer.GenerateTextureId();
+        m_renderer.LoadIndexedPixelDataIntoTexture(atlas->GetTextureWidth(), atlas->GetTextureHeight(), atlas->GetTexturePixelData(), textureId);
+        textureIds.push_back(textureId);
+    }
+
+    for (const atlasPicture& picture : atlasPictures)
+    {
+        const PictureAtlas* atlas = atlases.at(picture.atlasIndex);
+        m_pictures[picture.index - m_staticData.indexOfFirstPicture] = new Picture(
+            textureIds.at(picture.atlasIndex),
+            picture.imageWidth,
+            picture.imageHeight,
+            atlas->GetTextureWidth(),
+            atlas->GetTextureHeight(),
+            picture.offsetX,
+            picture.offsetY);
+    }
+
+    for (PictureAtlas* atlas : atlases)
+    {
+        delete atlas;
+    }
+
+    Logging::Instance().AddLogMessage("Packed " + std::to_string(atlasPictures.size()) + " pictures into " + std::to_string(atlases.size()) + " texture atlases");
+}
+
 unsigned int EgaGraph::LoadFileChunkIntoTexture(
     const FileChunk* decompressedChunk,
     const uint16_t imageWidth,
@@ -646,11 +841,7 @@ unsigned int EgaGraph::LoadFileChunkIntoTexture(
     const uint16_t textureHeight,
     const bool transparent)
 {
-    const uint32_t bytesPerOutputPixel = 4;
-    const uint32_t numberOfPlanes = 4;
-    const uint32_t planeSize = decompressedChunk->GetSize() / numberOfPlanes;
-    const uint32_t numberOfEgaPixelsPerByte = 8;
-    const uint32_t numberOfPixels = planeSize * numberOfEgaPixelsPerByte;
+    const uint32_t bytesPerOutputPixel = 1;
     const uint32_t textureImageSize = textureWidth * textureHeight * bytesPerOutputPixel;
 
     if (textureImageSize < imageWidth * imageHeight * bytesPerOutputPixel)
@@ -660,10 +851,74 @@ unsigned int EgaGraph::LoadFileChunkIntoTexture(
 
     uint8_t* textureImage = new uint8_t[textureImageSize];
 
+    ConvertPictureToIndices(decompressedChunk, imageWidth, imageHeight, textureWidth, textureHeight, transparent, textureImage);
+
+    const unsigned int textureId = m_renderer.GenerateTextureId();
+    m_renderer.LoadIndexedPixelDataIntoTexture(textureWidth, textureHeight, textureImage, textureId);
+
+    delete[] textureImage;
+
+    return textureId;
+}
+
+unsigned int EgaGraph::LoadMaskedFileChunkIntoTexture(
+    const FileChunk* decompressedChunk,
+    const uint16_t imageWidth,
+    const uint16_t imageHeight,
+    const uint16_t textureWidth,
+    const uint16_t textureHeight)
+{
+    const uint32_t bytesPerOutputPixel = 1;
+    const uint32_t textureImageSize = textureWidth * textureHeight * bytesPerOutputPixel;
+
+    if (textureImageSize < imageWidth * imageHeight * bytesPerOutputPixel)
+    {
+        Logging::Instance().FatalError("Texture image of size " + std::to_string(textureImageSize) + " is too small to contain masked image of dimensions (" + std::to_string(imageWidth) + " x " + std::to_string(imageHeight) + std::to_string(bytesPerOutputPixel) + ")");
+    }
+
+    uint8_t* textureImage = new uint8_t[textureImageSize];
+
+    ConvertMaskedPictureToIndices(decompressedChunk, imageWidth, imageHeight, textureWidth, textureHeight, textureImage);
+
+    const unsigned int textureId = m_renderer.GenerateTextureId();
+    m_renderer.LoadIndexedPixelDataIntoTexture(textureWidth, textureHeight, textureImage, textureId);
+
+    delete[] textureImage;
+
+    return textureId;
+}
+
+uint16_t EgaGraph::GetNumberOfTilesSize16(const bool masked) const
+{
+    return (masked) ?
+        m_staticData.indexOfLastTileSize16Masked - m_staticData.indexOfFirstTileSize16Masked + 1 :
+        m_staticData.indexOfLastTileSize16 - m_staticData.indexOfFirstTileSize16 + 1;
+}
+
+const egaGraphStaticData& EgaGraph::GetStaticData() const
+{
+    return m_staticData;
+}
+
+void EgaGraph::ConvertPictureToIndices(
+    const FileChunk* decompressedChunk,
+    const uint16_t imageWidth,
+    const uint16_t imageHeight,
+    const uint16_t textureWidth,
+    const uint16_t textureHeight,
+    const bool transparent,
+    uint8_t* textureImage)
+{
+    const uint32_t bytesPerOutputPixel = 1;
+    const uint32_t numberOfPlanes = 4;
+    const uint32_t planeSize = decompressedChunk->GetSize() / numberOfPlanes;
+    const uint32_t numberOfEgaPixelsPerByte = 8;
+    const uint32_t textureImageSize = textureWidth * textureHeight * bytesPerOutputPixel;
+
     // Clear the whole texture
     for (uint32_t i = 0; i < textureImageSize; i++)
     {
-        textureImage[i] = 0;
+        textureImage[i] = EgaTransparentIndex;
     }
 
     unsigned char* chunk = decompressedChunk->GetChunk();
@@ -683,16 +938,12 @@ unsigned int EgaGraph::LoadFileChunkIntoTexture(
                     (greenplane ? EgaGreen : EgaBlack) +
                     (blueplane ? EgaBlue : EgaBlack));
             const bool transparentPixel = transparent && (colorIndex == 5);
-            const rgbColor outputColor = EgaToRgb(transparentPixel ? EgaBlack : colorIndex);
 
             const uint32_t outputImagePixelOffset = ((i * 8) + 7 - j);
             const uint32_t outputImagePixelX = outputImagePixelOffset % imageWidth;
             const uint32_t outputImagePixelY = outputImagePixelOffset / imageWidth;
             const uint32_t outputTextureOffset = ((outputImagePixelY * textureWidth) + outputImagePixelX) * bytesPerOutputPixel;
-            textureImage[outputTextureOffset] = outputColor.red;
-            textureImage[outputTextureOffset + 1] = outputColor.green;
-            textureImage[outputTextureOffset + 2] = outputColor.blue;
-            textureImage[outputTextureOffset + 3] = transparentPixel ? 0 : 255;
+            textureImage[outputTextureOffset] = transparentPixel ? EgaTransparentIndex : colorIndex;
         }
     }
 
@@ -721,40 +972,26 @@ unsigned int EgaGraph::LoadFileChunkIntoTexture(
             }
         }
     }
-
-    const unsigned int textureId = m_renderer.GenerateTextureId();
-    m_renderer.LoadPixelDataIntoTexture(textureWidth, textureHeight, textureImage, textureId);
-
-    delete[] textureImage;
-
-    return textureId;
 }
 
-unsigned int EgaGraph::LoadMaskedFileChunkIntoTexture(
+void EgaGraph::ConvertMaskedPictureToIndices(
     const FileChunk* decompressedChunk,
     const uint16_t imageWidth,
     const uint16_t imageHeight,
     const uint16_t textureWidth,
-    const uint16_t textureHeight)
+    const uint16_t textureHeight,
+    uint8_t* textureImage)
 {
-    const uint32_t bytesPerOutputPixel = 4;
+    const uint32_t bytesPerOutputPixel = 1;
     const uint32_t numberOfPlanes = 5;
     const uint32_t planeSize = decompressedChunk->GetSize() / numberOfPlanes;
     const uint32_t numberOfEgaPixelsPerByte = 8;
-    const uint32_t numberOfPixels = planeSize * numberOfEgaPixelsPerByte;
     const uint32_t textureImageSize = textureWidth * textureHeight * bytesPerOutputPixel;
 
-    if (textureImageSize < imageWidth * imageHeight * bytesPerOutputPixel)
-    {
-        Logging::Instance().FatalError("Texture image of size " + std::to_string(textureImageSize) + " is too small to contain masked image of dimensions (" + std::to_string(imageWidth) + " x " + std::to_string(imageHeight) + std::to_string(bytesPerOutputPixel) + ")");
-    }
-
-    uint8_t* textureImage = new uint8_t[textureImageSize];
-
     // Clear the whole texture
     for (uint32_t i = 0; i < textureImageSize; i++)
     {
-        textureImage[i] = 0;
+        textureImage[i] = EgaTransparentIndex;
     }
 
     unsigned char* chunk = decompressedChunk->GetChunk();
@@ -774,15 +1011,11 @@ unsigned int EgaGraph::LoadMaskedFileChunkIntoTexture(
                 (redplane ? EgaRed : EgaBlack) +
                     (greenplane ? EgaGreen : EgaBlack) +
                     (blueplane ? EgaBlue : EgaBlack));
-            const rgbColor outputColor = EgaToRgb(transparencyplane ? EgaBlack : colorIndex);
             const uint32_t outputImagePixelOffset = ((i * 8) + 7 - j);
             const uint32_t outputImagePixelX = outputImagePixelOffset % imageWidth;
             const uint32_t outputImagePixelY = outputImagePixelOffset / imageWidth;
             const uint32_t outputTextureOffset = ((outputImagePixelY * textureWidth) + outputImagePixelX) * bytesPerOutputPixel;
-            textureImage[outputTextureOffset] = outputColor.red;
-            textureImage[outputTextureOffset + 1] = outputColor.green;
-            textureImage[outputTextureOffset + 2] = outputColor.blue;
-            textureImage[outputTextureOffset + 3] = transparencyplane ? 0 : 255;
+            textureImage[outputTextureOffset] = transparencyplane ? EgaTransparentIndex : colorIndex;
         }
     }
 
@@ -811,18 +1044,4 @@ unsigned int EgaGraph::LoadMaskedFileChunkIntoTexture(
             }
         }
     }
-
-    const unsigned int textureId = m_renderer.GenerateTextureId();
-    m_renderer.LoadPixelDataIntoTexture(textureWidth, textureHeight, textureImage, textureId);
-
-    delete[] textureImage;
-
-    return textureId;
-}
-
-uint16_t EgaGraph::GetNumberOfTilesSize16(const bool masked) const
-{
-    return (masked) ?
-        m_staticData.indexOfLastTileSize16Masked - m_staticData.indexOfFirstTileSize16Masked + 1 :
-        m_staticData.indexOfLastTileSize16 - m_staticData.indexOfFirstTileSize16 + 1;
 }
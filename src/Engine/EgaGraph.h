@@ -17,14 +17,19 @@
 // EgaGraph
 //
 // Class for reading data structures (pictures, fonts, etc.) from an EGAGRAPH file.
+// The pictures that have a texture of their own are loaded on demand, and their textures are unloaded again when they
+// exceed the texture budget. The texture atlases and fonts stay loaded.
 //
 #pragma once
 
 #include <filesystem>
+#include <set>
 #include <stdint.h>
 #include <string>
 #include <vector>
+#include "AssetResidency.h"
 #include "Huffman.h"
+#include "IPictureSource.h"
 #include "IRenderer.h"
 #include "Logging.h"
 
@@ -55,7 +60,7 @@ typedef struct egaGraphStaticData
     uint16_t indexOfHandPicture;
 } egaGraphStaticData;
 
-class EgaGraph
+class EgaGraph : public IPictureSource
 {
 public:
     EgaGraph(const egaGraphStaticData& staticData, const std::filesystem::path& path, IRenderer& renderer);
@@ -64,6 +69,14 @@ public:
     Picture* GetPicture(const uint16_t index);
     Picture* GetMaskedPicture(const uint16_t index);
     Picture* GetSprite(const uint16_t index);
+    // Loads the pictures that are not loaded yet, such that GetPicture does not need to decode them on first use.
+    // The pictures are decoded on worker threads and uploaded on the calling thread. Returns the number of pictures loaded.
+    uint16_t LoadPictures(const std::set<uint16_t>& indices);
+    unsigned int GetPictureTextureId(const uint16_t index) override;
+    // Unloads the textures of the pictures that were used least recently, while the textures exceed the given budget.
+    // To be called once per frame, after rendering.
+    void UpdateResidency(const uint64_t textureBudgetInBytes);
+    const AssetResidency& GetTextureResidency() const;
     Font* GetFont(const uint16_t index);
     const Font* GetDefaultFont(const uint16_t lineHeight);
     LevelLocationNames* GetWorldLocationNames(const uint16_t index);
@@ -75,12 +88,34 @@ public:
     const TextureAtlas* const GetTilesSize16() const;
     const TextureAtlas* const GetTilesSize16Masked() const;
     uint16_t GetNumberOfTilesSize16(const bool masked) const;
+    const egaGraphStaticData& GetStaticData() const;
+
+    // Converts the planar EGA data of a picture into a palettized image with the dimensions of the texture.
+    static void ConvertPictureToIndices(
+        const FileChunk* decompressedChunk,
+        const uint16_t imageWidth,
+        const uint16_t imageHeight,
+        const uint16_t textureWidth,
+        const uint16_t textureHeight,
+        const bool transparent,
+        uint8_t* textureImage);
+    static void ConvertMaskedPictureToIndices(
+        const FileChunk* decompressedChunk,
+        const uint16_t imageWidth,
+        const uint16_t imageHeight,
+        const uint16_t textureWidth,
+        const uint16_t textureHeight,
+        uint8_t* textureImage);
 
 private:
     uint32_t GetChunkSize(const uint16_t index) const;
     TextureAtlas* CreateTextureAtlasForTilesSize8(const FileChunk* decompressedChunk, const bool masked) const;
     TextureAtlas* CreateTextureAtlasForTilesSize16(const bool masked) const;
     TextureAtlas* CreateTextureAtlasForFont(const bool* fontPicture, const uint16_t lineHeight);
+    void CreatePictureAtlases();
+    Picture* CreatePictureWithSource(const uint16_t index, const uint16_t imageWidth, const uint16_t imageHeight);
+    void LoadPictureTexture(const uint16_t index, const Picture& picture);
+    void SetPictureTexture(const uint16_t index, const Picture& picture, const unsigned int textureId);
     unsigned int LoadFileChunkIntoTexture(
         const FileChunk* decompressedChunk,
         const uint16_t imageWidth,
@@ -113,5 +148,8 @@ private:
     const TextureAtlas* m_tilesSize8MaskedTextureAtlas;
     const TextureAtlas* m_tilesSize16TextureAtlas;
     const TextureAtlas* m_tilesSize16MaskedTextureAtlas;
+
+    std::vector<unsigned int> m_pictureTextureIds;
+    AssetResidency m_textureResidency;
 };
 
@@ -17,14 +17,20 @@
 #include "EngineCore.h"
 #include "../../ThirdParty/RefKeen/id_sd.h"
 #include "DefaultFont.h"
+#include "FrameProfiler.h"
 #include "LevelLocationNames.h"
 #include "Macros.h"
+#include "MemoryStreamBuffer.h"
 #include "RenderableTiles.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <set>
+#include <thread>
+#include <utility>
 
 namespace fs = std::filesystem;
 
@@ -33,6 +39,18 @@ const uint8_t versionMinor = 5;
 const uint8_t versionLevel = 4;
 const std::string versionPhase = "Beta";
 
+// Rewinding goes back up to one minute, in steps of two seconds.
+const uint32_t rewindSnapshotInterval = 2000u;
+const uint16_t maxRewindSnapshots = 30;
+const char* const quickSaveName = "quicksave";
+
+// Chunks of the saved games
+const char* const chunkIdGame = "GAME";
+const char* const chunkIdInventory = "INVT";
+const char* const chunkIdLevel = "LEVL";
+const char* const chunkIdTimer = "TIME";
+const char* const chunkIdScore = "SCOR";
+
 const uint8_t VictoryStatePlayGetBolt = 0;
 const uint8_t VictoryStatePlayingGetBolt = 1;
 const uint8_t VictoryStatePlayGetNuke = 2;
@@ -95,7 +113,13 @@ EngineCore::EngineCore(IGame& game, const ISystem& system, PlayerInput& keyboard
     m_insideBorderFlashLocation(false),
     m_levelStatistics(),
     m_renderableLevelStatistics(m_levelStatistics),
-    m_savedGamesInDosFormat(m_game.GetSavedGameInDosFormatConfig())
+    m_savedGamesInDosFormat(m_game.GetSavedGameInDosFormatConfig()),
+    m_rewindSnapshots(maxRewindSnapshots),
+    m_snapshot(),
+    m_quickSaveSnapshot(),
+    m_timeStampOfLastRewindSnapshot(0),
+    m_savedGameWriter(),
+    m_levelWarmedUp(false)
 {
     m_messageInPopup[0] = 0;
     m_gameTimer.Reset();
@@ -186,6 +210,7 @@ void EngineCore::LoadLevel(const uint8_t mapIndex)
     // must be preserved when transfering to the next map.
     const int16_t health = (m_level == nullptr) ? 100 : m_level->GetPlayerActor()->GetHealth();
     UnloadLevel();
+    m_rewindSnapshots.Clear();
 
     m_level = m_game.GetGameMaps()->GetLevelFromStart(mapIndex);
 
@@ -211,6 +236,8 @@ void EngineCore::LoadLevel(const uint8_t mapIndex)
 
     m_game.SpawnActors(m_level, m_difficultyLevel);
     m_level->GetPlayerActor()->SetHealth(health);
+    // The pictures and sounds of the level are loaded while the entering level screen is shown
+    m_levelWarmedUp = false;
     m_autoMap.ResetOrigin(*m_level, m_configurationSettings.GetCVarEnum(CVarIdAutoMapMode).GetItemIndex());
     m_levelStatistics.SetCountersAtStartOfLevel(*m_level);
 
@@ -236,7 +263,9 @@ void EngineCore::LoadLevel(const uint8_t mapIndex)
 
 void EngineCore::DrawScene(IRenderer& renderer)
 {
+    PROFILE_SCOPE("DrawScene");
     m_framesCounter.AddFrame(m_gameTimer.GetActualTime());
+    renderer.SetGpuTimingEnabled(m_configurationSettings.GetCVarEnum(CVarIdShowFpsMode).GetItemIndex() == CVarItemIdShowFpsExtended);
 
     if (m_setOverlayOnNextDraw)
     {
@@ -249,6 +278,7 @@ void EngineCore::DrawScene(IRenderer& renderer)
     IRenderer::FrameSettings frameSettings;
     frameSettings.textureFilter = (m_configurationSettings.GetCVarEnum(CVarIdTextureFilter).GetItemIndex() == CVarItemIdTextureFilterNearest) ? IRenderer::Nearest : IRenderer::Linear;
     frameSettings.vSyncEnabled = m_configurationSettings.GetCVarBool(CVarIdVSync).IsEnabled();
+    frameSettings.palettizedTextures = m_configurationSettings.GetCVarBool(CVarIdPalettizedTextures).IsEnabled();
     renderer.SetFrameSettings(frameSettings);
 
     if (m_state == AutoMapDialog && m_level != nullptr)
@@ -604,6 +634,24 @@ void EngineCore::DrawScene(IRenderer& renderer)
             renderableTextFont7.LeftAligned(renderer.GetGraphicsApiVersion(), EgaBrightYellow, offsetX, 22);
             renderableTextFont7.LeftAligned(renderer.GetGraphicsAdapterVendor(), EgaBrightYellow, offsetX, 30);
             renderableTextFont7.LeftAligned(renderer.GetGraphicsAdapterModel(), EgaBrightYellow, offsetX, 38);
+
+            const IRenderer::RenderStatistics& statistics = renderer.GetRenderStatistics();
+            const std::string drawStatisticsStr =
+                std::to_string(statistics.textureBinds) + " binds, " +
+                std::to_string(statistics.drawBatches) + " batches, " +
+                std::to_string(statistics.vertices) + " vertices";
+            renderableTextFont7.LeftAligned(drawStatisticsStr, EgaBrightYellow, offsetX, 46);
+            if (statistics.gpuTimesAvailable)
+            {
+                const char* passNames[IRenderer::RenderPassCount] = { "Floor", "Walls", "Sprites", "Text", "Tiles", "Map", "Iso map" };
+                char gpuTimeStr[24];
+                for (uint8_t pass = 0; pass < IRenderer::RenderPassCount; pass++)
+                {
+                    std::snprintf(gpuTimeStr, sizeof(gpuTimeStr), "%.2f ms", statistics.gpuTimeInMilliseconds[pass]);
+                    renderableTextFont7.LeftAligned(passNames[pass], EgaBrightYellow, offsetX, 54 + (pass * 8));
+                    renderableTextFont7.LeftAligned(gpuTimeStr, EgaBrightYellow, offsetX + 40, 54 + (pass * 8));
+                }
+            }
             renderer.RenderText(renderableTextFont7);
         }
     }
@@ -612,6 +660,9 @@ void EngineCore::DrawScene(IRenderer& renderer)
     m_renderableOverscanBorder.Draw(renderer, margin, m_gameTimer.GetActualTime(), m_state == Help);
     
     renderer.Unprepare2DRendering();
+
+    // Only textures that were not used in this frame are unloaded
+    m_game.GetEgaGraph()->UpdateResidency((uint64_t)m_configurationSettings.GetCVarInt(CVarIdTextureBudget).GetValue() * 1024 * 1024);
 }
 
 // Based on US_CenterWindow in ID_US.C of the Catacomb Abyss source code.
@@ -693,6 +744,7 @@ void EngineCore::EnterKeyReleased()
 
 bool EngineCore::Think()
 {
+    PROFILE_SCOPE("Think");
     const uint32_t currentTimestampOfPlayer = m_gameTimer.GetMillisecondsForPlayer();
     const uint32_t currentTimestampOfWorld = m_gameTimer.GetMilliSecondsForWorld();
 
@@ -731,6 +783,10 @@ bool EngineCore::Think()
         SD_SetMusicMode(smm_Off);
     }
 
+    m_game.GetAudioPlayer()->UpdatePrerendering(m_configurationSettings.GetCVarBool(CVarIdPrerenderAdlib).IsEnabled(), m_system.GetConfigurationFilePath() / "AudioCache");
+    m_game.GetAudioPlayer()->SetSoundMixerEnabled(m_configurationSettings.GetCVarBool(CVarIdSoundMixer).IsEnabled());
+    m_game.GetAudioPlayer()->UpdateResidency((uint64_t)m_configurationSettings.GetCVarInt(CVarIdSoundBudget).GetValue() * 1024);
+
     if (m_menu->IsActive())
     {
         m_menu->SetSaveGameEnabled((m_state == InGame || m_state == WarpCheatDialog || m_state == GodModeCheatDialog || m_state == FreeItemsCheatDialog || m_state == AutoMapDialog) && !m_level->GetPlayerActor()->IsDead());
@@ -819,6 +875,8 @@ bool EngineCore::Think()
         }
     }
 
+    UpdateRewindSnapshots();
+
     if (m_state == InGame && !m_menu->IsActive())
     {
         if (m_score.Update(m_timeStampOfPlayerCurrentFrame))
@@ -1011,6 +1069,18 @@ bool EngineCore::Think()
             m_menu->OpenRestoreGameMenu();
             m_gameTimer.Pause();
         }
+        if (m_state == InGame && m_playerInput.IsKeyJustPressed(SDLK_F5))
+        {
+            QuickSave();
+        }
+        if (m_state == InGame && m_playerInput.IsKeyJustPressed(SDLK_F7))
+        {
+            Rewind();
+        }
+        if (m_state == InGame && m_playerInput.IsKeyJustPressed(SDLK_F9))
+        {
+            QuickLoad();
+        }
     }
 
     if (m_state != Help &&
@@ -1077,6 +1147,11 @@ bool EngineCore::Think()
 
     if (m_state == EnteringLevel)
     {
+        if (m_level != nullptr && !m_levelWarmedUp)
+        {
+            WarmUpLevel();
+        }
+
         if (m_timeStampToEnterGame < m_gameTimer.GetActualTime())
         {
             m_state = InGame;
@@ -1090,6 +1165,10 @@ bool EngineCore::Think()
         if (m_level == nullptr)
         {
             LoadLevel(m_warpToLevel);
+            if (m_state == InGame)
+            {
+                WarmUpLevel();
+            }
         }
     }
 
@@ -1416,6 +1495,7 @@ bool EngineCore::Think()
 
 void EngineCore::ThinkActors()
 {
+    PROFILE_SCOPE("ThinkActors");
     const uint16_t mapSize = m_level->GetLevelWidth() * m_level->GetLevelHeight();
     for ( uint16_t i = 0; i < mapSize; i++)
     {
@@ -3187,51 +3267,65 @@ void EngineCore::UnloadLevel()
     m_level = nullptr;
 }
 
-bool EngineCore::StoreGameToFileWithFullPath(const fs::path filename) const
+void EngineCore::StoreGameToBuffer(std::vector<uint8_t>& data, const bool compress) const
 {
-    bool result = false;
-
-    if (m_level == nullptr)
+    SavedGameChunks chunks;
     {
-        return false;
+        MemoryStreamBuffer buffer(chunks.AddChunk(chunkIdGame));
+        std::ostream stream(&buffer);
+        stream.write((const char*)&versionMajor, sizeof(versionMajor));
+        stream.write((const char*)&versionMinor, sizeof(versionMinor));
+        const uint8_t gameId = m_game.GetId();
+        stream.write((const char*)&gameId, sizeof(gameId));
+        stream.write((const char*)&m_difficultyLevel, sizeof(m_difficultyLevel));
+        stream.write((const char*)&m_godModeIsOn, sizeof(m_godModeIsOn));
     }
-
-    std::ofstream file;
-    file.open(filename, std::ofstream::binary);
-    if (file.is_open())
     {
-        const char headerString[11] = "CATACOMBGL";
-        file.write(headerString, sizeof(headerString));
-        file.write((const char*)&versionMajor, sizeof(versionMajor));
-        file.write((const char*)&versionMinor, sizeof(versionMinor));
-        const uint8_t gameId = m_game.GetId();
-        file.write((const char*)&gameId, sizeof(gameId));
-        file.write((const char*)&m_difficultyLevel, sizeof(m_difficultyLevel));
-        file.write((const char*)&m_godModeIsOn, sizeof(m_godModeIsOn));
-        m_playerInventory.StoreToFile(file);
-        m_level->StoreToFile(file);
-        m_gameTimer.StoreToFile(file);
-        // The amount of points scored by the player gets stored since version 0.4.0
-        const uint32_t points = m_score.GetPoints();
-        file.write((const char*)&points, sizeof(points));
-        file.close();
-        result = true;
+        MemoryStreamBuffer buffer(chunks.AddChunk(chunkIdInventory));
+        std::ostream stream(&buffer);
+        m_playerInventory.StoreToFile(stream);
+    }
+    {
+        MemoryStreamBuffer buffer(chunks.AddChunk(chunkIdLevel));
+        std::ostream stream(&buffer);
+        m_level->StoreToFile(stream);
     }
-    else
     {
-        Logging::Instance().AddLogMessage("WARNING: Unable to write to file " + filename.string());
+        MemoryStreamBuffer buffer(chunks.AddChunk(chunkIdTimer));
+        std::ostream stream(&buffer);
+        m_gameTimer.StoreToFile(stream);
+    }
+    {
+        MemoryStreamBuffer buffer(chunks.AddChunk(chunkIdScore));
+        std::ostream stream(&buffer);
+        const uint32_t points = m_score.GetPoints();
+        stream.write((const char*)&points, sizeof(points));
     }
-    return result;
+    chunks.Serialize(data, compress);
 }
 
 bool EngineCore::StoreGameToFile(const std::string filename)
 {
+    if (m_level == nullptr)
+    {
+        return false;
+    }
+
     const fs::path filenamePath = m_system.GetConfigurationFilePath();
     const fs::path filenamePathForGame = filenamePath / m_game.GetSavedGamesPath();
     if (m_system.CreatePath(filenamePathForGame))
     {
+        if (filename == quickSaveName)
+        {
+            // The quick save in memory is no longer the same as the one on disk
+            m_quickSaveSnapshot.clear();
+        }
+        // The game is serialized right away, while the file is written in the background
+        std::vector<uint8_t> data;
+        StoreGameToBuffer(data, true);
         const fs::path fullPath = filenamePathForGame / ( filename + ".sav" );
-        return StoreGameToFileWithFullPath(fullPath);
+        m_savedGameWriter.Write(fullPath, std::move(data));
+        return true;
     }
     else
     {
@@ -3243,75 +3337,269 @@ bool EngineCore::StoreGameToFile(const std::string filename)
 
 void EngineCore::LoadGameFromFileWithFullPath(const fs::path filename)
 {
+    // A quick save may still be on its way to disk
+    m_savedGameWriter.Wait();
+
     std::ifstream file;
-    file.open(filename, std::ifstream::binary);
+    file.open(filename, std::ifstream::binary | std::ifstream::ate);
     if (file.is_open())
     {
         Logging::Instance().AddLogMessage("Loading saved game " + filename.string());
-        char headerString[11];
-        file.read(headerString, 11);
-        if (file.fail())
+        std::vector<uint8_t> data((size_t)file.tellg());
+        file.seekg(0);
+        file.read((char*)data.data(), data.size());
+        const bool readFailed = file.fail();
+        file.close();
+        if (readFailed)
+        {
+            Logging::Instance().AddLogMessage("WARNING: Unable to read from file " + filename.string());
+        }
+        else if (LoadGameFromBuffer(data))
         {
-            Logging::Instance().AddLogMessage("WARNING: Unable to read header from " + filename.string());
-            file.close();
-            return;
+            m_rewindSnapshots.Clear();
         }
+        else
+        {
+            Logging::Instance().AddLogMessage("WARNING: Unable to read saved game from " + filename.string());
+        }
+    }
+    else
+    {
+        Logging::Instance().AddLogMessage("WARNING: Unable to open file " + filename.string());
+    }
+}
+
+bool EngineCore::LoadGameFromBuffer(const std::vector<uint8_t>& data)
+{
+    if (SavedGameChunks::GetFormatVersion(data) == 0)
+    {
+        MemoryStreamBuffer buffer(data);
+        std::istream stream(&buffer);
+        return LoadGameFromStream(stream);
+    }
+
+    SavedGameChunks chunks;
+    if (!chunks.Deserialize(data))
+    {
+        return false;
+    }
+    return LoadGameFromChunks(chunks);
+}
+
+bool EngineCore::LoadGameFromChunks(const SavedGameChunks& chunks)
+{
+    const std::vector<uint8_t>* const game = chunks.GetChunk(chunkIdGame);
+    const std::vector<uint8_t>* const inventory = chunks.GetChunk(chunkIdInventory);
+    const std::vector<uint8_t>* const level = chunks.GetChunk(chunkIdLevel);
+    const std::vector<uint8_t>* const timer = chunks.GetChunk(chunkIdTimer);
+    if (game == nullptr || inventory == nullptr || level == nullptr || timer == nullptr)
+    {
+        return false;
+    }
+
+    DifficultyLevel difficultyLevel = Normal;
+    bool godModeIsOn = false;
+    {
+        MemoryStreamBuffer buffer(*game);
+        std::istream stream(&buffer);
         uint8_t versionMajorRead = 0;
-        file.read((char*)&versionMajorRead, sizeof(versionMajorRead));
+        stream.read((char*)&versionMajorRead, sizeof(versionMajorRead));
         uint8_t versionMinorRead = 0;
-        file.read((char*)&versionMinorRead, sizeof(versionMinorRead));
+        stream.read((char*)&versionMinorRead, sizeof(versionMinorRead));
         uint8_t gameId = 0;
-        file.read((char*)&gameId, sizeof(gameId));
-        file.read((char*)&m_difficultyLevel, sizeof(m_difficultyLevel));
-        file.read((char*)&m_godModeIsOn, sizeof(m_godModeIsOn));
-        m_playerInventory.LoadFromFile(file);
-        UnloadLevel();
-        m_level = m_game.GetGameMaps()->GetLevelFromSavedGame(file);
-        m_level->LoadActorsFromFile(file, m_game.GetDecorateActors());
-        if (versionMajorRead > 0 || versionMinorRead >= 5)
-        {
-            // The fog of war map gets stored since version 0.5.0
-            m_level->LoadFogOfWarFromFile(file);
-        }
-        m_gameTimer.LoadFromFile(file);
-        if (versionMajorRead > 0 || versionMinorRead >= 4)
+        stream.read((char*)&gameId, sizeof(gameId));
+        stream.read((char*)&difficultyLevel, sizeof(difficultyLevel));
+        stream.read((char*)&godModeIsOn, sizeof(godModeIsOn));
+        if (stream.fail() || gameId != m_game.GetId())
         {
-            // The amount of points scored by the player gets stored since version 0.4.0
-            long points = 0;
-            file.read((char*)&points, sizeof(long));
-            m_score.SetPoints(points);
+            return false;
         }
-        file.close();
+    }
+    m_difficultyLevel = difficultyLevel;
+    m_godModeIsOn = godModeIsOn;
 
-        // Temporarily load the same level from scratch to setup the level statistics correctly.
-        Level* levelFromScratch = m_game.GetGameMaps()->GetLevelFromStart(m_level->GetLevelIndex());
-        m_game.SpawnActors(levelFromScratch, m_difficultyLevel);
-        m_levelStatistics.SetCountersAtStartOfLevel(*levelFromScratch);
-        delete levelFromScratch;
+    {
+        MemoryStreamBuffer buffer(*inventory);
+        std::istream stream(&buffer);
+        m_playerInventory.LoadFromFile(stream);
+    }
+    {
+        MemoryStreamBuffer buffer(*level);
+        std::istream stream(&buffer);
+        UnloadLevel();
+        m_level = m_game.GetGameMaps()->GetLevelFromSavedGame(stream);
+        m_level->LoadActorsFromFile(stream, m_game.GetDecorateActors());
+        m_level->LoadFogOfWarFromFile(stream);
+    }
+    {
+        MemoryStreamBuffer buffer(*timer);
+        std::istream stream(&buffer);
+        m_gameTimer.LoadFromFile(stream);
+    }
+    const std::vector<uint8_t>* const score = chunks.GetChunk(chunkIdScore);
+    if (score != nullptr)
+    {
+        MemoryStreamBuffer buffer(*score);
+        std::istream stream(&buffer);
+        uint32_t points = 0;
+        stream.read((char*)&points, sizeof(points));
+        m_score.SetPoints(points);
+    }
 
-        // Now count how many monsters/secrets/items are remaining
-        m_levelStatistics.UpdateMonstersKilled(*m_level);
-        m_levelStatistics.UpdateSecrets(*m_level);
-        m_levelStatistics.UpdateItems(*m_level);
+    SetupLoadedGame();
+    return true;
+}
 
-        m_playerActions.ResetForNewLevel();
-        m_manaBar.Reset(m_configurationSettings.GetCVarBool(CVarIdManaBar).IsEnabled());
-        m_warpToLevel = m_level->GetLevelIndex();
-        m_menu->SetActive(false);
-        m_state = InGame;
+bool EngineCore::LoadGameFromStream(std::istream& stream)
+{
+    char headerString[11];
+    stream.read(headerString, 11);
+    if (stream.fail())
+    {
+        return false;
+    }
+    uint8_t versionMajorRead = 0;
+    stream.read((char*)&versionMajorRead, sizeof(versionMajorRead));
+    uint8_t versionMinorRead = 0;
+    stream.read((char*)&versionMinorRead, sizeof(versionMinorRead));
+    uint8_t gameId = 0;
+    stream.read((char*)&gameId, sizeof(gameId));
+    stream.read((char*)&m_difficultyLevel, sizeof(m_difficultyLevel));
+    stream.read((char*)&m_godModeIsOn, sizeof(m_godModeIsOn));
+    m_playerInventory.LoadFromFile(stream);
+    UnloadLevel();
+    m_level = m_game.GetGameMaps()->GetLevelFromSavedGame(stream);
+    m_level->LoadActorsFromFile(stream, m_game.GetDecorateActors());
+    if (versionMajorRead > 0 || versionMinorRead >= 5)
+    {
+        // The fog of war map gets stored since version 0.5.0
+        m_level->LoadFogOfWarFromFile(stream);
+    }
+    m_gameTimer.LoadFromFile(stream);
+    if (versionMajorRead > 0 || versionMinorRead >= 4)
+    {
+        // The amount of points scored by the player gets stored since version 0.4.0
+        uint32_t points = 0;
+        stream.read((char*)&points, sizeof(points));
+        m_score.SetPoints(points);
+    }
 
-        const uint32_t currentTimestampOfPlayer = m_gameTimer.GetMillisecondsForPlayer();
-        const uint32_t currentTimestampOfWorld = m_gameTimer.GetMilliSecondsForWorld();
+    SetupLoadedGame();
+    return true;
+}
 
-        m_timeStampOfPlayerPreviousFrame = m_timeStampOfPlayerCurrentFrame;
-        m_timeStampOfPlayerCurrentFrame = currentTimestampOfPlayer;
-        m_timeStampOfWorldPreviousFrame = m_timeStampOfWorldCurrentFrame;
-        m_timeStampOfWorldCurrentFrame = currentTimestampOfWorld;
-        m_timeStampFadeEffect = 0;
+void EngineCore::SetupLoadedGame()
+{
+    // Temporarily load the same level from scratch to setup the level statistics correctly.
+    Level* levelFromScratch = m_game.GetGameMaps()->GetLevelFromStart(m_level->GetLevelIndex());
+    m_game.SpawnActors(levelFromScratch, m_difficultyLevel);
+    m_levelStatistics.SetCountersAtStartOfLevel(*levelFromScratch);
+    delete levelFromScratch;
+
+    // Now count how many monsters/secrets/items are remaining
+    m_levelStatistics.UpdateMonstersKilled(*m_level);
+    m_levelStatistics.UpdateSecrets(*m_level);
+    m_levelStatistics.UpdateItems(*m_level);
+
+    m_playerActions.ResetForNewLevel();
+    m_manaBar.Reset(m_configurationSettings.GetCVarBool(CVarIdManaBar).IsEnabled());
+    m_warpToLevel = m_level->GetLevelIndex();
+    m_menu->SetActive(false);
+    m_state = InGame;
+
+    const uint32_t currentTimestampOfPlayer = m_gameTimer.GetMillisecondsForPlayer();
+    const uint32_t currentTimestampOfWorld = m_gameTimer.GetMilliSecondsForWorld();
+
+    m_timeStampOfPlayerPreviousFrame = m_timeStampOfPlayerCurrentFrame;
+    m_timeStampOfPlayerCurrentFrame = currentTimestampOfPlayer;
+    m_timeStampOfWorldPreviousFrame = m_timeStampOfWorldCurrentFrame;
+    m_timeStampOfWorldCurrentFrame = currentTimestampOfWorld;
+    m_timeStampFadeEffect = 0;
+
+    WarmUpLevel();
+}
+
+void EngineCore::CaptureSnapshot(std::vector<uint8_t>& snapshot) const
+{
+    PROFILE_SCOPE("CaptureSnapshot");
+    // Uncompressed, such that consecutive snapshots differ in few bytes
+    StoreGameToBuffer(snapshot, false);
+}
+
+bool EngineCore::RestoreSnapshot(const std::vector<uint8_t>& snapshot)
+{
+    return LoadGameFromBuffer(snapshot);
+}
+
+void EngineCore::UpdateRewindSnapshots()
+{
+    if (m_state != InGame || m_menu->IsActive() || m_level == nullptr || m_level->GetPlayerActor()->IsDead() || m_gameTimer.IsPaused())
+    {
+        return;
+    }
+
+    // The player time goes back when an older state is restored
+    if (m_timeStampOfPlayerCurrentFrame >= m_timeStampOfLastRewindSnapshot + rewindSnapshotInterval ||
+        m_timeStampOfPlayerCurrentFrame < m_timeStampOfLastRewindSnapshot)
+    {
+        CaptureSnapshot(m_snapshot);
+        m_rewindSnapshots.Push(m_snapshot);
+        m_timeStampOfLastRewindSnapshot = m_timeStampOfPlayerCurrentFrame;
+    }
+}
+
+void EngineCore::QuickSave()
+{
+    StoreGameToBuffer(m_quickSaveSnapshot, true);
+
+    const fs::path filenamePathForGame = m_system.GetConfigurationFilePath() / m_game.GetSavedGamesPath();
+    if (m_system.CreatePath(filenamePathForGame))
+    {
+        m_savedGameWriter.Write(filenamePathForGame / (std::string(quickSaveName) + ".sav"), m_quickSaveSnapshot);
+        if (std::find(m_savedGames.begin(), m_savedGames.end(), quickSaveName) == m_savedGames.end())
+        {
+            m_savedGames.push_back(quickSaveName);
+            m_menu->AddNewSavedGame(m_playerInput, quickSaveName);
+        }
     }
     else
     {
-        Logging::Instance().AddLogMessage("WARNING: Unable to open file " + filename.string());
+        Logging::Instance().AddLogMessage("WARNING: Unable to create path " + filenamePathForGame.string());
+    }
+
+    DisplayStatusMessage("QUICK SAVED", 1000);
+}
+
+void EngineCore::QuickLoad()
+{
+    if (!m_quickSaveSnapshot.empty())
+    {
+        if (RestoreSnapshot(m_quickSaveSnapshot))
+        {
+            m_rewindSnapshots.Clear();
+            DisplayStatusMessage("QUICK LOADED", 1000);
+        }
+    }
+    else if (std::find(m_savedGames.begin(), m_savedGames.end(), quickSaveName) != m_savedGames.end())
+    {
+        // Quick saved in an earlier session
+        LoadGameFromFile(quickSaveName);
+        StartMusicIfNeeded();
+    }
+}
+
+void EngineCore::Rewind()
+{
+    // Going back to a snapshot that was taken only just before is hardly noticeable, so go one snapshot further.
+    if (m_rewindSnapshots.GetSize() > 1 && m_timeStampOfPlayerCurrentFrame < m_timeStampOfLastRewindSnapshot + 1000u)
+    {
+        m_rewindSnapshots.Pop();
+    }
+
+    if (!m_rewindSnapshots.IsEmpty() && RestoreSnapshot(m_rewindSnapshots.GetNewest()))
+    {
+        m_timeStampOfLastRewindSnapshot = m_timeStampOfPlayerCurrentFrame;
+        DisplayStatusMessage("REWOUND", 1000);
     }
 }
 
@@ -3335,6 +3623,7 @@ void EngineCore::LoadDosGameFromFile(const std::string filename)
     {
         m_playerInventory.LoadFromDosGame(*savedGame);
         UnloadLevel();
+        m_rewindSnapshots.Clear();
         m_level = m_game.GetGameMaps()->GetLevelFromDosSavedGame(savedGame);
         m_level->LoadActorsFromDosSavedGame(*savedGame, m_game.GetSavedGameConverter(), m_game.GetDecorateActors());
         m_score.SetPoints(savedGame->GetScore());
@@ -3377,7 +3666,42 @@ void EngineCore::LoadDosGameFromFile(const std::string filename)
         m_timeStampOfWorldPreviousFrame = m_timeStampOfWorldCurrentFrame;
         m_timeStampOfWorldCurrentFrame = currentTimestampOfWorld;
         m_timeStampFadeEffect = 0;
+
+        WarmUpLevel();
+    }
+}
+
+void EngineCore::WarmUpLevel()
+{
+    PROFILE_SCOPE("WarmUpLevel");
+
+    // Explosions are spawned during play, and the player fires a larger projectile with a charged shot
+    std::vector<const DecorateActor*> spawnedActors = { &m_game.GetExplosionActor(), &m_game.GetExplodingWallActor() };
+    const auto bigShot = m_game.GetDecorateActors().find(m_level->GetPlayerActor()->GetDecorateActor().projectileId + 1);
+    if (bigShot != m_game.GetDecorateActors().end())
+    {
+        spawnedActors.push_back(&bigShot->second);
+    }
+
+    std::set<uint16_t> pictureIndices;
+    std::set<uint16_t> soundIndices;
+    m_level->GetPicturesAndSoundsInUse(m_game.GetDecorateActors(), spawnedActors, pictureIndices, soundIndices);
+
+    // The sounds are decoded while the pictures are
+    uint16_t soundsLoaded = 0;
+    AudioRepository* audioRepository = m_game.GetAudioRepository();
+    std::thread soundLoader([audioRepository, &soundIndices, &soundsLoaded]()
+    {
+        soundsLoaded = audioRepository->LoadSounds(soundIndices);
+    });
+    const uint16_t picturesLoaded = m_game.GetEgaGraph()->LoadPictures(pictureIndices);
+    soundLoader.join();
+
+    if (picturesLoaded > 0 || soundsLoaded > 0)
+    {
+        Logging::Instance().AddLogMessage("Loaded " + std::to_string(picturesLoaded) + " pictures and " + std::to_string(soundsLoaded) + " sounds for map " + std::to_string(m_level->GetLevelIndex()));
     }
+    m_levelWarmedUp = true;
 }
 
 uint8_t EngineCore::GetScreenMode() const
@@ -40,6 +40,9 @@
 #include "RenderableOverscanBorder.h"
 #include "RenderableLevelStatistics.h"
 #include "SavedGamesInDosFormat.h"
+#include "SavedGameChunks.h"
+#include "SnapshotRing.h"
+#include "AsyncFileWriter.h"
 #include <filesystem>
 
 class EngineCore
@@ -134,13 +137,27 @@ private:
     void StartNewGameWithDifficultySelection();
     void StartNewGame();
     void UnloadLevel();
-    bool StoreGameToFileWithFullPath(const std::filesystem::path filename) const;
+    void StoreGameToBuffer(std::vector<uint8_t>& data, const bool compress) const;
     bool StoreGameToFile(const std::string filename);
     void LoadGameFromFileWithFullPath(const std::filesystem::path filename);
+    bool LoadGameFromBuffer(const std::vector<uint8_t>& data);
+    bool LoadGameFromChunks(const SavedGameChunks& chunks);
+    // Saved games from before the chunks format
+    bool LoadGameFromStream(std::istream& stream);
+    void SetupLoadedGame();
     void LoadGameFromFile(const std::string filename);
     void LoadDosGameFromFile(const std::string filename);
     bool AreScrollsPresent() const;
     void StartMusicIfNeeded();
+    void WarmUpLevel();
+
+    // Snapshots of the game state in memory, in the same format as the saved games
+    void CaptureSnapshot(std::vector<uint8_t>& snapshot) const;
+    bool RestoreSnapshot(const std::vector<uint8_t>& snapshot);
+    void UpdateRewindSnapshots();
+    void QuickSave();
+    void QuickLoad();
+    void Rewind();
 
     IGame& m_game;
     ConfigurationSettings& m_configurationSettings;
@@ -197,4 +214,10 @@ private:
     LevelStatistics m_levelStatistics;
     RenderableLevelStatistics m_renderableLevelStatistics;
     SavedGamesInDosFormat m_savedGamesInDosFormat;
+    SnapshotRing m_rewindSnapshots;
+    std::vector<uint8_t> m_snapshot;
+    std::vector<uint8_t> m_quickSaveSnapshot;
+    uint32_t m_timeStampOfLastRewindSnapshot;
+    AsyncFileWriter m_savedGameWriter;
+    bool m_levelWarmedUp;
 };
@@ -17,8 +17,7 @@
 
 FadeEffect::FadeEffect() :
     m_picture(nullptr),
-    m_pixelsRemoved(64000),
-    m_rndval(0)
+    m_pixelsRemoved(64000)
 {
 
 }
@@ -34,7 +33,6 @@ void FadeEffect::SetOverlay(IRenderer& renderer)
     delete m_picture;
     m_picture = renderer.GetScreenCapture(textureId);
     m_pixelsRemoved = 0;
-    m_rndval = 0;
 }
 
 void FadeEffect::DrawOverlay(IRenderer& renderer, const uint32_t milliSec)
@@ -42,47 +40,53 @@ void FadeEffect::DrawOverlay(IRenderer& renderer, const uint32_t milliSec)
     const uint32_t totalDurationInMilliSec = 1000;
     if (milliSec <= totalDurationInMilliSec)
     {
-        // FizzleFade effect implementation based on Wolf4SDL source code, file ID_VH.CPP.
-        const uint32_t rndmask = 0x00012000;
-        const uint32_t rndbits_y = 8;
-        const uint32_t screenWidth = 320;
-        const uint32_t screenHeight = 200;
-
-        const uint32_t pixelsToRemove = (milliSec * screenWidth * screenHeight) / totalDurationInMilliSec;
-        std::vector < std::pair<int16_t, int16_t>> coordinates;
-        for (uint32_t p = m_pixelsRemoved; p < pixelsToRemove; p++)
+        const uint32_t pixelsToRemove = (milliSec * 320 * 200) / totalDurationInMilliSec;
+        if (pixelsToRemove > m_pixelsRemoved)
         {
-            // Seperate random value into x/y pair
-            const int32_t x = m_rndval >> rndbits_y;
-            const int32_t y = m_rndval & ((1 << rndbits_y) - 1);
-
-            // Advance to next random element
-            m_rndval = (m_rndval >> 1) ^ (m_rndval & 1 ? 0 : rndmask);
-
-            if (x >= screenWidth || y >= screenHeight)
-            {
-                if (m_rndval == 0)     // entire sequence has been completed
-                {
-                    break;
-                }
-                p--;
-                continue;
-            }
-            coordinates.push_back(std::make_pair(x, y));
-
-            if (m_rndval == 0)		// entire sequence has been completed
-            {
-                break;
-            }
+            m_pixelsRemoved = pixelsToRemove;
         }
-        m_pixelsRemoved = pixelsToRemove;
-        renderer.RemovePixelsFromScreenCapture(coordinates);
     }
 
-    renderer.RenderScreenCapture(m_picture);
+    renderer.RenderScreenCapture(m_picture, GetRevealTimes().data(), (uint16_t)m_pixelsRemoved);
 }
 
 bool FadeEffect::OverlayActive() const
 {
     return (m_pixelsRemoved > 0);
+}
+
+const std::vector<uint16_t>& FadeEffect::GetRevealTimes()
+{
+    static const std::vector<uint16_t> revealTimes = GenerateRevealTimes();
+    return revealTimes;
+}
+
+std::vector<uint16_t> FadeEffect::GenerateRevealTimes()
+{
+    // FizzleFade effect implementation based on Wolf4SDL source code, file ID_VH.CPP.
+    const uint32_t rndmask = 0x00012000;
+    const uint32_t rndbits_y = 8;
+    const uint32_t screenWidth = 320;
+    const uint32_t screenHeight = 200;
+
+    std::vector<uint16_t> revealTimes(screenWidth * screenHeight, 0xFFFF);
+    uint16_t revealTime = 0;
+    int32_t rndval = 0;
+    do
+    {
+        // Seperate random value into x/y pair
+        const int32_t x = rndval >> rndbits_y;
+        const int32_t y = rndval & ((1 << rndbits_y) - 1);
+
+        // Advance to next random element
+        rndval = (rndval >> 1) ^ (rndval & 1 ? 0 : rndmask);
+
+        if (x < screenWidth && y < screenHeight)
+        {
+            revealTimes[(y * screenWidth) + x] = revealTime;
+            revealTime++;
+        }
+    } while (rndval != 0);   // entire sequence has been completed
+
+    return revealTimes;
 }
\ No newline at end of file
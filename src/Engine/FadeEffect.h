@@ -15,6 +15,7 @@
 #pragma once
 
 #include "IRenderer.h"
+#include <vector>
 
 class FadeEffect
 {
@@ -26,9 +27,15 @@ public:
     void DrawOverlay(IRenderer& renderer, const uint32_t milliSec);
     bool OverlayActive() const;
 
+    // Returns for each of the 320 x 200 pixels the moment at which it is removed, expressed as the
+    // number of pixels that were removed before it. Pixels that are never removed get the value 0xFFFF.
+    static const std::vector<uint16_t>& GetRevealTimes();
+
     Picture* m_picture;
     uint32_t m_pixelsRemoved;
-    int32_t  m_rndval;
+
+private:
+    static std::vector<uint16_t> GenerateRevealTimes();
 };
 
 
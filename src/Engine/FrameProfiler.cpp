@@ -0,0 +1,258 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "FrameProfiler.h"
+#include "DefaultFont.h"
+#include "Logging.h"
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+// Used for markers that did not fit in the frame
+static const uint16_t markerNotRecorded = 0xFFFF;
+
+static std::string MicrosecondsToMilliseconds(const uint32_t microseconds)
+{
+    std::ostringstream stream;
+    stream << std::fixed << std::setprecision(2) << (float)microseconds / 1000.0f << " ms";
+    return stream.str();
+}
+
+FrameProfiler::FrameProfiler() :
+    m_frames(MaxFrames),
+    m_currentFrame(0),
+    m_numberOfFrames(0),
+    m_recording(false),
+    m_depth(0),
+    m_startTime(std::chrono::steady_clock::now()),
+    m_traceFileName("")
+{
+
+}
+
+FrameProfiler::~FrameProfiler()
+{
+
+}
+
+FrameProfiler& FrameProfiler::Instance()
+{
+    static FrameProfiler instance;
+    return instance;
+}
+
+void FrameProfiler::BeginFrame()
+{
+    const uint64_t timestamp = GetTimeInMicroseconds();
+    if (m_recording)
+    {
+        Frame& frame = m_frames[m_currentFrame];
+        frame.durationInMicroseconds = (uint32_t)(timestamp - frame.startInMicroseconds);
+        m_currentFrame = (m_currentFrame + 1) % MaxFrames;
+        if (m_numberOfFrames < MaxFrames)
+        {
+            m_numberOfFrames++;
+        }
+    }
+
+    Frame& frame = m_frames[m_currentFrame];
+    frame.startInMicroseconds = timestamp;
+    frame.durationInMicroseconds = 0;
+    frame.numberOfMarkers = 0;
+    m_depth = 0;
+    m_recording = true;
+}
+
+void FrameProfiler::BeginScope(const char* name)
+{
+    if (!m_recording)
+    {
+        return;
+    }
+
+    Frame& frame = m_frames[m_currentFrame];
+    const bool fits = (m_depth < MaxDepth) && (frame.numberOfMarkers < MaxMarkersPerFrame);
+    if (m_depth < MaxDepth)
+    {
+        m_openMarkers[m_depth] = fits ? frame.numberOfMarkers : markerNotRecorded;
+    }
+    if (fits)
+    {
+        Marker& marker = frame.markers[frame.numberOfMarkers];
+        marker.name = name;
+        marker.depth = m_depth;
+        marker.startInMicroseconds = (uint32_t)(GetTimeInMicroseconds() - frame.startInMicroseconds);
+        marker.durationInMicroseconds = 0;
+        frame.numberOfMarkers++;
+    }
+    m_depth++;
+}
+
+void FrameProfiler::EndScope()
+{
+    if (!m_recording || m_depth == 0)
+    {
+        return;
+    }
+
+    m_depth--;
+    if (m_depth < MaxDepth && m_openMarkers[m_depth] != markerNotRecorded)
+    {
+        Frame& frame = m_frames[m_currentFrame];
+        Marker& marker = frame.markers[m_openMarkers[m_depth]];
+        marker.durationInMicroseconds = (uint32_t)(GetTimeInMicroseconds() - frame.startInMicroseconds) - marker.startInMicroseconds;
+    }
+}
+
+void FrameProfiler::Reset()
+{
+    m_currentFrame = 0;
+    m_numberOfFrames = 0;
+    m_recording = false;
+    m_depth = 0;
+}
+
+uint16_t FrameProfiler::GetNumberOfFrames() const
+{
+    return m_numberOfFrames;
+}
+
+const FrameProfiler::Frame& FrameProfiler::GetFrame(const uint16_t age) const
+{
+    return m_frames[(m_currentFrame + MaxFrames - 1 - age) % MaxFrames];
+}
+
+std::string FrameProfiler::GetChromeTrace() const
+{
+    // Complete events ("ph":"X") with timestamps and durations in microseconds
+    std::ostringstream trace;
+    trace << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    for (int32_t age = m_numberOfFrames - 1; age >= 0; age--)
+    {
+        const Frame& frame = GetFrame((uint16_t)age);
+        trace << (first ? "" : ",") << "\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame.startInMicroseconds << ",\"dur\":" << frame.durationInMicroseconds << "}";
+        first = false;
+        for (uint16_t i = 0; i < frame.numberOfMarkers; i++)
+        {
+            const Marker& marker = frame.markers[i];
+            trace << ",\n{\"name\":\"" << marker.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frame.startInMicroseconds + marker.startInMicroseconds << ",\"dur\":" << marker.durationInMicroseconds << "}";
+        }
+    }
+    trace << "\n]}\n";
+    return trace.str();
+}
+
+void FrameProfiler::SetTraceFile(const fs::path traceFileName)
+{
+    m_traceFileName = traceFileName;
+}
+
+bool FrameProfiler::WriteTraceFile() const
+{
+    std::ofstream file;
+    file.open(m_traceFileName, std::ofstream::out | std::ofstream::trunc);
+    if (!file.is_open())
+    {
+        Logging::Instance().AddLogMessage("WARNING: Unable to write frame profile to " + m_traceFileName.string());
+        return false;
+    }
+
+    file << GetChromeTrace();
+    file.close();
+    Logging::Instance().AddLogMessage("Frame profile of " + std::to_string(m_numberOfFrames) + " frames written to " + m_traceFileName.string());
+    return true;
+}
+
+void FrameProfiler::Draw(IRenderer& renderer) const
+{
+    const uint16_t framesShown = (m_numberOfFrames < 128) ? m_numberOfFrames : 128;
+    if (framesShown == 0)
+    {
+        return;
+    }
+
+    // Average duration per marker over the frames shown, in order of first appearance
+    typedef struct
+    {
+        const char* name;
+        uint8_t depth;
+        uint64_t totalDuration;
+    } MarkerSummary;
+    std::vector<MarkerSummary> summaries;
+    uint64_t totalFrameDuration = 0;
+    uint32_t maxFrameDuration = 0;
+    for (uint16_t age = 0; age < framesShown; age++)
+    {
+        const Frame& frame = GetFrame(framesShown - 1 - age);
+        totalFrameDuration += frame.durationInMicroseconds;
+        maxFrameDuration = (frame.durationInMicroseconds > maxFrameDuration) ? frame.durationInMicroseconds : maxFrameDuration;
+        for (uint16_t i = 0; i < frame.numberOfMarkers; i++)
+        {
+            const Marker& marker = frame.markers[i];
+            auto summary = summaries.begin();
+            while (summary != summaries.end() && !(summary->name == marker.name && summary->depth == marker.depth))
+            {
+                summary++;
+            }
+            if (summary == summaries.end())
+            {
+                summaries.push_back({ marker.name, marker.depth, marker.durationInMicroseconds });
+            }
+            else
+            {
+                summary->totalDuration += marker.durationInMicroseconds;
+            }
+        }
+    }
+
+    const int16_t left = 372;
+    const int16_t top = 40;
+    const uint16_t width = 264;
+    const uint16_t height = 156;
+    const uint16_t graphHeight = 34;
+    const uint16_t maxTextLines = (height - graphHeight - 8) / 8;
+    renderer.Prepare2DRendering(true);
+    renderer.Render2DBar(left, top, width, height, EgaBlack);
+
+    RenderableText renderableText(*DefaultFont::Get(renderer, 7));
+    renderableText.LeftAligned("Frame avg " + MicrosecondsToMilliseconds((uint32_t)(totalFrameDuration / framesShown)) + ", max " + MicrosecondsToMilliseconds(maxFrameDuration), EgaBrightWhite, left + 4, top + 4);
+    for (uint16_t i = 0; i < summaries.size() && i + 1 < maxTextLines; i++)
+    {
+        const int16_t offsetY = top + 4 + ((i + 1) * 8);
+        renderableText.LeftAlignedTruncated(summaries.at(i).name, EgaLightGray, left + 4 + (summaries.at(i).depth * 8), offsetY, 170 - (summaries.at(i).depth * 8));
+        renderableText.LeftAligned(MicrosecondsToMilliseconds((uint32_t)(summaries.at(i).totalDuration / framesShown)), EgaLightGray, left + 190, offsetY);
+    }
+    renderer.RenderText(renderableText);
+
+    // One bar per frame, one pixel per millisecond, with a line at the duration of a frame at 60 Hz
+    const int16_t graphBottom = top + height - 4;
+    renderer.Render2DBar(left + 4, graphBottom - 17, 256, 1, EgaDarkGray);
+    for (uint16_t age = 0; age < framesShown; age++)
+    {
+        const uint32_t duration = GetFrame(age).durationInMicroseconds;
+        const uint16_t barHeight = (duration / 1000 >= graphHeight) ? graphHeight : (uint16_t)(duration / 1000) + 1;
+        const egaColor color = (duration < 17000) ? EgaBrightGreen : (duration < 34000) ? EgaBrightYellow : EgaBrightRed;
+        renderer.Render2DBar(left + 4 + 254 - (age * 2), graphBottom - barHeight, 2, barHeight, color);
+    }
+    renderer.Unprepare2DRendering();
+}
+
+uint64_t FrameProfiler::GetTimeInMicroseconds() const
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_startTime).count();
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// FrameProfiler
+//
+// Measures how long the parts of a frame take, with scoped markers that can be nested. The markers of the most
+// recent frames are kept in a ring buffer, which can be shown as an overlay graph and written to a trace file in the
+// Chrome trace event format, to be opened in chrome://tracing or Perfetto.
+// The markers in the engine are only compiled in when FRAMEPROFILER is defined.
+//
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "IRenderer.h"
+
+class FrameProfiler
+{
+public:
+    static const uint16_t MaxFrames = 256;
+    static const uint16_t MaxMarkersPerFrame = 128;
+    static const uint8_t MaxDepth = 16;
+
+    typedef struct
+    {
+        const char* name;
+        uint8_t depth;
+        uint32_t startInMicroseconds; // Relative to the start of the frame
+        uint32_t durationInMicroseconds;
+    } Marker;
+
+    typedef struct
+    {
+        uint64_t startInMicroseconds;
+        uint32_t durationInMicroseconds;
+        uint16_t numberOfMarkers;
+        Marker markers[MaxMarkersPerFrame];
+    } Frame;
+
+    FrameProfiler();
+    ~FrameProfiler();
+
+    static FrameProfiler& Instance();
+
+    // Completes the frame that is being recorded, if any, and starts recording the next one.
+    void BeginFrame();
+    void BeginScope(const char* name);
+    void EndScope();
+    void Reset();
+
+    uint16_t GetNumberOfFrames() const;
+    // Completed frames, where age 0 is the most recent one.
+    const Frame& GetFrame(const uint16_t age) const;
+
+    std::string GetChromeTrace() const;
+    void SetTraceFile(const std::filesystem::path traceFileName);
+    bool WriteTraceFile() const;
+
+    void Draw(IRenderer& renderer) const;
+
+private:
+    uint64_t GetTimeInMicroseconds() const;
+
+    std::vector<Frame> m_frames;
+    uint16_t m_currentFrame;
+    uint16_t m_numberOfFrames;
+    bool m_recording;
+    uint16_t m_openMarkers[MaxDepth];
+    uint8_t m_depth;
+    std::chrono::steady_clock::time_point m_startTime;
+    std::filesystem::path m_traceFileName;
+};
+
+class FrameProfilerScope
+{
+public:
+    FrameProfilerScope(const char* name)
+    {
+        FrameProfiler::Instance().BeginScope(name);
+    }
+
+    ~FrameProfilerScope()
+    {
+        FrameProfiler::Instance().EndScope();
+    }
+};
+
+#ifdef FRAMEPROFILER
+#define PROFILE_FRAME() FrameProfiler::Instance().BeginFrame()
+#define PROFILE_SCOPE(name) const FrameProfilerScope frameProfilerScope(name)
+#else
+#define PROFILE_FRAME()
+#define PROFILE_SCOPE(name)
+#endif
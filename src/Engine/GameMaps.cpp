@@ -15,6 +15,7 @@
 
 #include "GameMaps.h"
 #include <fstream>
+#include <algorithm>
 #include "Decompressor.h"
 #include "SavedGameInDosFormat.h"
 
@@ -95,39 +96,34 @@ Level* GameMaps::GetLevelFromStart(const uint8_t mapIndex) const
         Logging::Instance().FatalError("Map height (" + std::to_string(mapHeight) + ") too large for level " + std::to_string(mapIndex) + " in " + m_staticData.filename);
     }
 
-    uint8_t* plane0Source = &(m_rawData->GetChunk()[plane0Offset]);
-    FileChunk* carmackExpandedChunk = Decompressor::CarmackExpand(plane0Source);
-    FileChunk* decompressedPlane0 = Decompressor::RLEW_Decompress(carmackExpandedChunk->GetChunk(), rlewTag);
+    // The planes are expanded straight into the storage of the level
+    const uint32_t mapSize = (uint32_t)mapWidth * (uint32_t)mapHeight;
+    uint16_t* plane0 = new uint16_t[mapSize];
+    uint16_t* plane2 = new uint16_t[mapSize];
+    std::vector<uint16_t> carmackHistory;
 
-    if ((decompressedPlane0->GetSize() / sizeof(uint16_t)) < (uint32_t)mapWidth * (uint32_t)mapHeight)
+    const uint8_t* plane0Source = &(m_rawData->GetChunk()[plane0Offset]);
+    if (!Decompressor::CarmackRLEWExpand(plane0Source, plane0Length, rlewTag, carmackHistory, plane0, mapSize))
     {
         Logging::Instance().FatalError("Plane 0 of level " + std::to_string(mapIndex) + " in " + m_staticData.filename +
-            " is " + std::to_string(decompressedPlane0->GetSize()) + " bytes in size, which is too small for a level with a width of " +
+            " is corrupt or too small for a level with a width of " +
             std::to_string(mapWidth) + " and a height of " + std::to_string(mapHeight));
     }
 
-    uint8_t* plane2Source = &(m_rawData->GetChunk()[plane2Offset]);
-    FileChunk* carmackExpandedChunk2 = Decompressor::CarmackExpand(plane2Source);
-    FileChunk* decompressedPlane2 = Decompressor::RLEW_Decompress(carmackExpandedChunk2->GetChunk(), rlewTag);
-
-    if ((decompressedPlane2->GetSize() / sizeof(uint16_t)) < (uint32_t)mapWidth * (uint32_t)mapHeight)
+    const uint8_t* plane2Source = &(m_rawData->GetChunk()[plane2Offset]);
+    if (!Decompressor::CarmackRLEWExpand(plane2Source, plane2Length, rlewTag, carmackHistory, plane2, mapSize))
     {
         Logging::Instance().FatalError("Plane 2 of level " + std::to_string(mapIndex) + " in " + m_staticData.filename +
-            " is " + std::to_string(decompressedPlane2->GetSize()) + " bytes in size, which is too small for a level with a width of " +
+            " is corrupt or too small for a level with a width of " +
             std::to_string(mapWidth) + " and a height of " + std::to_string(mapHeight));
     }
 
-    Level* level = new Level(mapIndex, mapWidth, mapHeight, (uint16_t*)(decompressedPlane0->GetChunk()), (uint16_t*)(decompressedPlane2->GetChunk()), m_staticData.mapsInfo.at(mapIndex), m_staticData.wallsInfo);
-
-    delete carmackExpandedChunk;
-    delete decompressedPlane0;
-    delete carmackExpandedChunk2;
-    delete decompressedPlane2;
+    Level* level = new Level(mapIndex, mapWidth, mapHeight, plane0, plane2, m_staticData.mapsInfo.at(mapIndex), m_staticData.wallsInfo);
 
     return level;
 }
 
-Level* GameMaps::GetLevelFromSavedGame(std::ifstream& file) const
+Level* GameMaps::GetLevelFromSavedGame(std::istream& file) const
 {
     uint8_t mapIndex = 0;
     file.read((char*)&mapIndex, sizeof(mapIndex));
@@ -187,8 +183,6 @@ Level* GameMaps::GetLevelFromSavedGame(std::ifstream& file) const
     }
 
     Level* level = new Level(mapIndex, mapWidth, mapHeight, plane0, plane2, m_staticData.mapsInfo.at(mapIndex), m_staticData.wallsInfo);
-    delete[] plane0;
-    delete[] plane2;
 
     return level;
 }
@@ -204,8 +198,11 @@ Level* GameMaps::GetLevelFromDosSavedGame(const SavedGameInDosFormat* savedGameI
     const uint16_t mapWidth = *(uint16_t*)(&(headerStart[18]));
     const uint16_t mapHeight = *(uint16_t*)(&(headerStart[20]));
 
-    const uint16_t* plane0 = (const uint16_t*)savedGameInDosFormat->GetPlane0()->GetChunk();
-    const uint16_t* plane2 = (const uint16_t*)savedGameInDosFormat->GetPlane2()->GetChunk();
+    const uint32_t mapSize = (uint32_t)mapWidth * (uint32_t)mapHeight;
+    uint16_t* plane0 = new uint16_t[mapSize];
+    uint16_t* plane2 = new uint16_t[mapSize];
+    std::copy_n((const uint16_t*)savedGameInDosFormat->GetPlane0()->GetChunk(), mapSize, plane0);
+    std::copy_n((const uint16_t*)savedGameInDosFormat->GetPlane2()->GetChunk(), mapSize, plane2);
 
     Level* level = new Level(mapIndex, mapWidth, mapHeight, plane0, plane2, m_staticData.mapsInfo.at(mapIndex), m_staticData.wallsInfo);
 
@@ -243,3 +240,8 @@ uint16_t GameMaps::GetTileWallExplosion(const bool isWaterLevel) const
 {
     return isWaterLevel ? m_staticData.tileWaterExplosion : m_staticData.tileWallExplosion;
 }
+
+const gameMapsStaticData& GameMaps::GetStaticData() const
+{
+    return m_staticData;
+}
@@ -50,10 +50,11 @@ public:
     ~GameMaps();
 
     Level* GetLevelFromStart(const uint8_t mapIndex) const;
-    Level* GetLevelFromSavedGame(std::ifstream& file) const;
+    Level* GetLevelFromSavedGame(std::istream& file) const;
     Level* GetLevelFromDosSavedGame(const SavedGameInDosFormat* savedGameInDosFormat) const;
     uint8_t GetNumberOfLevels() const;
     uint16_t GetTileWallExplosion(const bool isWaterLevel) const;
+    const gameMapsStaticData& GetStaticData() const;
 
 private:
     uint32_t GetChunkSize(const uint16_t index);
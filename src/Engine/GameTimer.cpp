@@ -17,6 +17,9 @@
 #include <SDL_timer.h>
 #include <fstream>
 
+bool GameTimer::m_steppedClockEnabled = false;
+uint32_t GameTimer::m_steppedClockTime = 0;
+
 GameTimer::GameTimer()
 {
     m_paused = true;
@@ -116,7 +119,18 @@ void GameTimer::FreezeTime()
 
 uint32_t GameTimer::GetCurrentTime()
 {
-    return SDL_GetTicks();
+    return m_steppedClockEnabled ? m_steppedClockTime : SDL_GetTicks();
+}
+
+void GameTimer::SetSteppedClock(const bool enabled)
+{
+    m_steppedClockEnabled = enabled;
+    m_steppedClockTime = 0;
+}
+
+void GameTimer::AdvanceSteppedClock(const uint32_t milliseconds)
+{
+    m_steppedClockTime += milliseconds;
 }
 
 uint32_t GameTimer::GetRemainingFreezeTime()
@@ -142,7 +156,7 @@ uint32_t GameTimer::GetActualTime()
     return GetCurrentTime();
 }
 
-void GameTimer::StoreToFile(std::ofstream& file) const
+void GameTimer::StoreToFile(std::ostream& file) const
 {
     const uint32_t playerTime = GetMillisecondsForPlayer();
     file.write((const char*)&playerTime, sizeof(playerTime));
@@ -150,7 +164,7 @@ void GameTimer::StoreToFile(std::ofstream& file) const
     file.write((const char*)&m_totalFrozenTime, sizeof(m_totalFrozenTime));
 }
 
-bool GameTimer::LoadFromFile(std::ifstream& file)
+bool GameTimer::LoadFromFile(std::istream& file)
 {
     uint32_t playerTime = 0;
     file.read((char*)&playerTime, sizeof(playerTime));
@@ -42,8 +42,13 @@ public:
     void FreezeTime();
     uint32_t GetRemainingFreezeTime();
 
-    void StoreToFile(std::ofstream& file) const;
-    bool LoadFromFile(std::ifstream& file);
+    void StoreToFile(std::ostream& file) const;
+    bool LoadFromFile(std::istream& file);
+
+    // With a stepped clock, time only advances via AdvanceSteppedClock(), such that a replayed
+    // input script results in the same frames on every run.
+    static void SetSteppedClock(const bool enabled);
+    static void AdvanceSteppedClock(const uint32_t milliseconds);
 
 private:
     static uint32_t GetCurrentTime();
@@ -54,4 +59,7 @@ private:
     uint32_t m_freezeStartTime;
     uint32_t m_totalFrozenTime;
     bool m_paused;
+
+    static bool m_steppedClockEnabled;
+    static uint32_t m_steppedClockTime;
 };
@@ -29,26 +29,46 @@ Huffman::~Huffman()
 
 }
 
-FileChunk* Huffman::Decompress(unsigned char* compressedChunk, const unsigned long compressedSize, const unsigned long decompressedSize)
+FileChunk* Huffman::Decompress(unsigned char* compressedChunk, const unsigned long compressedSize, const unsigned long decompressedSize) const
 {
     FileChunk* fileChunk = new FileChunk(decompressedSize);
 
-    unsigned char* decompressedChunk = fileChunk->GetChunk();
-    unsigned char huffindex = 254;
-    unsigned long byteIndex = 0;
+    huffmanStreamState state;
+    ResetStreamState(state);
+    DecompressStream(compressedChunk, compressedSize, state, fileChunk->GetChunk(), decompressedSize);
+
+    return fileChunk;
+}
+
+void Huffman::ResetStreamState(huffmanStreamState& state)
+{
+    state.byteIndex = 0;
+    state.bitIndex = 0;
+    state.nodeIndex = 254;
+}
+
+unsigned long Huffman::DecompressStream(
+    const unsigned char* compressedChunk,
+    const unsigned long compressedSize,
+    huffmanStreamState& state,
+    unsigned char* destination,
+    const unsigned long destinationSize) const
+{
+    unsigned short huffindex = state.nodeIndex;
+    unsigned long byteIndex = state.byteIndex;
+    unsigned short bitIndex = state.bitIndex;
     unsigned long destIndex = 0;
 
-    while (byteIndex < compressedSize && destIndex < decompressedSize)
+    while (byteIndex < compressedSize && destIndex < destinationSize)
     {
         unsigned char value = compressedChunk[byteIndex];
 
-        unsigned short bitIndex = 0;
-        while (bitIndex < 8 && destIndex < decompressedSize)
+        while (bitIndex < 8 && destIndex < destinationSize)
         {
             unsigned short huffValue = (value & (1 << bitIndex)) ? m_table[huffindex].bit1 : m_table[huffindex].bit0;
             if (huffValue < 256)
             {
-                decompressedChunk[destIndex] = (unsigned char)huffValue;
+                destination[destIndex] = (unsigned char)huffValue;
                 destIndex++;
                 huffindex = 254;
             }
@@ -59,8 +79,17 @@ FileChunk* Huffman::Decompress(unsigned char* compressedChunk, const unsigned lo
 
             bitIndex++;
         }
-        byteIndex++;
+
+        if (bitIndex == 8)
+        {
+            bitIndex = 0;
+            byteIndex++;
+        }
     }
 
-    return fileChunk;
-}
\ No newline at end of file
+    state.nodeIndex = huffindex;
+    state.byteIndex = byteIndex;
+    state.bitIndex = bitIndex;
+
+    return destIndex;
+}
@@ -29,13 +29,31 @@ typedef struct huffmanNode
 
 typedef huffmanNode huffmanTable[256];
 
+typedef struct huffmanStreamState
+{
+    unsigned long byteIndex;
+    unsigned short bitIndex;
+    unsigned short nodeIndex;
+} huffmanStreamState;
+
 class Huffman
 {
 public:
     Huffman(const huffmanTable table);
     ~Huffman();
 
-    FileChunk* Decompress(unsigned char* compressedChunk, const unsigned long compressedSize, const unsigned long decompressedSize);
+    FileChunk* Decompress(unsigned char* compressedChunk, const unsigned long compressedSize, const unsigned long decompressedSize) const;
+
+    // Incremental decompression: decodes at most destinationSize bytes, continuing where the previous call with the
+    // same state left off. Returns the number of bytes written, which is less than destinationSize only when the
+    // compressed data is exhausted.
+    static void ResetStreamState(huffmanStreamState& state);
+    unsigned long DecompressStream(
+        const unsigned char* compressedChunk,
+        const unsigned long compressedSize,
+        huffmanStreamState& state,
+        unsigned char* destination,
+        const unsigned long destinationSize) const;
 
 private:
     huffmanTable m_table;
@@ -0,0 +1,31 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// IPictureSource
+//
+// Interface for the owner of pictures whose texture can be unloaded while the picture itself stays available.
+//
+#pragma once
+
+#include <stdint.h>
+
+class IPictureSource
+{
+public:
+    virtual ~IPictureSource() {};
+    // Returns the texture of the picture with the given index, which is loaded again if it was unloaded.
+    virtual unsigned int GetPictureTextureId(const uint16_t index) = 0;
+};
@@ -50,8 +50,34 @@ public:
     {
         TextureFilterSetting textureFilter;
         bool vSyncEnabled;
+        // Only applies to textures that are loaded afterwards.
+        bool palettizedTextures;
     } FrameSettings;
 
+    // Render passes of which the GPU time is measured. Passes that are rendered as part of another pass, like the text
+    // of the automap, are accounted to the outer pass.
+    enum RenderPass
+    {
+        RenderPass3DTiles,
+        RenderPass3DWalls,
+        RenderPassSprites,
+        RenderPassText,
+        RenderPassTiles,
+        RenderPassAutoMapTopDown,
+        RenderPassAutoMapIso,
+        RenderPassCount
+    };
+
+    typedef struct
+    {
+        uint32_t textureBinds;
+        uint32_t drawBatches;
+        uint32_t vertices;
+        // GPU times are only available when GPU timing is enabled and supported, and lag a few frames behind.
+        bool gpuTimesAvailable;
+        float gpuTimeInMilliseconds[RenderPassCount];
+    } RenderStatistics;
+
     virtual ~IRenderer() {};
 
     //
@@ -68,6 +94,11 @@ public:
     //
     virtual unsigned int GenerateTextureId() const = 0;
     virtual void LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const = 0;
+    // Loads palettized pixel data, with one byte per pixel as described in EgaColor.h. With palettized textures enabled
+    // and supported, the texture keeps the indices and the colors are looked up while rendering; otherwise the pixel
+    // data is expanded to RGBA.
+    virtual void LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const = 0;
+    virtual void DeleteTexture(const unsigned int textureId) const = 0;
 
     //
     // 2D rendering
@@ -92,8 +123,9 @@ public:
     // Screen capture
     //
     virtual Picture* GetScreenCapture(const unsigned int textureId) = 0;
-    virtual void RemovePixelsFromScreenCapture(const std::vector<std::pair<int16_t, int16_t>>& coordinates) = 0;
-    virtual void RenderScreenCapture(Picture* screenCapture) = 0;
+    // Renders the screen capture, except for the pixels of which the reveal time is lower than the revealed time.
+    // The reveal times are a map of 320 x 200 pixels, which is repeated horizontally on wide screens.
+    virtual void RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime) = 0;
 
     //
     // Capabilities
@@ -103,4 +135,15 @@ public:
     virtual const std::string& GetGraphicsAdapterModel() const = 0;
     virtual bool IsVSyncSupported() = 0;
     virtual bool IsOriginalScreenResolutionSupported() = 0;
+    // Whether the screen capture is copied into a texture on the GPU, instead of being read back by the CPU.
+    virtual bool IsScreenCaptureOnGpuSupported() = 0;
+
+    //
+    // Statistics
+    //
+    virtual void SetGpuTimingEnabled(const bool enabled) = 0;
+    // Closes the statistics of the current frame. To be called once per frame, before the window is swapped.
+    virtual void EndFrameStatistics() = 0;
+    // Statistics of the last completed frame.
+    virtual const RenderStatistics& GetRenderStatistics() const = 0;
 };
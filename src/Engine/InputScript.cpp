@@ -0,0 +1,189 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "InputScript.h"
+#include "PlayerInput.h"
+#include <SDL_keyboard.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+InputScript::InputScript() :
+    m_lastFrame(0)
+{
+
+}
+
+InputScript::~InputScript()
+{
+
+}
+
+bool InputScript::Parse(const std::string& script, std::string& errorMessage)
+{
+    m_commands.clear();
+    m_lastFrame = 0;
+    bool quitFound = false;
+
+    std::istringstream lines(script);
+    std::string line;
+    uint32_t lineNumber = 0;
+    while (std::getline(lines, line))
+    {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+
+        std::istringstream words(line);
+        std::string frameString;
+        if (!(words >> frameString) || frameString.at(0) == '#')
+        {
+            continue;
+        }
+
+        const std::string linePrefix = "Line " + std::to_string(lineNumber) + ": ";
+        if (frameString.find_first_not_of("0123456789") != std::string::npos || frameString.size() > 9)
+        {
+            errorMessage = linePrefix + "invalid frame number " + frameString;
+            return false;
+        }
+
+        command newCommand = { (uint32_t)std::stoul(frameString), Press, SDLK_UNKNOWN, 0, 0 };
+        std::string commandName;
+        words >> commandName;
+        std::string argument;
+        std::getline(words >> std::ws, argument);
+
+        if (commandName == "press" || commandName == "release" || commandName == "tap")
+        {
+            newCommand.key = SDL_GetKeyFromName(argument.c_str());
+            if (newCommand.key == SDLK_UNKNOWN)
+            {
+                errorMessage = linePrefix + "unknown key '" + argument + "'";
+                return false;
+            }
+            newCommand.type = (commandName == "release") ? Release : Press;
+            m_commands.push_back(newCommand);
+            if (commandName == "tap")
+            {
+                newCommand.frameNumber++;
+                newCommand.type = Release;
+                m_commands.push_back(newCommand);
+            }
+        }
+        else if (commandName == "mouse")
+        {
+            std::istringstream motion(argument);
+            if (!(motion >> newCommand.mouseX >> newCommand.mouseY))
+            {
+                errorMessage = linePrefix + "expected the mouse motion as <dx> <dy>";
+                return false;
+            }
+            newCommand.type = MouseMotion;
+            m_commands.push_back(newCommand);
+        }
+        else if (commandName == "capture")
+        {
+            newCommand.type = Capture;
+            m_commands.push_back(newCommand);
+        }
+        else if (commandName == "quit")
+        {
+            if (!quitFound || newCommand.frameNumber < m_lastFrame)
+            {
+                m_lastFrame = newCommand.frameNumber;
+            }
+            quitFound = true;
+        }
+        else
+        {
+            errorMessage = linePrefix + "unknown command '" + commandName + "'";
+            return false;
+        }
+    }
+
+    // Commands of the same frame are applied in the order of the script
+    std::stable_sort(m_commands.begin(), m_commands.end(), [](const command& a, const command& b) { return a.frameNumber < b.frameNumber; });
+
+    if (!quitFound && !m_commands.empty())
+    {
+        m_lastFrame = m_commands.back().frameNumber;
+    }
+
+    return true;
+}
+
+bool InputScript::LoadFromFile(const std::filesystem::path& filename, std::string& errorMessage)
+{
+    std::ifstream file(filename);
+    if (!file.is_open())
+    {
+        errorMessage = "Unable to open input script " + filename.string();
+        return false;
+    }
+
+    std::stringstream script;
+    script << file.rdbuf();
+    if (!Parse(script.str(), errorMessage))
+    {
+        errorMessage = filename.filename().string() + ": " + errorMessage;
+        return false;
+    }
+
+    return true;
+}
+
+void InputScript::ApplyToInput(const uint32_t frameNumber, PlayerInput& input) const
+{
+    input.SetHasFocus(true);
+    input.SetMouseXPos(0);
+    input.SetMouseYPos(0);
+
+    auto it = std::lower_bound(m_commands.begin(), m_commands.end(), frameNumber, [](const command& c, const uint32_t frame) { return c.frameNumber < frame; });
+    while (it != m_commands.end() && it->frameNumber == frameNumber)
+    {
+        if (it->type == Press || it->type == Release)
+        {
+            input.SetKeyPressed(it->key, it->type == Press);
+        }
+        else if (it->type == MouseMotion)
+        {
+            input.SetMouseXPos(input.GetMouseXPos() + it->mouseX);
+            input.SetMouseYPos(input.GetMouseYPos() + it->mouseY);
+        }
+        it++;
+    }
+}
+
+bool InputScript::IsCaptureFrame(const uint32_t frameNumber) const
+{
+    auto it = std::lower_bound(m_commands.begin(), m_commands.end(), frameNumber, [](const command& c, const uint32_t frame) { return c.frameNumber < frame; });
+    while (it != m_commands.end() && it->frameNumber == frameNumber)
+    {
+        if (it->type == Capture)
+        {
+            return true;
+        }
+        it++;
+    }
+    return false;
+}
+
+uint32_t InputScript::GetLastFrame() const
+{
+    return m_lastFrame;
+}
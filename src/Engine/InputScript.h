@@ -0,0 +1,74 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// InputScript
+//
+// Keyboard and mouse input for the frames of an offscreen run, read from a text file. Each line holds a frame number
+// and a command:
+//   <frame> press <key>      The key is held down from this frame on. Keys are given by their SDL names.
+//   <frame> release <key>    The key is released in this frame.
+//   <frame> tap <key>        The key is pressed in this frame and released in the next frame.
+//   <frame> mouse <dx> <dy>  Relative mouse motion in this frame.
+//   <frame> capture          The rendered frame is stored as an image.
+//   <frame> quit             The run ends after this frame.
+// Empty lines and lines that start with # are ignored.
+//
+#pragma once
+
+#include <SDL_keycode.h>
+#include <filesystem>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class PlayerInput;
+
+class InputScript
+{
+public:
+    InputScript();
+    ~InputScript();
+
+    bool Parse(const std::string& script, std::string& errorMessage);
+    bool LoadFromFile(const std::filesystem::path& filename, std::string& errorMessage);
+
+    void ApplyToInput(const uint32_t frameNumber, PlayerInput& input) const;
+    bool IsCaptureFrame(const uint32_t frameNumber) const;
+    // Without a quit command, the run ends after the frame of the last command.
+    uint32_t GetLastFrame() const;
+
+private:
+    enum commandType
+    {
+        Press,
+        Release,
+        MouseMotion,
+        Capture,
+        Quit
+    };
+
+    struct command
+    {
+        uint32_t frameNumber;
+        commandType type;
+        SDL_Keycode key;
+        int32_t mouseX;
+        int32_t mouseY;
+    };
+
+    std::vector<command> m_commands;
+    uint32_t m_lastFrame;
+};
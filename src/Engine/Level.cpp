@@ -15,6 +15,7 @@
 
 #include "Level.h"
 #include "EgaGraph.h"
+#include "FrameProfiler.h"
 #include "LevelLocationNames.h"
 #include "Logging.h"
 #include "PlayerInventory.h"
@@ -28,16 +29,21 @@
 #include <cmath>
 #include <cstddef>
 
+// Each level, and each full rebuild of its automap, gets a unique automap geometry ID.
+static uint32_t nextAutoMapGeometryId = 1;
+
 Level::Level(
     const uint8_t mapIndex,
     const uint16_t mapWidth,
     const uint16_t mapHeight,
-    const uint16_t* plane0,
-    const uint16_t* plane2,
+    uint16_t* plane0,
+    uint16_t* plane2,
     const LevelInfo& mapInfo,
     const std::vector<WallInfo>& wallsInfo):
     m_levelWidth (mapWidth),
     m_levelHeight (mapHeight),
+    m_plane0 (plane0),
+    m_plane2 (plane2),
     m_levelInfo (mapInfo),
     m_wallsInfo (wallsInfo),
     m_lightningStartTimestamp(0),
@@ -48,17 +54,13 @@ Level::Level(
     m_blockingActors(nullptr),
     m_nonBlockingActors(nullptr),
     m_wallXVisible(nullptr),
-    m_wallYVisible(nullptr)
+    m_wallYVisible(nullptr),
+    m_autoMapDirtyTiles(nullptr),
+    m_autoMapDirtyTileIndices(),
+    m_autoMapGeometryId(0),
+    m_autoMapGeometryCheat(false)
 {
     const uint16_t mapSize = m_levelWidth * m_levelHeight;
-    m_plane0 = new uint16_t[mapSize];
-    m_plane2 = new uint16_t[mapSize];
-    for ( uint16_t i = 0; i < mapSize; i++)
-    {
-        m_plane0[i] = plane0[i];
-        m_plane2[i] = plane2[i];
-    }
-
     m_visibilityMap = new bool[mapSize];
     m_fogOfWarMap = new bool[mapSize];
 
@@ -76,6 +78,7 @@ Level::Level(
 
     m_wallXVisible = new bool[m_levelWidth * m_levelHeight];
     m_wallYVisible = new bool[m_levelWidth * m_levelHeight];
+    m_autoMapDirtyTiles = new bool[m_levelWidth * m_levelHeight];
 
     for (uint32_t i = 0u; i < (uint32_t)(m_levelWidth * m_levelHeight); i++)
     {
@@ -83,12 +86,15 @@ Level::Level(
         m_fogOfWarMap[i] = false;
         m_wallXVisible[i] = false;
         m_wallYVisible[i] = false;
+        m_autoMapDirtyTiles[i] = false;
     }
 
+    InvalidateAutoMapGeometry();
+
     UpdateLocationNamesBestPositions();
 }
 
-bool Level::LoadActorsFromFile(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors)
+bool Level::LoadActorsFromFile(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors)
 {
     m_playerActor = new Actor(file, decorateActors);
     uint16_t numberOfBlockingActors = 0;
@@ -142,7 +148,7 @@ bool Level::LoadActorsFromDosSavedGame(
     return true;
 }
 
-bool Level::LoadFogOfWarFromFile(std::ifstream& file)
+bool Level::LoadFogOfWarFromFile(std::istream& file)
 {
     file.read((char*)m_fogOfWarMap, m_levelWidth * m_levelHeight * sizeof(m_fogOfWarMap[0]));
     if (file.fail())
@@ -151,6 +157,8 @@ bool Level::LoadFogOfWarFromFile(std::ifstream& file)
         return false;
     }
 
+    InvalidateAutoMapGeometry();
+
     return true;
 }
 
@@ -167,6 +175,7 @@ Level::~Level()
 
     delete[] m_wallXVisible;
     delete[] m_wallYVisible;
+    delete[] m_autoMapDirtyTiles;
 
     delete m_playerActor;
 
@@ -194,7 +203,7 @@ Level::~Level()
     }
 }
 
-void Level::StoreToFile(std::ofstream& file) const
+void Level::StoreToFile(std::ostream& file) const
 {
     file.write((const char*)&m_levelIndex, sizeof(m_levelIndex));
     file.write((const char*)&m_levelWidth, sizeof(m_levelWidth));
@@ -238,6 +247,74 @@ void Level::StoreToFile(std::ofstream& file) const
     file.write((const char*)m_fogOfWarMap, m_levelWidth * m_levelHeight * sizeof(m_fogOfWarMap[0]));
 }
 
+void Level::GetPicturesAndSoundsInUse(
+    const std::map<uint16_t, const DecorateActor>& decorateActors,
+    const std::vector<const DecorateActor*>& spawnedActors,
+    std::set<uint16_t>& pictureIndices,
+    std::set<uint16_t>& soundIndices) const
+{
+    const uint16_t mapSize = m_levelWidth * m_levelHeight;
+    for (uint16_t i = 0; i < mapSize; i++)
+    {
+        const uint16_t wallTile = m_plane0[i];
+        if (wallTile < m_wallsInfo.size())
+        {
+            const WallInfo& wallInfo = m_wallsInfo.at(wallTile);
+            pictureIndices.insert(wallInfo.textureLight.begin(), wallInfo.textureLight.end());
+            pictureIndices.insert(wallInfo.textureDark.begin(), wallInfo.textureDark.end());
+        }
+    }
+
+    std::vector<const DecorateActor*> actorsToVisit(spawnedActors);
+    if (m_playerActor != nullptr)
+    {
+        actorsToVisit.push_back(&m_playerActor->GetDecorateActor());
+    }
+    for (uint16_t i = 0; i < mapSize; i++)
+    {
+        if (m_blockingActors[i] != nullptr)
+        {
+            actorsToVisit.push_back(&m_blockingActors[i]->GetDecorateActor());
+        }
+    }
+    for (uint16_t i = 0; i < m_maxNonBlockingActors; i++)
+    {
+        if (m_nonBlockingActors[i] != nullptr)
+        {
+            actorsToVisit.push_back(&m_nonBlockingActors[i]->GetDecorateActor());
+        }
+    }
+
+    std::set<const DecorateActor*> visitedActors;
+    while (!actorsToVisit.empty())
+    {
+        const DecorateActor* decorateActor = actorsToVisit.back();
+        actorsToVisit.pop_back();
+        if (!visitedActors.insert(decorateActor).second)
+        {
+            continue;
+        }
+
+        for (const auto& state : decorateActor->states)
+        {
+            for (const DecorateAnimationFrame& frame : state.second.animation)
+            {
+                pictureIndices.insert(frame.pictureIndex);
+            }
+        }
+        soundIndices.insert(decorateActor->hitSound);
+
+        if (decorateActor->projectileId != 0)
+        {
+            const auto projectile = decorateActors.find(decorateActor->projectileId);
+            if (projectile != decorateActors.end())
+            {
+                actorsToVisit.push_back(&projectile->second);
+            }
+        }
+    }
+}
+
 uint16_t Level::GetLevelWidth() const
 {
     return m_levelWidth;
@@ -276,6 +353,11 @@ void Level::SetWallTile(const uint16_t x, const uint16_t y, const uint16_t wallT
     }
 
     m_plane0[(y * m_levelWidth) + x] = wallTile;
+
+    // The wall tile also determines the walls of the automap tiles to the east and south.
+    MarkAutoMapTileDirty(x, y);
+    MarkAutoMapTileDirty(x + 1, y);
+    MarkAutoMapTileDirty(x, y + 1);
 }
 
 void Level::SetFloorTile(const uint16_t x, const uint16_t y, const uint16_t floorTile)
@@ -286,6 +368,7 @@ void Level::SetFloorTile(const uint16_t x, const uint16_t y, const uint16_t floo
     }
 
     m_plane2[(y * m_levelWidth) + x] = floorTile;
+    MarkAutoMapTileDirty(x, y);
 }
 
 bool Level::IsSolidWall(const uint16_t x, const uint16_t y) const
@@ -442,6 +525,7 @@ uint8_t Level::GetLevelIndex() const
 
 void Level::UpdateVisibilityMap()
 {
+    PROFILE_SCOPE("UpdateVisibilityMap");
     for (std::size_t i = 0; i < (m_levelWidth * m_levelHeight); ++i)
     {
         m_visibilityMap[i] = false;
@@ -532,11 +616,15 @@ void Level::UpdateVisibilityMap()
         for (uint16_t y = 0; y < m_levelHeight; y++)
         {
             const uint16_t tileIndex = (y * m_levelWidth) + x;
-            m_fogOfWarMap[tileIndex] |=
+            if (!m_fogOfWarMap[tileIndex] &&
                 (m_wallXVisible[tileIndex] ||
                  m_wallYVisible[tileIndex] ||
                  (y < m_levelHeight - 1 && m_wallYVisible[tileIndex + m_levelWidth]) ||
-                 (x < m_levelWidth - 1 && m_wallXVisible[tileIndex + 1]));
+                 (x < m_levelWidth - 1 && m_wallXVisible[tileIndex + 1])))
+            {
+                m_fogOfWarMap[tileIndex] = true;
+                MarkAutoMapTileDirty(x, y);
+            }
         }
     }
 }
@@ -968,6 +1056,9 @@ void Level::SetBlockingActor(const uint16_t x, const uint16_t y, Actor* actor)
     }
 
     m_blockingActors[(y * m_levelWidth) + x] = actor;
+
+    // Fake walls are shown on the automap when cheating
+    MarkAutoMapTileDirty(x, y);
 }
 
 Actor* Level::GetBlockingActor(const uint16_t x, const uint16_t y) const
@@ -1427,6 +1518,7 @@ void Level::Setup3DScene(
     const uint32_t timeStamp,
     const uint32_t ticks)
 {
+    PROFILE_SCOPE("Setup3DScene");
     Renderable3DTiles& renderable3DTiles = renderable3DScene.Get3DTilesMutable();
     for (int16_t y = 1; y < m_levelHeight - 1; y++)
     {
@@ -1441,6 +1533,7 @@ void Level::Setup3DScene(
     renderable3DTiles.SetOnlyFloor(false);
     renderable3DTiles.SetFloorColor(GetGroundColor());
     renderable3DTiles.SetCeilingColor(GetSkyColor(timeStamp));
+    renderable3DTiles.SetMapSize(m_levelWidth, m_levelHeight);
 
     const float x1 = m_playerActor->GetX();
     const float y1 = m_playerActor->GetY();
@@ -1463,8 +1556,7 @@ void Level::Setup3DScene(
                         const Picture* northPicture = egaGraph.GetPicture(northWall);
                         if (northPicture != nullptr)
                         {
-                            const unsigned int textureId = northPicture->GetTextureId();
-                            renderable3DScene.AddNorthWall(x, y, textureId);
+                            renderable3DScene.AddNorthWall(x, y, northPicture);
                         }
                     }
                     const uint16_t southwallIndex = GetWallTile(x, y);
@@ -1474,8 +1566,7 @@ void Level::Setup3DScene(
                         const Picture* southPicture = egaGraph.GetPicture(southWall);
                         if (southPicture != nullptr)
                         {
-                            const unsigned int textureId = southPicture->GetTextureId();
-                            renderable3DScene.AddSouthWall(x, y, textureId);
+                            renderable3DScene.AddSouthWall(x, y, southPicture);
                         }
                     }
                 }
@@ -1493,8 +1584,7 @@ void Level::Setup3DScene(
                         const Picture* eastPicture = egaGraph.GetPicture(eastWall);
                         if (eastPicture != nullptr)
                         {
-                            const unsigned int textureId = eastPicture->GetTextureId();
-                            renderable3DScene.AddEastWall(x, y, textureId);
+                            renderable3DScene.AddEastWall(x, y, eastPicture);
                         }
                     }
                     const uint16_t westwallIndex = GetWallTile(x - 1, y);
@@ -1504,8 +1594,7 @@ void Level::Setup3DScene(
                         const Picture* westPicture = egaGraph.GetPicture(westWall);
                         if (westPicture != nullptr)
                         {
-                            const unsigned int textureId = westPicture->GetTextureId();
-                            renderable3DScene.AddWestWall(x, y, textureId);
+                            renderable3DScene.AddWestWall(x, y, westPicture);
                         }
                     }
                 }
@@ -1684,73 +1773,44 @@ void Level::SetupAutoMapIso(
     renderableAutoMapIso.PrepareFrame(aspectRatio, originX, originY);
     renderableAutoMapIso.SetPlayerPosition(m_playerActor->GetX(), m_playerActor->GetY(), m_playerActor->GetAngle());
 
-    Renderable3DTiles& renderable3DTiles = renderableAutoMapIso.GetFloorTilesMutable();
+    if (cheat != m_autoMapGeometryCheat)
+    {
+        m_autoMapGeometryCheat = cheat;
+        InvalidateAutoMapGeometry();
+    }
 
-    for (uint16_t y = 1; y < m_levelHeight - 1; y++)
+    if (renderableAutoMapIso.GetStaticGeometryId() != m_autoMapGeometryId)
     {
-        for (uint16_t x = 1; x < m_levelWidth - 1; x++)
+        // Build the floor tiles, walls and wall caps of the whole level, including the black borders
+        renderableAutoMapIso.ResetStaticGeometry(m_autoMapGeometryId, m_levelWidth + 1, m_levelHeight + 1);
+        for (uint16_t y = 0; y <= m_levelHeight; y++)
         {
-            if (IsVisibleTile(x, y) && (cheat || IsTileClearFromFogOfWar(x, y)))
+            for (uint16_t x = 0; x <= m_levelWidth; x++)
             {
-                // Add floor and ceiling tile
-                renderable3DTiles.AddTile(Renderable3DTiles::tileCoordinate{ (int16_t)x, (int16_t)y });
-
-                // Add walls
-                const uint16_t northwallIndex = GetWallTile(x, y - 1);
-                const uint16_t northWall = GetDarkWallPictureIndex(northwallIndex, 0);
-                if (northWall != 1)
-                {
-                    const Picture* northPicture = egaGraph.GetPicture(northWall);
-                    if (northPicture != nullptr)
-                    {
-                        renderableAutoMapIso.AddNorthWall(x, y, northPicture->GetTextureId());
-                    }
-                }
-
-                const uint16_t westwallIndex = GetWallTile(x - 1, y);
-                const uint16_t westWall = GetLightWallPictureIndex(westwallIndex, 0);
-                if (westWall != 1)
-                {
-                    const Picture* westPicture = egaGraph.GetPicture(westWall);
-                    if (westPicture != nullptr)
-                    {
-                        renderableAutoMapIso.AddWestWall(x, y, westPicture->GetTextureId());
-                    }
-                }
+                renderableAutoMapIso.SetStaticTile(x, y, GetAutoMapIsoTile(egaGraph, x, y, cheat));
             }
         }
     }
-
-    renderable3DTiles.SetOnlyFloor(true);
-    renderable3DTiles.SetFloorColor(GetGroundColor());
-
-    const egaColor wallCapMainColor = GetWallCapMainColor();
-    for (uint16_t y = 0; y < m_levelHeight; y++)
+    else
     {
-        for (uint16_t x = 0; x < m_levelWidth; x++)
+        // Only update the tiles that changed since the previous frame
+        for (const uint16_t tileIndex : m_autoMapDirtyTileIndices)
         {
-            const bool isTileClearFromFogOfWar = IsTileClearFromFogOfWar(x, y);
-            if (!IsVisibleTile(x, y) && (cheat || isTileClearFromFogOfWar))
-            {
-                const egaColor centerColor = GetWallCapCenterColor(x, y, cheat);
-                renderableAutoMapIso.AddWallCap(x, y, wallCapMainColor, centerColor);
-            }
-            else if (!isTileClearFromFogOfWar && !cheat)
-            {
-                renderableAutoMapIso.AddWallCap(x, y, EgaBlack, EgaBlack);
-            }
+            const uint16_t x = tileIndex % m_levelWidth;
+            const uint16_t y = tileIndex / m_levelWidth;
+            renderableAutoMapIso.SetStaticTile(x, y, GetAutoMapIsoTile(egaGraph, x, y, cheat));
         }
     }
 
-    // Add black borders
-    for (uint16_t y = 0; y < m_levelHeight; y++)
-    {
-        renderableAutoMapIso.AddWallCap(m_levelWidth, y, EgaBlack, EgaBlack);
-    }
-    for (uint16_t x = 0; x < m_levelWidth; x++)
+    for (const uint16_t tileIndex : m_autoMapDirtyTileIndices)
     {
-        renderableAutoMapIso.AddWallCap(x, m_levelHeight, EgaBlack, EgaBlack);
+        m_autoMapDirtyTiles[tileIndex] = false;
     }
+    m_autoMapDirtyTileIndices.clear();
+
+    Renderable3DTiles& renderable3DTiles = renderableAutoMapIso.GetFloorTilesMutable();
+    renderable3DTiles.SetOnlyFloor(true);
+    renderable3DTiles.SetFloorColor(GetGroundColor());
 
     RenderableSprites& renderableSprites = renderableAutoMapIso.GetSpritesMutable();
 
@@ -1867,6 +1927,91 @@ void Level::SetupAutoMapIso(
     renderableAutoMapIso.FinalizeFrame();
 }
 
+RenderableAutoMapIso::staticTile Level::GetAutoMapIsoTile(EgaGraph& egaGraph, const uint16_t x, const uint16_t y, const bool cheat) const
+{
+    RenderableAutoMapIso::staticTile tile = { false, false, false, false, nullptr, nullptr, EgaBlack, EgaBlack };
+
+    if (x >= m_levelWidth || y >= m_levelHeight)
+    {
+        // Black border
+        tile.wallCap = true;
+        return tile;
+    }
+
+    const bool isTileClearFromFogOfWar = IsTileClearFromFogOfWar(x, y);
+    const bool isVisibleTile = IsVisibleTile(x, y);
+    if (isVisibleTile && (cheat || isTileClearFromFogOfWar) &&
+        x > 0 && x < m_levelWidth - 1 && y > 0 && y < m_levelHeight - 1)
+    {
+        // Add floor and ceiling tile
+        tile.floor = true;
+
+        // Add walls
+        const uint16_t northwallIndex = GetWallTile(x, y - 1);
+        const uint16_t northWall = GetDarkWallPictureIndex(northwallIndex, 0);
+        if (northWall != 1)
+        {
+            const Picture* northPicture = egaGraph.GetPicture(northWall);
+            if (northPicture != nullptr)
+            {
+                tile.northWall = true;
+                tile.northWallPicture = northPicture;
+            }
+        }
+
+        const uint16_t westwallIndex = GetWallTile(x - 1, y);
+        const uint16_t westWall = GetLightWallPictureIndex(westwallIndex, 0);
+        if (westWall != 1)
+        {
+            const Picture* westPicture = egaGraph.GetPicture(westWall);
+            if (westPicture != nullptr)
+            {
+                tile.westWall = true;
+                tile.westWallPicture = westPicture;
+            }
+        }
+    }
+
+    if (!isVisibleTile && (cheat || isTileClearFromFogOfWar))
+    {
+        tile.wallCap = true;
+        tile.wallCapMainColor = GetWallCapMainColor();
+        tile.wallCapCenterColor = GetWallCapCenterColor(x, y, cheat);
+    }
+    else if (!isTileClearFromFogOfWar && !cheat)
+    {
+        tile.wallCap = true;
+    }
+
+    return tile;
+}
+
+void Level::MarkAutoMapTileDirty(const uint16_t x, const uint16_t y)
+{
+    if (x >= m_levelWidth || y >= m_levelHeight)
+    {
+        return;
+    }
+
+    const uint16_t tileIndex = (y * m_levelWidth) + x;
+    if (!m_autoMapDirtyTiles[tileIndex])
+    {
+        m_autoMapDirtyTiles[tileIndex] = true;
+        m_autoMapDirtyTileIndices.push_back(tileIndex);
+    }
+}
+
+void Level::InvalidateAutoMapGeometry()
+{
+    // A new ID makes the next automap frame build all tiles from scratch
+    m_autoMapGeometryId = nextAutoMapGeometryId++;
+    for (const uint16_t tileIndex : m_autoMapDirtyTileIndices)
+    {
+        m_autoMapDirtyTiles[tileIndex] = false;
+    }
+    m_autoMapDirtyTileIndices.clear();
+}
+
 uint16_t Level::GetTileIdFromActor(const Actor* actor)
 {
     const uint16_t tileId0 = actor->GetDecorateActor().spawnOnAllDifficulties;
@@ -2252,6 +2397,7 @@ void Level::RemoveActor(Actor* actor)
         {
             delete m_blockingActors[i];
             m_blockingActors[i] = nullptr;
+            MarkAutoMapTileDirty(i % m_levelWidth, i / m_levelWidth);
         }
     }
 }
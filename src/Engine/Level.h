@@ -22,6 +22,7 @@
 #pragma once
 #include <stdint.h>
 #include "EgaColor.h"
+#include <set>
 #include <string>
 #include <vector>
 #include "PlayerInventory.h"
@@ -99,20 +100,21 @@ enum AutoMapType
 class Level
 {
 public:
+    // The level takes ownership of the planes, which must be allocated with new[] and hold levelWidth * levelHeight tiles.
     Level(
         const uint8_t levelIndex,
         const uint16_t levelWidth,
         const uint16_t levelHeight,
-        const uint16_t* plane0,
-        const uint16_t* plane2,
+        uint16_t* plane0,
+        uint16_t* plane2,
         const LevelInfo& mapInfo,
         const std::vector<WallInfo>& wallsInfo);
-    bool LoadActorsFromFile(std::ifstream& file, const std::map<uint16_t, const DecorateActor>& decorateActors);
+    bool LoadActorsFromFile(std::istream& file, const std::map<uint16_t, const DecorateActor>& decorateActors);
     bool LoadActorsFromDosSavedGame(
         const SavedGameInDosFormat& savedGameInDosFormat,
         const ISavedGameConverter& savedGameConverter,
         const std::map<uint16_t, const DecorateActor>& decorateActors);
-    bool LoadFogOfWarFromFile(std::ifstream& file);
+    bool LoadFogOfWarFromFile(std::istream& file);
     ~Level();
 
     uint16_t GetLevelWidth() const;
@@ -160,9 +162,17 @@ public:
     void SpawnExplosion(const float x, const float y, const int16_t delay, const uint32_t timestamp, const DecorateActor& decorateActor);
     void SpawnBigExplosion(const float x, const float y, const uint16_t delay, const uint32_t range, const uint32_t timestamp, const DecorateActor& decorateActor);
 
-    void StoreToFile(std::ofstream& file) const;
+    void StoreToFile(std::ostream& file) const;
     bool IsWaterLevel() const;
 
+    // Collects the pictures of the walls and of all animations of the actors in the level, and the sounds of the actors.
+    // The projectiles that the actors fire are included, as well as the given actors that can be spawned during play.
+    void GetPicturesAndSoundsInUse(
+        const std::map<uint16_t, const DecorateActor>& decorateActors,
+        const std::vector<const DecorateActor*>& spawnedActors,
+        std::set<uint16_t>& pictureIndices,
+        std::set<uint16_t>& soundIndices) const;
+
     void Setup3DScene(
         EgaGraph& egaGraph,
         Renderable3DScene& renderable3DScene,
@@ -224,6 +234,9 @@ private:
         const float x1, const float y1,
         const float x2, const float y2);
     uint16_t inline HideDestructibleTiles(const uint16_t tileIndex) const;
+    RenderableAutoMapIso::staticTile GetAutoMapIsoTile(EgaGraph& egaGraph, const uint16_t x, const uint16_t y, const bool cheat) const;
+    void MarkAutoMapTileDirty(const uint16_t x, const uint16_t y);
+    void InvalidateAutoMapGeometry();
 
     const uint16_t m_levelWidth;
     const uint16_t m_levelHeight;
@@ -243,4 +256,10 @@ private:
     bool* m_wallXVisible;
     bool* m_wallYVisible;
     std::map<uint8_t, locationNameBestPos> m_locationNameBestPositions;
+
+    // Tiles of which the automap geometry changed since the previous automap frame, due to fog of war or changed walls.
+    bool* m_autoMapDirtyTiles;
+    std::vector<uint16_t> m_autoMapDirtyTileIndices;
+    uint32_t m_autoMapGeometryId;
+    bool m_autoMapGeometryCheat;
 };
@@ -57,6 +57,8 @@ void Logging::SetLogFile(const fs::path traceFileName)
 
 void Logging::AddLogMessage(const std::string& logline)
 {
+    // Log messages can also be added by worker threads
+    std::lock_guard<std::mutex> lock(m_mutex);
     m_allLogMessages.push_back(logline);
     std::ofstream file;
     file.open(m_traceFileName, std::ofstream::out | std::ios_base::app);
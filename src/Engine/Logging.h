@@ -15,6 +15,7 @@
 #pragma once
 
 #include <filesystem>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -34,4 +35,5 @@ private:
 
     std::vector<std::string> m_allLogMessages;
     std::filesystem::path m_traceFileName;
+    std::mutex m_mutex;
 };
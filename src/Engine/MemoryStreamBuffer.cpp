@@ -0,0 +1,55 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "MemoryStreamBuffer.h"
+
+MemoryStreamBuffer::MemoryStreamBuffer(std::vector<uint8_t>& data) :
+    m_data(&data)
+{
+
+}
+
+MemoryStreamBuffer::MemoryStreamBuffer(const std::vector<uint8_t>& data) :
+    m_data(nullptr)
+{
+    // The get area is only read from.
+    char* begin = (char*)const_cast<uint8_t*>(data.data());
+    setg(begin, begin, begin + data.size());
+}
+
+MemoryStreamBuffer::int_type MemoryStreamBuffer::overflow(int_type c)
+{
+    if (m_data == nullptr)
+    {
+        return traits_type::eof();
+    }
+
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        m_data->push_back((uint8_t)traits_type::to_char_type(c));
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize MemoryStreamBuffer::xsputn(const char* s, std::streamsize count)
+{
+    if (m_data == nullptr)
+    {
+        return 0;
+    }
+
+    m_data->insert(m_data->end(), (const uint8_t*)s, (const uint8_t*)s + count);
+    return count;
+}
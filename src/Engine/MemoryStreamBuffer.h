@@ -0,0 +1,43 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// MemoryStreamBuffer
+//
+// Stream buffer on top of a byte vector, such that the game state can be written to and read from memory by the same
+// code that writes and reads saved games. Writing appends to the vector. Since clearing a vector keeps its capacity,
+// a buffer that is reused for each snapshot only allocates memory when the game state has grown.
+//
+#pragma once
+
+#include <stdint.h>
+#include <streambuf>
+#include <vector>
+
+class MemoryStreamBuffer : public std::streambuf
+{
+public:
+    // For writing to the end of the data.
+    explicit MemoryStreamBuffer(std::vector<uint8_t>& data);
+    // For reading from the start of the data.
+    explicit MemoryStreamBuffer(const std::vector<uint8_t>& data);
+
+protected:
+    int_type overflow(int_type c) override;
+    std::streamsize xsputn(const char* s, std::streamsize count) override;
+
+private:
+    std::vector<uint8_t>* m_data;
+};
@@ -0,0 +1,100 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "MusicTrack.h"
+
+MusicTrack::MusicTrack(const Huffman& huffman, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize) :
+    m_huffman(huffman),
+    m_compressedData(compressedData),
+    m_compressedSize(compressedSize),
+    m_decompressedSize(decompressedSize),
+    m_bytesDecoded(0),
+    m_length(0),
+    m_currentBlock(0),
+    m_positionInBlock(0)
+{
+    m_blockFill[0] = 0;
+    m_blockFill[1] = 0;
+    Rewind();
+}
+
+MusicTrack::~MusicTrack()
+{
+
+}
+
+uint16_t MusicTrack::GetLength() const
+{
+    return m_length;
+}
+
+void MusicTrack::Rewind()
+{
+    Huffman::ResetStreamState(m_streamState);
+    m_bytesDecoded = 0;
+    DecodeBlock(0);
+    DecodeBlock(1);
+    m_currentBlock = 0;
+    m_positionInBlock = 0;
+
+    // The first word of the track contains the length in bytes of the register data that follows
+    const uint8_t lengthLow = ReadByte();
+    const uint8_t lengthHigh = ReadByte();
+    m_length = (uint16_t)(lengthLow | (lengthHigh << 8));
+}
+
+void MusicTrack::ReadEvent(uint8_t& reg, uint8_t& value, uint16_t& delay)
+{
+    reg = ReadByte();
+    value = ReadByte();
+    const uint8_t delayLow = ReadByte();
+    const uint8_t delayHigh = ReadByte();
+    delay = (uint16_t)(delayLow | (delayHigh << 8));
+}
+
+uint8_t MusicTrack::ReadByte()
+{
+    if (m_positionInBlock == m_blockFill[m_currentBlock])
+    {
+        if (m_blockFill[m_currentBlock] < BlockSize)
+        {
+            // End of track
+            return 0;
+        }
+
+        // Move on to the block that was decoded ahead, and immediately refill the one that was just consumed
+        const uint8_t consumedBlock = m_currentBlock;
+        m_currentBlock = 1 - m_currentBlock;
+        m_positionInBlock = 0;
+        DecodeBlock(consumedBlock);
+
+        if (m_blockFill[m_currentBlock] == 0)
+        {
+            return 0;
+        }
+    }
+
+    return m_blocks[m_currentBlock][m_positionInBlock++];
+}
+
+void MusicTrack::DecodeBlock(const uint8_t blockIndex)
+{
+    const uint32_t bytesLeft = m_decompressedSize - m_bytesDecoded;
+    const uint32_t bytesToDecode = (bytesLeft < BlockSize) ? bytesLeft : BlockSize;
+    const unsigned long bytesDecoded =
+        m_huffman.DecompressStream(m_compressedData, m_compressedSize, m_streamState, m_blocks[blockIndex], bytesToDecode);
+    m_blockFill[blockIndex] = (uint16_t)bytesDecoded;
+    m_bytesDecoded += (uint32_t)bytesDecoded;
+}
@@ -0,0 +1,56 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// MusicTrack
+//
+// Streams the register writes of a single Adlib music track to the sequencer.
+// The Huffman compressed track is expanded one block at a time, keeping one block decoded ahead of the sequencer,
+// so only the compressed data stays resident and starting a track does not require decoding it entirely.
+//
+#pragma once
+
+#include <stdint.h>
+#include "Huffman.h"
+
+class MusicTrack
+{
+public:
+    MusicTrack(const Huffman& huffman, const uint8_t* compressedData, const uint32_t compressedSize, const uint32_t decompressedSize);
+    ~MusicTrack();
+
+    uint16_t GetLength() const;
+    void Rewind();
+    void ReadEvent(uint8_t& reg, uint8_t& value, uint16_t& delay);
+
+    static const uint16_t BlockSize = 512;
+
+private:
+    uint8_t ReadByte();
+    void DecodeBlock(const uint8_t blockIndex);
+
+    const Huffman& m_huffman;
+    const uint8_t* m_compressedData;
+    const uint32_t m_compressedSize;
+    const uint32_t m_decompressedSize;
+    huffmanStreamState m_streamState;
+    uint32_t m_bytesDecoded;
+    uint16_t m_length;
+
+    uint8_t m_blocks[2][BlockSize];
+    uint16_t m_blockFill[2];
+    uint8_t m_currentBlock;
+    uint16_t m_positionInBlock;
+};
@@ -0,0 +1,151 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OffscreenRecorder.h"
+#include "GameTimer.h"
+#include "Logging.h"
+#include "PngWriter.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+static uint32_t GetMicroseconds(const std::chrono::steady_clock::time_point start, const std::chrono::steady_clock::time_point end)
+{
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+}
+
+static std::string ToMilliseconds(const uint32_t microseconds)
+{
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%.3f", microseconds / 1000.0);
+    return std::string(buffer);
+}
+
+OffscreenRecorder::OffscreenRecorder(const InputScript& inputScript, const std::filesystem::path& outputPath) :
+    m_inputScript(inputScript),
+    m_outputPath(outputPath),
+    m_frameNumber(0)
+{
+    GameTimer::SetSteppedClock(true);
+    const auto now = std::chrono::steady_clock::now();
+    m_frameStart = now;
+    m_thinkEnd = now;
+    m_drawEnd = now;
+}
+
+OffscreenRecorder::~OffscreenRecorder()
+{
+    GameTimer::SetSteppedClock(false);
+}
+
+void OffscreenRecorder::BeginFrame()
+{
+    m_frameStart = std::chrono::steady_clock::now();
+    m_thinkEnd = m_frameStart;
+    m_drawEnd = m_frameStart;
+}
+
+void OffscreenRecorder::ApplyInput(PlayerInput& input) const
+{
+    m_inputScript.ApplyToInput(m_frameNumber, input);
+}
+
+void OffscreenRecorder::EndThink()
+{
+    m_thinkEnd = std::chrono::steady_clock::now();
+}
+
+void OffscreenRecorder::EndDraw()
+{
+    m_drawEnd = std::chrono::steady_clock::now();
+}
+
+void OffscreenRecorder::EndFrame(const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels)
+{
+    const auto frameEnd = std::chrono::steady_clock::now();
+    const frameTiming timing =
+    {
+        GetMicroseconds(m_frameStart, m_thinkEnd),
+        GetMicroseconds(m_thinkEnd, m_drawEnd),
+        GetMicroseconds(m_drawEnd, frameEnd)
+    };
+    m_frameTimings.push_back(timing);
+
+    if (m_inputScript.IsCaptureFrame(m_frameNumber))
+    {
+        char filename[32];
+        snprintf(filename, sizeof(filename), "frame_%05u.png", m_frameNumber);
+        if (!PngWriter::WriteToFile(m_outputPath / filename, width, height, rgbaPixels))
+        {
+            Logging::Instance().AddLogMessage("WARNING: unable to write " + (m_outputPath / filename).string());
+        }
+    }
+
+    GameTimer::AdvanceSteppedClock(MillisecondsPerFrame);
+    m_frameNumber++;
+}
+
+uint32_t OffscreenRecorder::GetFrameNumber() const
+{
+    return m_frameNumber;
+}
+
+bool OffscreenRecorder::IsFinished() const
+{
+    return m_frameNumber > m_inputScript.GetLastFrame();
+}
+
+bool OffscreenRecorder::WriteTimings() const
+{
+    std::ofstream file(m_outputPath / "timings.csv");
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    file << "frame,think_ms,draw_ms,read_ms,total_ms\n";
+    for (size_t i = 0; i < m_frameTimings.size(); i++)
+    {
+        const frameTiming& timing = m_frameTimings.at(i);
+        const uint32_t total = timing.thinkInMicroseconds + timing.drawInMicroseconds + timing.readInMicroseconds;
+        file << i << "," << ToMilliseconds(timing.thinkInMicroseconds) << "," << ToMilliseconds(timing.drawInMicroseconds) << ","
+             << ToMilliseconds(timing.readInMicroseconds) << "," << ToMilliseconds(total) << "\n";
+    }
+
+    return file.good();
+}
+
+std::string OffscreenRecorder::GetTimingsSummary() const
+{
+    if (m_frameTimings.empty())
+    {
+        return "No frames rendered";
+    }
+
+    std::vector<uint32_t> totals;
+    uint64_t sum = 0;
+    for (const frameTiming& timing : m_frameTimings)
+    {
+        const uint32_t total = timing.thinkInMicroseconds + timing.drawInMicroseconds + timing.readInMicroseconds;
+        totals.push_back(total);
+        sum += total;
+    }
+    std::sort(totals.begin(), totals.end());
+    const uint32_t average = (uint32_t)(sum / totals.size());
+    const uint32_t percentile95 = totals.at(((totals.size() * 95) + 99) / 100 - 1);
+
+    return std::to_string(totals.size()) + " frames rendered; average " + ToMilliseconds(average) + " ms, 95th percentile " +
+        ToMilliseconds(percentile95) + " ms, slowest " + ToMilliseconds(totals.back()) + " ms";
+}
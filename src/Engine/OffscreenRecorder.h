@@ -0,0 +1,71 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OffscreenRecorder
+//
+// Drives an offscreen run: the input of each frame comes from an input script, the game clock advances by a fixed
+// step per frame and the frames that the script selects are stored as PNG images. The time spent in each part of a
+// frame is written to timings.csv, such that both the images and the timings can serve as a baseline.
+//
+#pragma once
+
+#include "InputScript.h"
+#include <chrono>
+#include <filesystem>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class PlayerInput;
+
+class OffscreenRecorder
+{
+public:
+    // One tick of the game timer per frame.
+    static const uint32_t MillisecondsPerFrame = 14;
+
+    OffscreenRecorder(const InputScript& inputScript, const std::filesystem::path& outputPath);
+    ~OffscreenRecorder();
+
+    void BeginFrame();
+    void ApplyInput(PlayerInput& input) const;
+    void EndThink();
+    void EndDraw();
+    // Ends the frame after the rendered pixels were read, as RGBA rows from top to bottom.
+    void EndFrame(const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels);
+
+    uint32_t GetFrameNumber() const;
+    bool IsFinished() const;
+
+    bool WriteTimings() const;
+    std::string GetTimingsSummary() const;
+
+private:
+    struct frameTiming
+    {
+        uint32_t thinkInMicroseconds;
+        uint32_t drawInMicroseconds;
+        uint32_t readInMicroseconds;
+    };
+
+    const InputScript& m_inputScript;
+    const std::filesystem::path m_outputPath;
+    uint32_t m_frameNumber;
+    std::chrono::steady_clock::time_point m_frameStart;
+    std::chrono::steady_clock::time_point m_thinkEnd;
+    std::chrono::steady_clock::time_point m_drawEnd;
+    std::vector<frameTiming> m_frameTimings;
+};
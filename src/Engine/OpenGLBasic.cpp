@@ -22,6 +22,10 @@ OpenGLBasic::OpenGLBasic() :
     m_bindTextureFuncPtr(nullptr),
     m_texParameteriFuncPtr(nullptr),
     m_texImage2DFuncPtr(nullptr),
+    m_enableFuncPtr(nullptr),
+    m_disableFuncPtr(nullptr),
+    m_blendFuncFuncPtr(nullptr),
+    m_depthMaskFuncPtr(nullptr),
     m_isSupported(true)
 {
     m_genTexturesFuncPtr = (GL_GenTextures_Func)SDL_GL_GetProcAddress("glGenTextures");
@@ -55,6 +59,38 @@ OpenGLBasic::OpenGLBasic() :
         m_isSupported = false;
         return;
     }
+
+    m_enableFuncPtr = (GL_Enable_Func)SDL_GL_GetProcAddress("glEnable");
+    if (m_enableFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glEnable");
+        m_isSupported = false;
+        return;
+    }
+
+    m_disableFuncPtr = (GL_Disable_Func)SDL_GL_GetProcAddress("glDisable");
+    if (m_disableFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glDisable");
+        m_isSupported = false;
+        return;
+    }
+
+    m_blendFuncFuncPtr = (GL_BlendFunc_Func)SDL_GL_GetProcAddress("glBlendFunc");
+    if (m_blendFuncFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glBlendFunc");
+        m_isSupported = false;
+        return;
+    }
+
+    m_depthMaskFuncPtr = (GL_DepthMask_Func)SDL_GL_GetProcAddress("glDepthMask");
+    if (m_depthMaskFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glDepthMask");
+        m_isSupported = false;
+        return;
+    }
 }
 
 OpenGLBasic::~OpenGLBasic()
@@ -95,3 +131,23 @@ void OpenGLBasic::GlTexImage2D(
 {
     m_texImage2DFuncPtr(target, level, internalformat, width, height, border, format, type, pixels);
 }
+
+void OpenGLBasic::GlEnable(unsigned int cap) const
+{
+    m_enableFuncPtr(cap);
+}
+
+void OpenGLBasic::GlDisable(unsigned int cap) const
+{
+    m_disableFuncPtr(cap);
+}
+
+void OpenGLBasic::GlBlendFunc(unsigned int sfactor, unsigned int dfactor) const
+{
+    m_blendFuncFuncPtr(sfactor, dfactor);
+}
+
+void OpenGLBasic::GlDepthMask(unsigned char flag) const
+{
+    m_depthMaskFuncPtr(flag);
+}
@@ -49,17 +49,29 @@ public:
         unsigned int format,
         unsigned int type,
         void* pixels) const;
+    void GlEnable(unsigned int cap) const;
+    void GlDisable(unsigned int cap) const;
+    void GlBlendFunc(unsigned int sfactor, unsigned int dfactor) const;
+    void GlDepthMask(unsigned char flag) const;
 
 private:
     typedef void(CALLBACK *GL_GenTextures_Func)(unsigned int, unsigned int*);
     typedef void(CALLBACK *GL_BindTexture_Func)(unsigned int, unsigned int);
     typedef void(CALLBACK *GL_TexParameteri_Func)(unsigned int, unsigned int, int);
     typedef void(CALLBACK *GL_TexImage2D_Func)(unsigned int, int, int, unsigned int, unsigned int, int, unsigned int, unsigned int, void*);
+    typedef void(CALLBACK *GL_Enable_Func)(unsigned int);
+    typedef void(CALLBACK *GL_Disable_Func)(unsigned int);
+    typedef void(CALLBACK *GL_BlendFunc_Func)(unsigned int, unsigned int);
+    typedef void(CALLBACK *GL_DepthMask_Func)(unsigned char);
 
     GL_GenTextures_Func m_genTexturesFuncPtr;
     GL_BindTexture_Func m_bindTextureFuncPtr;
     GL_TexParameteri_Func m_texParameteriFuncPtr;
     GL_TexImage2D_Func m_texImage2DFuncPtr;
+    GL_Enable_Func m_enableFuncPtr;
+    GL_Disable_Func m_disableFuncPtr;
+    GL_BlendFunc_Func m_blendFuncFuncPtr;
+    GL_DepthMask_Func m_depthMaskFuncPtr;
 
     bool m_isSupported;
 };
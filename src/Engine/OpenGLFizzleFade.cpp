@@ -0,0 +1,249 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/
+
+#include "OpenGLFizzleFade.h"
+#include "../Engine/Logging.h"
+#ifndef _WIN32
+#include <GL/glext.h>
+#else
+// The file glext.h is not available in the Visual Studio Platform Toolset.
+// Below are the specific definitions from glext.h that are needed in this source file.
+static constexpr unsigned int GL_TEXTURE0 = 0x84C0;
+static constexpr unsigned int GL_TEXTURE1 = 0x84C1;
+static constexpr unsigned int GL_FRAGMENT_SHADER = 0x8B30;
+static constexpr unsigned int GL_VERTEX_SHADER = 0x8B31;
+static constexpr unsigned int GL_COMPILE_STATUS = 0x8B81;
+static constexpr unsigned int GL_LINK_STATUS = 0x8B82;
+#endif
+#include <SDL_video.h>
+#include <vector>
+
+// Size of the texture that holds the 320 x 200 reveal time map
+static const uint16_t revealTimesTextureWidth = 512;
+static const uint16_t revealTimesTextureHeight = 256;
+
+static const char* vertexShaderSource =
+    "varying vec2 screenCoordinate;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+    "    screenCoordinate = gl_Vertex.xy;\n"
+    "    gl_Position = ftransform();\n"
+    "}\n";
+
+// The screen coordinates are in original 320 x 200 pixels. The reveal time of each pixel is stored
+// as a 16-bit value in the red and green components. The map is repeated horizontally on wide screens,
+// while the pixels above and below it are never removed.
+static const char* fragmentShaderSource =
+    "uniform sampler2D screenCapture;\n"
+    "uniform sampler2D revealTimes;\n"
+    "uniform float revealedTime;\n"
+    "varying vec2 screenCoordinate;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 pixel = vec2(mod(floor(screenCoordinate.x), 320.0), floor(screenCoordinate.y));\n"
+    "    if (pixel.y >= 0.0 && pixel.y < 200.0)\n"
+    "    {\n"
+    "        vec4 revealTime = texture2D(revealTimes, (pixel + 0.5) / vec2(512.0, 256.0));\n"
+    "        float time = floor(revealTime.r * 255.0 + 0.5) * 256.0 + floor(revealTime.g * 255.0 + 0.5);\n"
+    "        if (time < revealedTime)\n"
+    "        {\n"
+    "            discard;\n"
+    "        }\n"
+    "    }\n"
+    "    gl_FragColor = texture2D(screenCapture, gl_TexCoord[0].st);\n"
+    "}\n";
+
+OpenGLFizzleFade::OpenGLFizzleFade(const OpenGLBasic& openGLBasic) :
+    m_createShaderFuncPtr(nullptr),
+    m_shaderSourceFuncPtr(nullptr),
+    m_compileShaderFuncPtr(nullptr),
+    m_getShaderivFuncPtr(nullptr),
+    m_getShaderInfoLogFuncPtr(nullptr),
+    m_createProgramFuncPtr(nullptr),
+    m_attachShaderFuncPtr(nullptr),
+    m_linkProgramFuncPtr(nullptr),
+    m_getProgramivFuncPtr(nullptr),
+    m_useProgramFuncPtr(nullptr),
+    m_getUniformLocationFuncPtr(nullptr),
+    m_uniform1iFuncPtr(nullptr),
+    m_uniform1fFuncPtr(nullptr),
+    m_activeTextureFuncPtr(nullptr),
+    m_openGLBasic(openGLBasic),
+    m_isSupported(false),
+    m_program(0),
+    m_revealedTimeLocation(-1),
+    m_textureIdRevealTimes(0),
+    m_uploadedRevealTimes(nullptr)
+{
+    // All shader functions require OpenGL 2.0
+    m_createShaderFuncPtr = (GL_CreateShader_Func)SDL_GL_GetProcAddress("glCreateShader");
+    m_shaderSourceFuncPtr = (GL_ShaderSource_Func)SDL_GL_GetProcAddress("glShaderSource");
+    m_compileShaderFuncPtr = (GL_CompileShader_Func)SDL_GL_GetProcAddress("glCompileShader");
+    m_getShaderivFuncPtr = (GL_GetShaderiv_Func)SDL_GL_GetProcAddress("glGetShaderiv");
+    m_getShaderInfoLogFuncPtr = (GL_GetShaderInfoLog_Func)SDL_GL_GetProcAddress("glGetShaderInfoLog");
+    m_createProgramFuncPtr = (GL_CreateProgram_Func)SDL_GL_GetProcAddress("glCreateProgram");
+    m_attachShaderFuncPtr = (GL_AttachShader_Func)SDL_GL_GetProcAddress("glAttachShader");
+    m_linkProgramFuncPtr = (GL_LinkProgram_Func)SDL_GL_GetProcAddress("glLinkProgram");
+    m_getProgramivFuncPtr = (GL_GetProgramiv_Func)SDL_GL_GetProcAddress("glGetProgramiv");
+    m_useProgramFuncPtr = (GL_UseProgram_Func)SDL_GL_GetProcAddress("glUseProgram");
+    m_getUniformLocationFuncPtr = (GL_GetUniformLocation_Func)SDL_GL_GetProcAddress("glGetUniformLocation");
+    m_uniform1iFuncPtr = (GL_Uniform1i_Func)SDL_GL_GetProcAddress("glUniform1i");
+    m_uniform1fFuncPtr = (GL_Uniform1f_Func)SDL_GL_GetProcAddress("glUniform1f");
+    // glActiveTexture requires OpenGL 1.3
+    m_activeTextureFuncPtr = (GL_ActiveTexture_Func)SDL_GL_GetProcAddress("glActiveTexture");
+    if (m_createShaderFuncPtr == nullptr ||
+        m_shaderSourceFuncPtr == nullptr ||
+        m_compileShaderFuncPtr == nullptr ||
+        m_getShaderivFuncPtr == nullptr ||
+        m_getShaderInfoLogFuncPtr == nullptr ||
+        m_createProgramFuncPtr == nullptr ||
+        m_attachShaderFuncPtr == nullptr ||
+        m_linkProgramFuncPtr == nullptr ||
+        m_getProgramivFuncPtr == nullptr ||
+        m_useProgramFuncPtr == nullptr ||
+        m_getUniformLocationFuncPtr == nullptr ||
+        m_uniform1iFuncPtr == nullptr ||
+        m_uniform1fFuncPtr == nullptr ||
+        m_activeTextureFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointers for OpenGL shaders; fizzle fade uses the stencil buffer");
+        return;
+    }
+
+    if (!CompileProgram())
+    {
+        return;
+    }
+
+    m_openGLBasic.GlGenTextures(1, &m_textureIdRevealTimes);
+
+    Logging::Instance().AddLogMessage("OpenGL fizzle fade shader is supported");
+    m_isSupported = true;
+}
+
+OpenGLFizzleFade::~OpenGLFizzleFade()
+{
+
+}
+
+bool OpenGLFizzleFade::IsSupported() const
+{
+    return m_isSupported;
+}
+
+void OpenGLFizzleFade::Bind(const uint16_t* revealTimes, const uint16_t revealedTime)
+{
+    if (revealTimes != m_uploadedRevealTimes)
+    {
+        UploadRevealTimes(revealTimes);
+    }
+
+    // The screen capture is bound to texture unit 0 by the renderer; the reveal times go into unit 1.
+    m_activeTextureFuncPtr(GL_TEXTURE1);
+    m_openGLBasic.GlBindTexture(GL_TEXTURE_2D, m_textureIdRevealTimes);
+    m_activeTextureFuncPtr(GL_TEXTURE0);
+
+    m_useProgramFuncPtr(m_program);
+    m_uniform1fFuncPtr(m_revealedTimeLocation, (float)revealedTime);
+}
+
+void OpenGLFizzleFade::Unbind()
+{
+    m_useProgramFuncPtr(0);
+
+    m_activeTextureFuncPtr(GL_TEXTURE1);
+    m_openGLBasic.GlBindTexture(GL_TEXTURE_2D, 0);
+    m_activeTextureFuncPtr(GL_TEXTURE0);
+}
+
+bool OpenGLFizzleFade::CompileProgram()
+{
+    const unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, vertexShaderSource);
+    const unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, fragmentShaderSource);
+    if (vertexShader == 0 || fragmentShader == 0)
+    {
+        return false;
+    }
+
+    m_program = m_createProgramFuncPtr();
+    m_attachShaderFuncPtr(m_program, vertexShader);
+    m_attachShaderFuncPtr(m_program, fragmentShader);
+    m_linkProgramFuncPtr(m_program);
+
+    int linkStatus = 0;
+    m_getProgramivFuncPtr(m_program, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == 0)
+    {
+        Logging::Instance().AddLogMessage("Failed to link fizzle fade shader program");
+        return false;
+    }
+
+    m_useProgramFuncPtr(m_program);
+    m_uniform1iFuncPtr(m_getUniformLocationFuncPtr(m_program, "screenCapture"), 0);
+    m_uniform1iFuncPtr(m_getUniformLocationFuncPtr(m_program, "revealTimes"), 1);
+    m_revealedTimeLocation = m_getUniformLocationFuncPtr(m_program, "revealedTime");
+    m_useProgramFuncPtr(0);
+
+    return true;
+}
+
+unsigned int OpenGLFizzleFade::CompileShader(const unsigned int type, const char* source)
+{
+    const unsigned int shader = m_createShaderFuncPtr(type);
+    m_shaderSourceFuncPtr(shader, 1, &source, nullptr);
+    m_compileShaderFuncPtr(shader);
+
+    int compileStatus = 0;
+    m_getShaderivFuncPtr(shader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == 0)
+    {
+        char infoLog[512];
+        m_getShaderInfoLogFuncPtr(shader, sizeof(infoLog), nullptr, infoLog);
+        Logging::Instance().AddLogMessage("Failed to compile fizzle fade shader: " + std::string(infoLog));
+        return 0;
+    }
+
+    return shader;
+}
+
+void OpenGLFizzleFade::UploadRevealTimes(const uint16_t* revealTimes)
+{
+    std::vector<uint8_t> pixelData(revealTimesTextureWidth * revealTimesTextureHeight * 4, 0);
+    for (uint16_t y = 0; y < 200; y++)
+    {
+        for (uint16_t x = 0; x < 320; x++)
+        {
+            const uint16_t revealTime = revealTimes[(y * 320) + x];
+            const uint32_t offset = ((y * revealTimesTextureWidth) + x) * 4;
+            pixelData[offset] = (uint8_t)(revealTime >> 8);
+            pixelData[offset + 1] = (uint8_t)(revealTime & 0xFF);
+        }
+    }
+
+    m_openGLBasic.GlBindTexture(GL_TEXTURE_2D, m_textureIdRevealTimes);
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    m_openGLBasic.GlTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+        revealTimesTextureWidth,
+        revealTimesTextureHeight,
+        0, GL_RGBA, GL_UNSIGNED_BYTE,
+        pixelData.data());
+    m_openGLBasic.GlBindTexture(GL_TEXTURE_2D, 0);
+
+    m_uploadedRevealTimes = revealTimes;
+}
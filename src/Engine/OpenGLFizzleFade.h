@@ -0,0 +1,82 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/
+
+//
+// OpenGLFizzleFade
+//
+// Implements the fizzle fade as a single draw of the screen capture, using a shader program that
+// discards the pixels of which the reveal time has passed. Requires OpenGL 2.0.
+//
+#pragma once
+
+#include "Macros.h"
+#include "OpenGLBasic.h"
+#include <string>
+
+class OpenGLFizzleFade
+{
+public:
+    OpenGLFizzleFade(const OpenGLBasic& openGLBasic);
+    ~OpenGLFizzleFade();
+
+    bool IsSupported() const;
+
+    // The reveal times are a map of 320 x 200 pixels, which is only uploaded when it differs from the previous call.
+    void Bind(const uint16_t* revealTimes, const uint16_t revealedTime);
+    void Unbind();
+
+private:
+    bool CompileProgram();
+    unsigned int CompileShader(const unsigned int type, const char* source);
+    void UploadRevealTimes(const uint16_t* revealTimes);
+
+    typedef char GLchar_Type;
+    typedef unsigned int (CALLBACK* GL_CreateShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_ShaderSource_Func)(unsigned int, int, const GLchar_Type**, const int*);
+    typedef void (CALLBACK* GL_CompileShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetShaderiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_GetShaderInfoLog_Func)(unsigned int, int, int*, GLchar_Type*);
+    typedef unsigned int (CALLBACK* GL_CreateProgram_Func)();
+    typedef void (CALLBACK* GL_AttachShader_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_LinkProgram_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetProgramiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_UseProgram_Func)(unsigned int);
+    typedef int (CALLBACK* GL_GetUniformLocation_Func)(unsigned int, const GLchar_Type*);
+    typedef void (CALLBACK* GL_Uniform1i_Func)(int, int);
+    typedef void (CALLBACK* GL_Uniform1f_Func)(int, float);
+    typedef void (CALLBACK* GL_ActiveTexture_Func)(unsigned int);
+
+    GL_CreateShader_Func m_createShaderFuncPtr;
+    GL_ShaderSource_Func m_shaderSourceFuncPtr;
+    GL_CompileShader_Func m_compileShaderFuncPtr;
+    GL_GetShaderiv_Func m_getShaderivFuncPtr;
+    GL_GetShaderInfoLog_Func m_getShaderInfoLogFuncPtr;
+    GL_CreateProgram_Func m_createProgramFuncPtr;
+    GL_AttachShader_Func m_attachShaderFuncPtr;
+    GL_LinkProgram_Func m_linkProgramFuncPtr;
+    GL_GetProgramiv_Func m_getProgramivFuncPtr;
+    GL_UseProgram_Func m_useProgramFuncPtr;
+    GL_GetUniformLocation_Func m_getUniformLocationFuncPtr;
+    GL_Uniform1i_Func m_uniform1iFuncPtr;
+    GL_Uniform1f_Func m_uniform1fFuncPtr;
+    GL_ActiveTexture_Func m_activeTextureFuncPtr;
+
+    const OpenGLBasic& m_openGLBasic;
+    bool m_isSupported;
+    unsigned int m_program;
+    int m_revealedTimeLocation;
+    unsigned int m_textureIdRevealTimes;
+    const uint16_t* m_uploadedRevealTimes;
+};
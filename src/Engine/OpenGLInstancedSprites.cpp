@@ -0,0 +1,311 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OpenGLInstancedSprites.h"
+#include "OpenGLPalette.h"
+#include "RenderableSprites.h"
+#include "Logging.h"
+#ifndef _WIN32
+#include <GL/glext.h>
+#else
+// The file glext.h is not available in the Visual Studio Platform Toolset.
+// Below are the specific definitions from glext.h that are needed in this source file.
+static constexpr unsigned int GL_ARRAY_BUFFER = 0x8892;
+static constexpr unsigned int GL_STREAM_DRAW = 0x88E0;
+static constexpr unsigned int GL_STATIC_DRAW = 0x88E4;
+static constexpr unsigned int GL_FRAGMENT_SHADER = 0x8B30;
+static constexpr unsigned int GL_VERTEX_SHADER = 0x8B31;
+static constexpr unsigned int GL_COMPILE_STATUS = 0x8B81;
+static constexpr unsigned int GL_LINK_STATUS = 0x8B82;
+#endif
+#include <SDL_video.h>
+#include <cmath>
+
+// Attribute locations, as bound before linking the shader program
+static const unsigned int cornerAttribute = 0;
+static const unsigned int positionAttribute = 1;
+static const unsigned int orientationAttribute = 2;
+static const unsigned int sizeAttribute = 3;
+static const unsigned int textureRectAttribute = 4;
+
+// The shader compares the orientation against these values
+static_assert(RenderableSprites::RotatedTowardsPlayer == 0 && RenderableSprites::AlongXAxis == 1 &&
+    RenderableSprites::AlongYAxis == 2 && RenderableSprites::Isometric == 3, "Sprite orientations do not match the vertex shader");
+
+// Each instance is a quad from the bottom left corner to the top right corner, rotated around its position.
+// Sprites that face the player are a bit sunken into the floor. The depth shading is the same single light
+// as the fixed function pipeline applies to the other geometry in the 3D scene.
+static const char* vertexShaderSource =
+    "uniform vec2 playerDirection;\n"
+    "uniform bool depthShading;\n"
+    "attribute vec2 corner;\n"
+    "attribute vec3 position;\n"
+    "attribute float orientation;\n"
+    "attribute vec2 size;\n"
+    "attribute vec4 textureRect;\n"
+    "void main()\n"
+    "{\n"
+    "    vec2 direction =\n"
+    "        (orientation < 0.5) ? playerDirection :\n"
+    "        (orientation < 1.5) ? vec2(1.0, 0.0) :\n"
+    "        (orientation < 2.5) ? vec2(0.0, 1.0) :\n"
+    "        vec2(-0.70710678, 0.70710678);\n"
+    "    float zOffset = (orientation < 0.5) ? 0.0625 : 0.0;\n"
+    "    vec4 vertex = vec4(position.xy + direction * ((corner.x - 0.5) * size.x), position.z + zOffset + corner.y * size.y, 1.0);\n"
+    "    gl_TexCoord[0] = vec4(textureRect.xy + corner * textureRect.zw, 0.0, 1.0);\n"
+    "    if (depthShading)\n"
+    "    {\n"
+    "        vec4 eyeVertex = gl_ModelViewMatrix * vertex;\n"
+    "        vec3 toLight = normalize(gl_LightSource[1].position.xyz - eyeVertex.xyz);\n"
+    "        float diffuse = max(dot(normalize(gl_NormalMatrix * gl_Normal), toLight), 0.0);\n"
+    "        vec4 color = gl_FrontLightModelProduct.sceneColor + gl_FrontLightProduct[1].ambient + diffuse * gl_FrontLightProduct[1].diffuse;\n"
+    "        gl_FrontColor = vec4(clamp(color.rgb, 0.0, 1.0), gl_FrontMaterial.diffuse.a);\n"
+    "    }\n"
+    "    else\n"
+    "    {\n"
+    "        gl_FrontColor = gl_Color;\n"
+    "    }\n"
+    "    gl_Position = gl_ModelViewProjectionMatrix * vertex;\n"
+    "}\n";
+
+// Follows OpenGLPalette::LookupShaderSource, as the sprite texture can be palettized.
+static const char* fragmentShaderSource =
+    "uniform sampler2D spriteTexture;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = TextureColor(spriteTexture, gl_TexCoord[0].st) * gl_Color;\n"
+    "}\n";
+
+// Corners of the quad, in the same order as the sprites were drawn in immediate mode
+static const float corners[] = { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f };
+
+OpenGLInstancedSprites::OpenGLInstancedSprites() :
+    m_createShaderFuncPtr(nullptr),
+    m_shaderSourceFuncPtr(nullptr),
+    m_compileShaderFuncPtr(nullptr),
+    m_getShaderivFuncPtr(nullptr),
+    m_getShaderInfoLogFuncPtr(nullptr),
+    m_createProgramFuncPtr(nullptr),
+    m_attachShaderFuncPtr(nullptr),
+    m_bindAttribLocationFuncPtr(nullptr),
+    m_linkProgramFuncPtr(nullptr),
+    m_getProgramivFuncPtr(nullptr),
+    m_useProgramFuncPtr(nullptr),
+    m_getUniformLocationFuncPtr(nullptr),
+    m_uniform1iFuncPtr(nullptr),
+    m_uniform2fFuncPtr(nullptr),
+    m_genBuffersFuncPtr(nullptr),
+    m_bindBufferFuncPtr(nullptr),
+    m_bufferDataFuncPtr(nullptr),
+    m_vertexAttribPointerFuncPtr(nullptr),
+    m_enableVertexAttribArrayFuncPtr(nullptr),
+    m_disableVertexAttribArrayFuncPtr(nullptr),
+    m_vertexAttribDivisorFuncPtr(nullptr),
+    m_drawArraysInstancedFuncPtr(nullptr),
+    m_isSupported(false),
+    m_program(0),
+    m_playerDirectionLocation(-1),
+    m_depthShadingLocation(-1),
+    m_cornerBuffer(0),
+    m_instanceBuffer(0)
+{
+    // All shader and vertex attribute functions require OpenGL 2.0
+    m_createShaderFuncPtr = (GL_CreateShader_Func)SDL_GL_GetProcAddress("glCreateShader");
+    m_shaderSourceFuncPtr = (GL_ShaderSource_Func)SDL_GL_GetProcAddress("glShaderSource");
+    m_compileShaderFuncPtr = (GL_CompileShader_Func)SDL_GL_GetProcAddress("glCompileShader");
+    m_getShaderivFuncPtr = (GL_GetShaderiv_Func)SDL_GL_GetProcAddress("glGetShaderiv");
+    m_getShaderInfoLogFuncPtr = (GL_GetShaderInfoLog_Func)SDL_GL_GetProcAddress("glGetShaderInfoLog");
+    m_createProgramFuncPtr = (GL_CreateProgram_Func)SDL_GL_GetProcAddress("glCreateProgram");
+    m_attachShaderFuncPtr = (GL_AttachShader_Func)SDL_GL_GetProcAddress("glAttachShader");
+    m_bindAttribLocationFuncPtr = (GL_BindAttribLocation_Func)SDL_GL_GetProcAddress("glBindAttribLocation");
+    m_linkProgramFuncPtr = (GL_LinkProgram_Func)SDL_GL_GetProcAddress("glLinkProgram");
+    m_getProgramivFuncPtr = (GL_GetProgramiv_Func)SDL_GL_GetProcAddress("glGetProgramiv");
+    m_useProgramFuncPtr = (GL_UseProgram_Func)SDL_GL_GetProcAddress("glUseProgram");
+    m_getUniformLocationFuncPtr = (GL_GetUniformLocation_Func)SDL_GL_GetProcAddress("glGetUniformLocation");
+    m_uniform1iFuncPtr = (GL_Uniform1i_Func)SDL_GL_GetProcAddress("glUniform1i");
+    m_uniform2fFuncPtr = (GL_Uniform2f_Func)SDL_GL_GetProcAddress("glUniform2f");
+    m_vertexAttribPointerFuncPtr = (GL_VertexAttribPointer_Func)SDL_GL_GetProcAddress("glVertexAttribPointer");
+    m_enableVertexAttribArrayFuncPtr = (GL_EnableVertexAttribArray_Func)SDL_GL_GetProcAddress("glEnableVertexAttribArray");
+    m_disableVertexAttribArrayFuncPtr = (GL_DisableVertexAttribArray_Func)SDL_GL_GetProcAddress("glDisableVertexAttribArray");
+    // All buffer functions require OpenGL 1.5
+    m_genBuffersFuncPtr = (GL_GenBuffers_Func)SDL_GL_GetProcAddress("glGenBuffers");
+    m_bindBufferFuncPtr = (GL_BindBuffer_Func)SDL_GL_GetProcAddress("glBindBuffer");
+    m_bufferDataFuncPtr = (GL_BufferData_Func)SDL_GL_GetProcAddress("glBufferData");
+    // glVertexAttribDivisor requires OpenGL 3.3
+    m_vertexAttribDivisorFuncPtr = (GL_VertexAttribDivisor_Func)SDL_GL_GetProcAddress("glVertexAttribDivisor");
+    // glDrawArraysInstanced requires OpenGL 3.1
+    m_drawArraysInstancedFuncPtr = (GL_DrawArraysInstanced_Func)SDL_GL_GetProcAddress("glDrawArraysInstanced");
+    if (m_createShaderFuncPtr == nullptr ||
+        m_shaderSourceFuncPtr == nullptr ||
+        m_compileShaderFuncPtr == nullptr ||
+        m_getShaderivFuncPtr == nullptr ||
+        m_getShaderInfoLogFuncPtr == nullptr ||
+        m_createProgramFuncPtr == nullptr ||
+        m_attachShaderFuncPtr == nullptr ||
+        m_bindAttribLocationFuncPtr == nullptr ||
+        m_linkProgramFuncPtr == nullptr ||
+        m_getProgramivFuncPtr == nullptr ||
+        m_useProgramFuncPtr == nullptr ||
+        m_getUniformLocationFuncPtr == nullptr ||
+        m_uniform1iFuncPtr == nullptr ||
+        m_uniform2fFuncPtr == nullptr ||
+        m_genBuffersFuncPtr == nullptr ||
+        m_bindBufferFuncPtr == nullptr ||
+        m_bufferDataFuncPtr == nullptr ||
+        m_vertexAttribPointerFuncPtr == nullptr ||
+        m_enableVertexAttribArrayFuncPtr == nullptr ||
+        m_disableVertexAttribArrayFuncPtr == nullptr ||
+        m_vertexAttribDivisorFuncPtr == nullptr ||
+        m_drawArraysInstancedFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointers for OpenGL instancing; sprites are drawn one by one");
+        return;
+    }
+
+    if (!CompileProgram())
+    {
+        return;
+    }
+
+    m_genBuffersFuncPtr(1, &m_cornerBuffer);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_cornerBuffer);
+    m_bufferDataFuncPtr(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    m_genBuffersFuncPtr(1, &m_instanceBuffer);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, 0);
+
+    Logging::Instance().AddLogMessage("OpenGL instanced sprites are supported");
+    m_isSupported = true;
+}
+
+OpenGLInstancedSprites::~OpenGLInstancedSprites()
+{
+
+}
+
+bool OpenGLInstancedSprites::IsSupported() const
+{
+    return m_isSupported;
+}
+
+unsigned int OpenGLInstancedSprites::GetProgram() const
+{
+    return m_program;
+}
+
+void OpenGLInstancedSprites::Bind(const std::vector<spriteInstance>& instances, const float playerAngle, const bool depthShading)
+{
+    // Orphan the buffer of the previous frame, such that the upload does not have to wait for the draws that use it
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_instanceBuffer);
+    m_bufferDataFuncPtr(GL_ARRAY_BUFFER, (GLsizeiptr_Type)(instances.size() * sizeof(spriteInstance)), instances.data(), GL_STREAM_DRAW);
+
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_cornerBuffer);
+    m_vertexAttribPointerFuncPtr(cornerAttribute, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+    m_enableVertexAttribArrayFuncPtr(cornerAttribute);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_instanceBuffer);
+    m_enableVertexAttribArrayFuncPtr(positionAttribute);
+    m_enableVertexAttribArrayFuncPtr(orientationAttribute);
+    m_enableVertexAttribArrayFuncPtr(sizeAttribute);
+    m_enableVertexAttribArrayFuncPtr(textureRectAttribute);
+
+    const float radians = playerAngle * 3.14159265f / 180.0f;
+    m_useProgramFuncPtr(m_program);
+    m_uniform2fFuncPtr(m_playerDirectionLocation, std::cos(radians), std::sin(radians));
+    m_uniform1iFuncPtr(m_depthShadingLocation, depthShading ? 1 : 0);
+}
+
+void OpenGLInstancedSprites::Draw(const uint32_t firstInstance, const uint32_t numberOfInstances)
+{
+    // Without a base instance in OpenGL 3.3, the range is selected by offsetting the instance attributes
+    const size_t offset = firstInstance * sizeof(spriteInstance);
+    const int stride = (int)sizeof(spriteInstance);
+    m_vertexAttribPointerFuncPtr(positionAttribute, 3, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(spriteInstance, positionX)));
+    m_vertexAttribPointerFuncPtr(orientationAttribute, 1, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(spriteInstance, orientation)));
+    m_vertexAttribPointerFuncPtr(sizeAttribute, 2, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(spriteInstance, width)));
+    m_vertexAttribPointerFuncPtr(textureRectAttribute, 4, GL_FLOAT, GL_FALSE, stride, (const void*)(offset + offsetof(spriteInstance, textureLeft)));
+    m_drawArraysInstancedFuncPtr(GL_TRIANGLE_FAN, 0, 4, (int)numberOfInstances);
+}
+
+void OpenGLInstancedSprites::Unbind()
+{
+    m_useProgramFuncPtr(0);
+
+    m_disableVertexAttribArrayFuncPtr(cornerAttribute);
+    m_disableVertexAttribArrayFuncPtr(positionAttribute);
+    m_disableVertexAttribArrayFuncPtr(orientationAttribute);
+    m_disableVertexAttribArrayFuncPtr(sizeAttribute);
+    m_disableVertexAttribArrayFuncPtr(textureRectAttribute);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, 0);
+}
+
+bool OpenGLInstancedSprites::CompileProgram()
+{
+    const unsigned int vertexShader = CompileShader(GL_VERTEX_SHADER, { vertexShaderSource });
+    const unsigned int fragmentShader = CompileShader(GL_FRAGMENT_SHADER, { OpenGLPalette::LookupShaderSource, fragmentShaderSource });
+    if (vertexShader == 0 || fragmentShader == 0)
+    {
+        return false;
+    }
+
+    m_program = m_createProgramFuncPtr();
+    m_attachShaderFuncPtr(m_program, vertexShader);
+    m_attachShaderFuncPtr(m_program, fragmentShader);
+    m_bindAttribLocationFuncPtr(m_program, cornerAttribute, "corner");
+    m_bindAttribLocationFuncPtr(m_program, positionAttribute, "position");
+    m_bindAttribLocationFuncPtr(m_program, orientationAttribute, "orientation");
+    m_bindAttribLocationFuncPtr(m_program, sizeAttribute, "size");
+    m_bindAttribLocationFuncPtr(m_program, textureRectAttribute, "textureRect");
+    m_linkProgramFuncPtr(m_program);
+
+    int linkStatus = 0;
+    m_getProgramivFuncPtr(m_program, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == 0)
+    {
+        Logging::Instance().AddLogMessage("Failed to link instanced sprites shader program");
+        return false;
+    }
+
+    // The divisors are part of the vertex attribute state, which is only used by this class
+    m_vertexAttribDivisorFuncPtr(positionAttribute, 1);
+    m_vertexAttribDivisorFuncPtr(orientationAttribute, 1);
+    m_vertexAttribDivisorFuncPtr(sizeAttribute, 1);
+    m_vertexAttribDivisorFuncPtr(textureRectAttribute, 1);
+
+    m_useProgramFuncPtr(m_program);
+    m_uniform1iFuncPtr(m_getUniformLocationFuncPtr(m_program, "spriteTexture"), 0);
+    m_playerDirectionLocation = m_getUniformLocationFuncPtr(m_program, "playerDirection");
+    m_depthShadingLocation = m_getUniformLocationFuncPtr(m_program, "depthShading");
+    m_useProgramFuncPtr(0);
+
+    return true;
+}
+
+unsigned int OpenGLInstancedSprites::CompileShader(const unsigned int type, const std::vector<const char*>& sources)
+{
+    const unsigned int shader = m_createShaderFuncPtr(type);
+    m_shaderSourceFuncPtr(shader, (int)sources.size(), (const GLchar_Type**)sources.data(), nullptr);
+    m_compileShaderFuncPtr(shader);
+
+    int compileStatus = 0;
+    m_getShaderivFuncPtr(shader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == 0)
+    {
+        char infoLog[512];
+        m_getShaderInfoLogFuncPtr(shader, sizeof(infoLog), nullptr, infoLog);
+        Logging::Instance().AddLogMessage("Failed to compile instanced sprites shader: " + std::string(infoLog));
+        return 0;
+    }
+
+    return shader;
+}
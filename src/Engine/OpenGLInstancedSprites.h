@@ -0,0 +1,120 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OpenGLInstancedSprites
+//
+// Renders the sprites of a frame from a single buffer of instance records, which is uploaded once per frame.
+// A vertex shader turns each instance into a quad with the orientation of the sprite, such that a run of sprites
+// that share a texture takes a single draw call. Requires OpenGL 3.3.
+//
+#pragma once
+
+#include "Macros.h"
+#include "OpenGLBasic.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+class OpenGLInstancedSprites
+{
+public:
+    // Orientation is one of RenderableSprites::SpriteOrientation, stored as a float for the vertex shader.
+    // The texture rectangle is in relative texture coordinates, as the sprite can be part of an atlas.
+    typedef struct
+    {
+        float positionX;
+        float positionY;
+        float positionZ;
+        float orientation;
+        float width;
+        float height;
+        float textureLeft;
+        float textureTop;
+        float textureWidth;
+        float textureHeight;
+    } spriteInstance;
+
+    OpenGLInstancedSprites();
+    ~OpenGLInstancedSprites();
+
+    bool IsSupported() const;
+    unsigned int GetProgram() const;
+
+    // Uploads the instances and binds the shader program. The player angle is in degrees, as in RenderableSprites.
+    void Bind(const std::vector<spriteInstance>& instances, const float playerAngle, const bool depthShading);
+    // Draws a range of the uploaded instances with the currently bound texture.
+    void Draw(const uint32_t firstInstance, const uint32_t numberOfInstances);
+    void Unbind();
+
+private:
+    bool CompileProgram();
+    unsigned int CompileShader(const unsigned int type, const std::vector<const char*>& sources);
+
+    typedef char GLchar_Type;
+    typedef ptrdiff_t GLsizeiptr_Type;
+    typedef unsigned int (CALLBACK* GL_CreateShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_ShaderSource_Func)(unsigned int, int, const GLchar_Type**, const int*);
+    typedef void (CALLBACK* GL_CompileShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetShaderiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_GetShaderInfoLog_Func)(unsigned int, int, int*, GLchar_Type*);
+    typedef unsigned int (CALLBACK* GL_CreateProgram_Func)();
+    typedef void (CALLBACK* GL_AttachShader_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_BindAttribLocation_Func)(unsigned int, unsigned int, const GLchar_Type*);
+    typedef void (CALLBACK* GL_LinkProgram_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetProgramiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_UseProgram_Func)(unsigned int);
+    typedef int (CALLBACK* GL_GetUniformLocation_Func)(unsigned int, const GLchar_Type*);
+    typedef void (CALLBACK* GL_Uniform1i_Func)(int, int);
+    typedef void (CALLBACK* GL_Uniform2f_Func)(int, float, float);
+    typedef void (CALLBACK* GL_GenBuffers_Func)(int, unsigned int*);
+    typedef void (CALLBACK* GL_BindBuffer_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_BufferData_Func)(unsigned int, GLsizeiptr_Type, const void*, unsigned int);
+    typedef void (CALLBACK* GL_VertexAttribPointer_Func)(unsigned int, int, unsigned int, unsigned char, int, const void*);
+    typedef void (CALLBACK* GL_EnableVertexAttribArray_Func)(unsigned int);
+    typedef void (CALLBACK* GL_DisableVertexAttribArray_Func)(unsigned int);
+    typedef void (CALLBACK* GL_VertexAttribDivisor_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_DrawArraysInstanced_Func)(unsigned int, int, int, int);
+
+    GL_CreateShader_Func m_createShaderFuncPtr;
+    GL_ShaderSource_Func m_shaderSourceFuncPtr;
+    GL_CompileShader_Func m_compileShaderFuncPtr;
+    GL_GetShaderiv_Func m_getShaderivFuncPtr;
+    GL_GetShaderInfoLog_Func m_getShaderInfoLogFuncPtr;
+    GL_CreateProgram_Func m_createProgramFuncPtr;
+    GL_AttachShader_Func m_attachShaderFuncPtr;
+    GL_BindAttribLocation_Func m_bindAttribLocationFuncPtr;
+    GL_LinkProgram_Func m_linkProgramFuncPtr;
+    GL_GetProgramiv_Func m_getProgramivFuncPtr;
+    GL_UseProgram_Func m_useProgramFuncPtr;
+    GL_GetUniformLocation_Func m_getUniformLocationFuncPtr;
+    GL_Uniform1i_Func m_uniform1iFuncPtr;
+    GL_Uniform2f_Func m_uniform2fFuncPtr;
+    GL_GenBuffers_Func m_genBuffersFuncPtr;
+    GL_BindBuffer_Func m_bindBufferFuncPtr;
+    GL_BufferData_Func m_bufferDataFuncPtr;
+    GL_VertexAttribPointer_Func m_vertexAttribPointerFuncPtr;
+    GL_EnableVertexAttribArray_Func m_enableVertexAttribArrayFuncPtr;
+    GL_DisableVertexAttribArray_Func m_disableVertexAttribArrayFuncPtr;
+    GL_VertexAttribDivisor_Func m_vertexAttribDivisorFuncPtr;
+    GL_DrawArraysInstanced_Func m_drawArraysInstancedFuncPtr;
+
+    bool m_isSupported;
+    unsigned int m_program;
+    int m_playerDirectionLocation;
+    int m_depthShadingLocation;
+    unsigned int m_cornerBuffer;
+    unsigned int m_instanceBuffer;
+};
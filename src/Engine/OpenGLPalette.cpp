@@ -0,0 +1,257 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OpenGLPalette.h"
+#include "EgaColor.h"
+#include "Logging.h"
+#ifndef _WIN32
+#include <GL/glext.h>
+#else
+// The file glext.h is not available in the Visual Studio Platform Toolset.
+// Below are the specific definitions from glext.h that are needed in this source file.
+static constexpr unsigned int GL_FRAGMENT_SHADER = 0x8B30;
+static constexpr unsigned int GL_COMPILE_STATUS = 0x8B81;
+static constexpr unsigned int GL_LINK_STATUS = 0x8B82;
+#endif
+#include <SDL_video.h>
+#include <string>
+
+// The palette holds the 16 EGA colors, followed by the transparent color. The indices are stored in a luminance
+// texture, from which they are read back as index / 255. With linear filtering, the colors of the four nearest
+// texels are blended, as the fixed function pipeline does for RGBA textures.
+const char* const OpenGLPalette::LookupShaderSource =
+    "uniform vec4 palette[17];\n"
+    "// Width and height of the texture, whether it is palettized, and whether it is filtered linearly\n"
+    "uniform vec4 textureParameters;\n"
+    "vec4 PaletteColor(sampler2D image, vec2 coordinates)\n"
+    "{\n"
+    "    return palette[int(texture2D(image, coordinates).r * 255.0 + 0.5)];\n"
+    "}\n"
+    "vec4 TextureColor(sampler2D image, vec2 coordinates)\n"
+    "{\n"
+    "    if (textureParameters.z < 0.5)\n"
+    "    {\n"
+    "        return texture2D(image, coordinates);\n"
+    "    }\n"
+    "    if (textureParameters.w < 0.5)\n"
+    "    {\n"
+    "        return PaletteColor(image, coordinates);\n"
+    "    }\n"
+    "    vec2 texelSize = 1.0 / textureParameters.xy;\n"
+    "    vec2 texel = coordinates * textureParameters.xy - 0.5;\n"
+    "    vec2 weight = fract(texel);\n"
+    "    vec2 topLeft = (floor(texel) + 0.5) * texelSize;\n"
+    "    vec4 top = mix(PaletteColor(image, topLeft), PaletteColor(image, topLeft + vec2(texelSize.x, 0.0)), weight.x);\n"
+    "    vec4 bottom = mix(PaletteColor(image, topLeft + vec2(0.0, texelSize.y)), PaletteColor(image, topLeft + texelSize), weight.x);\n"
+    "    return mix(top, bottom, weight.y);\n"
+    "}\n";
+
+static_assert(EgaPaletteSize == 17, "Palette size does not match the fragment shader");
+
+// Only replaces the texture lookup of the fixed function pipeline, which still does the lighting and alpha test.
+static const char* fragmentShaderSource =
+    "uniform sampler2D image;\n"
+    "void main()\n"
+    "{\n"
+    "    gl_FragColor = TextureColor(image, gl_TexCoord[0].st) * gl_Color;\n"
+    "}\n";
+
+OpenGLPalette::OpenGLPalette() :
+    m_createShaderFuncPtr(nullptr),
+    m_shaderSourceFuncPtr(nullptr),
+    m_compileShaderFuncPtr(nullptr),
+    m_getShaderivFuncPtr(nullptr),
+    m_getShaderInfoLogFuncPtr(nullptr),
+    m_createProgramFuncPtr(nullptr),
+    m_attachShaderFuncPtr(nullptr),
+    m_linkProgramFuncPtr(nullptr),
+    m_getProgramivFuncPtr(nullptr),
+    m_useProgramFuncPtr(nullptr),
+    m_getUniformLocationFuncPtr(nullptr),
+    m_uniform1iFuncPtr(nullptr),
+    m_uniform4fFuncPtr(nullptr),
+    m_uniform4fvFuncPtr(nullptr),
+    m_isSupported(false),
+    m_program(0),
+    m_hostProgram(0),
+    m_isProgramInUse(false),
+    m_uniforms()
+{
+    // All shader functions require OpenGL 2.0
+    m_createShaderFuncPtr = (GL_CreateShader_Func)SDL_GL_GetProcAddress("glCreateShader");
+    m_shaderSourceFuncPtr = (GL_ShaderSource_Func)SDL_GL_GetProcAddress("glShaderSource");
+    m_compileShaderFuncPtr = (GL_CompileShader_Func)SDL_GL_GetProcAddress("glCompileShader");
+    m_getShaderivFuncPtr = (GL_GetShaderiv_Func)SDL_GL_GetProcAddress("glGetShaderiv");
+    m_getShaderInfoLogFuncPtr = (GL_GetShaderInfoLog_Func)SDL_GL_GetProcAddress("glGetShaderInfoLog");
+    m_createProgramFuncPtr = (GL_CreateProgram_Func)SDL_GL_GetProcAddress("glCreateProgram");
+    m_attachShaderFuncPtr = (GL_AttachShader_Func)SDL_GL_GetProcAddress("glAttachShader");
+    m_linkProgramFuncPtr = (GL_LinkProgram_Func)SDL_GL_GetProcAddress("glLinkProgram");
+    m_getProgramivFuncPtr = (GL_GetProgramiv_Func)SDL_GL_GetProcAddress("glGetProgramiv");
+    m_useProgramFuncPtr = (GL_UseProgram_Func)SDL_GL_GetProcAddress("glUseProgram");
+    m_getUniformLocationFuncPtr = (GL_GetUniformLocation_Func)SDL_GL_GetProcAddress("glGetUniformLocation");
+    m_uniform1iFuncPtr = (GL_Uniform1i_Func)SDL_GL_GetProcAddress("glUniform1i");
+    m_uniform4fFuncPtr = (GL_Uniform4f_Func)SDL_GL_GetProcAddress("glUniform4f");
+    m_uniform4fvFuncPtr = (GL_Uniform4fv_Func)SDL_GL_GetProcAddress("glUniform4fv");
+    if (m_createShaderFuncPtr == nullptr ||
+        m_shaderSourceFuncPtr == nullptr ||
+        m_compileShaderFuncPtr == nullptr ||
+        m_getShaderivFuncPtr == nullptr ||
+        m_getShaderInfoLogFuncPtr == nullptr ||
+        m_createProgramFuncPtr == nullptr ||
+        m_attachShaderFuncPtr == nullptr ||
+        m_linkProgramFuncPtr == nullptr ||
+        m_getProgramivFuncPtr == nullptr ||
+        m_useProgramFuncPtr == nullptr ||
+        m_getUniformLocationFuncPtr == nullptr ||
+        m_uniform1iFuncPtr == nullptr ||
+        m_uniform4fFuncPtr == nullptr ||
+        m_uniform4fvFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointers for OpenGL palettized textures; fallback to RGBA textures");
+        return;
+    }
+
+    if (!CompileProgram())
+    {
+        return;
+    }
+
+    Logging::Instance().AddLogMessage("OpenGL palettized textures are supported");
+    m_isSupported = true;
+}
+
+OpenGLPalette::~OpenGLPalette()
+{
+
+}
+
+bool OpenGLPalette::IsSupported() const
+{
+    return m_isSupported;
+}
+
+void OpenGLPalette::ApplyTexture(const bool palettized, const uint32_t textureWidth, const uint32_t textureHeight, const bool linearFilter)
+{
+    if (!m_isSupported)
+    {
+        return;
+    }
+
+    if (m_hostProgram == 0)
+    {
+        if (!palettized)
+        {
+            Reset();
+            return;
+        }
+
+        if (!m_isProgramInUse)
+        {
+            m_useProgramFuncPtr(m_program);
+            m_isProgramInUse = true;
+        }
+    }
+
+    const programUniforms& uniforms = GetUniforms((m_hostProgram != 0) ? m_hostProgram : m_program);
+    m_uniform4fFuncPtr(uniforms.textureParameters, (float)textureWidth, (float)textureHeight, palettized ? 1.0f : 0.0f, linearFilter ? 1.0f : 0.0f);
+}
+
+void OpenGLPalette::SetHostProgram(const unsigned int program)
+{
+    // The host program replaces the palette program that may have been in use
+    m_hostProgram = program;
+    m_isProgramInUse = false;
+}
+
+void OpenGLPalette::Reset()
+{
+    if (m_isProgramInUse)
+    {
+        m_useProgramFuncPtr(0);
+        m_isProgramInUse = false;
+    }
+}
+
+bool OpenGLPalette::CompileProgram()
+{
+    const unsigned int fragmentShader = m_createShaderFuncPtr(GL_FRAGMENT_SHADER);
+    const char* sources[] = { LookupShaderSource, fragmentShaderSource };
+    m_shaderSourceFuncPtr(fragmentShader, 2, sources, nullptr);
+    m_compileShaderFuncPtr(fragmentShader);
+
+    int compileStatus = 0;
+    m_getShaderivFuncPtr(fragmentShader, GL_COMPILE_STATUS, &compileStatus);
+    if (compileStatus == 0)
+    {
+        char infoLog[512];
+        m_getShaderInfoLogFuncPtr(fragmentShader, sizeof(infoLog), nullptr, infoLog);
+        Logging::Instance().AddLogMessage("Failed to compile palette shader: " + std::string(infoLog));
+        return false;
+    }
+
+    m_program = m_createProgramFuncPtr();
+    m_attachShaderFuncPtr(m_program, fragmentShader);
+    m_linkProgramFuncPtr(m_program);
+
+    int linkStatus = 0;
+    m_getProgramivFuncPtr(m_program, GL_LINK_STATUS, &linkStatus);
+    if (linkStatus == 0)
+    {
+        Logging::Instance().AddLogMessage("Failed to link palette shader program");
+        return false;
+    }
+
+    m_useProgramFuncPtr(m_program);
+    m_uniform1iFuncPtr(m_getUniformLocationFuncPtr(m_program, "image"), 0);
+    GetUniforms(m_program);
+    m_useProgramFuncPtr(0);
+
+    return true;
+}
+
+// The program must be in use, as the palette is uploaded into it the first time.
+const OpenGLPalette::programUniforms& OpenGLPalette::GetUniforms(const unsigned int program)
+{
+    const auto it = m_uniforms.find(program);
+    if (it != m_uniforms.end())
+    {
+        return it->second;
+    }
+
+    const programUniforms uniforms =
+    {
+        m_getUniformLocationFuncPtr(program, "palette"),
+        m_getUniformLocationFuncPtr(program, "textureParameters")
+    };
+
+    float palette[EgaPaletteSize * 4];
+    for (uint8_t i = 0; i < EgaRange; i++)
+    {
+        const rgbColor color = EgaToRgb((egaColor)i);
+        palette[(i * 4)] = (float)color.red / 255.0f;
+        palette[(i * 4) + 1] = (float)color.green / 255.0f;
+        palette[(i * 4) + 2] = (float)color.blue / 255.0f;
+        palette[(i * 4) + 3] = 1.0f;
+    }
+
+    // Transparent pixels are black, as in the RGBA textures, such that linear filtering blends them the same way
+    for (uint8_t c = 0; c < 4; c++)
+    {
+        palette[(EgaTransparentIndex * 4) + c] = 0.0f;
+    }
+    m_uniform4fvFuncPtr(uniforms.palette, EgaPaletteSize, palette);
+
+    return m_uniforms.insert(std::make_pair(program, uniforms)).first->second;
+}
@@ -0,0 +1,96 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OpenGLPalette
+//
+// Resolves the colors of palettized textures, which hold an EGA color index per pixel, via a palette in a fragment
+// shader. As the indices cannot be filtered, linear filtering is done in the shader as well. Shader programs of other
+// classes can look up the palette too, by including the lookup functions in their fragment shader. Requires OpenGL 2.0.
+//
+#pragma once
+
+#include "Macros.h"
+#include "OpenGLBasic.h"
+#include <map>
+#include <stdint.h>
+
+class OpenGLPalette
+{
+public:
+    OpenGLPalette();
+    ~OpenGLPalette();
+
+    bool IsSupported() const;
+
+    // To be called after a texture is bound. Without a host program, the palette program is used for a palettized
+    // texture and the fixed function pipeline for an RGBA texture.
+    void ApplyTexture(const bool palettized, const uint32_t textureWidth, const uint32_t textureHeight, const bool linearFilter);
+    // Passes the bound textures to the given shader program instead, until it is set to 0.
+    void SetHostProgram(const unsigned int program);
+    // Restores the fixed function pipeline, before another shader program is used.
+    void Reset();
+
+    // Declares the function vec4 TextureColor(sampler2D image, vec2 coordinates), which returns the color of a
+    // palettized or RGBA texture.
+    static const char* const LookupShaderSource;
+
+private:
+    typedef struct
+    {
+        int palette;
+        int textureParameters;
+    } programUniforms;
+
+    bool CompileProgram();
+    const programUniforms& GetUniforms(const unsigned int program);
+
+    typedef char GLchar_Type;
+    typedef unsigned int (CALLBACK* GL_CreateShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_ShaderSource_Func)(unsigned int, int, const GLchar_Type**, const int*);
+    typedef void (CALLBACK* GL_CompileShader_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetShaderiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_GetShaderInfoLog_Func)(unsigned int, int, int*, GLchar_Type*);
+    typedef unsigned int (CALLBACK* GL_CreateProgram_Func)();
+    typedef void (CALLBACK* GL_AttachShader_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_LinkProgram_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetProgramiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_UseProgram_Func)(unsigned int);
+    typedef int (CALLBACK* GL_GetUniformLocation_Func)(unsigned int, const GLchar_Type*);
+    typedef void (CALLBACK* GL_Uniform1i_Func)(int, int);
+    typedef void (CALLBACK* GL_Uniform4f_Func)(int, float, float, float, float);
+    typedef void (CALLBACK* GL_Uniform4fv_Func)(int, int, const float*);
+
+    GL_CreateShader_Func m_createShaderFuncPtr;
+    GL_ShaderSource_Func m_shaderSourceFuncPtr;
+    GL_CompileShader_Func m_compileShaderFuncPtr;
+    GL_GetShaderiv_Func m_getShaderivFuncPtr;
+    GL_GetShaderInfoLog_Func m_getShaderInfoLogFuncPtr;
+    GL_CreateProgram_Func m_createProgramFuncPtr;
+    GL_AttachShader_Func m_attachShaderFuncPtr;
+    GL_LinkProgram_Func m_linkProgramFuncPtr;
+    GL_GetProgramiv_Func m_getProgramivFuncPtr;
+    GL_UseProgram_Func m_useProgramFuncPtr;
+    GL_GetUniformLocation_Func m_getUniformLocationFuncPtr;
+    GL_Uniform1i_Func m_uniform1iFuncPtr;
+    GL_Uniform4f_Func m_uniform4fFuncPtr;
+    GL_Uniform4fv_Func m_uniform4fvFuncPtr;
+
+    bool m_isSupported;
+    unsigned int m_program;
+    unsigned int m_hostProgram;
+    bool m_isProgramInUse;
+    std::map<unsigned int, programUniforms> m_uniforms;
+};
@@ -0,0 +1,150 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OpenGLStateCache.h"
+
+// State that is not in this list is passed on as is
+static const unsigned int trackedCapabilities[] =
+{
+    GL_BLEND,
+    GL_CULL_FACE,
+    GL_DEPTH_TEST,
+    GL_LIGHTING,
+    GL_STENCIL_TEST,
+    GL_TEXTURE_2D
+};
+
+OpenGLStateCache::OpenGLStateCache(const OpenGLBasic& openGLBasic) :
+    m_openGLBasic(openGLBasic),
+    m_isTextureBindingKnown(false),
+    m_boundTextureId(0),
+    m_textureFilters(),
+    m_blendSourceFactor(0),
+    m_blendDestinationFactor(0),
+    m_depthMask(Unknown)
+{
+    static_assert(sizeof(trackedCapabilities) / sizeof(trackedCapabilities[0]) == CapabilityCount, "Capability count does not match the tracked capabilities");
+    Invalidate();
+}
+
+OpenGLStateCache::~OpenGLStateCache()
+{
+
+}
+
+bool OpenGLStateCache::BindTexture(const unsigned int textureId)
+{
+    if (m_isTextureBindingKnown && textureId == m_boundTextureId)
+    {
+        return false;
+    }
+
+    m_openGLBasic.GlBindTexture(GL_TEXTURE_2D, textureId);
+    m_boundTextureId = textureId;
+    m_isTextureBindingKnown = true;
+    return true;
+}
+
+void OpenGLStateCache::SetTextureFilter(const int filter)
+{
+    const auto textureFilter = m_textureFilters.find(m_boundTextureId);
+    if (textureFilter != m_textureFilters.end() && textureFilter->second == filter)
+    {
+        return;
+    }
+
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    m_openGLBasic.GlTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    m_textureFilters[m_boundTextureId] = filter;
+}
+
+void OpenGLStateCache::SetCapability(const unsigned int capability, const bool enabled)
+{
+    uint8_t index = 0;
+    while (index < CapabilityCount && trackedCapabilities[index] != capability)
+    {
+        index++;
+    }
+
+    if (index < CapabilityCount)
+    {
+        if (m_capabilities[index] == (int8_t)enabled)
+        {
+            return;
+        }
+        m_capabilities[index] = (int8_t)enabled;
+    }
+
+    if (enabled)
+    {
+        m_openGLBasic.GlEnable(capability);
+    }
+    else
+    {
+        m_openGLBasic.GlDisable(capability);
+    }
+}
+
+void OpenGLStateCache::SetBlendFunc(const unsigned int sourceFactor, const unsigned int destinationFactor)
+{
+    if (sourceFactor == m_blendSourceFactor && destinationFactor == m_blendDestinationFactor)
+    {
+        return;
+    }
+
+    m_openGLBasic.GlBlendFunc(sourceFactor, destinationFactor);
+    m_blendSourceFactor = sourceFactor;
+    m_blendDestinationFactor = destinationFactor;
+}
+
+void OpenGLStateCache::SetDepthMask(const bool enabled)
+{
+    if (m_depthMask == (int8_t)enabled)
+    {
+        return;
+    }
+
+    m_openGLBasic.GlDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    m_depthMask = (int8_t)enabled;
+}
+
+void OpenGLStateCache::ForgetTexture(const unsigned int textureId)
+{
+    m_textureFilters.erase(textureId);
+    if (textureId == m_boundTextureId)
+    {
+        m_isTextureBindingKnown = false;
+    }
+}
+
+void OpenGLStateCache::InvalidateTextureBinding()
+{
+    m_isTextureBindingKnown = false;
+}
+
+void OpenGLStateCache::Invalidate()
+{
+    m_isTextureBindingKnown = false;
+    m_textureFilters.clear();
+    for (uint8_t i = 0; i < CapabilityCount; i++)
+    {
+        m_capabilities[i] = Unknown;
+    }
+
+    // GL_ZERO is never requested as source factor, so the first blend function is always passed on
+    m_blendSourceFactor = GL_ZERO;
+    m_blendDestinationFactor = GL_ZERO;
+    m_depthMask = Unknown;
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OpenGLStateCache
+//
+// Keeps track of the OpenGL state that the renderer changes most often, such that redundant changes are not passed
+// on to the driver. The texture filter is stored per texture, as it is part of the texture object, and is only set
+// again when it differs. State that is changed without the cache, for instance by a shader class, must be
+// invalidated afterwards.
+//
+#pragma once
+
+#include "OpenGLBasic.h"
+#include <map>
+#include <stdint.h>
+
+class OpenGLStateCache
+{
+public:
+    OpenGLStateCache(const OpenGLBasic& openGLBasic);
+    ~OpenGLStateCache();
+
+    // Returns false if the texture was already bound.
+    bool BindTexture(const unsigned int textureId);
+    // Applies to the texture that is bound via BindTexture.
+    void SetTextureFilter(const int filter);
+    void SetCapability(const unsigned int capability, const bool enabled);
+    void SetBlendFunc(const unsigned int sourceFactor, const unsigned int destinationFactor);
+    void SetDepthMask(const bool enabled);
+
+    // To be called when the texture is deleted or its parameters are changed without the cache.
+    void ForgetTexture(const unsigned int textureId);
+    // To be called when another texture is bound without the cache.
+    void InvalidateTextureBinding();
+    void Invalidate();
+
+private:
+    static const uint8_t CapabilityCount = 6;
+    static const int8_t Unknown = -1;
+
+    const OpenGLBasic& m_openGLBasic;
+    bool m_isTextureBindingKnown;
+    unsigned int m_boundTextureId;
+    std::map<unsigned int, int> m_textureFilters;
+    int8_t m_capabilities[CapabilityCount];
+    unsigned int m_blendSourceFactor;
+    unsigned int m_blendDestinationFactor;
+    int8_t m_depthMask;
+};
@@ -0,0 +1,149 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OpenGLTileMesh.h"
+#include "Logging.h"
+#ifndef _WIN32
+#include <GL/glext.h>
+#else
+// The file glext.h is not available in the Visual Studio Platform Toolset.
+// Below are the specific definitions from glext.h that are needed in this source file.
+static constexpr unsigned int GL_ARRAY_BUFFER = 0x8892;
+static constexpr unsigned int GL_STATIC_DRAW = 0x88E4;
+#endif
+#include <SDL_video.h>
+
+typedef struct
+{
+    float s;
+    float t;
+    float x;
+    float y;
+    float z;
+} tileVertex;
+
+OpenGLTileMesh::OpenGLTileMesh() :
+    m_genBuffersFuncPtr(nullptr),
+    m_bindBufferFuncPtr(nullptr),
+    m_bufferDataFuncPtr(nullptr),
+    m_multiDrawArraysFuncPtr(nullptr),
+    m_interleavedArraysFuncPtr(nullptr),
+    m_disableClientStateFuncPtr(nullptr),
+    m_isSupported(false),
+    m_buffer(0),
+    m_mapWidth(0),
+    m_mapHeight(0),
+    m_firstVertices(),
+    m_vertexCounts()
+{
+    // All buffer functions require OpenGL 1.5
+    m_genBuffersFuncPtr = (GL_GenBuffers_Func)SDL_GL_GetProcAddress("glGenBuffers");
+    m_bindBufferFuncPtr = (GL_BindBuffer_Func)SDL_GL_GetProcAddress("glBindBuffer");
+    m_bufferDataFuncPtr = (GL_BufferData_Func)SDL_GL_GetProcAddress("glBufferData");
+    // glMultiDrawArrays requires OpenGL 1.4
+    m_multiDrawArraysFuncPtr = (GL_MultiDrawArrays_Func)SDL_GL_GetProcAddress("glMultiDrawArrays");
+    // Vertex arrays require OpenGL 1.1
+    m_interleavedArraysFuncPtr = (GL_InterleavedArrays_Func)SDL_GL_GetProcAddress("glInterleavedArrays");
+    m_disableClientStateFuncPtr = (GL_DisableClientState_Func)SDL_GL_GetProcAddress("glDisableClientState");
+    if (m_genBuffersFuncPtr == nullptr ||
+        m_bindBufferFuncPtr == nullptr ||
+        m_bufferDataFuncPtr == nullptr ||
+        m_multiDrawArraysFuncPtr == nullptr ||
+        m_interleavedArraysFuncPtr == nullptr ||
+        m_disableClientStateFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointers for OpenGL vertex buffers; floor tiles are drawn one by one");
+        return;
+    }
+
+    m_genBuffersFuncPtr(1, &m_buffer);
+
+    Logging::Instance().AddLogMessage("OpenGL vertex buffers are supported");
+    m_isSupported = true;
+}
+
+OpenGLTileMesh::~OpenGLTileMesh()
+{
+
+}
+
+bool OpenGLTileMesh::IsSupported() const
+{
+    return m_isSupported;
+}
+
+void OpenGLTileMesh::Prepare(const uint16_t mapWidth, const uint16_t mapHeight)
+{
+    if (mapWidth == m_mapWidth && mapHeight == m_mapHeight)
+    {
+        return;
+    }
+
+    // Four vertices per tile, row by row, such that consecutive tiles on a row are a single range of vertices
+    std::vector<tileVertex> vertices;
+    vertices.reserve((size_t)mapWidth * mapHeight * 4);
+    for (uint16_t y = 0; y < mapHeight; y++)
+    {
+        for (uint16_t x = 0; x < mapWidth; x++)
+        {
+            const float tileX = (float)x;
+            const float tileY = (float)y;
+            vertices.push_back(tileVertex{ 0.0f, 1.0f, tileX + 1.0f, tileY, 0.0f });        // Bottom Left
+            vertices.push_back(tileVertex{ 1.0f, 1.0f, tileX + 1.0f, tileY + 1.0f, 0.0f }); // Bottom Right
+            vertices.push_back(tileVertex{ 1.0f, 0.0f, tileX, tileY + 1.0f, 0.0f });        // Top Right
+            vertices.push_back(tileVertex{ 0.0f, 0.0f, tileX, tileY, 0.0f });               // Top Left
+        }
+    }
+
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_buffer);
+    m_bufferDataFuncPtr(GL_ARRAY_BUFFER, (GLsizeiptr_Type)(vertices.size() * sizeof(tileVertex)), vertices.data(), GL_STATIC_DRAW);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, 0);
+
+    m_mapWidth = mapWidth;
+    m_mapHeight = mapHeight;
+}
+
+uint32_t OpenGLTileMesh::Draw(const std::vector<Renderable3DTiles::tileRow>& tileRows)
+{
+    m_firstVertices.clear();
+    m_vertexCounts.clear();
+    uint32_t numberOfVertices = 0;
+    for (const Renderable3DTiles::tileRow& row : tileRows)
+    {
+        if (row.x < 0 || row.y < 0 || row.y >= m_mapHeight || row.x + row.length > m_mapWidth)
+        {
+            // Not part of the mesh
+            continue;
+        }
+        m_firstVertices.push_back(((row.y * m_mapWidth) + row.x) * 4);
+        m_vertexCounts.push_back(row.length * 4);
+        numberOfVertices += row.length * 4;
+    }
+
+    if (m_firstVertices.empty())
+    {
+        return 0;
+    }
+
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, m_buffer);
+    // Enables the vertex and texture coordinate arrays
+    m_interleavedArraysFuncPtr(GL_T2F_V3F, 0, nullptr);
+    m_multiDrawArraysFuncPtr(GL_QUADS, m_firstVertices.data(), m_vertexCounts.data(), (int)m_firstVertices.size());
+    m_disableClientStateFuncPtr(GL_TEXTURE_COORD_ARRAY);
+    m_disableClientStateFuncPtr(GL_VERTEX_ARRAY);
+    m_bindBufferFuncPtr(GL_ARRAY_BUFFER, 0);
+
+    return numberOfVertices;
+}
@@ -0,0 +1,65 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OpenGLTileMesh
+//
+// Keeps a quad for every tile of the map in a vertex buffer in GPU memory, as the floor and ceiling tiles
+// never move. Each frame, only the ranges of visible tiles are passed to a single draw call. Requires OpenGL 1.5.
+//
+#pragma once
+
+#include "Macros.h"
+#include "OpenGLBasic.h"
+#include "Renderable3DTiles.h"
+#include <cstddef>
+#include <vector>
+
+class OpenGLTileMesh
+{
+public:
+    OpenGLTileMesh();
+    ~OpenGLTileMesh();
+
+    bool IsSupported() const;
+
+    // Builds the mesh when the map size differs from the current mesh. The tiles are at height zero.
+    void Prepare(const uint16_t mapWidth, const uint16_t mapHeight);
+    // Draws the given rows of tiles with the currently bound texture; returns the number of vertices.
+    uint32_t Draw(const std::vector<Renderable3DTiles::tileRow>& tileRows);
+
+private:
+    typedef ptrdiff_t GLsizeiptr_Type;
+    typedef void (CALLBACK* GL_GenBuffers_Func)(int, unsigned int*);
+    typedef void (CALLBACK* GL_BindBuffer_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_BufferData_Func)(unsigned int, GLsizeiptr_Type, const void*, unsigned int);
+    typedef void (CALLBACK* GL_MultiDrawArrays_Func)(unsigned int, const int*, const int*, int);
+    typedef void (CALLBACK* GL_InterleavedArrays_Func)(unsigned int, int, const void*);
+    typedef void (CALLBACK* GL_DisableClientState_Func)(unsigned int);
+
+    GL_GenBuffers_Func m_genBuffersFuncPtr;
+    GL_BindBuffer_Func m_bindBufferFuncPtr;
+    GL_BufferData_Func m_bufferDataFuncPtr;
+    GL_MultiDrawArrays_Func m_multiDrawArraysFuncPtr;
+    GL_InterleavedArrays_Func m_interleavedArraysFuncPtr;
+    GL_DisableClientState_Func m_disableClientStateFuncPtr;
+
+    bool m_isSupported;
+    unsigned int m_buffer;
+    uint16_t m_mapWidth;
+    uint16_t m_mapHeight;
+    std::vector<int> m_firstVertices;
+    std::vector<int> m_vertexCounts;
+};
@@ -0,0 +1,164 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OpenGLTimerQueries.h"
+#include "../Engine/Logging.h"
+#ifndef _WIN32
+#include <GL/glext.h>
+#else
+// The file glext.h is not available in the Visual Studio Platform Toolset.
+// Below are the specific definitions from glext.h that are needed in this source file.
+static constexpr unsigned int GL_QUERY_RESULT = 0x8866;
+static constexpr unsigned int GL_QUERY_RESULT_AVAILABLE = 0x8867;
+static constexpr unsigned int GL_TIME_ELAPSED = 0x88BF;
+#endif
+#include <SDL_video.h>
+
+OpenGLTimerQueries::OpenGLTimerQueries() :
+    m_genQueriesFuncPtr(nullptr),
+    m_beginQueryFuncPtr(nullptr),
+    m_endQueryFuncPtr(nullptr),
+    m_getQueryObjectivFuncPtr(nullptr),
+    m_getQueryObjectui64vFuncPtr(nullptr),
+    m_isSupported(false),
+    m_isQueryRunning(false),
+    m_currentFrame(0)
+{
+    for (FrameQueries& frame : m_frames)
+    {
+        frame.numberOfQueries = 0;
+    }
+
+    // glGenQueries requires OpenGL 1.5
+    m_genQueriesFuncPtr = (GL_GenQueries_Func)SDL_GL_GetProcAddress("glGenQueries");
+    if (m_genQueriesFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glGenQueries");
+        return;
+    }
+
+    // glBeginQuery requires OpenGL 1.5
+    m_beginQueryFuncPtr = (GL_BeginQuery_Func)SDL_GL_GetProcAddress("glBeginQuery");
+    if (m_beginQueryFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glBeginQuery");
+        return;
+    }
+
+    // glEndQuery requires OpenGL 1.5
+    m_endQueryFuncPtr = (GL_EndQuery_Func)SDL_GL_GetProcAddress("glEndQuery");
+    if (m_endQueryFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glEndQuery");
+        return;
+    }
+
+    // glGetQueryObjectiv requires OpenGL 1.5
+    m_getQueryObjectivFuncPtr = (GL_GetQueryObjectiv_Func)SDL_GL_GetProcAddress("glGetQueryObjectiv");
+    if (m_getQueryObjectivFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glGetQueryObjectiv");
+        return;
+    }
+
+    // glGetQueryObjectui64v and GL_TIME_ELAPSED require OpenGL 3.3
+    m_getQueryObjectui64vFuncPtr = (GL_GetQueryObjectui64v_Func)SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+    if (m_getQueryObjectui64vFuncPtr == nullptr)
+    {
+        Logging::Instance().AddLogMessage("Failed to obtain function pointer for glGetQueryObjectui64v");
+        return;
+    }
+
+    for (FrameQueries& frame : m_frames)
+    {
+        m_genQueriesFuncPtr(MaxQueriesPerFrame, frame.queryIds);
+    }
+
+    Logging::Instance().AddLogMessage("OpenGL timer queries are supported");
+    m_isSupported = true;
+}
+
+OpenGLTimerQueries::~OpenGLTimerQueries()
+{
+
+}
+
+bool OpenGLTimerQueries::IsSupported() const
+{
+    return m_isSupported;
+}
+
+bool OpenGLTimerQueries::Begin(const uint8_t pass)
+{
+    FrameQueries& frame = m_frames[m_currentFrame];
+    if (!m_isSupported || m_isQueryRunning || frame.numberOfQueries == MaxQueriesPerFrame || pass >= MaxPasses)
+    {
+        return false;
+    }
+
+    m_beginQueryFuncPtr(GL_TIME_ELAPSED, frame.queryIds[frame.numberOfQueries]);
+    frame.passes[frame.numberOfQueries] = pass;
+    frame.numberOfQueries++;
+    m_isQueryRunning = true;
+    return true;
+}
+
+void OpenGLTimerQueries::End()
+{
+    if (m_isQueryRunning)
+    {
+        m_endQueryFuncPtr(GL_TIME_ELAPSED);
+        m_isQueryRunning = false;
+    }
+}
+
+bool OpenGLTimerQueries::EndFrame(float elapsedTimesInMilliseconds[MaxPasses])
+{
+    if (!m_isSupported)
+    {
+        return false;
+    }
+
+    End();
+
+    // The oldest frame in the ring is read back and then reused for the next frame
+    m_currentFrame = (m_currentFrame + 1) % FramesInFlight;
+    FrameQueries& frame = m_frames[m_currentFrame];
+    bool available = (frame.numberOfQueries > 0);
+    for (uint8_t i = 0; i < frame.numberOfQueries && available; i++)
+    {
+        int queryResultAvailable = 0;
+        m_getQueryObjectivFuncPtr(frame.queryIds[i], GL_QUERY_RESULT_AVAILABLE, &queryResultAvailable);
+        available = (queryResultAvailable != 0);
+    }
+
+    if (available)
+    {
+        for (uint8_t pass = 0; pass < MaxPasses; pass++)
+        {
+            elapsedTimesInMilliseconds[pass] = 0.0f;
+        }
+
+        for (uint8_t i = 0; i < frame.numberOfQueries; i++)
+        {
+            uint64_t elapsedTimeInNanoseconds = 0;
+            m_getQueryObjectui64vFuncPtr(frame.queryIds[i], GL_QUERY_RESULT, &elapsedTimeInNanoseconds);
+            elapsedTimesInMilliseconds[frame.passes[i]] += (float)elapsedTimeInNanoseconds / 1000000.0f;
+        }
+    }
+
+    frame.numberOfQueries = 0;
+    return available;
+}
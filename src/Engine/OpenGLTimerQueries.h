@@ -0,0 +1,71 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// OpenGLTimerQueries
+//
+// Measures the time the GPU spends on render passes, using timer queries. Requires OpenGL 3.3.
+// The results are read back a few frames later, when they are available, such that the CPU never waits for the GPU.
+//
+#pragma once
+
+#include "Macros.h"
+#include "OpenGLBasic.h"
+
+class OpenGLTimerQueries
+{
+public:
+    static const uint8_t MaxPasses = 8;
+    static const uint8_t FramesInFlight = 4;
+    static const uint8_t MaxQueriesPerFrame = 32;
+
+    OpenGLTimerQueries();
+    ~OpenGLTimerQueries();
+
+    bool IsSupported() const;
+
+    // Timer queries cannot be nested; returns false if a query is already running, or no more queries are left for this frame.
+    bool Begin(const uint8_t pass);
+    void End();
+
+    // Closes the current frame. Returns true if the queries of the frame that was closed FramesInFlight - 1 frames ago
+    // are all available, in which case its elapsed time per pass is stored. Results that are not available in time are dropped.
+    bool EndFrame(float elapsedTimesInMilliseconds[MaxPasses]);
+
+private:
+    typedef struct
+    {
+        unsigned int queryIds[MaxQueriesPerFrame];
+        uint8_t passes[MaxQueriesPerFrame];
+        uint8_t numberOfQueries;
+    } FrameQueries;
+
+    typedef void (CALLBACK* GL_GenQueries_Func)(int, unsigned int*);
+    typedef void (CALLBACK* GL_BeginQuery_Func)(unsigned int, unsigned int);
+    typedef void (CALLBACK* GL_EndQuery_Func)(unsigned int);
+    typedef void (CALLBACK* GL_GetQueryObjectiv_Func)(unsigned int, unsigned int, int*);
+    typedef void (CALLBACK* GL_GetQueryObjectui64v_Func)(unsigned int, unsigned int, uint64_t*);
+
+    GL_GenQueries_Func m_genQueriesFuncPtr;
+    GL_BeginQuery_Func m_beginQueryFuncPtr;
+    GL_EndQuery_Func m_endQueryFuncPtr;
+    GL_GetQueryObjectiv_Func m_getQueryObjectivFuncPtr;
+    GL_GetQueryObjectui64v_Func m_getQueryObjectui64vFuncPtr;
+
+    bool m_isSupported;
+    bool m_isQueryRunning;
+    uint8_t m_currentFrame;
+    FrameQueries m_frames[FramesInFlight];
+};
@@ -15,12 +15,23 @@
 
 #include "Picture.h"
 
-Picture::Picture(const unsigned int textureId, const uint16_t imageWidth, const uint16_t imageHeight, const uint16_t textureWidth, const uint16_t textureHeight) :
+Picture::Picture(
+    const unsigned int textureId,
+    const uint16_t imageWidth,
+    const uint16_t imageHeight,
+    const uint16_t textureWidth,
+    const uint16_t textureHeight,
+    const uint16_t imageOffsetX,
+    const uint16_t imageOffsetY) :
     m_textureId(textureId),
     m_imageWidth(imageWidth),
     m_imageHeight(imageHeight),
     m_textureWidth(textureWidth),
-    m_textureHeight(textureHeight)
+    m_textureHeight(textureHeight),
+    m_imageOffsetX(imageOffsetX),
+    m_imageOffsetY(imageOffsetY),
+    m_source(nullptr),
+    m_sourceIndex(0)
 {
 }
 
@@ -29,9 +40,15 @@ Picture::~Picture()
 
 }
 
+void Picture::SetSource(IPictureSource* source, const uint16_t index)
+{
+    m_source = source;
+    m_sourceIndex = index;
+}
+
 unsigned int Picture::GetTextureId() const
 {
-    return m_textureId;
+    return (m_source != nullptr) ? m_source->GetPictureTextureId(m_sourceIndex) : m_textureId;
 }
 
 uint16_t Picture::GetImageWidth() const
@@ -54,6 +71,36 @@ uint16_t Picture::GetTextureHeight() const
     return m_textureHeight;
 }
 
+uint16_t Picture::GetImageOffsetX() const
+{
+    return m_imageOffsetX;
+}
+
+uint16_t Picture::GetImageOffsetY() const
+{
+    return m_imageOffsetY;
+}
+
+float Picture::GetImageRelativeOffsetX() const
+{
+    return (float)m_imageOffsetX / (float)m_textureWidth;
+}
+
+float Picture::GetImageRelativeOffsetY() const
+{
+    return (float)m_imageOffsetY / (float)m_textureHeight;
+}
+
+float Picture::GetImageRelativeWidth() const
+{
+    return (float)m_imageWidth / (float)m_textureWidth;
+}
+
+float Picture::GetImageRelativeHeight() const
+{
+    return (float)m_imageHeight / (float)m_textureHeight;
+}
+
 uint16_t Picture::GetNearestPowerOfTwo(const uint16_t size)
 {
     // In order to support OpenGL 1.4, the texture width and height need to be a power of two.
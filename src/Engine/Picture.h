@@ -17,22 +17,41 @@
 // Picture
 //
 // Contains a single picture (wall texture, sprite texture, etc...)
+// A picture either has a texture of its own, or is stored at an offset within a texture that it shares with other pictures.
+// A picture with a source gets its texture from the source on each use, such that the source can unload the texture.
 //
 #pragma once
 
 #include "FileChunk.h"
+#include "IPictureSource.h"
 
 class Picture
 {
 public:
-    Picture(const unsigned int textureId, const uint16_t imageWidth, const uint16_t imageHeight, const uint16_t textureWidth, const uint16_t textureHeight);
+    Picture(
+        const unsigned int textureId,
+        const uint16_t imageWidth,
+        const uint16_t imageHeight,
+        const uint16_t textureWidth,
+        const uint16_t textureHeight,
+        const uint16_t imageOffsetX = 0,
+        const uint16_t imageOffsetY = 0);
     ~Picture();
 
+    void SetSource(IPictureSource* source, const uint16_t index);
     unsigned int GetTextureId() const;
     uint16_t GetImageWidth() const;
     uint16_t GetImageHeight() const;
     uint16_t GetTextureWidth() const;
     uint16_t GetTextureHeight() const;
+    uint16_t GetImageOffsetX() const;
+    uint16_t GetImageOffsetY() const;
+
+    // Texture coordinates of the image
+    float GetImageRelativeOffsetX() const;
+    float GetImageRelativeOffsetY() const;
+    float GetImageRelativeWidth() const;
+    float GetImageRelativeHeight() const;
     static uint16_t GetNearestPowerOfTwo(const uint16_t size);
 
 private:
@@ -40,6 +59,10 @@ private:
     uint16_t m_imageHeight;
     uint16_t m_textureWidth;
     uint16_t m_textureHeight;
+    uint16_t m_imageOffsetX;
+    uint16_t m_imageOffsetY;
     unsigned int m_textureId;
+    IPictureSource* m_source;
+    uint16_t m_sourceIndex;
 };
 
@@ -0,0 +1,127 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "PictureAtlas.h"
+#include "Picture.h"
+#include "EgaColor.h"
+#include <cstddef> // For std::size_t
+#include <cstring>
+
+PictureAtlas::PictureAtlas(const uint16_t textureWidth, const uint16_t maxTextureHeight, const uint16_t padding, const uint8_t bytesPerPixel) :
+    m_textureWidth(textureWidth),
+    m_maxTextureHeight(maxTextureHeight),
+    m_padding(padding),
+    m_bytesPerPixel(bytesPerPixel),
+    m_shelfX(0),
+    m_shelfY(0),
+    m_shelfHeight(0)
+{
+    // Fill the texture with transparent pixels; in RGBA, zero's amount to black and fully transparent.
+    const std::size_t textureSize = (std::size_t)m_textureWidth * m_maxTextureHeight * m_bytesPerPixel;
+    m_texturePixelData = new uint8_t[textureSize];
+    std::memset(m_texturePixelData, (m_bytesPerPixel == 1) ? EgaTransparentIndex : 0, textureSize);
+}
+
+PictureAtlas::~PictureAtlas()
+{
+    delete[] m_texturePixelData;
+}
+
+bool PictureAtlas::ReserveImage(const uint16_t imageWidth, const uint16_t imageHeight, uint16_t& offsetX, uint16_t& offsetY)
+{
+    const uint32_t cellWidth = imageWidth + (2u * m_padding);
+    const uint32_t cellHeight = imageHeight + (2u * m_padding);
+    if (cellWidth > m_textureWidth)
+    {
+        return false;
+    }
+
+    if (m_shelfX + cellWidth > m_textureWidth)
+    {
+        // Start a new shelf below the current one
+        m_shelfY += m_shelfHeight;
+        m_shelfX = 0;
+        m_shelfHeight = 0;
+    }
+
+    if (m_shelfY + cellHeight > m_maxTextureHeight)
+    {
+        return false;
+    }
+
+    offsetX = m_shelfX + m_padding;
+    offsetY = m_shelfY + m_padding;
+    m_shelfX += (uint16_t)cellWidth;
+    if (cellHeight > m_shelfHeight)
+    {
+        m_shelfHeight = (uint16_t)cellHeight;
+    }
+
+    return true;
+}
+
+void PictureAtlas::StoreImage(const uint16_t offsetX, const uint16_t offsetY, const uint16_t imageWidth, const uint16_t imageHeight, const uint8_t* const pixelData)
+{
+    if (imageWidth == 0 || imageHeight == 0)
+    {
+        return;
+    }
+
+    for (uint16_t y = 0; y < imageHeight; y++)
+    {
+        const std::size_t destination = (((std::size_t)(offsetY + y) * m_textureWidth) + offsetX) * m_bytesPerPixel;
+        std::memcpy(&m_texturePixelData[destination], &pixelData[(std::size_t)y * imageWidth * m_bytesPerPixel], (std::size_t)imageWidth * m_bytesPerPixel);
+    }
+
+    // Repeat the outer pixels into the padding, first the columns and then the rows including the corners
+    for (uint16_t y = offsetY; y < offsetY + imageHeight; y++)
+    {
+        for (uint16_t p = 1; p <= m_padding; p++)
+        {
+            CopyPixel(offsetX, y, offsetX - p, y);
+            CopyPixel(offsetX + imageWidth - 1, y, offsetX + imageWidth - 1 + p, y);
+        }
+    }
+    for (uint16_t x = offsetX - m_padding; x < offsetX + imageWidth + m_padding; x++)
+    {
+        for (uint16_t p = 1; p <= m_padding; p++)
+        {
+            CopyPixel(x, offsetY, x, offsetY - p);
+            CopyPixel(x, offsetY + imageHeight - 1, x, offsetY + imageHeight - 1 + p);
+        }
+    }
+}
+
+uint16_t PictureAtlas::GetTextureWidth() const
+{
+    return m_textureWidth;
+}
+
+uint16_t PictureAtlas::GetTextureHeight() const
+{
+    return Picture::GetNearestPowerOfTwo(m_shelfY + m_shelfHeight);
+}
+
+uint8_t* PictureAtlas::GetTexturePixelData() const
+{
+    return m_texturePixelData;
+}
+
+void PictureAtlas::CopyPixel(const uint16_t sourceX, const uint16_t sourceY, const uint16_t destinationX, const uint16_t destinationY)
+{
+    const std::size_t source = (((std::size_t)sourceY * m_textureWidth) + sourceX) * m_bytesPerPixel;
+    const std::size_t destination = (((std::size_t)destinationY * m_textureWidth) + destinationX) * m_bytesPerPixel;
+    std::memcpy(&m_texturePixelData[destination], &m_texturePixelData[source], m_bytesPerPixel);
+}
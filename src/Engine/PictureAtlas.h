@@ -0,0 +1,57 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// PictureAtlas
+//
+// Packs pictures of different sizes into a single texture, in rows (shelves) from top to bottom.
+// Each picture is surrounded by a padding into which its outer pixels are repeated, such that linear filtering
+// does not blend in the neighbouring pictures. The pictures are either RGBA, with 4 bytes per pixel, or palettized,
+// with 1 byte per pixel.
+//
+#pragma once
+
+#include <stdint.h>
+
+class PictureAtlas
+{
+public:
+    PictureAtlas(const uint16_t textureWidth, const uint16_t maxTextureHeight, const uint16_t padding, const uint8_t bytesPerPixel);
+    ~PictureAtlas();
+
+    // Reserves space for an image and returns its offset in pixels. Returns false if the image does not fit anymore.
+    // The space is used most efficiently when the images are reserved in order of decreasing height.
+    bool ReserveImage(const uint16_t imageWidth, const uint16_t imageHeight, uint16_t& offsetX, uint16_t& offsetY);
+
+    // Copies an image into the space that was reserved for it.
+    void StoreImage(const uint16_t offsetX, const uint16_t offsetY, const uint16_t imageWidth, const uint16_t imageHeight, const uint8_t* const pixelData);
+
+    uint16_t GetTextureWidth() const;
+    // Smallest power of two that contains all reserved images.
+    uint16_t GetTextureHeight() const;
+    uint8_t* GetTexturePixelData() const;
+
+private:
+    void CopyPixel(const uint16_t sourceX, const uint16_t sourceY, const uint16_t destinationX, const uint16_t destinationY);
+
+    const uint16_t m_textureWidth;
+    const uint16_t m_maxTextureHeight;
+    const uint16_t m_padding;
+    const uint8_t m_bytesPerPixel;
+    uint16_t m_shelfX;
+    uint16_t m_shelfY;
+    uint16_t m_shelfHeight;
+    uint8_t* m_texturePixelData;
+};
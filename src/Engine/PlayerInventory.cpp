@@ -245,7 +245,7 @@ void PlayerInventory::ResetForNewGame()
     }
 }
 
-void PlayerInventory::StoreToFile(std::ofstream& file) const
+void PlayerInventory::StoreToFile(std::ostream& file) const
 {
     file.write((const char*)&m_bolts, sizeof(m_bolts));
     file.write((const char*)&m_nukes, sizeof(m_nukes));
@@ -255,7 +255,7 @@ void PlayerInventory::StoreToFile(std::ofstream& file) const
     file.write((const char*)&m_gems, sizeof(m_gems));
 }
 
-bool PlayerInventory::LoadFromFile(std::ifstream& file)
+bool PlayerInventory::LoadFromFile(std::istream& file)
 {
     file.read((char*)&m_bolts, sizeof(m_bolts));
     file.read((char*)&m_nukes, sizeof(m_nukes));
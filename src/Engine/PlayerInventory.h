@@ -64,8 +64,8 @@ public:
     bool TakeNuke();
     void ResetForNewGame();
 
-    void StoreToFile(std::ofstream& file) const;
-    bool LoadFromFile(std::ifstream& file);
+    void StoreToFile(std::ostream& file) const;
+    bool LoadFromFile(std::istream& file);
 
     void LoadFromDosGame(const SavedGameInDosFormat& savedGameInDosFormat);
 
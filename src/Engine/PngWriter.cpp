@@ -0,0 +1,277 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "PngWriter.h"
+#include "Checksum.h"
+#include <fstream>
+
+const uint16_t minimumMatchLength = 3;
+const uint16_t maximumMatchLength = 258;
+const uint32_t windowSize = 32768;
+const uint32_t hashSize = 1 << 15;
+const uint16_t maximumChainLength = 32;
+
+const uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+const uint8_t lengthExtraBits[29] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0 };
+const uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+const uint8_t distanceExtraBits[30] = { 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13 };
+
+class BitWriter
+{
+public:
+    BitWriter(std::vector<uint8_t>& output) :
+        m_output(output),
+        m_bits(0),
+        m_numberOfBits(0)
+    {
+    }
+
+    // Deflate packs its values starting at the least significant bit.
+    void Write(const uint32_t value, const uint8_t numberOfBits)
+    {
+        m_bits |= value << m_numberOfBits;
+        m_numberOfBits += numberOfBits;
+        while (m_numberOfBits >= 8)
+        {
+            m_output.push_back((uint8_t)(m_bits & 0xFF));
+            m_bits >>= 8;
+            m_numberOfBits -= 8;
+        }
+    }
+
+    // Huffman codes are packed starting at their most significant bit.
+    void WriteCode(const uint32_t code, const uint8_t numberOfBits)
+    {
+        uint32_t reversedCode = 0;
+        for (uint8_t i = 0; i < numberOfBits; i++)
+        {
+            reversedCode |= ((code >> i) & 1) << (numberOfBits - 1 - i);
+        }
+        Write(reversedCode, numberOfBits);
+    }
+
+    void Flush()
+    {
+        if (m_numberOfBits > 0)
+        {
+            m_output.push_back((uint8_t)(m_bits & 0xFF));
+        }
+        m_bits = 0;
+        m_numberOfBits = 0;
+    }
+
+private:
+    std::vector<uint8_t>& m_output;
+    uint32_t m_bits;
+    uint8_t m_numberOfBits;
+};
+
+static void WriteLiteralOrLength(BitWriter& writer, const uint16_t symbol)
+{
+    // Fixed Huffman codes, as defined in RFC 1951 section 3.2.6
+    if (symbol < 144)
+    {
+        writer.WriteCode(0x30 + symbol, 8);
+    }
+    else if (symbol < 256)
+    {
+        writer.WriteCode(0x190 + (symbol - 144), 9);
+    }
+    else if (symbol < 280)
+    {
+        writer.WriteCode(symbol - 256, 7);
+    }
+    else
+    {
+        writer.WriteCode(0xC0 + (symbol - 280), 8);
+    }
+}
+
+static void WriteMatch(BitWriter& writer, const uint16_t length, const uint16_t distance)
+{
+    uint8_t lengthCode = 28;
+    while (lengthBase[lengthCode] > length)
+    {
+        lengthCode--;
+    }
+    WriteLiteralOrLength(writer, 257 + lengthCode);
+    writer.Write(length - lengthBase[lengthCode], lengthExtraBits[lengthCode]);
+
+    uint8_t distanceCode = 29;
+    while (distanceBase[distanceCode] > distance)
+    {
+        distanceCode--;
+    }
+    writer.WriteCode(distanceCode, 5);
+    writer.Write(distance - distanceBase[distanceCode], distanceExtraBits[distanceCode]);
+}
+
+static uint32_t Hash(const uint8_t* data)
+{
+    return ((data[0] << 10) ^ (data[1] << 5) ^ data[2]) & (hashSize - 1);
+}
+
+static void WriteUInt32(std::vector<uint8_t>& output, const uint32_t value)
+{
+    output.push_back((uint8_t)(value >> 24));
+    output.push_back((uint8_t)(value >> 16));
+    output.push_back((uint8_t)(value >> 8));
+    output.push_back((uint8_t)value);
+}
+
+static void WriteChunk(std::vector<uint8_t>& png, const char* type, const std::vector<uint8_t>& data)
+{
+    WriteUInt32(png, (uint32_t)data.size());
+    const size_t typeOffset = png.size();
+    png.insert(png.end(), type, type + 4);
+    png.insert(png.end(), data.begin(), data.end());
+    WriteUInt32(png, Checksum::Crc32(&png[typeOffset], png.size() - typeOffset));
+}
+
+void PngWriter::Encode(const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels, std::vector<uint8_t>& png)
+{
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    png.assign(signature, signature + 8);
+
+    std::vector<uint8_t> header;
+    WriteUInt32(header, width);
+    WriteUInt32(header, height);
+    header.push_back(8); // Bit depth
+    header.push_back(6); // Color type RGBA
+    header.push_back(0); // Compression method
+    header.push_back(0); // Filter method
+    header.push_back(0); // No interlace
+    WriteChunk(png, "IHDR", header);
+
+    // Each row starts with its filter type, which is none. Rows that repeat the row above are
+    // found as matches by the compression.
+    const size_t rowSize = (size_t)width * 4;
+    std::vector<uint8_t> imageData;
+    imageData.reserve((rowSize + 1) * height);
+    for (uint32_t y = 0; y < height; y++)
+    {
+        imageData.push_back(0);
+        imageData.insert(imageData.end(), rgbaPixels.begin() + (y * rowSize), rgbaPixels.begin() + ((y + 1) * rowSize));
+    }
+
+    std::vector<uint8_t> compressedData;
+    Compress(imageData, compressedData);
+    WriteChunk(png, "IDAT", compressedData);
+    WriteChunk(png, "IEND", std::vector<uint8_t>());
+}
+
+bool PngWriter::WriteToFile(const std::filesystem::path& filename, const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels)
+{
+    std::vector<uint8_t> png;
+    Encode(width, height, rgbaPixels, png);
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        return false;
+    }
+    file.write((const char*)png.data(), png.size());
+    return file.good();
+}
+
+void PngWriter::Compress(const std::vector<uint8_t>& data, std::vector<uint8_t>& compressedData)
+{
+    compressedData.clear();
+    compressedData.push_back(0x78); // Deflate with a 32K window
+    compressedData.push_back(0x01); // No preset dictionary, fastest compression level
+
+    BitWriter writer(compressedData);
+    writer.Write(1, 1); // Final block
+    writer.Write(1, 2); // Fixed Huffman codes
+
+    // Hash chains of the positions of the 3-byte sequences in the window; 0 marks the end of a chain.
+    std::vector<uint32_t> head(hashSize, 0);
+    std::vector<uint32_t> previous(windowSize, 0);
+    const uint8_t* source = data.data();
+    const size_t length = data.size();
+
+    size_t position = 0;
+    while (position < length)
+    {
+        uint16_t bestLength = 0;
+        uint16_t bestDistance = 0;
+        if (position + minimumMatchLength <= length)
+        {
+            const uint32_t hash = Hash(&source[position]);
+            const size_t maxLength = (length - position < maximumMatchLength) ? length - position : maximumMatchLength;
+            uint32_t candidate = head[hash];
+            uint16_t chainLength = 0;
+            while (candidate != 0 && position - (candidate - 1) <= windowSize && chainLength < maximumChainLength)
+            {
+                const size_t candidatePosition = candidate - 1;
+                uint16_t matchLength = 0;
+                while (matchLength < maxLength && source[candidatePosition + matchLength] == source[position + matchLength])
+                {
+                    matchLength++;
+                }
+                if (matchLength > bestLength)
+                {
+                    bestLength = matchLength;
+                    bestDistance = (uint16_t)(position - candidatePosition);
+                    if (matchLength == maxLength)
+                    {
+                        break;
+                    }
+                }
+                const uint32_t next = previous[candidatePosition % windowSize];
+                if (next >= candidate)
+                {
+                    break;
+                }
+                candidate = next;
+                chainLength++;
+            }
+        }
+
+        const size_t step = (bestLength >= minimumMatchLength) ? bestLength : 1;
+        if (step == 1)
+        {
+            WriteLiteralOrLength(writer, source[position]);
+        }
+        else
+        {
+            WriteMatch(writer, bestLength, bestDistance);
+        }
+
+        for (size_t i = 0; i < step; i++)
+        {
+            if (position + minimumMatchLength <= length)
+            {
+                const uint32_t hash = Hash(&source[position]);
+                previous[position % windowSize] = head[hash];
+                head[hash] = (uint32_t)(position + 1);
+            }
+            position++;
+        }
+    }
+
+    WriteLiteralOrLength(writer, 256); // End of block
+    writer.Flush();
+
+    // Adler-32 checksum of the uncompressed data
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (size_t i = 0; i < length; i++)
+    {
+        a = (a + source[i]) % 65521;
+        b = (b + a) % 65521;
+    }
+    WriteUInt32(compressedData, (b << 16) | a);
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// PngWriter
+//
+// Encodes RGBA pixels as a PNG image, such that rendered frames can be stored without depending on an image library.
+// The image data is compressed with LZ77 and the fixed Huffman codes of deflate, which is sufficient for the large
+// areas of flat colors in the frames of the game.
+//
+#pragma once
+
+#include <filesystem>
+#include <stdint.h>
+#include <vector>
+
+class PngWriter
+{
+public:
+    // The pixels are given as RGBA rows from top to bottom.
+    static void Encode(const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels, std::vector<uint8_t>& png);
+    static bool WriteToFile(const std::filesystem::path& filename, const uint32_t width, const uint32_t height, const std::vector<uint8_t>& rgbaPixels);
+
+    // Compresses the data into a zlib stream, as stored in the IDAT chunks.
+    static void Compress(const std::vector<uint8_t>& data, std::vector<uint8_t>& compressedData);
+};
@@ -108,28 +108,28 @@ const bool Renderable3DScene::GetOriginalScreenResolution() const
     return m_originalScreenResolution;
 }
 
-void Renderable3DScene::AddNorthWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void Renderable3DScene::AddNorthWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     const Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ (uint16_t)(x + 1u), y, x, y };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
-void Renderable3DScene::AddSouthWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void Renderable3DScene::AddSouthWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     const Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ x, y, (uint16_t)(x + 1u), y };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
-void Renderable3DScene::AddWestWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void Renderable3DScene::AddWestWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     const Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ x, y, x, (uint16_t)(y + 1u) };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
-void Renderable3DScene::AddEastWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void Renderable3DScene::AddEastWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     const Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ x, (uint16_t)(y + 1u), x, y };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
 Renderable3DTiles& Renderable3DScene::Get3DTilesMutable()
@@ -52,10 +52,10 @@ public:
     const uint16_t GetFieldOfView() const;
     const bool GetOriginalScreenResolution() const;
 
-    void AddNorthWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
-    void AddSouthWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
-    void AddWestWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
-    void AddEastWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
+    void AddNorthWall(const uint16_t x, const uint16_t y, const Picture* picture);
+    void AddSouthWall(const uint16_t x, const uint16_t y, const Picture* picture);
+    void AddWestWall(const uint16_t x, const uint16_t y, const Picture* picture);
+    void AddEastWall(const uint16_t x, const uint16_t y, const Picture* picture);
     Renderable3DTiles& Get3DTilesMutable();
     RenderableSprites& GetSpritesMutable();
 
@@ -18,7 +18,9 @@
 Renderable3DTiles::Renderable3DTiles() :
     m_floorColor(EgaBlack),
     m_ceilingColor(EgaBlack),
-    m_onlyFloor(false)
+    m_onlyFloor(false),
+    m_mapWidth(0),
+    m_mapHeight(0)
 {
     m_tileCoordinates.clear();
 }
@@ -26,6 +28,18 @@ Renderable3DTiles::Renderable3DTiles() :
 void Renderable3DTiles::AddTile(const tileCoordinate coordinate)
 {
     m_tileCoordinates.push_back(coordinate);
+
+    // The tiles are usually added row by row, such that neighbouring tiles extend the last row
+    if (!m_tileRows.empty())
+    {
+        tileRow& lastRow = m_tileRows.back();
+        if (lastRow.y == coordinate.y && lastRow.x + lastRow.length == coordinate.x)
+        {
+            lastRow.length++;
+            return;
+        }
+    }
+    m_tileRows.push_back(tileRow{ coordinate.x, coordinate.y, 1 });
 }
 
 egaColor Renderable3DTiles::GetFloorColor() const
@@ -63,7 +77,29 @@ const std::vector<Renderable3DTiles::tileCoordinate>& Renderable3DTiles::GetTile
     return m_tileCoordinates;
 }
 
+const std::vector<Renderable3DTiles::tileRow>& Renderable3DTiles::GetTileRows() const
+{
+    return m_tileRows;
+}
+
+void Renderable3DTiles::SetMapSize(const uint16_t width, const uint16_t height)
+{
+    m_mapWidth = width;
+    m_mapHeight = height;
+}
+
+uint16_t Renderable3DTiles::GetMapWidth() const
+{
+    return m_mapWidth;
+}
+
+uint16_t Renderable3DTiles::GetMapHeight() const
+{
+    return m_mapHeight;
+}
+
 void Renderable3DTiles::Reset()
 {
     m_tileCoordinates.clear();
+    m_tileRows.clear();
 }
\ No newline at end of file
@@ -32,6 +32,14 @@ public:
         int16_t y;
     } tileCoordinate;
 
+    // Consecutive tiles on the same row, starting at tile (x, y)
+    typedef struct
+    {
+        int16_t x;
+        int16_t y;
+        uint16_t length;
+    } tileRow;
+
     Renderable3DTiles();
     void AddTile(const tileCoordinate coordinate);
     egaColor GetFloorColor() const;
@@ -41,6 +49,13 @@ public:
     bool IsOnlyFloor() const;
     void SetOnlyFloor(const bool isOnlyFloor);
     const std::vector<tileCoordinate>& GetTileCoordinates() const;
+    const std::vector<tileRow>& GetTileRows() const;
+
+    // Size of the map that the tiles are part of, such that the renderer can keep a mesh of all tiles.
+    // A size of zero means that the tiles are not part of a map.
+    void SetMapSize(const uint16_t width, const uint16_t height);
+    uint16_t GetMapWidth() const;
+    uint16_t GetMapHeight() const;
     void Reset();
 
 private:
@@ -48,6 +63,9 @@ private:
     egaColor m_ceilingColor;
     bool m_onlyFloor;
     std::vector<tileCoordinate> m_tileCoordinates;
+    std::vector<tileRow> m_tileRows;
+    uint16_t m_mapWidth;
+    uint16_t m_mapHeight;
 };
 
 
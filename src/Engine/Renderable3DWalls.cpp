@@ -20,16 +20,17 @@ Renderable3DWalls::Renderable3DWalls()
     m_textureToWallsMap.clear();
 }
 
-void Renderable3DWalls::AddWall(const unsigned int textureId, const wallCoordinate coordinate)
+void Renderable3DWalls::AddWall(const Picture* picture, const wallCoordinate coordinate)
 {
+    const unsigned int textureId = picture->GetTextureId();
     if (m_textureToWallsMap.find(textureId) == m_textureToWallsMap.end())
     {
-        m_textureToWallsMap.insert(std::make_pair(textureId, std::vector<Renderable3DWalls::wallCoordinate>()));
+        m_textureToWallsMap.insert(std::make_pair(textureId, std::vector<Renderable3DWalls::texturedWall>()));
     }
-    m_textureToWallsMap.at(textureId).push_back(coordinate);
+    m_textureToWallsMap.at(textureId).push_back({ coordinate, picture });
 }
 
-const std::map<unsigned int, std::vector<Renderable3DWalls::wallCoordinate>>& Renderable3DWalls::GetTextureToWallsMap() const
+const std::map<unsigned int, std::vector<Renderable3DWalls::texturedWall>>& Renderable3DWalls::GetTextureToWallsMap() const
 {
     return m_textureToWallsMap;
 }
@@ -22,6 +22,7 @@
 #include <map>
 #include <vector>
 #include <cstdint>
+#include "Picture.h"
 
 class Renderable3DWalls
 {
@@ -34,11 +35,18 @@ public:
         uint16_t y2;
     } wallCoordinate;
 
+    typedef struct
+    {
+        wallCoordinate coordinate;
+        const Picture* picture;
+    } texturedWall;
+
     Renderable3DWalls();
-    void AddWall(const unsigned int textureId, const wallCoordinate coordinate);
-    const std::map<unsigned int, std::vector<wallCoordinate>>& GetTextureToWallsMap() const;
+    // Walls are grouped by the texture of their picture, which can be shared by the pictures of a texture atlas.
+    void AddWall(const Picture* picture, const wallCoordinate coordinate);
+    const std::map<unsigned int, std::vector<texturedWall>>& GetTextureToWallsMap() const;
     void Reset();
 
 private:
-    std::map<unsigned int, std::vector<wallCoordinate>> m_textureToWallsMap;
+    std::map<unsigned int, std::vector<texturedWall>> m_textureToWallsMap;
 };
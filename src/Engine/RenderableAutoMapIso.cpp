@@ -26,7 +26,11 @@ RenderableAutoMapIso::RenderableAutoMapIso(
     m_playerY(1.0f),
     m_playerAngle(0.0f),
     m_sprites(),
-    m_text(font)
+    m_text(font),
+    m_staticTilesWidth(0),
+    m_staticTilesHeight(0),
+    m_staticGeometryId(0),
+    m_staticGeometryChanged(false)
 {
 
 }
@@ -40,14 +44,15 @@ void RenderableAutoMapIso::PrepareFrame(
     m_originX = originX;
     m_originY = originY;
     m_sprites.Reset(100.0f, 100.0f, 0.0f);
-    m_walls.Reset();
-    m_wallCaps.clear();
-    m_floorTiles.Reset();
     m_text.Reset();
 }
 
 void RenderableAutoMapIso::FinalizeFrame()
 {
+    if (m_staticGeometryChanged)
+    {
+        RebuildStaticGeometry();
+    }
     m_sprites.SortSpritesBackToFront();
 }
 
@@ -118,16 +123,16 @@ void RenderableAutoMapIso::SetPlayerPosition(const float x, const float y, const
     m_playerAngle = angle;
 }
 
-void RenderableAutoMapIso::AddNorthWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void RenderableAutoMapIso::AddNorthWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     const Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ (uint16_t)(x + 1u), y, x, y };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
-void RenderableAutoMapIso::AddWestWall(const uint16_t x, const uint16_t y, const unsigned int textureId)
+void RenderableAutoMapIso::AddWestWall(const uint16_t x, const uint16_t y, const Picture* picture)
 {
     Renderable3DWalls::wallCoordinate wall = Renderable3DWalls::wallCoordinate{ x, y, x, (uint16_t)(y + 1u) };
-    m_walls.AddWall(textureId, wall);
+    m_walls.AddWall(picture, wall);
 }
 
 void RenderableAutoMapIso::AddWallCap(
@@ -210,4 +215,63 @@ RenderableSprites& RenderableAutoMapIso::GetSpritesMutable()
 RenderableText& RenderableAutoMapIso::GetTextMutable()
 {
     return m_text;
+}
+
+uint32_t RenderableAutoMapIso::GetStaticGeometryId() const
+{
+    return m_staticGeometryId;
+}
+
+void RenderableAutoMapIso::ResetStaticGeometry(const uint32_t geometryId, const uint16_t width, const uint16_t height)
+{
+    m_staticGeometryId = geometryId;
+    m_staticTilesWidth = width;
+    m_staticTilesHeight = height;
+    m_staticTiles.assign(width * height, staticTile{ false, false, false, false, 0, 0, EgaBlack, EgaBlack });
+    m_staticGeometryChanged = true;
+}
+
+void RenderableAutoMapIso::SetStaticTile(const uint16_t x, const uint16_t y, const staticTile& tile)
+{
+    if (x >= m_staticTilesWidth || y >= m_staticTilesHeight)
+    {
+        return;
+    }
+
+    m_staticTiles[(y * m_staticTilesWidth) + x] = tile;
+    m_staticGeometryChanged = true;
+}
+
+void RenderableAutoMapIso::RebuildStaticGeometry()
+{
+    m_walls.Reset();
+    m_wallCaps.clear();
+    m_floorTiles.Reset();
+    m_floorTiles.SetMapSize(m_staticTilesWidth, m_staticTilesHeight);
+
+    for (uint16_t y = 0; y < m_staticTilesHeight; y++)
+    {
+        for (uint16_t x = 0; x < m_staticTilesWidth; x++)
+        {
+            const staticTile& tile = m_staticTiles[(y * m_staticTilesWidth) + x];
+            if (tile.floor)
+            {
+                m_floorTiles.AddTile(Renderable3DTiles::tileCoordinate{ (int16_t)x, (int16_t)y });
+            }
+            if (tile.northWall)
+            {
+                AddNorthWall(x, y, tile.northWallPicture);
+            }
+            if (tile.westWall)
+            {
+                AddWestWall(x, y, tile.westWallPicture);
+            }
+            if (tile.wallCap)
+            {
+                AddWallCap(x, y, tile.wallCapMainColor, tile.wallCapCenterColor);
+            }
+        }
+    }
+
+    m_staticGeometryChanged = false;
 }
\ No newline at end of file
@@ -40,6 +40,18 @@ public:
         float y4;
     } quadCoordinates;
 
+    typedef struct
+    {
+        bool floor;
+        bool northWall;
+        bool westWall;
+        bool wallCap;
+        const Picture* northWallPicture;
+        const Picture* westWallPicture;
+        egaColor wallCapMainColor;
+        egaColor wallCapCenterColor;
+    } staticTile;
+
     RenderableAutoMapIso(
         const Font& font,
         const ViewPorts::ViewPortRect3D original3DViewArea);
@@ -64,14 +76,23 @@ public:
     const RenderableText& GetText() const;
 
     void SetPlayerPosition(const float x, const float y, const float angle);
-    void AddNorthWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
-    void AddWestWall(const uint16_t x, const uint16_t y, const unsigned int textureId);
-    void AddWallCap(const uint16_t x, const uint16_t y, const egaColor mainColor, const egaColor centerColor);
     Renderable3DTiles& GetFloorTilesMutable();
     RenderableSprites& GetSpritesMutable();
     RenderableText& GetTextMutable();
 
+    // The floor tiles, walls and wall caps are kept in between frames, as they only change when the
+    // fog of war lifts or a wall changes. They are set per tile and only rebuilt when a tile was changed.
+    // The geometry ID identifies the level, and the state of that level, that the tiles were set for.
+    uint32_t GetStaticGeometryId() const;
+    void ResetStaticGeometry(const uint32_t geometryId, const uint16_t width, const uint16_t height);
+    void SetStaticTile(const uint16_t x, const uint16_t y, const staticTile& tile);
+
 private:
+    void RebuildStaticGeometry();
+    void AddNorthWall(const uint16_t x, const uint16_t y, const Picture* picture);
+    void AddWestWall(const uint16_t x, const uint16_t y, const Picture* picture);
+    void AddWallCap(const uint16_t x, const uint16_t y, const egaColor mainColor, const egaColor centerColor);
+
     Renderable3DWalls m_walls;
     std::map <egaColor, std::vector<quadCoordinates>> m_wallCaps;
     Renderable3DTiles m_floorTiles;
@@ -84,4 +105,9 @@ private:
     float m_playerX;
     float m_playerY;
     float m_playerAngle;
+    std::vector<staticTile> m_staticTiles;
+    uint16_t m_staticTilesWidth;
+    uint16_t m_staticTilesHeight;
+    uint32_t m_staticGeometryId;
+    bool m_staticGeometryChanged;
 };
@@ -14,15 +14,20 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/ 
 
 #include "RenderableSprites.h"
+#include <algorithm>
 #include <cmath>
 
-const uint8_t MaxSpritesToRender = 100;
+// When the order of the previous frame is far off, like when the player turns around, the insertion sort is abandoned
+// after this many moves per sprite, in favour of std::sort.
+const uint32_t MaxInsertionSortMovesPerSprite = 8;
 
 RenderableSprites::RenderableSprites() :
     m_playerPosX(1.0f),
     m_playerPosY(1.0f),
     m_angle(0.0f),
-    m_sprites()
+    m_sprites(),
+    m_sortedSprites(),
+    m_order()
 {
 
 }
@@ -58,7 +63,29 @@ void RenderableSprites::AddSprite(const Picture* picture, const float offsetX, c
 
 void RenderableSprites::SortSpritesBackToFront()
 {
-    QuickSort(0, (uint16_t)(m_sprites.size()));
+    const uint16_t numberOfSprites = (uint16_t)m_sprites.size();
+
+    // The order of the previous frame only applies when the same number of sprites was added
+    if (m_order.size() != numberOfSprites)
+    {
+        m_order.resize(numberOfSprites);
+        for (uint16_t i = 0; i < numberOfSprites; i++)
+        {
+            m_order[i] = i;
+        }
+    }
+
+    if (!InsertionSort())
+    {
+        std::sort(m_order.begin(), m_order.end(), [this](const uint16_t p, const uint16_t q) { return IsFurther(p, q); });
+    }
+
+    m_sortedSprites.resize(numberOfSprites);
+    for (uint16_t i = 0; i < numberOfSprites; i++)
+    {
+        m_sortedSprites[i] = m_sprites[m_order[i]];
+    }
+    std::swap(m_sprites, m_sortedSprites);
 }
 
 const std::vector<RenderableSprites::RenderableSprite>& RenderableSprites::GetSprites() const
@@ -71,40 +98,33 @@ const float RenderableSprites::GetAngle() const
     return m_angle;
 }
 
-void RenderableSprites::QuickSort(uint16_t p, uint16_t q)
+bool RenderableSprites::IsFurther(const uint16_t p, const uint16_t q) const
 {
-    if (p < q)
-    {
-        int r = Partition(p, q);
-        QuickSort(p, r);
-        QuickSort(r + 1, q);
-    }
+    return m_sprites[p].distanceToPlayerViewScreen > m_sprites[q].distanceToPlayerViewScreen;
 }
 
-
-uint16_t RenderableSprites::Partition(uint16_t p, uint16_t q)
+// Returns false if the order was too far off to be sorted within the maximum number of moves.
+bool RenderableSprites::InsertionSort()
 {
-    const float x = m_sprites.at(p).distanceToPlayerViewScreen;
-    uint16_t i = p;
-
-    for (uint16_t j = p + 1; j < q; j++)
+    const uint32_t maxMoves = MaxInsertionSortMovesPerSprite * (uint32_t)m_order.size();
+    uint32_t moves = 0;
+    for (uint16_t i = 1; i < m_order.size(); i++)
     {
-        if (m_sprites.at(j).distanceToPlayerViewScreen >= x)
+        const uint16_t sprite = m_order[i];
+        uint16_t j = i;
+        while (j > 0 && IsFurther(sprite, m_order[j - 1]))
         {
-            i = i + 1;
-            Swap(i, j);
+            m_order[j] = m_order[j - 1];
+            j--;
+            moves++;
         }
-    }
+        m_order[j] = sprite;
 
-    Swap(i, p);
-    return i;
-}
+        if (moves > maxMoves)
+        {
+            return false;
+        }
+    }
 
-void RenderableSprites::Swap(uint16_t p, uint16_t q)
-{
-    std::swap(m_sprites.at(p).picture, m_sprites.at(q).picture);
-    std::swap(m_sprites.at(p).offsetX, m_sprites.at(q).offsetX);
-    std::swap(m_sprites.at(p).offsetY, m_sprites.at(q).offsetY);
-    std::swap(m_sprites.at(p).distanceToPlayerViewScreen, m_sprites.at(q).distanceToPlayerViewScreen);
-    std::swap(m_sprites.at(p).orientation, m_sprites.at(q).orientation);
+    return true;
 }
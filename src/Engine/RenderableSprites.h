@@ -21,6 +21,7 @@
 #pragma once
 
 #include "Picture.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
@@ -44,20 +45,26 @@ public:
         SpriteOrientation orientation;
     } RenderableSprite;
 
+    static const uint16_t MaxSpritesToRender = 1024;
+
     RenderableSprites();
     void Reset(const float playerPosX, const float playerPosY, const float angle);
     void AddSprite(const Picture* picture, const float offsetX, const float offsetY, const SpriteOrientation orientation);
+
+    // Sorts the sprites starting from the order of the previous frame. As the sprites are added in about the same order
+    // each frame and only move a bit relative to the player, this order is usually close to the sorted order.
     void SortSpritesBackToFront();
 
     const std::vector<RenderableSprite>& GetSprites() const;
     const float GetAngle() const;
 
 private:
-    void QuickSort(uint16_t p, uint16_t q);
-    uint16_t Partition(uint16_t p, uint16_t q);
-    void Swap(uint16_t p, uint16_t q);
+    bool IsFurther(const uint16_t p, const uint16_t q) const;
+    bool InsertionSort();
 
     std::vector<RenderableSprite> m_sprites;
+    std::vector<RenderableSprite> m_sortedSprites;
+    std::vector<uint16_t> m_order;
     float m_playerPosX;
     float m_playerPosY;
     float m_angle;
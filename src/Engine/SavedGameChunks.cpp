@@ -0,0 +1,282 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SavedGameChunks.h"
+#include "Checksum.h"
+#include <cstring>
+
+const char headerString[10] = { 'C', 'A', 'T', 'A', 'C', 'O', 'M', 'B', 'G', 'L' };
+const size_t headerSize = sizeof(headerString) + 1 + 2;
+const size_t chunkIdSize = 4;
+const size_t chunkHeaderSize = chunkIdSize + 1 + 4 + 4 + 4;
+
+const uint8_t compressionNone = 0;
+const uint8_t compressionRLEW = 1;
+
+// Same tag as the RLEW compression of the maps of the Catacomb games
+const uint16_t rlewTag = 0xABCD;
+
+// Shorter runs are cheaper to store as they are than as a tag, count and value.
+const uint16_t minimumRunLength = 4;
+
+// A run of tag, count and value expands to at most this many bytes
+const size_t maximumRunSize = 2 * 0xFFFF;
+const size_t runHeaderSize = 6;
+
+static void WriteUInt16(std::vector<uint8_t>& data, const uint16_t value)
+{
+    data.push_back((uint8_t)(value & 0xFF));
+    data.push_back((uint8_t)(value >> 8));
+}
+
+static void WriteUInt32(std::vector<uint8_t>& data, const uint32_t value)
+{
+    WriteUInt16(data, (uint16_t)(value & 0xFFFF));
+    WriteUInt16(data, (uint16_t)(value >> 16));
+}
+
+static uint16_t ReadUInt16(const uint8_t* data)
+{
+    return (uint16_t)(data[0] | (data[1] << 8));
+}
+
+static uint32_t ReadUInt32(const uint8_t* data)
+{
+    return (uint32_t)ReadUInt16(data) | ((uint32_t)ReadUInt16(data + 2) << 16);
+}
+
+const uint8_t SavedGameChunks::FormatVersion;
+
+SavedGameChunks::SavedGameChunks() :
+    m_chunks()
+{
+
+}
+
+SavedGameChunks::~SavedGameChunks()
+{
+
+}
+
+std::vector<uint8_t>& SavedGameChunks::AddChunk(const std::string& id)
+{
+    m_chunks.emplace_back(id, std::vector<uint8_t>());
+    return m_chunks.back().second;
+}
+
+const std::vector<uint8_t>* SavedGameChunks::GetChunk(const std::string& id) const
+{
+    for (const auto& chunk : m_chunks)
+    {
+        if (chunk.first == id)
+        {
+            return &chunk.second;
+        }
+    }
+    return nullptr;
+}
+
+void SavedGameChunks::Clear()
+{
+    m_chunks.clear();
+}
+
+void SavedGameChunks::Serialize(std::vector<uint8_t>& data, const bool compress) const
+{
+    data.assign(headerString, headerString + sizeof(headerString));
+    data.push_back(FormatVersion);
+    WriteUInt16(data, (uint16_t)m_chunks.size());
+
+    std::vector<uint8_t> compressedData;
+    for (const auto& chunk : m_chunks)
+    {
+        char id[chunkIdSize] = { ' ', ' ', ' ', ' ' };
+        chunk.first.copy(id, chunkIdSize);
+        data.insert(data.end(), id, id + chunkIdSize);
+
+        const std::vector<uint8_t>& chunkData = chunk.second;
+        bool compressed = false;
+        if (compress)
+        {
+            CompressRLEW(chunkData, compressedData);
+            compressed = compressedData.size() < chunkData.size();
+        }
+        const std::vector<uint8_t>& storedData = compressed ? compressedData : chunkData;
+
+        data.push_back(compressed ? compressionRLEW : compressionNone);
+        WriteUInt32(data, (uint32_t)chunkData.size());
+        WriteUInt32(data, (uint32_t)storedData.size());
+        WriteUInt32(data, Checksum::Crc32(chunkData.data(), chunkData.size()));
+        data.insert(data.end(), storedData.begin(), storedData.end());
+    }
+}
+
+bool SavedGameChunks::Deserialize(const std::vector<uint8_t>& data)
+{
+    m_chunks.clear();
+    if (GetFormatVersion(data) != FormatVersion)
+    {
+        return false;
+    }
+
+    const uint16_t numberOfChunks = ReadUInt16(&data[sizeof(headerString) + 1]);
+    size_t position = headerSize;
+    for (uint16_t i = 0; i < numberOfChunks; i++)
+    {
+        if (data.size() - position < chunkHeaderSize)
+        {
+            m_chunks.clear();
+            return false;
+        }
+        const uint8_t* chunkHeader = &data[position];
+        const std::string id((const char*)chunkHeader, chunkIdSize);
+        const uint8_t compression = chunkHeader[chunkIdSize];
+        const uint32_t size = ReadUInt32(chunkHeader + chunkIdSize + 1);
+        const uint32_t storedSize = ReadUInt32(chunkHeader + chunkIdSize + 5);
+        const uint32_t crc = ReadUInt32(chunkHeader + chunkIdSize + 9);
+        position += chunkHeaderSize;
+        if (data.size() - position < storedSize)
+        {
+            m_chunks.clear();
+            return false;
+        }
+
+        std::vector<uint8_t>& chunkData = AddChunk(id);
+        const uint8_t* storedData = data.data() + position;
+        bool valid = false;
+        if (compression == compressionNone)
+        {
+            chunkData.assign(storedData, storedData + storedSize);
+            valid = (storedSize == size);
+        }
+        else if (compression == compressionRLEW)
+        {
+            valid = ExpandRLEW(storedData, storedSize, size, chunkData);
+        }
+
+        if (!valid || Checksum::Crc32(chunkData.data(), chunkData.size()) != crc)
+        {
+            m_chunks.clear();
+            return false;
+        }
+        position += storedSize;
+    }
+
+    return true;
+}
+
+uint8_t SavedGameChunks::GetFormatVersion(const std::vector<uint8_t>& data)
+{
+    if (data.size() < headerSize || std::memcmp(data.data(), headerString, sizeof(headerString)) != 0)
+    {
+        return 0;
+    }
+    return data[sizeof(headerString)];
+}
+
+void SavedGameChunks::CompressRLEW(const std::vector<uint8_t>& data, std::vector<uint8_t>& compressedData)
+{
+    compressedData.clear();
+    compressedData.reserve(data.size());
+    const size_t numberOfWords = data.size() / 2;
+    size_t i = 0;
+    while (i < numberOfWords)
+    {
+        const uint16_t value = ReadUInt16(&data[i * 2]);
+        uint16_t count = 1;
+        while (i + count < numberOfWords && count < 0xFFFF && ReadUInt16(&data[(i + count) * 2]) == value)
+        {
+            count++;
+        }
+
+        if (count >= minimumRunLength || value == rlewTag)
+        {
+            WriteUInt16(compressedData, rlewTag);
+            WriteUInt16(compressedData, count);
+            WriteUInt16(compressedData, value);
+            i += count;
+        }
+        else
+        {
+            WriteUInt16(compressedData, value);
+            i++;
+        }
+    }
+
+    // An odd byte at the end is stored as is
+    if (data.size() % 2 == 1)
+    {
+        compressedData.push_back(data.back());
+    }
+}
+
+bool SavedGameChunks::ExpandRLEW(const uint8_t* compressedData, const size_t compressedSize, const size_t size, std::vector<uint8_t>& data)
+{
+    // The size comes from the chunk header; a damaged header must not lead to a huge allocation
+    const size_t maximumSize = (compressedSize / runHeaderSize) * maximumRunSize + (compressedSize % runHeaderSize);
+    if (size > maximumSize)
+    {
+        return false;
+    }
+
+    data.resize(size);
+    const size_t wordsSize = size & ~(size_t)1;
+    size_t position = 0;
+    size_t written = 0;
+    while (written < wordsSize)
+    {
+        if (compressedSize - position < 2)
+        {
+            return false;
+        }
+        const uint16_t value = ReadUInt16(compressedData + position);
+        position += 2;
+        if (value == rlewTag)
+        {
+            if (compressedSize - position < 4)
+            {
+                return false;
+            }
+            const uint16_t count = ReadUInt16(compressedData + position);
+            const uint8_t* repeatedValue = compressedData + position + 2;
+            position += 4;
+            if (written + (size_t)count * 2 > wordsSize)
+            {
+                return false;
+            }
+            for (uint16_t j = 0; j < count; j++)
+            {
+                data[written++] = repeatedValue[0];
+                data[written++] = repeatedValue[1];
+            }
+        }
+        else
+        {
+            data[written++] = compressedData[position - 2];
+            data[written++] = compressedData[position - 1];
+        }
+    }
+
+    if (size % 2 == 1)
+    {
+        if (position == compressedSize)
+        {
+            return false;
+        }
+        data[written] = compressedData[position++];
+    }
+
+    return position == compressedSize;
+}
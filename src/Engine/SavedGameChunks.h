@@ -0,0 +1,58 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// SavedGameChunks
+//
+// Container format of the saved games. The game state is split in chunks, each identified by four characters and
+// stored with its length and CRC, such that a reader can skip chunks it does not know and detect a damaged file before
+// any of it is applied. Chunks can be compressed with RLEW, which suits the 16-bit tile planes that make up most of a
+// saved game. The whole file is built in memory and parsed from memory, so that it is written and read in one go.
+//
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+class SavedGameChunks
+{
+public:
+    // The eleventh byte of the header used to be the terminator of the "CATACOMBGL" string. It now holds the
+    // format version, which makes the saved games from before the chunks format version 0.
+    static const uint8_t FormatVersion = 1;
+
+    SavedGameChunks();
+    ~SavedGameChunks();
+
+    // Returns the data of a new chunk, to be filled by the caller. The reference is valid until the next chunk is added.
+    std::vector<uint8_t>& AddChunk(const std::string& id);
+    // Returns nullptr if the chunk is not present.
+    const std::vector<uint8_t>* GetChunk(const std::string& id) const;
+    void Clear();
+
+    void Serialize(std::vector<uint8_t>& data, const bool compress) const;
+    // Returns false if the data is not in the chunks format or is damaged.
+    bool Deserialize(const std::vector<uint8_t>& data);
+
+    static uint8_t GetFormatVersion(const std::vector<uint8_t>& data);
+
+    static void CompressRLEW(const std::vector<uint8_t>& data, std::vector<uint8_t>& compressedData);
+    static bool ExpandRLEW(const uint8_t* compressedData, const size_t compressedSize, const size_t size, std::vector<uint8_t>& data);
+
+private:
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> m_chunks;
+};
@@ -24,9 +24,12 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <fstream>
 #include <ios>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -36,12 +39,19 @@ Shape::Shape(const IRenderer& renderer) :
     m_offsetX = 0;
     m_offsetY = 0;
     m_picture = nullptr;
+    m_pixelData = nullptr;
+    m_imageWidth = 0;
+    m_imageHeight = 0;
+    m_textureWidth = 0;
+    m_textureHeight = 0;
 }
 
 Shape::~Shape()
 {
     delete m_picture;
     m_picture = nullptr;
+    delete[] m_pixelData;
+    m_pixelData = nullptr;
 }
 
 struct CMP1Header
@@ -120,6 +130,46 @@ constexpr bool CmpChunk(const uint8_t* const Ptr, const char Name[4]) {
 #define BE_Cross_Swap32(x) ((uint32_t)(((uint32_t)(x)<<24)|(((uint32_t)(x)<<8)&0x00FF0000)|(((uint32_t)(x)>>8)&0x0000FF00)|((uint32_t)(x)>>24)))
 
 bool Shape::LoadFromFile(const fs::path filename)
+{
+    const bool decoded = DecodeFromFile(filename);
+    UploadTexture();
+    return decoded;
+}
+
+void Shape::LoadFromFiles(const std::vector<std::pair<Shape*, fs::path>>& shapes)
+{
+    // Each worker takes the next shape that is not yet taken, until all shapes are decoded.
+    std::atomic<size_t> nextShape(0);
+    const auto decodeShapes = [&shapes, &nextShape]()
+    {
+        size_t i = nextShape++;
+        while (i < shapes.size())
+        {
+            shapes.at(i).first->DecodeFromFile(shapes.at(i).second);
+            i = nextShape++;
+        }
+    };
+
+    // The calling thread decodes shapes as well
+    const size_t numberOfWorkers = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), shapes.size());
+    std::vector<std::thread> workers;
+    for (size_t i = 1; i < numberOfWorkers; i++)
+    {
+        workers.emplace_back(decodeShapes);
+    }
+    decodeShapes();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    for (const std::pair<Shape*, fs::path>& shape : shapes)
+    {
+        shape.first->UploadTexture();
+    }
+}
+
+bool Shape::DecodeFromFile(const fs::path filename)
 {
     uint8_t* data = nullptr;
     std::size_t dataSize = 0;
@@ -173,7 +223,10 @@ bool Shape::LoadFromFile(const fs::path filename)
             numberOfPlanes = ((struct BitMapHeader*)ptr)->d;
             if (numberOfPlanes != 4)
             {
-                Logging::Instance().FatalError("Failed to read shape " + filename.string() + ": number of planes is " + std::to_string(numberOfPlanes) + "; expected: 4");
+                // Reported by UploadTexture, as a fatal error cannot be raised from a worker thread
+                m_decodeError = "Failed to read shape " + filename.string() + ": number of planes is " + std::to_string(numberOfPlanes) + "; expected: 4";
+                // LAMBDA RETURN
+                return;
             }
 
             const uint8_t transparent = ((struct BitMapHeader*)ptr)->trans;
@@ -220,6 +273,12 @@ bool Shape::LoadFromFile(const fs::path filename)
         IFFfile = nullptr;
     }
 
+    if (!m_decodeError.empty())
+    {
+        delete[] data;
+        return false;
+    }
+
     FileChunk* chunk = new FileChunk(bytesPerRow * numberOfPlanes * height);
 
 	const bool NotWordAligned = bytesPerRow & 1;
@@ -298,12 +357,35 @@ bool Shape::LoadFromFile(const fs::path filename)
     const uint16_t imageWidth = bytesPerRow * numberOfPlanes * 2;
     const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(imageWidth);
     const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(height);
-    const unsigned int textureId = LoadFileChunkIntoTexture(chunk, imageWidth, height, textureWidth, textureHeight, false);
+    m_pixelData = ConvertFileChunkToPixelData(chunk, imageWidth, height, textureWidth, textureHeight, false);
     delete chunk;
 
-    m_picture = new Picture(textureId, imageWidth, height, textureWidth, textureHeight);
+    m_imageWidth = imageWidth;
+    m_imageHeight = height;
+    m_textureWidth = textureWidth;
+    m_textureHeight = textureHeight;
 
-    return true;
+    return m_pixelData != nullptr;
+}
+
+void Shape::UploadTexture()
+{
+    if (!m_decodeError.empty())
+    {
+        Logging::Instance().FatalError(m_decodeError);
+    }
+
+    if (m_pixelData == nullptr)
+    {
+        return;
+    }
+
+    const unsigned int textureId = m_renderer.GenerateTextureId();
+    m_renderer.LoadIndexedPixelDataIntoTexture(m_textureWidth, m_textureHeight, m_pixelData, textureId);
+    delete[] m_pixelData;
+    m_pixelData = nullptr;
+
+    m_picture = new Picture(textureId, m_imageWidth, m_imageHeight, m_textureWidth, m_textureHeight);
 }
 
 uint16_t Shape::GetOffsetX() const
@@ -321,7 +403,7 @@ Picture* Shape::GetPicture() const
     return m_picture;
 }
 
-unsigned int Shape::LoadFileChunkIntoTexture(
+uint8_t* Shape::ConvertFileChunkToPixelData(
     const FileChunk* decompressedChunk,
     const uint16_t imageWidth,
     const uint16_t imageHeight,
@@ -329,7 +411,7 @@ unsigned int Shape::LoadFileChunkIntoTexture(
     const uint16_t textureHeight,
     const bool transparent)
 {
-    const uint32_t bytesPerOutputPixel = 4;
+    const uint32_t bytesPerOutputPixel = 1;
     const uint32_t numberOfPlanes = 4;
     const uint32_t planeSize = decompressedChunk->GetSize() / numberOfPlanes;
     const uint32_t numberOfEgaPixelsPerByte = 8;
@@ -338,7 +420,8 @@ unsigned int Shape::LoadFileChunkIntoTexture(
 
     if (textureImageSize < imageWidth * imageHeight * bytesPerOutputPixel)
     {
-        Logging::Instance().FatalError("Texture image of size " + std::to_string(textureImageSize) + " is too small to contain image of dimensions (" + std::to_string(imageWidth) + " x " + std::to_string(imageHeight) + std::to_string(bytesPerOutputPixel) + ")");
+        m_decodeError = "Texture image of size " + std::to_string(textureImageSize) + " is too small to contain image of dimensions (" + std::to_string(imageWidth) + " x " + std::to_string(imageHeight) + std::to_string(bytesPerOutputPixel) + ")";
+        return nullptr;
     }
 
     uint8_t* textureImage = new uint8_t[textureImageSize];
@@ -346,7 +429,7 @@ unsigned int Shape::LoadFileChunkIntoTexture(
     // Clear the whole texture
     for (uint32_t i = 0; i < textureImageSize; i++)
     {
-        textureImage[i] = 0;
+        textureImage[i] = EgaTransparentIndex;
     }
 
     unsigned char* chunk = decompressedChunk->GetChunk();
@@ -366,23 +449,14 @@ unsigned int Shape::LoadFileChunkIntoTexture(
                     (greenplane ? EgaGreen : EgaBlack) +
                     (blueplane ? EgaBlue : EgaBlack));
             const bool transparentPixel = transparent && (colorIndex == 5);
-            const rgbColor outputColor = EgaToRgb(transparentPixel ? EgaBlack : colorIndex);
 
             const uint32_t outputImagePixelOffset = ((i * 8) + 7 - j);
             const uint32_t outputImagePixelX = outputImagePixelOffset % imageWidth;
             const uint32_t outputImagePixelY = outputImagePixelOffset / imageWidth;
             const uint32_t outputTextureOffset = ((outputImagePixelY * textureWidth) + outputImagePixelX) * bytesPerOutputPixel;
-            textureImage[outputTextureOffset] = outputColor.red;
-            textureImage[outputTextureOffset + 1] = outputColor.green;
-            textureImage[outputTextureOffset + 2] = outputColor.blue;
-            textureImage[outputTextureOffset + 3] = transparentPixel ? 0 : 255;
+            textureImage[outputTextureOffset] = transparentPixel ? EgaTransparentIndex : colorIndex;
         }
     }
 
-    const unsigned int textureId = m_renderer.GenerateTextureId();
-    m_renderer.LoadPixelDataIntoTexture(textureWidth, textureHeight, textureImage, textureId);
-
-    delete[] textureImage;
-
-    return textureId;
+    return textureImage;
 }
@@ -17,6 +17,8 @@
 // Shape
 //
 // A picture used in the introduction screens, which is read from a SHP??.ABS file.
+// Reading and decoding a shape file does not involve the renderer, such that several shapes can be decoded
+// on worker threads at the same time. Only the upload of the texture needs to be done on the render thread.
 //
 #pragma once
 
@@ -24,6 +26,9 @@
 #include "IRenderer.h"
 #include "Logging.h"
 #include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
 
 class Shape
 {
@@ -32,12 +37,17 @@ public:
     ~Shape();
     bool LoadFromFile(const std::filesystem::path filename);
 
+    // Loads all given shapes; the files are decoded in parallel, after which the textures are uploaded.
+    static void LoadFromFiles(const std::vector<std::pair<Shape*, std::filesystem::path>>& shapes);
+
     uint16_t GetOffsetX() const;
     uint16_t GetOffsetY() const;
     Picture* GetPicture() const;
 
 private:
-    unsigned int LoadFileChunkIntoTexture(
+    bool DecodeFromFile(const std::filesystem::path filename);
+    void UploadTexture();
+    uint8_t* ConvertFileChunkToPixelData(
         const FileChunk* decompressedChunk,
         const uint16_t imageWidth,
         const uint16_t imageHeight,
@@ -48,5 +58,11 @@ private:
     uint16_t m_offsetX;
     uint16_t m_offsetY;
     Picture* m_picture;
+    uint8_t* m_pixelData;
+    uint16_t m_imageWidth;
+    uint16_t m_imageHeight;
+    uint16_t m_textureWidth;
+    uint16_t m_textureHeight;
+    std::string m_decodeError;
     const IRenderer& m_renderer;
 };
@@ -0,0 +1,202 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SnapshotRing.h"
+#include <algorithm>
+
+// Short runs of equal bytes are cheaper to store as part of the literal bytes around them.
+const size_t minimumEqualRun = 8;
+
+static void WriteNumber(std::vector<uint8_t>& delta, size_t value)
+{
+    while (value >= 0x80)
+    {
+        delta.push_back((uint8_t)(value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    delta.push_back((uint8_t)value);
+}
+
+static bool ReadNumber(const std::vector<uint8_t>& delta, size_t& position, size_t& value)
+{
+    value = 0;
+    uint8_t shift = 0;
+    while (position < delta.size() && shift < 64)
+    {
+        const uint8_t byte = delta[position++];
+        value |= (size_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+        shift += 7;
+    }
+    return false;
+}
+
+SnapshotRing::SnapshotRing(const uint16_t capacity) :
+    m_deltas((capacity > 1) ? capacity - 1 : 0),
+    m_oldestDelta(0),
+    m_numberOfDeltas(0),
+    m_hasNewest(false)
+{
+
+}
+
+SnapshotRing::~SnapshotRing()
+{
+
+}
+
+void SnapshotRing::Push(const std::vector<uint8_t>& snapshot)
+{
+    if (m_hasNewest && !m_deltas.empty())
+    {
+        if (m_numberOfDeltas == m_deltas.size())
+        {
+            // Drop the oldest snapshot
+            m_oldestDelta = (m_oldestDelta + 1) % m_deltas.size();
+            m_numberOfDeltas--;
+        }
+        const uint16_t index = (m_oldestDelta + m_numberOfDeltas) % m_deltas.size();
+        EncodeDelta(snapshot, m_newest, m_deltas.at(index));
+        m_numberOfDeltas++;
+    }
+
+    m_newest.assign(snapshot.begin(), snapshot.end());
+    m_hasNewest = true;
+}
+
+const std::vector<uint8_t>& SnapshotRing::GetNewest() const
+{
+    return m_newest;
+}
+
+void SnapshotRing::Pop()
+{
+    if (m_numberOfDeltas == 0)
+    {
+        Clear();
+        return;
+    }
+
+    const uint16_t index = (m_oldestDelta + m_numberOfDeltas - 1) % m_deltas.size();
+    m_numberOfDeltas--;
+    if (ApplyDelta(m_newest, m_deltas.at(index), m_decoded))
+    {
+        m_newest.swap(m_decoded);
+    }
+    else
+    {
+        Clear();
+    }
+}
+
+void SnapshotRing::Clear()
+{
+    m_newest.clear();
+    m_oldestDelta = 0;
+    m_numberOfDeltas = 0;
+    m_hasNewest = false;
+}
+
+uint16_t SnapshotRing::GetSize() const
+{
+    return m_hasNewest ? m_numberOfDeltas + 1 : 0;
+}
+
+bool SnapshotRing::IsEmpty() const
+{
+    return !m_hasNewest;
+}
+
+size_t SnapshotRing::GetMemoryUsage() const
+{
+    size_t memoryUsage = m_newest.size();
+    for (uint16_t i = 0; i < m_numberOfDeltas; i++)
+    {
+        memoryUsage += m_deltas.at((m_oldestDelta + i) % m_deltas.size()).size();
+    }
+    return memoryUsage;
+}
+
+void SnapshotRing::EncodeDelta(const std::vector<uint8_t>& source, const std::vector<uint8_t>& target, std::vector<uint8_t>& delta)
+{
+    delta.clear();
+    WriteNumber(delta, target.size());
+
+    const size_t commonSize = (source.size() < target.size()) ? source.size() : target.size();
+    size_t position = 0;
+    while (position < target.size())
+    {
+        const size_t equalStart = position;
+        while (position < commonSize && source[position] == target[position])
+        {
+            position++;
+        }
+        const size_t equalLength = position - equalStart;
+
+        const size_t literalStart = position;
+        size_t equalRun = 0;
+        while (position < target.size() && equalRun < minimumEqualRun)
+        {
+            equalRun = (position < commonSize && source[position] == target[position]) ? equalRun + 1 : 0;
+            position++;
+        }
+        if (equalRun == minimumEqualRun)
+        {
+            // The equal run goes into the next pair
+            position -= equalRun;
+        }
+
+        WriteNumber(delta, equalLength);
+        WriteNumber(delta, position - literalStart);
+        delta.insert(delta.end(), target.begin() + literalStart, target.begin() + position);
+    }
+}
+
+bool SnapshotRing::ApplyDelta(const std::vector<uint8_t>& source, const std::vector<uint8_t>& delta, std::vector<uint8_t>& target)
+{
+    size_t deltaPosition = 0;
+    size_t targetSize = 0;
+    if (!ReadNumber(delta, deltaPosition, targetSize))
+    {
+        return false;
+    }
+
+    target.resize(targetSize);
+    size_t position = 0;
+    while (position < targetSize)
+    {
+        size_t equalLength = 0;
+        size_t literalLength = 0;
+        if (!ReadNumber(delta, deltaPosition, equalLength) ||
+            !ReadNumber(delta, deltaPosition, literalLength) ||
+            position + equalLength > source.size() ||
+            position + equalLength + literalLength > targetSize ||
+            deltaPosition + literalLength > delta.size())
+        {
+            return false;
+        }
+
+        std::copy(source.begin() + position, source.begin() + position + equalLength, target.begin() + position);
+        position += equalLength;
+        std::copy(delta.begin() + deltaPosition, delta.begin() + deltaPosition + literalLength, target.begin() + position);
+        position += literalLength;
+        deltaPosition += literalLength;
+    }
+
+    return deltaPosition == delta.size();
+}
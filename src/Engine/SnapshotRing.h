@@ -0,0 +1,60 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// SnapshotRing
+//
+// Keeps the most recent snapshots of the game state in memory, for rewinding. The newest snapshot is kept as is, while
+// each older snapshot is stored as the difference with the snapshot that followed it. Consecutive snapshots only
+// differ in the actors that moved and the tiles that changed, so the differences are small. When the ring is full,
+// the oldest snapshot is dropped. The storage of dropped snapshots is reused.
+//
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <vector>
+
+class SnapshotRing
+{
+public:
+    explicit SnapshotRing(const uint16_t capacity);
+    ~SnapshotRing();
+
+    void Push(const std::vector<uint8_t>& snapshot);
+    const std::vector<uint8_t>& GetNewest() const;
+    // Removes the newest snapshot, such that the snapshot before it becomes the newest.
+    void Pop();
+    void Clear();
+
+    uint16_t GetSize() const;
+    bool IsEmpty() const;
+    // Total number of bytes in use by the snapshots.
+    size_t GetMemoryUsage() const;
+
+    // The delta turns the source into the target. It consists of pairs of a number of bytes that are equal to the
+    // source and a number of bytes that are taken from the delta, both as variable length numbers.
+    static void EncodeDelta(const std::vector<uint8_t>& source, const std::vector<uint8_t>& target, std::vector<uint8_t>& delta);
+    static bool ApplyDelta(const std::vector<uint8_t>& source, const std::vector<uint8_t>& delta, std::vector<uint8_t>& target);
+
+private:
+    std::vector<uint8_t> m_newest;
+    std::vector<uint8_t> m_decoded;
+    // Circular buffer of deltas, from old to new. Each delta turns the snapshot after it into its own snapshot.
+    std::vector<std::vector<uint8_t>> m_deltas;
+    uint16_t m_oldestDelta;
+    uint16_t m_numberOfDeltas;
+    bool m_hasNewest;
+};
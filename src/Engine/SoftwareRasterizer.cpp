@@ -0,0 +1,531 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SoftwareRasterizer.h"
+#include <algorithm>
+#include <cmath>
+
+// Vertices are snapped to 1/256 of a pixel, such that the coverage of the edges can be determined exactly
+static const int64_t subPixelBits = 8;
+static const int64_t subPixels = 1 << subPixelBits;
+
+static int32_t FloorDivide(const int64_t value, const int64_t divisor)
+{
+    return (int32_t)((value >= 0) ? value / divisor : -((-value + divisor - 1) / divisor));
+}
+
+static void UnpackColor(const uint32_t pixel, float color[4])
+{
+    color[0] = (float)(pixel & 0xFF) / 255.0f;
+    color[1] = (float)((pixel >> 8) & 0xFF) / 255.0f;
+    color[2] = (float)((pixel >> 16) & 0xFF) / 255.0f;
+    color[3] = (float)(pixel >> 24) / 255.0f;
+}
+
+static uint32_t PackColor(const float color[4])
+{
+    uint32_t pixel = 0;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        const float component = (color[i] < 0.0f) ? 0.0f : (color[i] > 1.0f) ? 1.0f : color[i];
+        pixel |= (uint32_t)(component * 255.0f + 0.5f) << (i * 8);
+    }
+    return pixel;
+}
+
+static void SampleTexture(const SoftwareRasterizer::texture& texture, const bool linearFilter, const float s, const float t, float color[4])
+{
+    const int32_t width = (int32_t)texture.width;
+    const int32_t height = (int32_t)texture.height;
+    if (texture.pixels.empty())
+    {
+        // A deleted texture has no pixels left; it is sampled as fully transparent
+        color[0] = color[1] = color[2] = color[3] = 0.0f;
+        return;
+    }
+
+    if (!linearFilter)
+    {
+        const int32_t x = std::min(std::max((int32_t)std::floor(s * (float)width), 0), width - 1);
+        const int32_t y = std::min(std::max((int32_t)std::floor(t * (float)height), 0), height - 1);
+        UnpackColor(texture.pixels[(y * width) + x], color);
+        return;
+    }
+
+    const float u = (s * (float)width) - 0.5f;
+    const float v = (t * (float)height) - 0.5f;
+    const float uFloor = std::floor(u);
+    const float vFloor = std::floor(v);
+    const float alpha = u - uFloor;
+    const float beta = v - vFloor;
+    const int32_t x0 = std::min(std::max((int32_t)uFloor, 0), width - 1);
+    const int32_t x1 = std::min(std::max((int32_t)uFloor + 1, 0), width - 1);
+    const int32_t y0 = std::min(std::max((int32_t)vFloor, 0), height - 1);
+    const int32_t y1 = std::min(std::max((int32_t)vFloor + 1, 0), height - 1);
+
+    float texels[4][4];
+    UnpackColor(texture.pixels[(y0 * width) + x0], texels[0]);
+    UnpackColor(texture.pixels[(y0 * width) + x1], texels[1]);
+    UnpackColor(texture.pixels[(y1 * width) + x0], texels[2]);
+    UnpackColor(texture.pixels[(y1 * width) + x1], texels[3]);
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        color[i] =
+            ((1.0f - alpha) * (1.0f - beta) * texels[0][i]) +
+            (alpha * (1.0f - beta) * texels[1][i]) +
+            ((1.0f - alpha) * beta * texels[2][i]) +
+            (alpha * beta * texels[3][i]);
+    }
+}
+
+static bool IsSameState(const SoftwareRasterizer::drawState& a, const SoftwareRasterizer::drawState& b)
+{
+    return
+        a.boundTexture == b.boundTexture &&
+        a.linearFilter == b.linearFilter &&
+        a.depthTest == b.depthTest &&
+        a.depthWrite == b.depthWrite &&
+        a.blend == b.blend &&
+        a.cullFrontFaces == b.cullFrontFaces &&
+        a.revealTimes == b.revealTimes &&
+        a.revealedTime == b.revealedTime &&
+        a.viewPortLeft == b.viewPortLeft &&
+        a.viewPortBottom == b.viewPortBottom &&
+        a.viewPortWidth == b.viewPortWidth &&
+        a.viewPortHeight == b.viewPortHeight;
+}
+
+SoftwareRasterizer::SoftwareRasterizer(const uint32_t numberOfThreads) :
+    m_target(nullptr),
+    m_states(),
+    m_triangles(),
+    m_tilesX(0),
+    m_tilesY(0),
+    m_tileTriangles(),
+    m_workers(),
+    m_mutex(),
+    m_workAvailable(),
+    m_workDone(),
+    m_generation(0),
+    m_busyWorkers(0),
+    m_stopping(false),
+    m_nextTile(0)
+{
+    // The calling thread takes part in the rasterization as well
+    const uint32_t threads = (numberOfThreads > 0) ? numberOfThreads : std::max(std::thread::hardware_concurrency(), 1u);
+    for (uint32_t i = 1; i < threads; i++)
+    {
+        m_workers.emplace_back(&SoftwareRasterizer::WorkerLoop, this);
+    }
+}
+
+SoftwareRasterizer::~SoftwareRasterizer()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_workAvailable.notify_all();
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t SoftwareRasterizer::GetNumberOfThreads() const
+{
+    return (uint32_t)m_workers.size() + 1;
+}
+
+void SoftwareRasterizer::ResizeSurface(surface& target, const uint32_t width, const uint32_t height)
+{
+    target.color.width = width;
+    target.color.height = height;
+    target.color.pixels.assign((size_t)width * height, 0);
+    target.color.isSingleColor = false;
+    target.depth.assign((size_t)width * height, 1.0f);
+}
+
+void SoftwareRasterizer::SetTarget(surface* target)
+{
+    if (target != m_target)
+    {
+        Flush();
+        m_target = target;
+    }
+}
+
+void SoftwareRasterizer::Clear(const uint32_t color, const float depth)
+{
+    Flush();
+    if (m_target != nullptr)
+    {
+        std::fill(m_target->color.pixels.begin(), m_target->color.pixels.end(), color);
+        std::fill(m_target->depth.begin(), m_target->depth.end(), depth);
+    }
+}
+
+void SoftwareRasterizer::SetState(const drawState& state)
+{
+    if (m_states.empty() || !IsSameState(m_states.back(), state))
+    {
+        m_states.push_back(state);
+    }
+}
+
+void SoftwareRasterizer::AddTriangle(const vertex& v0, const vertex& v1, const vertex& v2)
+{
+    // Triangles with a texture that was never loaded or has been deleted are not drawn
+    if (m_target == nullptr || m_states.empty() || m_states.back().boundTexture == nullptr || m_states.back().boundTexture->pixels.empty())
+    {
+        return;
+    }
+    const drawState& state = m_states.back();
+
+    const vertex* vertices[3] = { &v0, &v1, &v2 };
+    int64_t x[3];
+    int64_t y[3];
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        x[i] = (int64_t)std::llround(vertices[i]->x * (float)subPixels);
+        y[i] = (int64_t)std::llround(vertices[i]->y * (float)subPixels);
+    }
+
+    int64_t area = ((x[1] - x[0]) * (y[2] - y[0])) - ((x[2] - x[0]) * (y[1] - y[0]));
+    if (area == 0)
+    {
+        return;
+    }
+
+    // Counter clockwise triangles face the front, as in OpenGL
+    if (area > 0 && state.cullFrontFaces)
+    {
+        return;
+    }
+
+    // The vertices are ordered counter clockwise, such that the inside of each edge is positive
+    if (area < 0)
+    {
+        std::swap(vertices[1], vertices[2]);
+        std::swap(x[1], x[2]);
+        std::swap(y[1], y[2]);
+        area = -area;
+    }
+
+    triangle tri;
+    tri.stateIndex = (uint32_t)(m_states.size() - 1);
+
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        const uint8_t from = (i + 1) % 3;
+        const uint8_t to = (i + 2) % 3;
+        const int64_t dx = x[to] - x[from];
+        const int64_t dy = y[to] - y[from];
+        edgeFunction& edge = tri.edges[i];
+        edge.a = -dy;
+        edge.b = dx;
+        edge.c = -((edge.a * x[from]) + (edge.b * y[from]));
+
+        // Pixels exactly on a left or top edge are covered; those on a right or bottom edge are not.
+        const bool isTopLeft = (dy < 0) || (dy == 0 && dx < 0);
+        if (isTopLeft)
+        {
+            edge.c++;
+        }
+    }
+
+    const int32_t viewPortRight = std::min(state.viewPortLeft + state.viewPortWidth, (int32_t)m_target->color.width) - 1;
+    const int32_t viewPortTop = std::min(state.viewPortBottom + state.viewPortHeight, (int32_t)m_target->color.height) - 1;
+    tri.minX = std::max(FloorDivide(std::min({ x[0], x[1], x[2] }), subPixels), std::max(state.viewPortLeft, 0));
+    tri.minY = std::max(FloorDivide(std::min({ y[0], y[1], y[2] }), subPixels), std::max(state.viewPortBottom, 0));
+    tri.maxX = std::min(FloorDivide(std::max({ x[0], x[1], x[2] }), subPixels), viewPortRight);
+    tri.maxY = std::min(FloorDivide(std::max({ y[0], y[1], y[2] }), subPixels), viewPortTop);
+    if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+    {
+        return;
+    }
+
+    // Attributes that are not interpolated linearly in window coordinates are divided by w
+    // Triangles at a constant depth from the viewer, like 2D pictures and sprites that face the player, are
+    // interpolated linearly, which saves a division per pixel.
+    const float maxDeviation = vertices[0]->oneOverW * 1.0e-6f;
+    tri.isPerspective =
+        std::fabs(vertices[1]->oneOverW - vertices[0]->oneOverW) > maxDeviation ||
+        std::fabs(vertices[2]->oneOverW - vertices[0]->oneOverW) > maxDeviation;
+    tri.isFlatColor = true;
+    float values[3][AttributeCount];
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        const vertex& v = *vertices[i];
+        const float factor = tri.isPerspective ? v.oneOverW : 1.0f;
+        values[i][AttributeDepth] = v.z;
+        values[i][AttributeOneOverW] = v.oneOverW;
+        values[i][AttributeS] = v.s * factor;
+        values[i][AttributeT] = v.t * factor;
+        values[i][AttributeRed] = v.red * factor;
+        values[i][AttributeGreen] = v.green * factor;
+        values[i][AttributeBlue] = v.blue * factor;
+        values[i][AttributeAlpha] = v.alpha * factor;
+        values[i][AttributeScreenX] = v.screenX * factor;
+        values[i][AttributeScreenY] = v.screenY * factor;
+        if (v.red != v0.red || v.green != v0.green || v.blue != v0.blue || v.alpha != v0.alpha)
+        {
+            tri.isFlatColor = false;
+        }
+    }
+    tri.color[0] = v0.red;
+    tri.color[1] = v0.green;
+    tri.color[2] = v0.blue;
+    tri.color[3] = v0.alpha;
+
+    // Plane equations of the attributes, relative to the first vertex
+    const double x0 = (double)x[0] / subPixels;
+    const double y0 = (double)y[0] / subPixels;
+    const double x10 = ((double)x[1] / subPixels) - x0;
+    const double y10 = ((double)y[1] / subPixels) - y0;
+    const double x20 = ((double)x[2] / subPixels) - x0;
+    const double y20 = ((double)y[2] / subPixels) - y0;
+    const double determinant = (x10 * y20) - (x20 * y10);
+    tri.originX = (float)x0;
+    tri.originY = (float)y0;
+    for (uint8_t a = 0; a < AttributeCount; a++)
+    {
+        const double f10 = (double)values[1][a] - values[0][a];
+        const double f20 = (double)values[2][a] - values[0][a];
+        tri.value[a] = values[0][a];
+        tri.dx[a] = (float)(((f10 * y20) - (f20 * y10)) / determinant);
+        tri.dy[a] = (float)(((f20 * x10) - (f10 * x20)) / determinant);
+    }
+
+    m_triangles.push_back(tri);
+}
+
+void SoftwareRasterizer::Flush()
+{
+    if (!m_triangles.empty() && m_target != nullptr)
+    {
+        // Distribute the triangles over the tiles that they overlap
+        m_tilesX = (m_target->color.width + TileSize - 1) / TileSize;
+        m_tilesY = (m_target->color.height + TileSize - 1) / TileSize;
+        m_tileTriangles.resize(std::max<size_t>(m_tileTriangles.size(), (size_t)m_tilesX * m_tilesY));
+        for (std::vector<uint32_t>& tileTriangles : m_tileTriangles)
+        {
+            tileTriangles.clear();
+        }
+        for (uint32_t i = 0; i < (uint32_t)m_triangles.size(); i++)
+        {
+            const triangle& tri = m_triangles[i];
+            for (uint32_t tileY = (uint32_t)tri.minY / TileSize; tileY <= (uint32_t)tri.maxY / TileSize; tileY++)
+            {
+                for (uint32_t tileX = (uint32_t)tri.minX / TileSize; tileX <= (uint32_t)tri.maxX / TileSize; tileX++)
+                {
+                    m_tileTriangles[(tileY * m_tilesX) + tileX].push_back(i);
+                }
+            }
+        }
+
+        m_nextTile = 0;
+        if (!m_workers.empty())
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_busyWorkers = (uint32_t)m_workers.size();
+                m_generation++;
+            }
+            m_workAvailable.notify_all();
+        }
+
+        RasterizeTiles();
+
+        if (!m_workers.empty())
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workDone.wait(lock, [this] { return m_busyWorkers == 0; });
+        }
+
+        m_triangles.clear();
+    }
+
+    // Only the current state is needed for the triangles that follow
+    if (m_states.size() > 1)
+    {
+        m_states.erase(m_states.begin(), m_states.end() - 1);
+    }
+}
+
+void SoftwareRasterizer::WorkerLoop()
+{
+    uint64_t handledGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_workAvailable.wait(lock, [this, handledGeneration] { return m_stopping || m_generation != handledGeneration; });
+            if (m_stopping)
+            {
+                return;
+            }
+            handledGeneration = m_generation;
+        }
+
+        RasterizeTiles();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busyWorkers--;
+        }
+        m_workDone.notify_one();
+    }
+}
+
+void SoftwareRasterizer::RasterizeTiles()
+{
+    const uint32_t numberOfTiles = m_tilesX * m_tilesY;
+    uint32_t tile = m_nextTile++;
+    while (tile < numberOfTiles)
+    {
+        const int32_t tileLeft = (int32_t)((tile % m_tilesX) * TileSize);
+        const int32_t tileBottom = (int32_t)((tile / m_tilesX) * TileSize);
+        for (const uint32_t triangleIndex : m_tileTriangles[tile])
+        {
+            RasterizeTriangle(m_triangles[triangleIndex], tileLeft, tileBottom, tileLeft + (int32_t)TileSize - 1, tileBottom + (int32_t)TileSize - 1);
+        }
+        tile = m_nextTile++;
+    }
+}
+
+void SoftwareRasterizer::RasterizeTriangle(const triangle& tri, const int32_t tileLeft, const int32_t tileBottom, const int32_t tileRight, const int32_t tileTop)
+{
+    const int32_t minX = std::max(tri.minX, tileLeft);
+    const int32_t minY = std::max(tri.minY, tileBottom);
+    const int32_t maxX = std::min(tri.maxX, tileRight);
+    const int32_t maxY = std::min(tri.maxY, tileTop);
+    if (minX > maxX || minY > maxY)
+    {
+        return;
+    }
+
+    const drawState& state = m_states[tri.stateIndex];
+    const texture& boundTexture = *state.boundTexture;
+    const uint32_t targetWidth = m_target->color.width;
+    uint32_t* const colorBuffer = m_target->color.pixels.data();
+    float* const depthBuffer = m_target->depth.data();
+
+    // Floors and bars have a single color texture, which need not be sampled
+    float singleTexel[4];
+    if (boundTexture.isSingleColor)
+    {
+        UnpackColor(boundTexture.pixels[0], singleTexel);
+    }
+
+    const int64_t stepX[3] = { tri.edges[0].a * subPixels, tri.edges[1].a * subPixels, tri.edges[2].a * subPixels };
+    for (int32_t py = minY; py <= maxY; py++)
+    {
+        const int64_t sampleY = ((int64_t)py * subPixels) + (subPixels / 2);
+        const int64_t sampleX = ((int64_t)minX * subPixels) + (subPixels / 2);
+        int64_t e[3];
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            e[i] = (tri.edges[i].a * sampleX) + (tri.edges[i].b * sampleY) + tri.edges[i].c;
+        }
+
+        const float cy = (float)py + 0.5f - tri.originY;
+        for (int32_t px = minX; px <= maxX; px++, e[0] += stepX[0], e[1] += stepX[1], e[2] += stepX[2])
+        {
+            if (e[0] <= 0 || e[1] <= 0 || e[2] <= 0)
+            {
+                continue;
+            }
+
+            const float cx = (float)px + 0.5f - tri.originX;
+            const float w = tri.isPerspective ? 1.0f / (tri.value[AttributeOneOverW] + (tri.dx[AttributeOneOverW] * cx) + (tri.dy[AttributeOneOverW] * cy)) : 1.0f;
+            const auto interpolate = [&tri, cx, cy, w](const attribute a)
+            {
+                return (tri.value[a] + (tri.dx[a] * cx) + (tri.dy[a] * cy)) * w;
+            };
+
+            if (state.revealTimes != nullptr)
+            {
+                const float screenX = std::floor(interpolate(AttributeScreenX));
+                const float screenY = std::floor(interpolate(AttributeScreenY));
+                if (screenY >= 0.0f && screenY < 200.0f)
+                {
+                    const uint32_t pixelX = (uint32_t)(screenX - (320.0f * std::floor(screenX / 320.0f)));
+                    if (state.revealTimes[((uint32_t)screenY * 320) + std::min(pixelX, 319u)] < state.revealedTime)
+                    {
+                        continue;
+                    }
+                }
+            }
+
+            const size_t offset = ((size_t)py * targetWidth) + px;
+            const float depth = tri.value[AttributeDepth] + (tri.dx[AttributeDepth] * cx) + (tri.dy[AttributeDepth] * cy);
+            if (state.depthTest && depth > depthBuffer[offset])
+            {
+                continue;
+            }
+
+            float texel[4];
+            if (boundTexture.isSingleColor)
+            {
+                std::copy(singleTexel, singleTexel + 4, texel);
+            }
+            else
+            {
+                SampleTexture(boundTexture, state.linearFilter, interpolate(AttributeS), interpolate(AttributeT), texel);
+            }
+
+            float color[4];
+            if (tri.isFlatColor)
+            {
+                for (uint8_t i = 0; i < 4; i++)
+                {
+                    color[i] = texel[i] * tri.color[i];
+                }
+            }
+            else
+            {
+                color[0] = texel[0] * interpolate(AttributeRed);
+                color[1] = texel[1] * interpolate(AttributeGreen);
+                color[2] = texel[2] * interpolate(AttributeBlue);
+                color[3] = texel[3] * interpolate(AttributeAlpha);
+            }
+
+            if (state.depthTest && state.depthWrite)
+            {
+                depthBuffer[offset] = depth;
+            }
+
+            if (state.blend && color[3] < 1.0f)
+            {
+                if (color[3] <= 0.0f)
+                {
+                    // Fully transparent
+                    continue;
+                }
+
+                float destination[4];
+                UnpackColor(colorBuffer[offset], destination);
+                const float sourceAlpha = color[3];
+                for (uint8_t i = 0; i < 4; i++)
+                {
+                    color[i] = (color[i] * sourceAlpha) + (destination[i] * (1.0f - sourceAlpha));
+                }
+            }
+
+            colorBuffer[offset] = PackColor(color);
+        }
+    }
+}
@@ -0,0 +1,172 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// SoftwareRasterizer
+//
+// Rasterizes triangles on the CPU, for hosts without a GPU. Triangles are given in window coordinates and collected
+// until Flush is called. The target is then split into tiles, which are rasterized in parallel by a pool of worker
+// threads. Within a tile the triangles are drawn in the order in which they were added, such that the result does not
+// depend on the number of threads. The rasterization follows the rules of OpenGL: pixels are sampled at their centers,
+// attributes are interpolated perspective correct and texture coordinates are clamped to the edge.
+//
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+class SoftwareRasterizer
+{
+public:
+    // RGBA pixels, with the red component in the lowest byte. The first row is at texture coordinate t = 0.
+    typedef struct
+    {
+        uint32_t width;
+        uint32_t height;
+        std::vector<uint32_t> pixels;
+        // All pixels have the same color, such that the texture need not be sampled.
+        bool isSingleColor;
+    } texture;
+
+    // The first row is the bottom row, as in OpenGL window coordinates.
+    typedef struct
+    {
+        texture color;
+        std::vector<float> depth;
+    } surface;
+
+    typedef struct
+    {
+        // Window coordinates; z is the depth in the range [0, 1].
+        float x;
+        float y;
+        float z;
+        float oneOverW;
+        float s;
+        float t;
+        float red;
+        float green;
+        float blue;
+        float alpha;
+        // Screen coordinates of the fizzle fade, in original 320 x 200 pixels.
+        float screenX;
+        float screenY;
+    } vertex;
+
+    typedef struct
+    {
+        const texture* boundTexture;
+        bool linearFilter;
+        bool depthTest;
+        bool depthWrite;
+        bool blend;
+        bool cullFrontFaces;
+        // Pixels of which the reveal time is lower than the revealed time are discarded. The reveal times are a map of
+        // 320 x 200 pixels in screen coordinates, which is repeated horizontally. Not applied without reveal times.
+        const uint16_t* revealTimes;
+        uint16_t revealedTime;
+        // Pixels outside of the view port are not drawn.
+        int32_t viewPortLeft;
+        int32_t viewPortBottom;
+        int32_t viewPortWidth;
+        int32_t viewPortHeight;
+    } drawState;
+
+    // Without a given number of threads, as many threads are used as the hardware supports.
+    SoftwareRasterizer(const uint32_t numberOfThreads = 0);
+    ~SoftwareRasterizer();
+
+    uint32_t GetNumberOfThreads() const;
+
+    static void ResizeSurface(surface& target, const uint32_t width, const uint32_t height);
+
+    // Pending triangles are drawn before the target changes.
+    void SetTarget(surface* target);
+    void Clear(const uint32_t color, const float depth);
+    void SetState(const drawState& state);
+    void AddTriangle(const vertex& v0, const vertex& v1, const vertex& v2);
+    // Draws the pending triangles. To be called before the target or any bound texture is read or modified.
+    void Flush();
+
+private:
+    static const uint32_t TileSize = 64;
+
+    enum attribute
+    {
+        AttributeDepth,
+        AttributeOneOverW,
+        AttributeS,
+        AttributeT,
+        AttributeRed,
+        AttributeGreen,
+        AttributeBlue,
+        AttributeAlpha,
+        AttributeScreenX,
+        AttributeScreenY,
+        AttributeCount
+    };
+
+    typedef struct
+    {
+        int64_t a;
+        int64_t b;
+        int64_t c;
+    } edgeFunction;
+
+    typedef struct
+    {
+        uint32_t stateIndex;
+        edgeFunction edges[3];
+        int32_t minX;
+        int32_t minY;
+        int32_t maxX;
+        int32_t maxY;
+        float originX;
+        float originY;
+        // Value at the origin and derivatives in x and y of each attribute. The attributes other than the depth and
+        // 1/w are divided by w.
+        float value[AttributeCount];
+        float dx[AttributeCount];
+        float dy[AttributeCount];
+        // Color of all vertices, when they have the same color
+        float color[4];
+        bool isPerspective;
+        bool isFlatColor;
+    } triangle;
+
+    void WorkerLoop();
+    void RasterizeTiles();
+    void RasterizeTriangle(const triangle& tri, const int32_t tileLeft, const int32_t tileBottom, const int32_t tileRight, const int32_t tileTop);
+
+    surface* m_target;
+    std::vector<drawState> m_states;
+    std::vector<triangle> m_triangles;
+    uint32_t m_tilesX;
+    uint32_t m_tilesY;
+    std::vector<std::vector<uint32_t>> m_tileTriangles;
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_workAvailable;
+    std::condition_variable m_workDone;
+    uint64_t m_generation;
+    uint32_t m_busyWorkers;
+    bool m_stopping;
+    std::atomic<uint32_t> m_nextTile;
+};
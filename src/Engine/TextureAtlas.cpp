@@ -14,6 +14,7 @@
 // along with this program.  If not, see http://www.gnu.org/licenses/ 
 
 #include "TextureAtlas.h"
+#include "EgaColor.h"
 #include <cstdint>
 #include <cstddef> // For std::size_t
 
@@ -24,7 +25,8 @@ TextureAtlas::TextureAtlas(
     const uint16_t numberOfColumns,
     const uint16_t numberOfRows,
     const uint16_t imageSpacingX,
-    const uint16_t imageSpacingY) :
+    const uint16_t imageSpacingY,
+    const uint16_t bytesPerPixel) :
     m_textureId(textureId),
     m_imageWidth(imageWidth),
     m_imageHeight(imageHeight),
@@ -34,17 +36,18 @@ TextureAtlas::TextureAtlas(
     m_imageSpacingY(imageSpacingY),
     m_textureWidth(CalculateTextureWidth(imageWidth, numberOfColumns, imageSpacingX)),
     m_textureHeight(CalculateTextureHeight(imageHeight, numberOfRows, imageSpacingY)),
-    m_bytesPerPixel(4),
+    m_bytesPerPixel(bytesPerPixel),
     m_imageRelativeWidth((float)m_imageWidth / (float)m_textureWidth),
     m_imageRelativeHeight((float)m_imageHeight / (float)m_textureHeight)
 {
     const std::size_t textureSize = m_textureWidth * m_textureHeight * m_bytesPerPixel;
     m_texturePixelData = new uint8_t[textureSize];
 
-    // Fill the texture with zero's, which amounts to black and fully transparent.
+    // Fill the texture with transparent pixels; in RGBA, zero's amount to black and fully transparent.
+    const uint8_t transparentValue = (m_bytesPerPixel == 1) ? EgaTransparentIndex : 0;
     for (std::size_t i = 0; i < textureSize; i++)
     {
-        m_texturePixelData[i] = 0;
+        m_texturePixelData[i] = transparentValue;
     }
 }
 
@@ -27,7 +27,8 @@ class TextureAtlas
 {
 public:
     // Spacing between individual images is needed to prevent an image from 'leaking' into its
-    // neighbouring image due to linear filtering.
+    // neighbouring image due to linear filtering. The images are either RGBA, with 4 bytes per pixel,
+    // or palettized, with 1 byte per pixel.
     TextureAtlas(
         const unsigned int textureId,
         const uint16_t imageWidth,
@@ -35,7 +36,8 @@ public:
         const uint16_t numberOfColumns,
         const uint16_t numberOfRows,
         const uint16_t imageSpacingX,
-        const uint16_t imageSpacingY);
+        const uint16_t imageSpacingY,
+        const uint16_t bytesPerPixel = 4);
     ~TextureAtlas();
 
     unsigned int GetTextureId() const;
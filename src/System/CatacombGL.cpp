@@ -16,10 +16,13 @@
 //
 // This source file is the main entry point of the CatacombGL executable. It contains the WinMain function.
 // It creates the OpenGL window and an instance of the EngineCore class. Then it runs the main game loop.
+// With the --offscreen option, no window is created. The frames are rendered by the software renderer, the input comes
+// from an input script and the selected frames are stored as PNG images, along with the timings of all frames.
 //
 
 #include "Finder.h"
 #include "RendererOpenGL.h"
+#include "RendererSoftware.h"
 #include "SystemSDL.h"
 #include "WindowSDL.h"
 
@@ -27,9 +30,12 @@
 #include "../Engine/Console.h"
 #include "../Engine/DefaultFont.h"
 #include "../Engine/EngineCore.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Engine/GameDetection.h"
 #include "../Engine/GameSelection.h"
+#include "../Engine/InputScript.h"
 #include "../Engine/Logging.h"
+#include "../Engine/OffscreenRecorder.h"
 #include "../Engine/PlayerInput.h"
 
 #include "../Abyss/GameAbyss.h"
@@ -88,7 +94,61 @@ void UpdatePlayerInput(const SDL_Window* const window, PlayerInput &input)
     }
 }
 
-void InitializeSDL()
+struct OffscreenSettings
+{
+    bool enabled;
+    fs::path inputScriptPath;
+    fs::path outputPath;
+    uint16_t width;
+    uint16_t height;
+};
+
+bool ParseCommandLine(const int argc, char** argv, OffscreenSettings& offscreen)
+{
+    offscreen.enabled = false;
+    offscreen.outputPath = fs::current_path() / "offscreen";
+    offscreen.width = 640;
+    offscreen.height = 480;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string option(argv[i]);
+        if (i + 1 >= argc)
+        {
+            return false;
+        }
+        const std::string value(argv[++i]);
+
+        if (option == "--offscreen")
+        {
+            offscreen.enabled = true;
+            offscreen.inputScriptPath = value;
+        }
+        else if (option == "--output")
+        {
+            offscreen.outputPath = value;
+        }
+        else if (option == "--size")
+        {
+            unsigned int width = 0;
+            unsigned int height = 0;
+            if (sscanf(value.c_str(), "%ux%u", &width, &height) != 2 || width == 0 || height == 0 || width > 8192 || height > 8192)
+            {
+                return false;
+            }
+            offscreen.width = (uint16_t)width;
+            offscreen.height = (uint16_t)height;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void InitializeSDL(const Uint32 flags)
 {
     SDL_version sdlVersion;
     memset(&sdlVersion, 0, sizeof(sdlVersion));
@@ -100,20 +160,28 @@ void InitializeSDL()
         std::to_string(sdlVersion.patch);
     Logging::Instance().AddLogMessage(sdlLogMessage);
 
-    if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) < 0)
+    if (SDL_Init(flags) < 0)
     {
         Logging::Instance().FatalError("SDL_Init failed: " + std::string(SDL_GetError()));
     }
 }
 
-int main(int /*argc*/,  char** /*argv*/)
+int main(int argc,  char** argv)
 {
+    OffscreenSettings offscreen;
+    if (!ParseCommandLine(argc, argv, offscreen))
+    {
+        std::cout << "Usage: CatacombGL [--offscreen <input script> [--output <folder>] [--size <width>x<height>]]" << std::endl;
+        return 1;
+    }
+
     ConfigurationSettings config;
     PlayerInput input;
     SystemSDL system;
 
     Console* console = new Console("CatacombGL " + EngineCore::GetVersionInfo());
-    IRenderer* renderer = new RendererOpenGL();
+    IRenderer* renderer = nullptr;
+    RendererSoftware* softwareRenderer = nullptr;
 
     EngineCore* engine = nullptr;
     IGame* game = nullptr;
@@ -124,13 +192,14 @@ int main(int /*argc*/,  char** /*argv*/)
     uint8_t screenMode = CVarItemIdScreenModeWindowed;
 
     /* initialize random seed: */
-    srand ((unsigned int)time(nullptr));
+    srand (offscreen.enabled ? 0u : (unsigned int)time(nullptr));
 
     const fs::path configPath = system.GetConfigurationFilePath();
     system.CreatePath(configPath);
 
     const fs::path logFilename = configPath / "CatacombGL_log.txt";
     Logging::Instance().SetLogFile(logFilename);
+    FrameProfiler::Instance().SetTraceFile(configPath / "CatacombGL_trace.json");
 
     const std::string buildBitInfo(system.isBuiltIn64Bit() ? " (64 bit)" : " (32 bit)");
     Logging::Instance().AddLogMessage("Initializing CatacombGL " + EngineCore::GetVersionInfo() + buildBitInfo);
@@ -141,7 +210,23 @@ int main(int /*argc*/,  char** /*argv*/)
     Logging::Instance().AddLogMessage("Loading CatacombGL.ini");
     config.LoadFromFile(configFilename);
 
-    InitializeSDL();
+    InputScript inputScript;
+    OffscreenRecorder* recorder = nullptr;
+    std::vector<uint8_t> framePixels;
+    if (offscreen.enabled)
+    {
+        std::string errorMessage;
+        if (!inputScript.LoadFromFile(offscreen.inputScriptPath, errorMessage))
+        {
+            Logging::Instance().FatalError(errorMessage);
+        }
+        system.CreatePath(offscreen.outputPath);
+        Logging::Instance().AddLogMessage("Rendering offscreen to " + offscreen.outputPath.string());
+        recorder = new OffscreenRecorder(inputScript, offscreen.outputPath);
+    }
+
+    // An offscreen run needs neither a display nor an audio device
+    InitializeSDL(offscreen.enabled ? SDL_INIT_TIMER : SDL_INIT_VIDEO | SDL_INIT_AUDIO);
 
     uint8_t selectedGame = GameID::NotDetected;
 
@@ -159,20 +244,45 @@ int main(int /*argc*/,  char** /*argv*/)
         }
     }
 
-    // Create Our OpenGL Window
-    CreateGLWindow(800, 600, 16, window, context);
+    if (offscreen.enabled)
+    {
+        softwareRenderer = new RendererSoftware();
+        renderer = softwareRenderer;
+    }
+    else if (config.GetCVarEnum(CVarIdRenderer).GetItemIndex() == CVarItemIdRendererSoftware)
+    {
+        CreateSoftwareWindow(800, 600, window);
 
-    renderer = new RendererOpenGL();
+        softwareRenderer = new RendererSoftware();
+        renderer = softwareRenderer;
+    }
+    else
+    {
+        // Create Our OpenGL Window
+        CreateGLWindow(800, 600, 16, window, context);
+
+        renderer = new RendererOpenGL();
+    }
     renderer->Setup();
-    SetScreenMode(config.GetCVarEnum(CVarIdScreenMode).GetItemIndex(), window);
+    if (offscreen.enabled)
+    {
+        renderer->SetWindowDimensions(offscreen.width, offscreen.height);
+    }
+    else
+    {
+        SetScreenMode(config.GetCVarEnum(CVarIdScreenMode).GetItemIndex(), window);
 
-    // Set Up Our Perspective GL Screen
-    ReSizeGLScene(renderer, 800, 600);
+        // Set Up Our Perspective GL Screen
+        ReSizeGLScene(renderer, 800, 600);
+    }
 
     Logging::Instance().AddLogMessage("Running on graphics adapter model " + renderer->GetGraphicsAdapterModel());
     Logging::Instance().AddLogMessage("Running on " + renderer->GetGraphicsApiVersion());
 
-    BE_ST_InitAudio();
+    if (!offscreen.enabled)
+    {
+        BE_ST_InitAudio();
+    }
     SD_Startup();
 
     fs::path initialSearchFolder = fs::current_path();
@@ -189,7 +299,7 @@ int main(int /*argc*/,  char** /*argv*/)
     {
         SDL_Event event;
         memset(&event, 0, sizeof(event));
-        while (SDL_PollEvent(&event))
+        while (!offscreen.enabled && SDL_PollEvent(&event))
         {
             if (event.type == SDL_WINDOWEVENT)
             {
@@ -197,6 +307,12 @@ int main(int /*argc*/,  char** /*argv*/)
             }
         }
 
+        if (recorder != nullptr)
+        {
+            recorder->BeginFrame();
+            recorder->EndThink();
+        }
+
         if (gameSelectionPresentation.gameListCatacombsPack.empty())
         {
             const GameDetectionState catacomb3Dv122DetectionState = (finder.GetGameScore(GameID::Catacomb3Dv122) == 0) ? Detected : NotDetected;
@@ -219,13 +335,25 @@ int main(int /*argc*/,  char** /*argv*/)
         IRenderer::FrameSettings frameSettings;
         frameSettings.textureFilter = (config.GetCVarEnum(CVarIdTextureFilter).GetItemIndex() == CVarItemIdTextureFilterNearest) ? IRenderer::Nearest : IRenderer::Linear;
         frameSettings.vSyncEnabled = config.GetCVarBool(CVarIdVSync).IsEnabled();
+        frameSettings.palettizedTextures = config.GetCVarBool(CVarIdPalettizedTextures).IsEnabled();
         renderer->SetFrameSettings(frameSettings);
 
         gameSelection.Draw(gameSelectionPresentation);
         console->Draw(*renderer);
-        SDL_GL_SwapWindow(window);
-
-        UpdatePlayerInput(window, input);
+        renderer->EndFrameStatistics();
+        if (recorder != nullptr)
+        {
+            recorder->EndDraw();
+            softwareRenderer->ReadFrame(framePixels);
+            recorder->ApplyInput(input);
+            recorder->EndFrame(offscreen.width, offscreen.height, framePixels);
+            active = !recorder->IsFinished();
+        }
+        else
+        {
+            SwapWindow(window, softwareRenderer);
+            UpdatePlayerInput(window, input);
+        }
 
         if (input.IsKeyPressed(SDLK_1))
         {
@@ -372,17 +500,21 @@ int main(int /*argc*/,  char** /*argv*/)
             engine = new EngineCore(*game, system, input, config);
 
             // Update the window title with the selected game info.
-            const std::string windowTitle = "CatacombGL " + EngineCore::GetVersionInfo() + " [" + game->GetName() + "]";
-            SDL_SetWindowTitle(window, windowTitle.c_str());
+            if (window != nullptr)
+            {
+                const std::string windowTitle = "CatacombGL " + EngineCore::GetVersionInfo() + " [" + game->GetName() + "]";
+                SDL_SetWindowTitle(window, windowTitle.c_str());
+            }
         }
     }
 
     // Loop That Runs While done=FALSE
     while(active)
     {
+        PROFILE_FRAME();
         SDL_Event event;
         memset(&event, 0, sizeof(event));
-        while (SDL_PollEvent(&event))
+        while (!offscreen.enabled && SDL_PollEvent(&event))
         {
             if (event.type == SDL_WINDOWEVENT)
             {
@@ -390,10 +522,30 @@ int main(int /*argc*/,  char** /*argv*/)
             }
         }
 
+        if (recorder != nullptr)
+        {
+            recorder->BeginFrame();
+        }
+
         if (engine->Think())
         {
             active = false;
         }
+        else if (recorder != nullptr)
+        {
+            recorder->ApplyInput(input);
+            console->ProcessInput(input);
+            recorder->EndThink();
+
+            engine->DrawScene(*renderer);
+            console->Draw(*renderer);
+            renderer->EndFrameStatistics();
+            recorder->EndDraw();
+
+            softwareRenderer->ReadFrame(framePixels);
+            recorder->EndFrame(offscreen.width, offscreen.height, framePixels);
+            active = !recorder->IsFinished();
+        }
         else                                // Not Time To Quit, Update Screen
         {
             SDL_SetRelativeMouseMode(engine->RequiresMouseCapture() ? SDL_TRUE : SDL_FALSE);
@@ -407,10 +559,24 @@ int main(int /*argc*/,  char** /*argv*/)
             
             engine->DrawScene(*renderer);
             console->Draw(*renderer);
-            SDL_GL_SwapWindow(window);
+            renderer->EndFrameStatistics();
+            {
+                PROFILE_SCOPE("SwapWindow");
+                SwapWindow(window, softwareRenderer);
+            }
         }
     }
 
+    if (recorder != nullptr)
+    {
+        if (!recorder->WriteTimings())
+        {
+            Logging::Instance().AddLogMessage("WARNING: unable to write the frame timings to " + offscreen.outputPath.string());
+        }
+        Logging::Instance().AddLogMessage("Offscreen run: " + recorder->GetTimingsSummary());
+        std::cout << recorder->GetTimingsSummary() << std::endl;
+    }
+
     finder.SafePaths(config);
 
     // Kill The Window
@@ -420,8 +586,11 @@ int main(int /*argc*/,  char** /*argv*/)
     SD_Shutdown();
     BE_ST_ShutdownAudio();
 
-    // Store configuration
-    config.StoreToFile(configFilename);
+    // Store configuration, unless an offscreen run could have changed it
+    if (!offscreen.enabled)
+    {
+        config.StoreToFile(configFilename);
+    }
 
     delete engine;
     delete game;
@@ -430,6 +599,7 @@ int main(int /*argc*/,  char** /*argv*/)
 
     delete renderer;
     delete console;
+    delete recorder;
 
     return 0;
 }
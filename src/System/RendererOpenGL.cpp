@@ -16,6 +16,7 @@
 #include "RendererOpenGL.h"
 #include "../Engine/Logging.h"
 #include "../Engine/Console.h"
+#include "../Engine/FrameProfiler.h"
 #include "../Engine/OverscanBorder.h"
 #include "../Engine/ViewPorts.h"
 
@@ -36,24 +37,72 @@ static const unsigned int GL_CLAMP_TO_EDGE = 0x812F;
 #include <cmath>
 #include <string>
 
+// Querying the error state of OpenGL can stall the pipeline until all commands are executed,
+// hence errors are only checked in debug builds.
+#ifdef NDEBUG
+const bool checkErrors = false;
+#else
+const bool checkErrors = true;
+#endif
+
 const float FloorZ = 2.2f;
 const float CeilingZ = 1.0f;
 const float PlayerZ = 1.6f;
 
+// Measures the GPU time of a render pass for as long as it is in scope. As timer queries cannot be nested,
+// a pass that is rendered as part of another pass is not measured separately.
+class GpuTimerScope
+{
+public:
+    GpuTimerScope(OpenGLTimerQueries& timerQueries, const bool enabled, const IRenderer::RenderPass pass) :
+        m_timerQueries(timerQueries),
+        m_isMeasuring(enabled && timerQueries.Begin((uint8_t)pass))
+    {
+    }
+
+    ~GpuTimerScope()
+    {
+        if (m_isMeasuring)
+        {
+            m_timerQueries.End();
+        }
+    }
+
+private:
+    OpenGLTimerQueries& m_timerQueries;
+    const bool m_isMeasuring;
+};
+
 // Constructor
 RendererOpenGL::RendererOpenGL() :
     m_windowWidth(800u),
     m_windowHeight(600u),
     m_textureFilter(GL_LINEAR),
+    m_palettizedTextures(false),
     m_currentSwapInterval(-1),
     m_isVSyncSupported(false),
+    m_isScreenCaptureOnGpuSupported(false),
+    m_isScreenCaptureUpsideDown(false),
     m_graphicsApiVersion(""),
     m_graphicsAdapterVendor(""),
     m_graphicsAdapterModel(""),
     m_openGLBasic(),
-    m_openGLFramebuffer(m_openGLBasic)
+    m_openGLFramebuffer(m_openGLBasic),
+    m_openGLFizzleFade(m_openGLBasic),
+    m_openGLTimerQueries(),
+    m_openGLInstancedSprites(),
+    m_openGLTileMesh(),
+    m_openGLPalette(),
+    m_openGLStateCache(m_openGLBasic),
+    m_palettizedTextureSizes(),
+    m_spriteInstances(),
+    m_screenCaptureRevealedTime(0),
+    m_isGpuTimingEnabled(false),
+    m_frameStatistics(),
+    m_renderStatistics()
 {
     memset(&m_singleColorTexture, 0, sizeof(m_singleColorTexture[0]) * EgaRange);
+    static_assert(RenderPassCount <= OpenGLTimerQueries::MaxPasses, "Not enough timer query passes for all render passes");
 }
 
 void RendererOpenGL::Setup()
@@ -79,6 +128,14 @@ void RendererOpenGL::Setup()
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClearDepth(1.0);                         // Depth Buffer Setup
     glClearStencil(0);
+
+    // Check whether the frame buffer can be copied into a texture, by copying a small part of it
+    const unsigned int probeTextureId = GenerateTextureId();
+    m_isScreenCaptureOnGpuSupported = CopyScreenIntoTexture(8, 8, probeTextureId);
+    glDeleteTextures(1, &probeTextureId);
+    m_openGLStateCache.ForgetTexture(probeTextureId);
+    const std::string screenCaptureLogMessage = m_isScreenCaptureOnGpuSupported ? "Screen capture on GPU is supported" : "Screen capture on GPU is NOT supported";
+    Logging::Instance().AddLogMessage(screenCaptureLogMessage);
 }
 
 void RendererOpenGL::SetWindowDimensions(const uint16_t windowWidth, const uint16_t windowHeight)
@@ -90,6 +147,7 @@ void RendererOpenGL::SetWindowDimensions(const uint16_t windowWidth, const uint1
 void RendererOpenGL::SetFrameSettings(const FrameSettings& frameSettings)
 {
     m_textureFilter = (frameSettings.textureFilter == Nearest) ? GL_NEAREST : GL_LINEAR;
+    m_palettizedTextures = frameSettings.palettizedTextures;
 
     const int32_t requestedSwapInterval = (frameSettings.vSyncEnabled) ? 1 : 0;
     if (requestedSwapInterval != m_currentSwapInterval)
@@ -110,37 +168,100 @@ unsigned int RendererOpenGL::GenerateTextureId() const
 
 void RendererOpenGL::LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const
 {
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    GLenum glError = glGetError();
-    if (glError != GL_NO_ERROR)
+    m_openGLStateCache.BindTexture(textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelData);
+    if (checkErrors)
     {
-        Logging::Instance().FatalError("Error binding texture (id=" + std::to_string(textureId) + "): glBindTexture returned " + ErrorCodeToString(glError));
+        const GLenum glError = glGetError();
+        if (glError != GL_NO_ERROR)
+        {
+            Logging::Instance().FatalError("Error loading pixel data into texture (id=" + std::to_string(textureId) + ";width=" + std::to_string(width) + ";height=" + std::to_string(height) + "): glTexImage2D returned " + ErrorCodeToString(glError));
+        }
     }
 
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixelData);
-    glError = glGetError();
-    if (glError != GL_NO_ERROR)
+    // Do not wrap the texture
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    // The texture id may have been used before
+    m_palettizedTextureSizes.erase(textureId);
+}
+
+void RendererOpenGL::LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const
+{
+    if (!m_palettizedTextures || !m_openGLPalette.IsSupported())
+    {
+        std::vector<uint8_t> pixelData((size_t)width * height * 4);
+        for (size_t i = 0; i < (size_t)width * height; i++)
+        {
+            const uint8_t index = indexedPixelData[i];
+            const bool transparent = (index >= EgaRange);
+            const rgbColor color = EgaToRgb(transparent ? EgaBlack : (egaColor)index);
+            pixelData[(i * 4)] = color.red;
+            pixelData[(i * 4) + 1] = color.green;
+            pixelData[(i * 4) + 2] = color.blue;
+            pixelData[(i * 4) + 3] = transparent ? 0 : 255;
+        }
+        LoadPixelDataIntoTexture(width, height, pixelData.data(), textureId);
+        return;
+    }
+
+    m_openGLStateCache.BindTexture(textureId);
+
+    // The rows of indices are not aligned to 4 bytes
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, indexedPixelData);
+    if (checkErrors)
     {
-        Logging::Instance().FatalError("Error loading pixel data into texture (id=" + std::to_string(textureId) + ";width=" + std::to_string(width) + ";height=" + std::to_string(height) + "): glTexImage2D returned " + ErrorCodeToString(glError));
+        const GLenum glError = glGetError();
+        if (glError != GL_NO_ERROR)
+        {
+            Logging::Instance().FatalError("Error loading palettized pixel data into texture (id=" + std::to_string(textureId) + ";width=" + std::to_string(width) + ";height=" + std::to_string(height) + "): glTexImage2D returned " + ErrorCodeToString(glError));
+        }
     }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     // Do not wrap the texture
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    m_palettizedTextureSizes[textureId] = { width, height };
 }
 
-void RendererOpenGL::BindTexture(unsigned int textureId) const
+void RendererOpenGL::DeleteTexture(const unsigned int textureId) const
+{
+    glDeleteTextures(1, &textureId);
+    m_openGLStateCache.ForgetTexture(textureId);
+    m_palettizedTextureSizes.erase(textureId);
+}
+
+void RendererOpenGL::BindTexture(unsigned int textureId)
 {
     // Select the texture from the picture
-    glBindTexture(GL_TEXTURE_2D, textureId);
-    const GLenum glError = glGetError();
-    if (glError == GL_INVALID_VALUE)
+    if (m_openGLStateCache.BindTexture(textureId))
     {
-        Logging::Instance().FatalError("Error binding texture (id=" + std::to_string(textureId) + "): glBindTexture returned " + ErrorCodeToString(glError));
+        m_frameStatistics.textureBinds++;
+        if (checkErrors)
+        {
+            const GLenum glError = glGetError();
+            if (glError == GL_INVALID_VALUE)
+            {
+                Logging::Instance().FatalError("Error binding texture (id=" + std::to_string(textureId) + "): glBindTexture returned " + ErrorCodeToString(glError));
+            }
+        }
     }
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_textureFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_textureFilter);
+    const auto palettizedTexture = m_palettizedTextureSizes.find(textureId);
+    if (palettizedTexture != m_palettizedTextureSizes.end())
+    {
+        // The indices cannot be blended; the palette shader filters the colors instead
+        m_openGLStateCache.SetTextureFilter(GL_NEAREST);
+        m_openGLPalette.ApplyTexture(true, palettizedTexture->second.width, palettizedTexture->second.height, m_textureFilter == GL_LINEAR);
+        return;
+    }
+
+    m_openGLStateCache.SetTextureFilter(m_textureFilter);
+    m_openGLPalette.ApplyTexture(false, 0, 0, false);
 }
 
 const std::string RendererOpenGL::ErrorCodeToString(const GLenum errorCode)
@@ -186,6 +307,8 @@ unsigned int RendererOpenGL::GenerateSingleColorTexture(const egaColor color) co
 
 void RendererOpenGL::RenderText(const RenderableText& renderableText)
 {
+    PROFILE_SCOPE("RenderText");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPassText);
     const std::vector<RenderableText::renderableCharacter>& characters = renderableText.GetText();
     const Font& font = renderableText.GetFont();
     if (characters.empty())
@@ -230,6 +353,7 @@ void RendererOpenGL::RenderText(const RenderableText& renderableText)
         glTexCoord2f(textureOffsetX, textureOffsetY); glVertex2i(offsetX, offsetY);
     }
     glEnd();
+    AddDrawBatch((uint32_t)characters.size() * 4);
 
     glColor3f(1.0f, 1.0f, 1.0f);
 }
@@ -243,11 +367,11 @@ void RendererOpenGL::Prepare2DRendering(const bool helpWindow)
     glColor3f(1.0f,1.0f,1.0f);
 
     // Make sure the depth test is disabled
-    glDisable(GL_DEPTH_TEST);
+    m_openGLStateCache.SetCapability(GL_DEPTH_TEST, false);
 
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_openGLStateCache.SetCapability(GL_TEXTURE_2D, true);
+    m_openGLStateCache.SetCapability(GL_BLEND, true);
+    m_openGLStateCache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Create a 2D orthographic projection matrix, such that it imitates the 320x200 EGA pixel matrix.
     glMatrixMode(GL_PROJECTION);
@@ -257,16 +381,17 @@ void RendererOpenGL::Prepare2DRendering(const bool helpWindow)
 
     gluOrtho2D(rect.left, rect.right, rect.bottom, rect.top);
 
-    glDisable(GL_LIGHTING);
+    m_openGLStateCache.SetCapability(GL_LIGHTING, false);
 }
 
 void RendererOpenGL::Unprepare2DRendering()
 {
-    glDisable(GL_BLEND);
+    m_openGLStateCache.SetCapability(GL_BLEND, false);
 }
 
 void RendererOpenGL::Render2DPicture(const Picture* picture, const int16_t offsetX, const int16_t offsetY)
 {
+    PROFILE_SCOPE("Render2DPicture");
     if (picture == nullptr)
     {
         // Nothing to render
@@ -279,18 +404,22 @@ void RendererOpenGL::Render2DPicture(const Picture* picture, const int16_t offse
     // Draw the texture as a quad
     const GLint width = (uint16_t)picture->GetImageWidth();
     const GLint height = (uint16_t)picture->GetImageHeight();
-    const float relativeImageWidth = (float)picture->GetImageWidth() / (float)picture->GetTextureWidth();
-    const float relativeImageHeight = (float)picture->GetImageHeight() / (float)picture->GetTextureHeight();
+    const float left = picture->GetImageRelativeOffsetX();
+    const float top = picture->GetImageRelativeOffsetY();
+    const float right = left + picture->GetImageRelativeWidth();
+    const float bottom = top + picture->GetImageRelativeHeight();
     glBegin(GL_QUADS);
-    glTexCoord2f(0, relativeImageHeight); glVertex2i(offsetX, offsetY + height);
-    glTexCoord2f(relativeImageWidth, relativeImageHeight); glVertex2i(offsetX + width, offsetY + height);
-    glTexCoord2f(relativeImageWidth, 0); glVertex2i(offsetX + width, offsetY);
-    glTexCoord2f(0, 0); glVertex2i(offsetX, offsetY);
+    glTexCoord2f(left, bottom); glVertex2i(offsetX, offsetY + height);
+    glTexCoord2f(right, bottom); glVertex2i(offsetX + width, offsetY + height);
+    glTexCoord2f(right, top); glVertex2i(offsetX + width, offsetY);
+    glTexCoord2f(left, top); glVertex2i(offsetX, offsetY);
     glEnd();
+    AddDrawBatch(4);
 }
 
 void RendererOpenGL::Render2DPictureSegment(const Picture* picture, const int16_t offsetX, const int16_t offsetY, const uint16_t segmentOffsetX, const uint16_t segmentOffsetY, const uint16_t segmentWidth, const uint16_t segmentHeight)
 {
+    PROFILE_SCOPE("Render2DPictureSegment");
     if (picture == nullptr)
     {
         // Nothing to render
@@ -303,12 +432,17 @@ void RendererOpenGL::Render2DPictureSegment(const Picture* picture, const int16_
     // Draw the texture as a quad
     const float textureWidth = (float)picture->GetTextureWidth();
     const float textureHeight = (float)picture->GetTextureHeight();
+    const float left = (float)(picture->GetImageOffsetX() + segmentOffsetX) / textureWidth;
+    const float top = (float)(picture->GetImageOffsetY() + segmentOffsetY) / textureHeight;
+    const float right = left + (segmentWidth / textureWidth);
+    const float bottom = top + (segmentHeight / textureHeight);
     glBegin(GL_QUADS);
-    glTexCoord2f(segmentOffsetX / textureWidth, (segmentOffsetY + segmentHeight) / textureHeight); glVertex2i(offsetX, offsetY + segmentHeight);
-    glTexCoord2f((segmentOffsetX + segmentWidth) / textureWidth, (segmentOffsetY + segmentHeight) / textureHeight); glVertex2i(offsetX + segmentWidth, offsetY + segmentHeight);
-    glTexCoord2f((segmentOffsetX + segmentWidth) / textureWidth, segmentOffsetY / textureHeight); glVertex2i(offsetX + segmentWidth, offsetY);
-    glTexCoord2f(segmentOffsetX / textureWidth, segmentOffsetY / textureHeight); glVertex2i(offsetX, offsetY);
+    glTexCoord2f(left, bottom); glVertex2i(offsetX, offsetY + segmentHeight);
+    glTexCoord2f(right, bottom); glVertex2i(offsetX + segmentWidth, offsetY + segmentHeight);
+    glTexCoord2f(right, top); glVertex2i(offsetX + segmentWidth, offsetY);
+    glTexCoord2f(left, top); glVertex2i(offsetX, offsetY);
     glEnd();
+    AddDrawBatch(4);
 }
 
 void RendererOpenGL::Render2DBar(const int16_t x, const int16_t y, const uint16_t width, const uint16_t height, const egaColor colorIndex)
@@ -321,10 +455,13 @@ void RendererOpenGL::Render2DBar(const int16_t x, const int16_t y, const uint16_
     glTexCoord2i(1, 0); glVertex2i(x + width, y);
     glTexCoord2i(0, 0); glVertex2i(x, y);
     glEnd();
+    AddDrawBatch(4);
 }
 
 void RendererOpenGL::RenderTiles(const RenderableTiles& renderableTiles)
 {
+    PROFILE_SCOPE("RenderTiles");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPassTiles);
     const TextureAtlas& textureAtlas = renderableTiles.GetTextureAtlas();
     const std::vector<RenderableTiles::RenderableTile> tiles = renderableTiles.GetTiles();
 
@@ -358,6 +495,7 @@ void RendererOpenGL::RenderTiles(const RenderableTiles& renderableTiles)
         glVertex2i(offsetX + imageWidth, offsetY);
     }
     glEnd();
+    AddDrawBatch((uint32_t)tiles.size() * 4);
 }
 
 void RendererOpenGL::ApplyDepthShading(const Renderable3DScene& renderable3DScene) const
@@ -367,7 +505,7 @@ void RendererOpenGL::ApplyDepthShading(const Renderable3DScene& renderable3DScen
         const GLfloat LightAmbient[] = { 1.0f, 1.0f, 1.0f, 1.0f };
         const GLfloat LightDiffuse[] = { 1.0f, 1.0f, 1.0f, 1.0f };
         const GLfloat LightPosition[] = { renderable3DScene.GetOriginX(), renderable3DScene.GetOriginY(), -PlayerZ, 1.0f };
-        glEnable(GL_LIGHTING);
+        m_openGLStateCache.SetCapability(GL_LIGHTING, true);
         glLightfv(GL_LIGHT1, GL_AMBIENT, LightAmbient);
         glLightfv(GL_LIGHT1, GL_DIFFUSE, LightDiffuse);
         glLightfv(GL_LIGHT1, GL_POSITION, LightPosition);
@@ -377,6 +515,7 @@ void RendererOpenGL::ApplyDepthShading(const Renderable3DScene& renderable3DScen
 
 void RendererOpenGL::Render3DScene(const Renderable3DScene& renderable3DScene)
 {
+    PROFILE_SCOPE("Render3DScene");
     if (renderable3DScene.GetOriginalScreenResolution())
     {
         const ViewPorts::ViewPortRect3D rect3D = renderable3DScene.GetOriginal3DViewArea();
@@ -384,11 +523,15 @@ void RendererOpenGL::Render3DScene(const Renderable3DScene& renderable3DScene)
         const uint16_t bufferWidth = rect3D.width + (additionalMargin * 2);
         m_openGLFramebuffer.Bind(bufferWidth, rect3D.height);
 
+        // A resize of the frame buffer sets up its textures without the state cache
+        m_openGLStateCache.ForgetTexture(m_openGLFramebuffer.GetTextureId());
+        m_openGLStateCache.InvalidateTextureBinding();
+
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         glViewport(0, 0, bufferWidth, rect3D.height);
 
-        glEnable(GL_DEPTH_TEST);                        // Enables Depth Testing
+        m_openGLStateCache.SetCapability(GL_DEPTH_TEST, true); // Enables Depth Testing
 
         glDepthFunc(GL_LEQUAL);                         // The Type Of Depth Testing To Do
 
@@ -438,6 +581,7 @@ void RendererOpenGL::Render3DScene(const Renderable3DScene& renderable3DScene)
         glTexCoord2i(1, 0); glVertex2i(offsetX + width, offsetY + height);
         glTexCoord2i(0, 0); glVertex2i(offsetX, offsetY + height);
         glEnd();
+        AddDrawBatch(4);
     }
     else
     {
@@ -445,7 +589,7 @@ void RendererOpenGL::Render3DScene(const Renderable3DScene& renderable3DScene)
 
         glViewport(rect.left, rect.bottom, rect.width, rect.height);
 
-        glEnable(GL_DEPTH_TEST);                        // Enables Depth Testing
+        m_openGLStateCache.SetCapability(GL_DEPTH_TEST, true); // Enables Depth Testing
 
         glDepthFunc(GL_LEQUAL);                         // The Type Of Depth Testing To Do
 
@@ -498,9 +642,11 @@ uint16_t RendererOpenGL::GetAdditionalMarginDueToWideScreen(const float aspectRa
 
 void RendererOpenGL::Render3DWalls(const Renderable3DWalls& walls)
 {
-    glEnable(GL_CULL_FACE);
-    const std::map<unsigned int, std::vector<Renderable3DWalls::wallCoordinate>> textureToWallsMap = walls.GetTextureToWallsMap();
-    for (const std::pair<unsigned int, std::vector<Renderable3DWalls::wallCoordinate>> textureToWalls : textureToWallsMap)
+    PROFILE_SCOPE("Render3DWalls");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPass3DWalls);
+    m_openGLStateCache.SetCapability(GL_CULL_FACE, true);
+    const std::map<unsigned int, std::vector<Renderable3DWalls::texturedWall>>& textureToWallsMap = walls.GetTextureToWallsMap();
+    for (const std::pair<const unsigned int, std::vector<Renderable3DWalls::texturedWall>>& textureToWalls : textureToWallsMap)
     {
         const unsigned int textureId = textureToWalls.first;
         // Select the texture from the picture
@@ -508,21 +654,29 @@ void RendererOpenGL::Render3DWalls(const Renderable3DWalls& walls)
 
         // Draw the texture as a quad
         glBegin(GL_QUADS);
-        for (const Renderable3DWalls::wallCoordinate& coordinate : textureToWalls.second)
+        for (const Renderable3DWalls::texturedWall& wall : textureToWalls.second)
         {
-            glTexCoord2i(1, 1); glVertex3f((float)coordinate.x1, (float)coordinate.y1, FloorZ);
-            glTexCoord2i(0, 1); glVertex3f((float)coordinate.x2, (float)coordinate.y2, FloorZ);
-            glTexCoord2i(0, 0); glVertex3f((float)coordinate.x2, (float)coordinate.y2, CeilingZ);
-            glTexCoord2i(1, 0); glVertex3f((float)coordinate.x1, (float)coordinate.y1, CeilingZ);
+            const Renderable3DWalls::wallCoordinate& coordinate = wall.coordinate;
+            const float left = wall.picture->GetImageRelativeOffsetX();
+            const float top = wall.picture->GetImageRelativeOffsetY();
+            const float right = left + wall.picture->GetImageRelativeWidth();
+            const float bottom = top + wall.picture->GetImageRelativeHeight();
+            glTexCoord2f(right, bottom); glVertex3f((float)coordinate.x1, (float)coordinate.y1, FloorZ);
+            glTexCoord2f(left, bottom); glVertex3f((float)coordinate.x2, (float)coordinate.y2, FloorZ);
+            glTexCoord2f(left, top); glVertex3f((float)coordinate.x2, (float)coordinate.y2, CeilingZ);
+            glTexCoord2f(right, top); glVertex3f((float)coordinate.x1, (float)coordinate.y1, CeilingZ);
         }
         glEnd();
+        AddDrawBatch((uint32_t)textureToWalls.second.size() * 4);
     }
 
-    glDisable(GL_CULL_FACE);
+    m_openGLStateCache.SetCapability(GL_CULL_FACE, false);
 }
 
 void RendererOpenGL::RenderSprites(const RenderableSprites& renderableSprites)
 {
+    PROFILE_SCOPE("RenderSprites");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPassSprites);
     const std::vector<RenderableSprites::RenderableSprite>& sprites = renderableSprites.GetSprites();
     if (sprites.empty())
     {
@@ -530,65 +684,146 @@ void RendererOpenGL::RenderSprites(const RenderableSprites& renderableSprites)
         return;
     }
 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
+    m_openGLStateCache.SetCapability(GL_BLEND, true);
+    m_openGLStateCache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_openGLStateCache.SetDepthMask(false);
     glPushMatrix();
 
-    unsigned int previousTextureId = 0;
+    if (m_openGLInstancedSprites.IsSupported())
+    {
+        RenderSpritesInstanced(renderableSprites);
+    }
+    else
+    {
+        unsigned int previousTextureId = 0;
+
+        for (size_t i = 0; i < sprites.size(); i++)
+        {
+            const Picture* picture = sprites.at(i).picture;
+            const float offsetX = sprites.at(i).offsetX;
+            const float offsetY = sprites.at(i).offsetY;
+            const RenderableSprites::SpriteOrientation orientation = sprites.at(i).orientation;
+            glMatrixMode(GL_MODELVIEW);                     // Select The Projection Matrix
+            glLoadIdentity();
+
+            glTranslatef(offsetX, offsetY, 0.0f);
+            const float angle =
+                (orientation == RenderableSprites::RotatedTowardsPlayer) ? renderableSprites.GetAngle() :
+                (orientation == RenderableSprites::Isometric) ? 135.0f :
+                (orientation == RenderableSprites::AlongYAxis) ? 90.0f :
+                0.0f;
+
+            glRotatef(angle, 0.0f, 0.0f, 1.0f);
+
+            const GLfloat halfWidth = (float)(picture->GetImageWidth()) / 128.0f;
+            const GLfloat topZ = CeilingZ + ((float)(picture->GetImageHeight()) / 64.0f) * (FloorZ - CeilingZ);
+
+            // Select the texture from the picture
+            const unsigned int textureId = picture->GetTextureId();
+            if (textureId != previousTextureId || previousTextureId == 0)
+            {
+                BindTexture(textureId);
+                previousTextureId = textureId;
+            }
+
+            // Sprites that face the player are a bit sunken into the floor
+            const float zOffset = (orientation == RenderableSprites::RotatedTowardsPlayer) ? 0.0625f : 0.0f;
+
+            // Draw the texture as a quad
+            const float left = picture->GetImageRelativeOffsetX();
+            const float top = picture->GetImageRelativeOffsetY();
+            const float right = left + picture->GetImageRelativeWidth();
+            const float bottom = top + picture->GetImageRelativeHeight();
+            glBegin(GL_QUADS);
+            glTexCoord2f(left, top); glVertex3f(-halfWidth, 0.0f, CeilingZ + zOffset);
+            glTexCoord2f(right, top); glVertex3f(halfWidth, 0.0f, CeilingZ + zOffset);
+            glTexCoord2f(right, bottom); glVertex3f(halfWidth, 0.0f, topZ + zOffset);
+            glTexCoord2f(left, bottom); glVertex3f(-halfWidth, 0.0f, topZ + zOffset);
+            glEnd();
+            AddDrawBatch(4);
+        }
+    }
+
+    glPopMatrix();
+    m_openGLStateCache.SetDepthMask(true);
+    m_openGLStateCache.SetCapability(GL_BLEND, false);
+}
 
+void RendererOpenGL::RenderSpritesInstanced(const RenderableSprites& renderableSprites)
+{
+    const std::vector<RenderableSprites::RenderableSprite>& sprites = renderableSprites.GetSprites();
+    m_spriteInstances.resize(sprites.size());
     for (size_t i = 0; i < sprites.size(); i++)
     {
-        const Picture* picture = sprites.at(i).picture;
-        const float offsetX = sprites.at(i).offsetX;
-        const float offsetY = sprites.at(i).offsetY;
-        const RenderableSprites::SpriteOrientation orientation = sprites.at(i).orientation;
-        glMatrixMode(GL_MODELVIEW);                     // Select The Projection Matrix
-        glLoadIdentity();
-
-        glTranslatef(offsetX, offsetY, 0.0f);
-        const float angle =
-            (orientation == RenderableSprites::RotatedTowardsPlayer) ? renderableSprites.GetAngle() :
-            (orientation == RenderableSprites::Isometric) ? 135.0f :
-            (orientation == RenderableSprites::AlongYAxis) ? 90.0f :
-            0.0f;
+        const Picture* picture = sprites[i].picture;
+        OpenGLInstancedSprites::spriteInstance& instance = m_spriteInstances[i];
+        instance.positionX = sprites[i].offsetX;
+        instance.positionY = sprites[i].offsetY;
+        instance.positionZ = CeilingZ;
+        instance.orientation = (float)sprites[i].orientation;
+        instance.width = (float)(picture->GetImageWidth()) / 64.0f;
+        instance.height = ((float)(picture->GetImageHeight()) / 64.0f) * (FloorZ - CeilingZ);
+        instance.textureLeft = picture->GetImageRelativeOffsetX();
+        instance.textureTop = picture->GetImageRelativeOffsetY();
+        instance.textureWidth = picture->GetImageRelativeWidth();
+        instance.textureHeight = picture->GetImageRelativeHeight();
+    }
 
-        glRotatef(angle, 0.0f, 0.0f, 1.0f);
+    // The vertex shader places each sprite in world coordinates
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
 
-        const GLfloat halfWidth = (float)(picture->GetImageWidth()) / 128.0f;
-        const GLfloat topZ = CeilingZ + ((float)(picture->GetImageHeight()) / 64.0f) * (FloorZ - CeilingZ);
+    m_openGLInstancedSprites.Bind(m_spriteInstances, renderableSprites.GetAngle(), glIsEnabled(GL_LIGHTING) == GL_TRUE);
+    m_openGLPalette.SetHostProgram(m_openGLInstancedSprites.GetProgram());
 
-        // Select the texture from the picture
-        const unsigned int textureId = picture->GetTextureId();
-        if (textureId != previousTextureId || previousTextureId == 0)
+    // The sprites are sorted back to front, so each run of sprites that share a texture atlas takes one draw
+    size_t firstSpriteInRun = 0;
+    for (size_t i = 1; i <= sprites.size(); i++)
+    {
+        if (i == sprites.size() || sprites[i].picture->GetTextureId() != sprites[firstSpriteInRun].picture->GetTextureId())
         {
-            BindTexture(textureId);
-            previousTextureId = textureId;
+            BindTexture(sprites[firstSpriteInRun].picture->GetTextureId());
+            m_openGLInstancedSprites.Draw((uint32_t)firstSpriteInRun, (uint32_t)(i - firstSpriteInRun));
+            AddDrawBatch((uint32_t)(i - firstSpriteInRun) * 4);
+            firstSpriteInRun = i;
         }
-
-        // Sprites that face the player are a bit sunken into the floor
-        const float zOffset = (orientation == RenderableSprites::RotatedTowardsPlayer) ? 0.0625f : 0.0f;
-
-        // Draw the texture as a quad
-        const float relativeImageWidth = (float)picture->GetImageWidth() / (float)picture->GetTextureWidth();
-        const float relativeImageHeight = (float)picture->GetImageHeight() / (float)picture->GetTextureHeight();
-        glBegin(GL_QUADS);
-        glTexCoord2f(0.0f, 0.0f); glVertex3f(-halfWidth, 0.0f, CeilingZ + zOffset);
-        glTexCoord2f(relativeImageWidth, 0.0f); glVertex3f(halfWidth, 0.0f, CeilingZ + zOffset);
-        glTexCoord2f(relativeImageWidth, relativeImageHeight); glVertex3f(halfWidth, 0.0f, topZ + zOffset);
-        glTexCoord2f(0.0f, relativeImageHeight); glVertex3f(-halfWidth, 0.0f, topZ + zOffset);
-        glEnd();
     }
 
-    glPopMatrix();
-    glDepthMask(GL_TRUE);
-    glDisable(GL_BLEND);
+    m_openGLInstancedSprites.Unbind();
+    m_openGLPalette.SetHostProgram(0);
 }
 
 void RendererOpenGL::Render3DTiles(const Renderable3DTiles& tiles)
 {
+    PROFILE_SCOPE("Render3DTiles");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPass3DTiles);
     // Do not write into the depth buffer. This allows sprites to appear a bit sunken into the floor.
-    glDepthMask(GL_FALSE);
+    m_openGLStateCache.SetDepthMask(false);
+
+    if (m_openGLTileMesh.IsSupported() && tiles.GetMapWidth() > 0 && tiles.GetMapHeight() > 0)
+    {
+        // The mesh of the map stays in GPU memory; only the rows of visible tiles are sent each frame
+        m_openGLTileMesh.Prepare(tiles.GetMapWidth(), tiles.GetMapHeight());
+
+        glMatrixMode(GL_MODELVIEW);
+        glPushMatrix();
+        glTranslatef(0.0f, 0.0f, FloorZ);
+        BindTexture(m_singleColorTexture[tiles.GetFloorColor()]);
+        AddDrawBatch(m_openGLTileMesh.Draw(tiles.GetTileRows()));
+        glPopMatrix();
+
+        if (!tiles.IsOnlyFloor())
+        {
+            glPushMatrix();
+            glTranslatef(0.0f, 0.0f, CeilingZ);
+            BindTexture(m_singleColorTexture[tiles.GetCeilingColor()]);
+            AddDrawBatch(m_openGLTileMesh.Draw(tiles.GetTileRows()));
+            glPopMatrix();
+        }
+
+        m_openGLStateCache.SetDepthMask(true);
+        return;
+    }
 
     BindTexture(m_singleColorTexture[tiles.GetFloorColor()]);
 
@@ -605,6 +840,7 @@ void RendererOpenGL::Render3DTiles(const Renderable3DTiles& tiles)
         glTexCoord2i(0, 0); glVertex3f(tileX, tileY, FloorZ);               // Top Left
     }
     glEnd();
+    AddDrawBatch((uint32_t)tileCoordinates.size() * 4);
 
     if (!tiles.IsOnlyFloor())
     {
@@ -622,13 +858,16 @@ void RendererOpenGL::Render3DTiles(const Renderable3DTiles& tiles)
             glTexCoord2i(0, 0); glVertex3f(tileX, tileY, CeilingZ);               // Top Left
         }
         glEnd();
+        AddDrawBatch((uint32_t)tileCoordinates.size() * 4);
     }
 
-    glDepthMask(GL_TRUE);
+    m_openGLStateCache.SetDepthMask(true);
 }
 
 void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMapTopDown)
 {
+    PROFILE_SCOPE("RenderAutoMapTopDown");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPassAutoMapTopDown);
     const uint16_t wallsScaleFactor = autoMapTopDown.GetTileSize() / 16;
     const uint16_t textScaleFactor = 2;
     PrepareTopDownRendering(autoMapTopDown.GetAspectRatio(), autoMapTopDown.GetOriginal3DViewArea(), wallsScaleFactor);
@@ -638,15 +877,22 @@ void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMa
     RenderTopDownFloorTiles(autoMapTopDown.GetBorderTiles(), tileSize);
 
     // Draw walls and sprites
-    for (const auto picturePair : autoMapTopDown.GetPictures())
+    unsigned int previousTextureId = 0;
+    for (const auto& picturePair : autoMapTopDown.GetPictures())
     {
-        // Select the texture from the picture
+        // Select the texture from the picture, unless it is shared with the previous picture
         const Picture* picture = picturePair.first;
-        BindTexture(picture->GetTextureId());
+        if (picture->GetTextureId() != previousTextureId || previousTextureId == 0)
+        {
+            BindTexture(picture->GetTextureId());
+            previousTextureId = picture->GetTextureId();
+        }
         const GLint width = (uint16_t)picture->GetImageWidth();
         const GLint height = (uint16_t)picture->GetImageHeight();
-        const float relativeImageWidth = (float)picture->GetImageWidth() / (float)picture->GetTextureWidth();
-        const float relativeImageHeight = (float)picture->GetImageHeight() / (float)picture->GetTextureHeight();
+        const float left = picture->GetImageRelativeOffsetX();
+        const float top = picture->GetImageRelativeOffsetY();
+        const float right = left + picture->GetImageRelativeWidth();
+        const float bottom = top + picture->GetImageRelativeHeight();
 
         // Draw the texture as quads
         glBegin(GL_QUADS);
@@ -655,12 +901,13 @@ void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMa
         {
             const int16_t offsetX = coordinate.x;
             const int16_t offsetY = coordinate.y;
-            glTexCoord2f(0, relativeImageHeight); glVertex2i(offsetX, offsetY + height);
-            glTexCoord2f(relativeImageWidth, relativeImageHeight); glVertex2i(offsetX + width, offsetY + height);
-            glTexCoord2f(relativeImageWidth, 0); glVertex2i(offsetX + width, offsetY);
-            glTexCoord2f(0, 0); glVertex2i(offsetX, offsetY);
+            glTexCoord2f(left, bottom); glVertex2i(offsetX, offsetY + height);
+            glTexCoord2f(right, bottom); glVertex2i(offsetX + width, offsetY + height);
+            glTexCoord2f(right, top); glVertex2i(offsetX + width, offsetY);
+            glTexCoord2f(left, top); glVertex2i(offsetX, offsetY);
         }
         glEnd();
+        AddDrawBatch((uint32_t)picturePair.second.size() * 4);
     }
     RenderTiles(autoMapTopDown.GetTilesSize16());
     RenderTiles(autoMapTopDown.GetTilesSize16Masked());
@@ -681,6 +928,7 @@ void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMa
             glTexCoord2i(0, 0); glVertex2i(x, y);
         }
         glEnd();
+        AddDrawBatch((uint32_t)wallCapPair.second.size() * 4);
     }
 
     if (autoMapTopDown.GetTileSize() == 64)
@@ -702,11 +950,13 @@ void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMa
         glTexCoord2i(1, 0); glVertex2f(-6.4f, 0.0f);
         glTexCoord2i(0, 0); glVertex2f(6.4f, 0.0f);
         glEnd();
+        AddDrawBatch(4);
         glBegin(GL_TRIANGLES);
         glTexCoord2i(0, 1); glVertex2f(25.6f, 0.0f);
         glTexCoord2i(1, 1); glVertex2f(0.0f, -25.6f);
         glTexCoord2i(1, 0); glVertex2f(-25.6f, 0.0f);
         glEnd();
+        AddDrawBatch(3);
 
         glPopMatrix();
 
@@ -718,6 +968,8 @@ void RendererOpenGL::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMa
 
 void RendererOpenGL::RenderAutoMapIso(const RenderableAutoMapIso& autoMapIso)
 {
+    PROFILE_SCOPE("RenderAutoMapIso");
+    const GpuTimerScope gpuTimerScope(m_openGLTimerQueries, m_isGpuTimingEnabled, RenderPassAutoMapIso);
     const float xScale = PrepareIsoRendering(
         autoMapIso.GetAspectRatio(),
         autoMapIso.GetOriginal3DViewArea(),
@@ -749,11 +1001,13 @@ void RendererOpenGL::RenderAutoMapIso(const RenderableAutoMapIso& autoMapIso)
     glTexCoord2i(1, 0); glVertex3f(- 0.1f, 0.0f, 0.0f);
     glTexCoord2i(0, 0); glVertex3f(0.1f, 0.0f, 0.0f);
     glEnd();
+    AddDrawBatch(4);
     glBegin(GL_TRIANGLES);
     glTexCoord2i(0, 1); glVertex3f(0.4f, 0.0f, 0.0f);
     glTexCoord2i(1, 1); glVertex3f(0.0f, - 0.4f, 0.0f);
     glTexCoord2i(1, 0); glVertex3f(- 0.4f, 0.0f, 0.0f);
     glEnd();
+    AddDrawBatch(3);
 
     glPopMatrix();
 
@@ -775,13 +1029,18 @@ bool RendererOpenGL::IsOriginalScreenResolutionSupported()
     return m_openGLFramebuffer.IsSupported();
 }
 
+bool RendererOpenGL::IsScreenCaptureOnGpuSupported()
+{
+    return m_isScreenCaptureOnGpuSupported;
+}
+
 float RendererOpenGL::PrepareIsoRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const float originX, const float originY)
 {
     ViewPorts::ViewPortRect3D rect = ViewPorts::Get3D(m_windowWidth, m_windowHeight, aspectRatio, original3DViewArea);
 
     glViewport(rect.left, rect.bottom, rect.width, rect.height);
 
-    glEnable(GL_DEPTH_TEST);                        // Enables Depth Testing
+    m_openGLStateCache.SetCapability(GL_DEPTH_TEST, true); // Enables Depth Testing
 
     glDepthFunc(GL_LEQUAL);                         // The Type Of Depth Testing To Do
 
@@ -812,7 +1071,7 @@ float RendererOpenGL::PrepareIsoRendering(const float aspectRatio, const ViewPor
 
 void RendererOpenGL::PrepareIsoRenderingText(const float originX, const float originY, const float xScale)
 {
-    glDisable(GL_DEPTH_TEST);
+    m_openGLStateCache.SetCapability(GL_DEPTH_TEST, false);
 
     glMatrixMode(GL_PROJECTION);                        // Select The Projection Matrix
     glLoadIdentity();                                   // Reset The Projection Matrix
@@ -831,9 +1090,9 @@ void RendererOpenGL::PrepareIsoRenderingText(const float originX, const float or
 
     glShadeModel(GL_SMOOTH);
 
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_openGLStateCache.SetCapability(GL_TEXTURE_2D, true);
+    m_openGLStateCache.SetCapability(GL_BLEND, true);
+    m_openGLStateCache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 }
 
 void RendererOpenGL::PrepareTopDownRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const uint16_t scale)
@@ -846,11 +1105,11 @@ void RendererOpenGL::PrepareTopDownRendering(const float aspectRatio, const View
     glColor3f(1.0f, 1.0f, 1.0f);
 
     // Make sure the depth test is disabled
-    glDisable(GL_DEPTH_TEST);
+    m_openGLStateCache.SetCapability(GL_DEPTH_TEST, false);
 
-    glEnable(GL_TEXTURE_2D);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    m_openGLStateCache.SetCapability(GL_TEXTURE_2D, true);
+    m_openGLStateCache.SetCapability(GL_BLEND, true);
+    m_openGLStateCache.SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // Create a 2D orthographic projection matrix, such that it imitates the 320x200 EGA pixel matrix.
     glMatrixMode(GL_PROJECTION);
@@ -862,12 +1121,12 @@ void RendererOpenGL::PrepareTopDownRendering(const float aspectRatio, const View
     const double orthoBottom = (double)(original3DViewArea.bottom * scale);
     gluOrtho2D(0.0, orthoRight, orthoBottom, 0.0);
 
-    glDisable(GL_LIGHTING);
+    m_openGLStateCache.SetCapability(GL_LIGHTING, false);
 }
 
 void RendererOpenGL::RenderIsoWallCaps(const std::map <egaColor, std::vector<RenderableAutoMapIso::quadCoordinates>>& wallCaps)
 {
-    glEnable(GL_CULL_FACE);
+    m_openGLStateCache.SetCapability(GL_CULL_FACE, true);
 
     for (const std::pair<egaColor, std::vector<RenderableAutoMapIso::quadCoordinates>>& wallCap : wallCaps)
     {
@@ -885,9 +1144,10 @@ void RendererOpenGL::RenderIsoWallCaps(const std::map <egaColor, std::vector<Ren
             glTexCoord2i(1, 0); glVertex3f((float)coordinate.x4, (float)coordinate.y4, CeilingZ);
         }
         glEnd();
+        AddDrawBatch((uint32_t)wallCap.second.size() * 4);
     }
 
-    glDisable(GL_CULL_FACE);
+    m_openGLStateCache.SetCapability(GL_CULL_FACE, false);
 }
 
 void RendererOpenGL::RenderTopDownFloorTiles(const Renderable3DTiles& tiles, const uint16_t tileSize)
@@ -908,18 +1168,72 @@ void RendererOpenGL::RenderTopDownFloorTiles(const Renderable3DTiles& tiles, con
         
     }
     glEnd();
+    AddDrawBatch((uint32_t)floorTiles.size() * 4);
 }
 
 Picture* RendererOpenGL::GetScreenCapture(const unsigned int textureId)
+{
+    const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(m_windowWidth);
+    const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(m_windowHeight);
+
+    GLuint newTextureId;
+    if (textureId == 0)
+    {
+        newTextureId = GenerateTextureId();
+    }
+    else
+    {
+        newTextureId = textureId;
+    }
+
+    if (m_isScreenCaptureOnGpuSupported && !CopyScreenIntoTexture(textureWidth, textureHeight, newTextureId))
+    {
+        Logging::Instance().AddLogMessage("Screen capture on GPU failed; falling back to reading back the pixels");
+        m_isScreenCaptureOnGpuSupported = false;
+    }
+
+    if (m_isScreenCaptureOnGpuSupported)
+    {
+        // The rows in the texture are bottom to top, as in the frame buffer
+        m_isScreenCaptureUpsideDown = true;
+    }
+    else
+    {
+        ReadScreenIntoTexture(textureWidth, textureHeight, newTextureId);
+        m_isScreenCaptureUpsideDown = false;
+    }
+
+    glClear(GL_STENCIL_BUFFER_BIT);
+    m_screenCaptureRevealedTime = 0;
+
+    return new Picture(newTextureId, m_windowWidth, m_windowHeight, textureWidth, textureHeight);
+}
+
+bool RendererOpenGL::CopyScreenIntoTexture(const uint16_t textureWidth, const uint16_t textureHeight, const unsigned int textureId)
+{
+    // Clear any pending error, such that only errors of the copy are detected
+    glGetError();
+
+    m_openGLStateCache.BindTexture(textureId);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, textureWidth, textureHeight, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
+    const GLsizei width = (textureWidth < m_windowWidth) ? textureWidth : m_windowWidth;
+    const GLsizei height = (textureHeight < m_windowHeight) ? textureHeight : m_windowHeight;
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, width, height);
+
+    // Do not wrap the texture
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    return (glGetError() == GL_NO_ERROR);
+}
+
+void RendererOpenGL::ReadScreenIntoTexture(const uint16_t textureWidth, const uint16_t textureHeight, const unsigned int textureId)
 {
     // Pixels are read as GL_RGBA. Although the alpha channel is stricly speaking not necessary,
     // some graphics adapters do not handle glReadPixels with GL_RGB correctly.
     uint8_t* rawPixelData = new uint8_t[(unsigned int)m_windowWidth * (unsigned int)m_windowHeight * 4u];
     glReadPixels(0, 0, m_windowWidth, m_windowHeight, GL_RGBA, GL_UNSIGNED_BYTE, rawPixelData);
 
-    const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(m_windowWidth);
-    const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(m_windowHeight);
-
     uint8_t* texturePixelData = new uint8_t[(unsigned int)textureWidth * (unsigned int)textureHeight * 4u];
 
     // Flip pixels upside down
@@ -933,30 +1247,22 @@ Picture* RendererOpenGL::GetScreenCapture(const unsigned int textureId)
 
     delete[] rawPixelData;
 
-    GLuint newTextureId;
-    if (textureId == 0)
-    {
-        newTextureId = GenerateTextureId();
-    }
-    else
-    {
-        newTextureId = textureId;
-    }
-
-    LoadPixelDataIntoTexture(textureWidth, textureHeight, texturePixelData, newTextureId);
+    LoadPixelDataIntoTexture(textureWidth, textureHeight, texturePixelData, textureId);
 
     delete[] texturePixelData;
-
-    glClear(GL_STENCIL_BUFFER_BIT);
-
-    return new Picture(newTextureId, m_windowWidth, m_windowHeight, textureWidth, textureHeight);
 }
 
-void RendererOpenGL::RemovePixelsFromScreenCapture(const std::vector<std::pair<int16_t, int16_t>>& coordinates)
+void RendererOpenGL::RemovePixelsFromScreenCapture(const uint16_t* revealTimes, const uint16_t revealedTime)
 {
+    if (revealedTime <= m_screenCaptureRevealedTime)
+    {
+        // No additional pixels to remove
+        return;
+    }
+
     glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
-    glDepthMask(GL_FALSE);
-    glEnable(GL_STENCIL_TEST);
+    m_openGLStateCache.SetDepthMask(false);
+    m_openGLStateCache.SetCapability(GL_STENCIL_TEST, true);
 
     //Place a 1 where rendered
     glStencilFunc(GL_ALWAYS, 1, 1);
@@ -968,41 +1274,71 @@ void RendererOpenGL::RemovePixelsFromScreenCapture(const std::vector<std::pair<i
     const int16_t xMin = (int16_t)floor(rect.left);
     const int16_t xMax = (int16_t)ceil(rect.right);
 
+    uint32_t numberOfVertices = 0;
     glBegin(GL_QUADS);
-    for (auto& coordinate : coordinates)
+    for (int16_t y = 0; y < 200; y++)
     {
-        int16_t xFirst = coordinate.first;
-        while (xFirst >= xMin + 320)
+        for (int16_t x = 0; x < 320; x++)
         {
-            xFirst -= 320;
-        }
-        const int16_t y = coordinate.second;
-        for (int16_t x = xFirst; x < xMax; x += 320)
-        {
-            glVertex2i(x, y + 1);
-            glVertex2i(x + 1, y + 1);
-            glVertex2i(x + 1, y);
-            glVertex2i(x, y);
+            // Only the pixels that were revealed since the previous call are added to the stencil buffer
+            const uint16_t revealTime = revealTimes[(y * 320) + x];
+            if (revealTime < m_screenCaptureRevealedTime || revealTime >= revealedTime)
+            {
+                continue;
+            }
+
+            int16_t xFirst = x;
+            while (xFirst >= xMin + 320)
+            {
+                xFirst -= 320;
+            }
+            for (int16_t xRepeated = xFirst; xRepeated < xMax; xRepeated += 320)
+            {
+                glVertex2i(xRepeated, y + 1);
+                glVertex2i(xRepeated + 1, y + 1);
+                glVertex2i(xRepeated + 1, y);
+                glVertex2i(xRepeated, y);
+                numberOfVertices += 4;
+            }
         }
     }
     glEnd();
+    AddDrawBatch(numberOfVertices);
 
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
-    glDepthMask(GL_TRUE);
-    glDisable(GL_STENCIL_TEST);
+    m_openGLStateCache.SetDepthMask(true);
+    m_openGLStateCache.SetCapability(GL_STENCIL_TEST, false);
+
+    m_screenCaptureRevealedTime = revealedTime;
 }
 
-void RendererOpenGL::RenderScreenCapture(Picture* screenCapture)
+void RendererOpenGL::RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime)
 {
+    PROFILE_SCOPE("RenderScreenCapture");
     if (screenCapture == nullptr)
     {
         return;
     }
 
-    glEnable(GL_STENCIL_TEST);
+    if (m_openGLFizzleFade.IsSupported())
+    {
+        // The shader discards the removed pixels, such that the whole fade takes a single draw
+        m_openGLPalette.Reset();
+        m_openGLFizzleFade.Bind(revealTimes, revealedTime);
 
-    glStencilFunc(GL_NOTEQUAL, 1, 1);
-    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+        // The reveal times may have been uploaded without the state cache
+        m_openGLStateCache.InvalidateTextureBinding();
+    }
+    else
+    {
+        // Mask out the removed pixels via the stencil buffer
+        RemovePixelsFromScreenCapture(revealTimes, revealedTime);
+
+        m_openGLStateCache.SetCapability(GL_STENCIL_TEST, true);
+
+        glStencilFunc(GL_NOTEQUAL, 1, 1);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+    }
 
     // Select the texture from the picture
     BindTexture(screenCapture->GetTextureId());
@@ -1012,13 +1348,23 @@ void RendererOpenGL::RenderScreenCapture(Picture* screenCapture)
     ViewPorts::ViewPortRect2D rect = ViewPorts::GetOrtho2D(m_windowWidth, m_windowHeight, false);
     const float relativeImageWidth = (float)screenCapture->GetImageWidth() / (float)screenCapture->GetTextureWidth();
     const float relativeImageHeight = (float)screenCapture->GetImageHeight() / (float)screenCapture->GetTextureHeight();
-    glTexCoord2f(0, relativeImageHeight); glVertex2d(rect.left, rect.bottom);
-    glTexCoord2f(relativeImageWidth, relativeImageHeight); glVertex2d(rect.right, rect.bottom);
-    glTexCoord2f(relativeImageWidth, 0); glVertex2d(rect.right, rect.top);
-    glTexCoord2f(0, 0); glVertex2d(rect.left, rect.top);
+    const float textureBottom = m_isScreenCaptureUpsideDown ? 0.0f : relativeImageHeight;
+    const float textureTop = m_isScreenCaptureUpsideDown ? relativeImageHeight : 0.0f;
+    glTexCoord2f(0, textureBottom); glVertex2d(rect.left, rect.bottom);
+    glTexCoord2f(relativeImageWidth, textureBottom); glVertex2d(rect.right, rect.bottom);
+    glTexCoord2f(relativeImageWidth, textureTop); glVertex2d(rect.right, rect.top);
+    glTexCoord2f(0, textureTop); glVertex2d(rect.left, rect.top);
     glEnd();
+    AddDrawBatch(4);
 
-    glDisable(GL_STENCIL_TEST);
+    if (m_openGLFizzleFade.IsSupported())
+    {
+        m_openGLFizzleFade.Unbind();
+    }
+    else
+    {
+        m_openGLStateCache.SetCapability(GL_STENCIL_TEST, false);
+    }
 }
 
 uint16_t RendererOpenGL::GetWindowWidth() const
@@ -1046,6 +1392,47 @@ const std::string& RendererOpenGL::GetGraphicsAdapterModel() const
     return m_graphicsAdapterModel;
 }
 
+void RendererOpenGL::SetGpuTimingEnabled(const bool enabled)
+{
+    m_isGpuTimingEnabled = enabled;
+}
+
+void RendererOpenGL::EndFrameStatistics()
+{
+    // The GPU times of an earlier frame are kept until newer ones are read back
+    float gpuTimeInMilliseconds[OpenGLTimerQueries::MaxPasses];
+    if (m_openGLTimerQueries.EndFrame(gpuTimeInMilliseconds))
+    {
+        for (uint8_t pass = 0; pass < RenderPassCount; pass++)
+        {
+            m_renderStatistics.gpuTimeInMilliseconds[pass] = gpuTimeInMilliseconds[pass];
+        }
+        m_renderStatistics.gpuTimesAvailable = true;
+    }
+    else if (!m_isGpuTimingEnabled)
+    {
+        m_renderStatistics.gpuTimesAvailable = false;
+    }
+
+    m_renderStatistics.textureBinds = m_frameStatistics.textureBinds;
+    m_renderStatistics.drawBatches = m_frameStatistics.drawBatches;
+    m_renderStatistics.vertices = m_frameStatistics.vertices;
+    m_frameStatistics.textureBinds = 0;
+    m_frameStatistics.drawBatches = 0;
+    m_frameStatistics.vertices = 0;
+}
+
+const IRenderer::RenderStatistics& RendererOpenGL::GetRenderStatistics() const
+{
+    return m_renderStatistics;
+}
+
+void RendererOpenGL::AddDrawBatch(const uint32_t numberOfVertices)
+{
+    m_frameStatistics.drawBatches++;
+    m_frameStatistics.vertices += numberOfVertices;
+}
+
 egaColor RendererOpenGL::GetAutomapPlayerMarkerColor(const egaColor floorColor) const
 {
     return (floorColor == EgaBrightWhite || floorColor == EgaBrightYellow) ? EgaDarkGray : EgaBrightYellow;
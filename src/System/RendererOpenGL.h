@@ -19,7 +19,13 @@
 #include "../Engine/FileChunk.h"
 #include "../Engine/Font.h"
 #include "../Engine/IRenderer.h"
+#include "../Engine/OpenGLFizzleFade.h"
 #include "../Engine/OpenGLFrameBuffer.h"
+#include "../Engine/OpenGLInstancedSprites.h"
+#include "../Engine/OpenGLPalette.h"
+#include "../Engine/OpenGLStateCache.h"
+#include "../Engine/OpenGLTileMesh.h"
+#include "../Engine/OpenGLTimerQueries.h"
 #include "../Engine/Picture.h"
 
 #ifdef _WIN32
@@ -48,6 +54,8 @@ public:
     //
     unsigned int GenerateTextureId() const override;
     void LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const override;
+    void LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const override;
+    void DeleteTexture(const unsigned int textureId) const override;
 
     //
     // 2D rendering
@@ -72,8 +80,7 @@ public:
     // Screen capture
     //
     Picture* GetScreenCapture(const unsigned int textureId) override;
-    void RemovePixelsFromScreenCapture(const std::vector<std::pair<int16_t, int16_t>>& coordinates) override;
-    void RenderScreenCapture(Picture* screenCapture) override;
+    void RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime) override;
 
     //
     // Capabilities
@@ -83,9 +90,24 @@ public:
     const std::string& GetGraphicsAdapterModel() const override;
     bool IsVSyncSupported() override;
     bool IsOriginalScreenResolutionSupported() override;
+    bool IsScreenCaptureOnGpuSupported() override;
+
+    //
+    // Statistics
+    //
+    void SetGpuTimingEnabled(const bool enabled) override;
+    void EndFrameStatistics() override;
+    const RenderStatistics& GetRenderStatistics() const override;
 
 private:
-    void BindTexture(unsigned int textureId) const;
+    typedef struct
+    {
+        uint32_t width;
+        uint32_t height;
+    } textureSize;
+
+    void BindTexture(unsigned int textureId);
+    void AddDrawBatch(const uint32_t numberOfVertices);
 
     unsigned int GenerateSingleColorTexture(const egaColor color) const;
     static const std::string ErrorCodeToString(const GLenum errorCode);
@@ -96,18 +118,25 @@ private:
     void Render3DWalls(const Renderable3DWalls& walls);
     void Render3DTiles(const Renderable3DTiles& tiles);
     void RenderSprites(const RenderableSprites& renderableSprites);
+    void RenderSpritesInstanced(const RenderableSprites& renderableSprites);
     void PrepareTopDownRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const uint16_t scale);
     void RenderTopDownFloorTiles(const Renderable3DTiles& tiles, const uint16_t tileSize);
     void ApplyDepthShading(const Renderable3DScene& renderable3DScene) const;
     egaColor GetAutomapPlayerMarkerColor(const egaColor floorColor) const;
+    void RemovePixelsFromScreenCapture(const uint16_t* revealTimes, const uint16_t revealedTime);
+    bool CopyScreenIntoTexture(const uint16_t textureWidth, const uint16_t textureHeight, const unsigned int textureId);
+    void ReadScreenIntoTexture(const uint16_t textureWidth, const uint16_t textureHeight, const unsigned int textureId);
 
     uint16_t m_windowWidth;
     uint16_t m_windowHeight;
     unsigned int m_singleColorTexture[EgaRange];
 
     GLint m_textureFilter;
+    bool m_palettizedTextures;
     int32_t m_currentSwapInterval;
     bool m_isVSyncSupported;
+    bool m_isScreenCaptureOnGpuSupported;
+    bool m_isScreenCaptureUpsideDown;
 
     std::string m_graphicsApiVersion;
     std::string m_graphicsAdapterVendor;
@@ -115,5 +144,19 @@ private:
 
     OpenGLBasic m_openGLBasic;
     OpenGLFrameBuffer m_openGLFramebuffer;
+    OpenGLFizzleFade m_openGLFizzleFade;
+    OpenGLTimerQueries m_openGLTimerQueries;
+    OpenGLInstancedSprites m_openGLInstancedSprites;
+    OpenGLTileMesh m_openGLTileMesh;
+    OpenGLPalette m_openGLPalette;
+    mutable OpenGLStateCache m_openGLStateCache;
+    // Textures that hold palettized pixel data, by texture id
+    mutable std::map<unsigned int, textureSize> m_palettizedTextureSizes;
+    std::vector<OpenGLInstancedSprites::spriteInstance> m_spriteInstances;
+    uint16_t m_screenCaptureRevealedTime;
+
+    bool m_isGpuTimingEnabled;
+    RenderStatistics m_frameStatistics;
+    RenderStatistics m_renderStatistics;
 };
 
@@ -0,0 +1,1392 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "RendererSoftware.h"
+#include "../Engine/Logging.h"
+#include "../Engine/FrameProfiler.h"
+#include "../Engine/OverscanBorder.h"
+#include "../Engine/ViewPorts.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+const float FloorZ = 2.2f;
+const float CeilingZ = 1.0f;
+const float PlayerZ = 1.6f;
+
+// Opaque black, as OpenGL clears the window
+const uint32_t ClearColor = 0xFF000000;
+
+//
+// Matrix operations of the fixed function pipeline, on column-major 4x4 matrices
+//
+static void LoadIdentity(float m[16])
+{
+    for (uint8_t i = 0; i < 16; i++)
+    {
+        m[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+    }
+}
+
+// m = m * other
+static void MultiplyMatrix(float m[16], const float other[16])
+{
+    float result[16];
+    for (uint8_t column = 0; column < 4; column++)
+    {
+        for (uint8_t row = 0; row < 4; row++)
+        {
+            result[(column * 4) + row] =
+                (m[row] * other[(column * 4)]) +
+                (m[4 + row] * other[(column * 4) + 1]) +
+                (m[8 + row] * other[(column * 4) + 2]) +
+                (m[12 + row] * other[(column * 4) + 3]);
+        }
+    }
+    std::memcpy(m, result, sizeof(result));
+}
+
+static void Translate(float m[16], const float x, const float y, const float z)
+{
+    float translation[16];
+    LoadIdentity(translation);
+    translation[12] = x;
+    translation[13] = y;
+    translation[14] = z;
+    MultiplyMatrix(m, translation);
+}
+
+static void Rotate(float m[16], const float angle, const float axisX, const float axisY, const float axisZ)
+{
+    const double length = std::sqrt((double)(axisX * axisX) + (axisY * axisY) + (axisZ * axisZ));
+    const double x = axisX / length;
+    const double y = axisY / length;
+    const double z = axisZ / length;
+    const double radians = angle * 3.14159265358979323846 / 180.0;
+    const double c = std::cos(radians);
+    const double s = std::sin(radians);
+
+    float rotation[16];
+    LoadIdentity(rotation);
+    rotation[0] = (float)((x * x * (1.0 - c)) + c);
+    rotation[1] = (float)((y * x * (1.0 - c)) + (z * s));
+    rotation[2] = (float)((x * z * (1.0 - c)) - (y * s));
+    rotation[4] = (float)((x * y * (1.0 - c)) - (z * s));
+    rotation[5] = (float)((y * y * (1.0 - c)) + c);
+    rotation[6] = (float)((y * z * (1.0 - c)) + (x * s));
+    rotation[8] = (float)((x * z * (1.0 - c)) + (y * s));
+    rotation[9] = (float)((y * z * (1.0 - c)) - (x * s));
+    rotation[10] = (float)((z * z * (1.0 - c)) + c);
+    MultiplyMatrix(m, rotation);
+}
+
+// Equivalent of gluPerspective
+static void Perspective(float m[16], const double fieldOfView, const double aspect, const double zNear, const double zFar)
+{
+    const double f = 1.0 / std::tan(fieldOfView * 3.14159265358979323846 / 360.0);
+    float perspective[16] = {};
+    perspective[0] = (float)(f / aspect);
+    perspective[5] = (float)f;
+    perspective[10] = (float)((zFar + zNear) / (zNear - zFar));
+    perspective[11] = -1.0f;
+    perspective[14] = (float)((2.0 * zFar * zNear) / (zNear - zFar));
+    MultiplyMatrix(m, perspective);
+}
+
+// Equivalent of glOrtho
+static void Ortho(float m[16], const double left, const double right, const double bottom, const double top, const double zNear, const double zFar)
+{
+    float ortho[16];
+    LoadIdentity(ortho);
+    ortho[0] = (float)(2.0 / (right - left));
+    ortho[5] = (float)(2.0 / (top - bottom));
+    ortho[10] = (float)(-2.0 / (zFar - zNear));
+    ortho[12] = (float)(-(right + left) / (right - left));
+    ortho[13] = (float)(-(top + bottom) / (top - bottom));
+    ortho[14] = (float)(-(zFar + zNear) / (zFar - zNear));
+    MultiplyMatrix(m, ortho);
+}
+
+// Equivalent of gluLookAt
+static void LookAt(float m[16], const double eyeX, const double eyeY, const double eyeZ, const double centerX, const double centerY, const double centerZ, const double upX, const double upY, const double upZ)
+{
+    double forward[3] = { centerX - eyeX, centerY - eyeY, centerZ - eyeZ };
+    const double forwardLength = std::sqrt((forward[0] * forward[0]) + (forward[1] * forward[1]) + (forward[2] * forward[2]));
+    for (double& component : forward)
+    {
+        component /= forwardLength;
+    }
+    double side[3] = { (forward[1] * upZ) - (forward[2] * upY), (forward[2] * upX) - (forward[0] * upZ), (forward[0] * upY) - (forward[1] * upX) };
+    const double sideLength = std::sqrt((side[0] * side[0]) + (side[1] * side[1]) + (side[2] * side[2]));
+    for (double& component : side)
+    {
+        component /= sideLength;
+    }
+    const double up[3] = { (side[1] * forward[2]) - (side[2] * forward[1]), (side[2] * forward[0]) - (side[0] * forward[2]), (side[0] * forward[1]) - (side[1] * forward[0]) };
+
+    float lookAt[16];
+    LoadIdentity(lookAt);
+    for (uint8_t i = 0; i < 3; i++)
+    {
+        lookAt[i * 4] = (float)side[i];
+        lookAt[(i * 4) + 1] = (float)up[i];
+        lookAt[(i * 4) + 2] = (float)-forward[i];
+    }
+    MultiplyMatrix(m, lookAt);
+    Translate(m, (float)-eyeX, (float)-eyeY, (float)-eyeZ);
+}
+
+static void TransformPoint(const float m[16], const float x, const float y, const float z, float result[4])
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        result[i] = (m[i] * x) + (m[4 + i] * y) + (m[8 + i] * z) + m[12 + i];
+    }
+}
+
+// Constructor
+RendererSoftware::RendererSoftware(const uint32_t numberOfThreads) :
+    m_windowWidth(800u),
+    m_windowHeight(600u),
+    m_linearFilter(true),
+    m_graphicsApiVersion(""),
+    m_graphicsAdapterVendor(""),
+    m_graphicsAdapterModel(""),
+    m_textures(),
+    m_freeTextureIds(),
+    m_rasterizer(numberOfThreads),
+    m_windowSurface(),
+    m_offscreenSurface(),
+    m_drawState(),
+    m_projection(),
+    m_modelView(),
+    m_modelViewStack(),
+    m_lighting(false),
+    m_primitive(Quads),
+    m_vertices(),
+    m_framePixels(),
+    m_frameStatistics(),
+    m_renderStatistics()
+{
+    memset(&m_singleColorTexture, 0, sizeof(m_singleColorTexture[0]) * EgaRange);
+    LoadIdentity(m_projection.m);
+    LoadIdentity(m_modelView.m);
+    m_color[0] = m_color[1] = m_color[2] = m_color[3] = 1.0f;
+    m_lightPosition[0] = m_lightPosition[1] = m_lightPosition[2] = 0.0f;
+    m_texCoord[0] = m_texCoord[1] = 0.0f;
+
+    m_drawState.boundTexture = nullptr;
+    m_drawState.linearFilter = m_linearFilter;
+    m_drawState.depthTest = false;
+    m_drawState.depthWrite = true;
+    m_drawState.blend = false;
+    m_drawState.cullFrontFaces = false;
+    m_drawState.revealTimes = nullptr;
+    m_drawState.revealedTime = 0;
+
+    SoftwareRasterizer::ResizeSurface(m_windowSurface, m_windowWidth, m_windowHeight);
+    m_rasterizer.SetTarget(&m_windowSurface);
+    SetViewPort(0, 0, m_windowWidth, m_windowHeight);
+}
+
+void RendererSoftware::Setup()
+{
+    for (egaColor color = EgaBlack; color < EgaRange; color = egaColor(color + 1))
+    {
+        m_singleColorTexture[color] = GenerateSingleColorTexture(color);
+    }
+
+    m_graphicsApiVersion = "Software rasterizer";
+    m_graphicsAdapterVendor = "CatacombGL";
+    m_graphicsAdapterModel = "CPU with " + std::to_string(m_rasterizer.GetNumberOfThreads()) + " rendering threads";
+    Logging::Instance().AddLogMessage("Rasterizing on the CPU with " + std::to_string(m_rasterizer.GetNumberOfThreads()) + " threads");
+}
+
+void RendererSoftware::SetWindowDimensions(const uint16_t windowWidth, const uint16_t windowHeight)
+{
+    m_windowWidth = windowWidth;
+    m_windowHeight = windowHeight;
+
+    m_rasterizer.Flush();
+    SoftwareRasterizer::ResizeSurface(m_windowSurface, m_windowWidth, m_windowHeight);
+}
+
+void RendererSoftware::SetFrameSettings(const FrameSettings& frameSettings)
+{
+    // VSync and palettized textures do not apply to the CPU
+    m_linearFilter = (frameSettings.textureFilter == Linear);
+    m_drawState.linearFilter = m_linearFilter;
+
+    m_rasterizer.SetTarget(&m_windowSurface);
+    m_rasterizer.Clear(ClearColor, 1.0f);
+}
+
+unsigned int RendererSoftware::GenerateTextureId() const
+{
+    // The slots of deleted textures are used again, such that textures that are unloaded and loaded again over and
+    // over do not keep growing the list.
+    if (!m_freeTextureIds.empty())
+    {
+        const unsigned int textureId = m_freeTextureIds.back();
+        m_freeTextureIds.pop_back();
+        return textureId;
+    }
+
+    m_textures.push_back(std::make_unique<SoftwareRasterizer::texture>());
+    return (unsigned int)m_textures.size();
+}
+
+void RendererSoftware::StoreTexture(const unsigned int textureId, const uint32_t width, const uint32_t height, std::vector<uint32_t>& pixels) const
+{
+    if (textureId == 0)
+    {
+        Logging::Instance().FatalError("Error loading pixel data into texture (id=0;width=" + std::to_string(width) + ";height=" + std::to_string(height) + ")");
+    }
+
+    // Triangles that are still pending may refer to the previous contents of the texture
+    m_rasterizer.Flush();
+
+    while (m_textures.size() < textureId)
+    {
+        m_textures.push_back(std::make_unique<SoftwareRasterizer::texture>());
+    }
+
+    SoftwareRasterizer::texture& texture = *m_textures.at(textureId - 1);
+    texture.width = width;
+    texture.height = height;
+    texture.pixels.swap(pixels);
+    texture.isSingleColor = !texture.pixels.empty() &&
+        std::all_of(texture.pixels.begin(), texture.pixels.end(), [&texture](const uint32_t pixel) { return pixel == texture.pixels[0]; });
+}
+
+void RendererSoftware::LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const
+{
+    std::vector<uint32_t> pixels((size_t)width * height);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        const uint8_t* pixel = &pixelData[i * 4];
+        pixels[i] = (uint32_t)pixel[0] | ((uint32_t)pixel[1] << 8) | ((uint32_t)pixel[2] << 16) | ((uint32_t)pixel[3] << 24);
+    }
+    StoreTexture(textureId, width, height, pixels);
+}
+
+void RendererSoftware::LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const
+{
+    // The colors are looked up once, as sampling the expanded texture gives the same result
+    std::vector<uint32_t> pixels((size_t)width * height);
+    for (size_t i = 0; i < pixels.size(); i++)
+    {
+        const uint8_t index = indexedPixelData[i];
+        const bool transparent = (index >= EgaRange);
+        const rgbColor color = EgaToRgb(transparent ? EgaBlack : (egaColor)index);
+        pixels[i] = (uint32_t)color.red | ((uint32_t)color.green << 8) | ((uint32_t)color.blue << 16) | (transparent ? 0u : 0xFF000000u);
+    }
+    StoreTexture(textureId, width, height, pixels);
+}
+
+void RendererSoftware::DeleteTexture(const unsigned int textureId) const
+{
+    if (textureId == 0 || textureId > m_textures.size())
+    {
+        return;
+    }
+
+    if (std::find(m_freeTextureIds.begin(), m_freeTextureIds.end(), textureId) != m_freeTextureIds.end())
+    {
+        return;
+    }
+
+    // Triangles that are still pending may refer to the texture. The texture object itself stays, as its id is its
+    // position in the list of textures; the id is handed out again by GenerateTextureId.
+    m_rasterizer.Flush();
+    SoftwareRasterizer::texture& texture = *m_textures.at(textureId - 1);
+    texture.width = 0;
+    texture.height = 0;
+    std::vector<uint32_t>().swap(texture.pixels);
+    texture.isSingleColor = false;
+    m_freeTextureIds.push_back(textureId);
+}
+
+void RendererSoftware::BindTexture(unsigned int textureId)
+{
+    BindTexture((textureId > 0 && textureId <= m_textures.size()) ? m_textures.at(textureId - 1).get() : nullptr);
+}
+
+void RendererSoftware::BindTexture(const SoftwareRasterizer::texture* texture)
+{
+    if (texture != m_drawState.boundTexture)
+    {
+        m_drawState.boundTexture = texture;
+        m_frameStatistics.textureBinds++;
+    }
+}
+
+unsigned int RendererSoftware::GenerateSingleColorTexture(const egaColor color) const
+{
+    const rgbColor outputColor = EgaToRgb(color);
+    std::vector<uint32_t> pixels(8 * 8, (uint32_t)outputColor.red | ((uint32_t)outputColor.green << 8) | ((uint32_t)outputColor.blue << 16) | 0xFF000000u);
+
+    const unsigned int textureId = GenerateTextureId();
+    StoreTexture(textureId, 8, 8, pixels);
+
+    return textureId;
+}
+
+void RendererSoftware::SetViewPort(const int32_t left, const int32_t bottom, const int32_t width, const int32_t height)
+{
+    m_drawState.viewPortLeft = left;
+    m_drawState.viewPortBottom = bottom;
+    m_drawState.viewPortWidth = width;
+    m_drawState.viewPortHeight = height;
+}
+
+void RendererSoftware::SetColor(const float red, const float green, const float blue)
+{
+    m_color[0] = red;
+    m_color[1] = green;
+    m_color[2] = blue;
+    m_color[3] = 1.0f;
+}
+
+void RendererSoftware::PushMatrix()
+{
+    m_modelViewStack.push_back(m_modelView);
+}
+
+void RendererSoftware::PopMatrix()
+{
+    if (!m_modelViewStack.empty())
+    {
+        m_modelView = m_modelViewStack.back();
+        m_modelViewStack.pop_back();
+    }
+}
+
+void RendererSoftware::Begin(const primitiveType primitive)
+{
+    m_primitive = primitive;
+    m_vertices.clear();
+}
+
+void RendererSoftware::TexCoord(const float s, const float t)
+{
+    m_texCoord[0] = s;
+    m_texCoord[1] = t;
+}
+
+void RendererSoftware::Vertex(const float x, const float y, const float z)
+{
+    float eye[4];
+    TransformPoint(m_modelView.m, x, y, z, eye);
+    float clip[4];
+    TransformPoint(m_projection.m, eye[0], eye[1], eye[2], clip);
+
+    clipVertex vertex;
+    vertex.x = clip[0];
+    vertex.y = clip[1];
+    vertex.z = clip[2];
+    vertex.w = clip[3];
+    vertex.s = m_texCoord[0];
+    vertex.t = m_texCoord[1];
+    // The fizzle fade looks up the reveal times by the coordinates of the screen capture quad
+    vertex.screenX = x;
+    vertex.screenY = y;
+
+    if (m_lighting)
+    {
+        // Same as the fixed function lighting with the default material, the light set up in ApplyDepthShading
+        // and a normal of (0, 0, -1), which the model view matrices of the 3D view do not change.
+        const float lightX = m_lightPosition[0] - eye[0];
+        const float lightY = m_lightPosition[1] - eye[1];
+        const float lightZ = m_lightPosition[2] - eye[2];
+        const float lightLength = std::sqrt((lightX * lightX) + (lightY * lightY) + (lightZ * lightZ));
+        const float diffuse = (lightLength > 0.0f) ? std::max(-lightZ / lightLength, 0.0f) : 0.0f;
+        const float intensity = std::min(0.04f + 0.2f + (0.8f * diffuse), 1.0f);
+        vertex.color[0] = intensity;
+        vertex.color[1] = intensity;
+        vertex.color[2] = intensity;
+        vertex.color[3] = 1.0f;
+    }
+    else
+    {
+        std::memcpy(vertex.color, m_color, sizeof(m_color));
+    }
+
+    m_vertices.push_back(vertex);
+}
+
+void RendererSoftware::End()
+{
+    m_rasterizer.SetState(m_drawState);
+
+    if (m_primitive == Quads)
+    {
+        for (size_t i = 0; i + 3 < m_vertices.size(); i += 4)
+        {
+            DrawTriangle(m_vertices[i], m_vertices[i + 1], m_vertices[i + 2]);
+            DrawTriangle(m_vertices[i], m_vertices[i + 2], m_vertices[i + 3]);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i + 2 < m_vertices.size(); i += 3)
+        {
+            DrawTriangle(m_vertices[i], m_vertices[i + 1], m_vertices[i + 2]);
+        }
+    }
+    m_vertices.clear();
+}
+
+static float DistanceToClipPlane(const float* v, const uint8_t plane)
+{
+    // v points at the x, y, z and w of a clip vertex
+    const float coordinate = v[plane / 2];
+    return (plane % 2 == 0) ? v[3] + coordinate : v[3] - coordinate;
+}
+
+void RendererSoftware::DrawTriangle(const clipVertex& v0, const clipVertex& v1, const clipVertex& v2)
+{
+    // Clip the triangle against the view volume. Most triangles are entirely inside.
+    const uint8_t maxVertices = 3 + 6;
+    clipVertex polygon[maxVertices] = { v0, v1, v2 };
+    uint8_t numberOfVertices = 3;
+    for (uint8_t plane = 0; plane < 6 && numberOfVertices >= 3; plane++)
+    {
+        float distances[maxVertices];
+        bool allInside = true;
+        for (uint8_t i = 0; i < numberOfVertices; i++)
+        {
+            distances[i] = DistanceToClipPlane(&polygon[i].x, plane);
+            allInside = allInside && (distances[i] >= 0.0f);
+        }
+        if (allInside)
+        {
+            continue;
+        }
+
+        clipVertex clipped[maxVertices];
+        uint8_t numberOfClippedVertices = 0;
+        for (uint8_t i = 0; i < numberOfVertices; i++)
+        {
+            const uint8_t next = (i + 1) % numberOfVertices;
+            if (distances[i] >= 0.0f)
+            {
+                clipped[numberOfClippedVertices++] = polygon[i];
+            }
+            if ((distances[i] >= 0.0f) != (distances[next] >= 0.0f) && numberOfClippedVertices < maxVertices)
+            {
+                const float fraction = distances[i] / (distances[i] - distances[next]);
+                const float* from = &polygon[i].x;
+                const float* to = &polygon[next].x;
+                float* result = &clipped[numberOfClippedVertices++].x;
+                for (size_t component = 0; component < sizeof(clipVertex) / sizeof(float); component++)
+                {
+                    result[component] = from[component] + ((to[component] - from[component]) * fraction);
+                }
+            }
+        }
+        std::copy(clipped, clipped + numberOfClippedVertices, polygon);
+        numberOfVertices = numberOfClippedVertices;
+    }
+
+    if (numberOfVertices < 3)
+    {
+        return;
+    }
+
+    // Viewport transformation
+    SoftwareRasterizer::vertex windowVertices[maxVertices];
+    for (uint8_t i = 0; i < numberOfVertices; i++)
+    {
+        const clipVertex& source = polygon[i];
+        SoftwareRasterizer::vertex& destination = windowVertices[i];
+        const float oneOverW = 1.0f / source.w;
+        destination.x = (float)m_drawState.viewPortLeft + ((source.x * oneOverW) + 1.0f) * 0.5f * (float)m_drawState.viewPortWidth;
+        destination.y = (float)m_drawState.viewPortBottom + ((source.y * oneOverW) + 1.0f) * 0.5f * (float)m_drawState.viewPortHeight;
+        destination.z = ((source.z * oneOverW) + 1.0f) * 0.5f;
+        destination.oneOverW = oneOverW;
+        destination.s = source.s;
+        destination.t = source.t;
+        destination.red = source.color[0];
+        destination.green = source.color[1];
+        destination.blue = source.color[2];
+        destination.alpha = source.color[3];
+        destination.screenX = source.screenX;
+        destination.screenY = source.screenY;
+    }
+
+    for (uint8_t i = 1; i + 1 < numberOfVertices; i++)
+    {
+        m_rasterizer.AddTriangle(windowVertices[0], windowVertices[i], windowVertices[i + 1]);
+    }
+}
+
+void RendererSoftware::RenderText(const RenderableText& renderableText)
+{
+    PROFILE_SCOPE("RenderText");
+    const std::vector<RenderableText::renderableCharacter>& characters = renderableText.GetText();
+    const Font& font = renderableText.GetFont();
+    if (characters.empty())
+    {
+        // Nothing to render
+        return;
+    }
+
+    // Select the texture from the picture
+    const TextureAtlas* const textureAtlas = font.GetTextureAtlas();
+    BindTexture(textureAtlas->GetTextureId());
+
+    egaColor previousColor = EgaBlack;
+
+    // Draw the texture as a quad
+    Begin(Quads);
+
+    for (uint16_t chari = 0; chari < characters.size(); chari++)
+    {
+        const RenderableText::renderableCharacter& character = characters.at(chari);
+        const egaColor currentColor = character.color;
+        if (chari == 0 || currentColor != previousColor)
+        {
+            const rgbColor colorInRGB = EgaToRgb(currentColor);
+            SetColor((float)(colorInRGB.red) / 256.0f, (float)(colorInRGB.green) / 256.0f, (float)(colorInRGB.blue) / 256.0f);
+            previousColor = currentColor;
+        }
+
+        const uint8_t charIndex = (uint8_t)character.imageIndex;
+        const int16_t offsetX = character.offsetX;
+        const int16_t offsetY = character.offsetY;
+        const uint16_t charWidth = font.GetCharacterWidth(charIndex);
+        const uint16_t charHeight = textureAtlas->GetImageHeight();
+        const float textureHeight = textureAtlas->GetImageRelativeHeight();
+        const float textureWidth = textureAtlas->GetImageRelativeWidth() * ((float)charWidth / (float)textureAtlas->GetImageWidth());
+        const float textureOffsetX = textureAtlas->GetImageRelativeOffsetX(charIndex);
+        const float textureOffsetY = textureAtlas->GetImageRelativeOffsetY(charIndex);
+
+        TexCoord(textureOffsetX, textureOffsetY + textureHeight); Vertex(offsetX, (float)(offsetY + charHeight), 0.0f);
+        TexCoord(textureOffsetX + textureWidth, textureOffsetY + textureHeight); Vertex((float)(offsetX + charWidth), (float)(offsetY + charHeight), 0.0f);
+        TexCoord(textureOffsetX + textureWidth, textureOffsetY); Vertex((float)(offsetX + charWidth), offsetY, 0.0f);
+        TexCoord(textureOffsetX, textureOffsetY); Vertex(offsetX, offsetY, 0.0f);
+    }
+    End();
+    AddDrawBatch((uint32_t)characters.size() * 4);
+
+    SetColor(1.0f, 1.0f, 1.0f);
+}
+
+void RendererSoftware::Prepare2DRendering(const bool helpWindow)
+{
+    // Set the viewport to the entire window
+    SetViewPort(0, 0, m_windowWidth, m_windowHeight);
+
+    // Make sure no color is set
+    SetColor(1.0f, 1.0f, 1.0f);
+
+    // Make sure the depth test is disabled
+    m_drawState.depthTest = false;
+
+    m_drawState.blend = true;
+
+    // Create a 2D orthographic projection matrix, such that it imitates the 320x200 EGA pixel matrix.
+    LoadIdentity(m_projection.m);
+
+    ViewPorts::ViewPortRect2D rect = ViewPorts::GetOrtho2D(m_windowWidth, m_windowHeight, helpWindow);
+
+    Ortho(m_projection.m, rect.left, rect.right, rect.bottom, rect.top, -1.0, 1.0);
+
+    m_lighting = false;
+}
+
+void RendererSoftware::Unprepare2DRendering()
+{
+    m_drawState.blend = false;
+}
+
+void RendererSoftware::Render2DPicture(const Picture* picture, const int16_t offsetX, const int16_t offsetY)
+{
+    PROFILE_SCOPE("Render2DPicture");
+    if (picture == nullptr)
+    {
+        // Nothing to render
+        return;
+    }
+
+    // Select the texture from the picture
+    BindTexture(picture->GetTextureId());
+
+    // Draw the texture as a quad
+    const int32_t width = (uint16_t)picture->GetImageWidth();
+    const int32_t height = (uint16_t)picture->GetImageHeight();
+    const float left = picture->GetImageRelativeOffsetX();
+    const float top = picture->GetImageRelativeOffsetY();
+    const float right = left + picture->GetImageRelativeWidth();
+    const float bottom = top + picture->GetImageRelativeHeight();
+    Begin(Quads);
+    TexCoord(left, bottom); Vertex(offsetX, (float)(offsetY + height), 0.0f);
+    TexCoord(right, bottom); Vertex((float)(offsetX + width), (float)(offsetY + height), 0.0f);
+    TexCoord(right, top); Vertex((float)(offsetX + width), offsetY, 0.0f);
+    TexCoord(left, top); Vertex(offsetX, offsetY, 0.0f);
+    End();
+    AddDrawBatch(4);
+}
+
+void RendererSoftware::Render2DPictureSegment(const Picture* picture, const int16_t offsetX, const int16_t offsetY, const uint16_t segmentOffsetX, const uint16_t segmentOffsetY, const uint16_t segmentWidth, const uint16_t segmentHeight)
+{
+    PROFILE_SCOPE("Render2DPictureSegment");
+    if (picture == nullptr)
+    {
+        // Nothing to render
+        return;
+    }
+
+    // Select the texture from the picture
+    BindTexture(picture->GetTextureId());
+
+    // Draw the texture as a quad
+    const float textureWidth = (float)picture->GetTextureWidth();
+    const float textureHeight = (float)picture->GetTextureHeight();
+    const float left = (float)(picture->GetImageOffsetX() + segmentOffsetX) / textureWidth;
+    const float top = (float)(picture->GetImageOffsetY() + segmentOffsetY) / textureHeight;
+    const float right = left + (segmentWidth / textureWidth);
+    const float bottom = top + (segmentHeight / textureHeight);
+    Begin(Quads);
+    TexCoord(left, bottom); Vertex(offsetX, (float)(offsetY + segmentHeight), 0.0f);
+    TexCoord(right, bottom); Vertex((float)(offsetX + segmentWidth), (float)(offsetY + segmentHeight), 0.0f);
+    TexCoord(right, top); Vertex((float)(offsetX + segmentWidth), offsetY, 0.0f);
+    TexCoord(left, top); Vertex(offsetX, offsetY, 0.0f);
+    End();
+    AddDrawBatch(4);
+}
+
+void RendererSoftware::Render2DBar(const int16_t x, const int16_t y, const uint16_t width, const uint16_t height, const egaColor colorIndex)
+{
+    BindTexture(m_singleColorTexture[colorIndex]);
+
+    Begin(Quads);
+    TexCoord(0.0f, 1.0f); Vertex(x, (float)(y + height), 0.0f);
+    TexCoord(1.0f, 1.0f); Vertex((float)(x + width), (float)(y + height), 0.0f);
+    TexCoord(1.0f, 0.0f); Vertex((float)(x + width), y, 0.0f);
+    TexCoord(0.0f, 0.0f); Vertex(x, y, 0.0f);
+    End();
+    AddDrawBatch(4);
+}
+
+void RendererSoftware::RenderTiles(const RenderableTiles& renderableTiles)
+{
+    PROFILE_SCOPE("RenderTiles");
+    const TextureAtlas& textureAtlas = renderableTiles.GetTextureAtlas();
+    const std::vector<RenderableTiles::RenderableTile>& tiles = renderableTiles.GetTiles();
+
+    if (tiles.empty())
+    {
+        return;
+    }
+
+    const int16_t imageWidth = (int16_t)textureAtlas.GetImageWidth();
+    const int16_t imageHeight = (int16_t)textureAtlas.GetImageWidth();
+    const float imageRelWidth = textureAtlas.GetImageRelativeWidth();
+    const float imageRelHeight = textureAtlas.GetImageRelativeHeight();
+
+    BindTexture(textureAtlas.GetTextureId());
+
+    Begin(Quads);
+    for (const RenderableTiles::RenderableTile& tile : tiles)
+    {
+        const int16_t offsetX = tile.offsetX;
+        const int16_t offsetY = tile.offsetY;
+        const float imageRelOffsetX = textureAtlas.GetImageRelativeOffsetX(tile.imageIndex);
+        const float imageRelOffsetY = textureAtlas.GetImageRelativeOffsetY(tile.imageIndex);
+
+        TexCoord(imageRelOffsetX + imageRelWidth, imageRelOffsetY + imageRelHeight);
+        Vertex((float)(offsetX + imageWidth), (float)(offsetY + imageHeight), 0.0f);
+        TexCoord(imageRelOffsetX, imageRelOffsetY + imageRelHeight);
+        Vertex(offsetX, (float)(offsetY + imageHeight), 0.0f);
+        TexCoord(imageRelOffsetX, imageRelOffsetY);
+        Vertex(offsetX, offsetY, 0.0f);
+        TexCoord(imageRelOffsetX + imageRelWidth, imageRelOffsetY);
+        Vertex((float)(offsetX + imageWidth), offsetY, 0.0f);
+    }
+    End();
+    AddDrawBatch((uint32_t)tiles.size() * 4);
+}
+
+void RendererSoftware::ApplyDepthShading(const Renderable3DScene& renderable3DScene)
+{
+    if (renderable3DScene.GetDepthShading())
+    {
+        // The light is positioned while the model view matrix is the identity
+        m_lighting = true;
+        m_lightPosition[0] = renderable3DScene.GetOriginX();
+        m_lightPosition[1] = renderable3DScene.GetOriginY();
+        m_lightPosition[2] = -PlayerZ;
+    }
+}
+
+void RendererSoftware::Prepare3DRendering(const int32_t left, const int32_t bottom, const int32_t width, const int32_t height, const double aspect, const Renderable3DScene& renderable3DScene)
+{
+    SetViewPort(left, bottom, width, height);
+
+    m_drawState.depthTest = true;
+
+    LoadIdentity(m_projection.m);
+    Perspective(m_projection.m, (double)renderable3DScene.GetFieldOfView(), aspect, 0.2, 100.0);
+    Rotate(m_projection.m, 90.0f, 1.0f, 0.0f, 0.0f);
+    Rotate(m_projection.m, renderable3DScene.GetAngle(), 0.0f, 0.0f, -1.0f);
+    Translate(m_projection.m, -renderable3DScene.GetOriginX(), -renderable3DScene.GetOriginY(), -PlayerZ);
+
+    LoadIdentity(m_modelView.m);
+
+    ApplyDepthShading(renderable3DScene);
+
+    Render3DTiles(renderable3DScene.Get3DTiles());
+    Render3DWalls(renderable3DScene.GetWalls());
+    RenderSprites(renderable3DScene.GetSprites());
+}
+
+void RendererSoftware::Render3DScene(const Renderable3DScene& renderable3DScene)
+{
+    PROFILE_SCOPE("Render3DScene");
+    if (renderable3DScene.GetOriginalScreenResolution())
+    {
+        const ViewPorts::ViewPortRect3D rect3D = renderable3DScene.GetOriginal3DViewArea();
+        const uint16_t additionalMargin = GetAdditionalMarginDueToWideScreen(renderable3DScene.GetAspectRatio());
+        const uint16_t bufferWidth = rect3D.width + (additionalMargin * 2);
+
+        // The pending triangles may still sample the 3D view of the previous frame
+        m_rasterizer.SetTarget(&m_offscreenSurface);
+        if (m_offscreenSurface.color.width != bufferWidth || m_offscreenSurface.color.height != rect3D.height)
+        {
+            SoftwareRasterizer::ResizeSurface(m_offscreenSurface, bufferWidth, rect3D.height);
+        }
+        m_rasterizer.Clear(ClearColor, 1.0f);
+
+        // Calculate The Aspect Ratio Of The Window
+        const double aspect = (double)bufferWidth / ((double)rect3D.height * 1.2);
+        Prepare3DRendering(0, 0, bufferWidth, rect3D.height, aspect, renderable3DScene);
+
+        m_rasterizer.SetTarget(&m_windowSurface);
+
+        Prepare2DRendering(false);
+
+        // Select the texture from the picture
+        BindTexture(&m_offscreenSurface.color);
+
+        // Draw the texture as a quad
+        const int32_t width = bufferWidth;
+        const int32_t height = rect3D.height;
+        const int32_t offsetX = rect3D.left - (int32_t)additionalMargin;
+        const int32_t offsetY = rect3D.bottom - rect3D.height;
+        Begin(Quads);
+        TexCoord(0.0f, 1.0f); Vertex((float)offsetX, (float)offsetY, 0.0f);
+        TexCoord(1.0f, 1.0f); Vertex((float)(offsetX + width), (float)offsetY, 0.0f);
+        TexCoord(1.0f, 0.0f); Vertex((float)(offsetX + width), (float)(offsetY + height), 0.0f);
+        TexCoord(0.0f, 0.0f); Vertex((float)offsetX, (float)(offsetY + height), 0.0f);
+        End();
+        AddDrawBatch(4);
+    }
+    else
+    {
+        const ViewPorts::ViewPortRect3D rect = ViewPorts::Get3D(m_windowWidth, m_windowHeight, renderable3DScene.GetAspectRatio(), renderable3DScene.GetOriginal3DViewArea());
+
+        // Calculate The Aspect Ratio Of The Window
+        const double aspect = (double)rect.width / (double)rect.height;
+        Prepare3DRendering(rect.left, rect.bottom, rect.width, rect.height, aspect, renderable3DScene);
+    }
+}
+
+uint16_t RendererSoftware::GetAdditionalMarginDueToWideScreen(const float aspectRatio)
+{
+    ViewPorts::ViewPortRect2D rect = ViewPorts::GetOrtho2D(m_windowWidth, m_windowHeight, false);
+    if (aspectRatio < (4.0f / 3.0f) + 0.0001f)
+    {
+        // Original aspect ratio
+        return 0;
+    }
+    else
+    {
+        const double marginIncludingOverscanBorder = (rect.right - rect.left - 320.0f) / 2;
+        const double overscanBorderWidth = (double)(OverscanBorder::GetBorderWidth());
+        const double marginExcludingOverscanBorder = marginIncludingOverscanBorder - overscanBorderWidth;
+        return (marginExcludingOverscanBorder > 0.0) ? (uint16_t)(marginExcludingOverscanBorder + 0.5) : 0;
+    }
+}
+
+void RendererSoftware::Render3DWalls(const Renderable3DWalls& walls)
+{
+    PROFILE_SCOPE("Render3DWalls");
+    m_drawState.cullFrontFaces = true;
+    const std::map<unsigned int, std::vector<Renderable3DWalls::texturedWall>>& textureToWallsMap = walls.GetTextureToWallsMap();
+    for (const std::pair<const unsigned int, std::vector<Renderable3DWalls::texturedWall>>& textureToWalls : textureToWallsMap)
+    {
+        const unsigned int textureId = textureToWalls.first;
+        // Select the texture from the picture
+        BindTexture(textureId);
+
+        // Draw the texture as a quad
+        Begin(Quads);
+        for (const Renderable3DWalls::texturedWall& wall : textureToWalls.second)
+        {
+            const Renderable3DWalls::wallCoordinate& coordinate = wall.coordinate;
+            const float left = wall.picture->GetImageRelativeOffsetX();
+            const float top = wall.picture->GetImageRelativeOffsetY();
+            const float right = left + wall.picture->GetImageRelativeWidth();
+            const float bottom = top + wall.picture->GetImageRelativeHeight();
+            TexCoord(right, bottom); Vertex((float)coordinate.x1, (float)coordinate.y1, FloorZ);
+            TexCoord(left, bottom); Vertex((float)coordinate.x2, (float)coordinate.y2, FloorZ);
+            TexCoord(left, top); Vertex((float)coordinate.x2, (float)coordinate.y2, CeilingZ);
+            TexCoord(right, top); Vertex((float)coordinate.x1, (float)coordinate.y1, CeilingZ);
+        }
+        End();
+        AddDrawBatch((uint32_t)textureToWalls.second.size() * 4);
+    }
+
+    m_drawState.cullFrontFaces = false;
+}
+
+void RendererSoftware::RenderSprites(const RenderableSprites& renderableSprites)
+{
+    PROFILE_SCOPE("RenderSprites");
+    const std::vector<RenderableSprites::RenderableSprite>& sprites = renderableSprites.GetSprites();
+    if (sprites.empty())
+    {
+        // Nothing to render
+        return;
+    }
+
+    m_drawState.blend = true;
+    m_drawState.depthWrite = false;
+    PushMatrix();
+
+    for (const RenderableSprites::RenderableSprite& sprite : sprites)
+    {
+        const Picture* picture = sprite.picture;
+        const RenderableSprites::SpriteOrientation orientation = sprite.orientation;
+        LoadIdentity(m_modelView.m);
+
+        Translate(m_modelView.m, sprite.offsetX, sprite.offsetY, 0.0f);
+        const float angle =
+            (orientation == RenderableSprites::RotatedTowardsPlayer) ? renderableSprites.GetAngle() :
+            (orientation == RenderableSprites::Isometric) ? 135.0f :
+            (orientation == RenderableSprites::AlongYAxis) ? 90.0f :
+            0.0f;
+
+        Rotate(m_modelView.m, angle, 0.0f, 0.0f, 1.0f);
+
+        const float halfWidth = (float)(picture->GetImageWidth()) / 128.0f;
+        const float topZ = CeilingZ + ((float)(picture->GetImageHeight()) / 64.0f) * (FloorZ - CeilingZ);
+
+        // Select the texture from the picture
+        BindTexture(picture->GetTextureId());
+
+        // Sprites that face the player are a bit sunken into the floor
+        const float zOffset = (orientation == RenderableSprites::RotatedTowardsPlayer) ? 0.0625f : 0.0f;
+
+        // Draw the texture as a quad
+        const float left = picture->GetImageRelativeOffsetX();
+        const float top = picture->GetImageRelativeOffsetY();
+        const float right = left + picture->GetImageRelativeWidth();
+        const float bottom = top + picture->GetImageRelativeHeight();
+        Begin(Quads);
+        TexCoord(left, top); Vertex(-halfWidth, 0.0f, CeilingZ + zOffset);
+        TexCoord(right, top); Vertex(halfWidth, 0.0f, CeilingZ + zOffset);
+        TexCoord(right, bottom); Vertex(halfWidth, 0.0f, topZ + zOffset);
+        TexCoord(left, bottom); Vertex(-halfWidth, 0.0f, topZ + zOffset);
+        End();
+        AddDrawBatch(4);
+    }
+
+    PopMatrix();
+    m_drawState.depthWrite = true;
+    m_drawState.blend = false;
+}
+
+void RendererSoftware::Render3DTiles(const Renderable3DTiles& tiles)
+{
+    PROFILE_SCOPE("Render3DTiles");
+    // Do not write into the depth buffer. This allows sprites to appear a bit sunken into the floor.
+    m_drawState.depthWrite = false;
+
+    // The tiles have a single color texture, such that the rasterizer only interpolates the depth shading
+    BindTexture(m_singleColorTexture[tiles.GetFloorColor()]);
+
+    const std::vector<Renderable3DTiles::tileCoordinate>& tileCoordinates = tiles.GetTileCoordinates();
+
+    Begin(Quads);
+    for (const Renderable3DTiles::tileCoordinate& tile : tileCoordinates)
+    {
+        const float tileX = (float)tile.x;
+        const float tileY = (float)tile.y;
+        TexCoord(0.0f, 1.0f); Vertex(tileX + 1.0f, tileY, FloorZ);        // Bottom Left
+        TexCoord(1.0f, 1.0f); Vertex(tileX + 1.0f, tileY + 1.0f, FloorZ); // Bottom Right
+        TexCoord(1.0f, 0.0f); Vertex(tileX, tileY + 1.0f, FloorZ);        // Top Right
+        TexCoord(0.0f, 0.0f); Vertex(tileX, tileY, FloorZ);               // Top Left
+    }
+    End();
+    AddDrawBatch((uint32_t)tileCoordinates.size() * 4);
+
+    if (!tiles.IsOnlyFloor())
+    {
+        BindTexture(m_singleColorTexture[tiles.GetCeilingColor()]);
+
+        Begin(Quads);
+        for (const Renderable3DTiles::tileCoordinate& tile : tileCoordinates)
+        {
+            const float tileX = (float)tile.x;
+            const float tileY = (float)tile.y;
+            TexCoord(0.0f, 1.0f); Vertex(tileX + 1.0f, tileY, CeilingZ);        // Bottom Left
+            TexCoord(1.0f, 1.0f); Vertex(tileX + 1.0f, tileY + 1.0f, CeilingZ); // Bottom Right
+            TexCoord(1.0f, 0.0f); Vertex(tileX, tileY + 1.0f, CeilingZ);        // Top Right
+            TexCoord(0.0f, 0.0f); Vertex(tileX, tileY, CeilingZ);               // Top Left
+        }
+        End();
+        AddDrawBatch((uint32_t)tileCoordinates.size() * 4);
+    }
+
+    m_drawState.depthWrite = true;
+}
+
+void RendererSoftware::RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMapTopDown)
+{
+    PROFILE_SCOPE("RenderAutoMapTopDown");
+    const uint16_t wallsScaleFactor = autoMapTopDown.GetTileSize() / 16;
+    const uint16_t textScaleFactor = 2;
+    PrepareTopDownRendering(autoMapTopDown.GetAspectRatio(), autoMapTopDown.GetOriginal3DViewArea(), wallsScaleFactor);
+
+    const uint16_t tileSize = autoMapTopDown.GetTileSize();
+    RenderTopDownFloorTiles(autoMapTopDown.GetFloorTiles(), tileSize);
+    RenderTopDownFloorTiles(autoMapTopDown.GetBorderTiles(), tileSize);
+
+    // Draw walls and sprites
+    for (const auto& picturePair : autoMapTopDown.GetPictures())
+    {
+        // Select the texture from the picture
+        const Picture* picture = picturePair.first;
+        BindTexture(picture->GetTextureId());
+        const int32_t width = (uint16_t)picture->GetImageWidth();
+        const int32_t height = (uint16_t)picture->GetImageHeight();
+        const float left = picture->GetImageRelativeOffsetX();
+        const float top = picture->GetImageRelativeOffsetY();
+        const float right = left + picture->GetImageRelativeWidth();
+        const float bottom = top + picture->GetImageRelativeHeight();
+
+        // Draw the texture as quads
+        Begin(Quads);
+
+        for (const RenderableAutoMapTopDown::pictureCoordinate& coordinate : picturePair.second)
+        {
+            const int16_t offsetX = coordinate.x;
+            const int16_t offsetY = coordinate.y;
+            TexCoord(left, bottom); Vertex(offsetX, (float)(offsetY + height), 0.0f);
+            TexCoord(right, bottom); Vertex((float)(offsetX + width), (float)(offsetY + height), 0.0f);
+            TexCoord(right, top); Vertex((float)(offsetX + width), offsetY, 0.0f);
+            TexCoord(left, top); Vertex(offsetX, offsetY, 0.0f);
+        }
+        End();
+        AddDrawBatch((uint32_t)picturePair.second.size() * 4);
+    }
+    RenderTiles(autoMapTopDown.GetTilesSize16());
+    RenderTiles(autoMapTopDown.GetTilesSize16Masked());
+
+    const int16_t border = tileSize / 4;
+    const int16_t width = tileSize - (2 * border);
+    for (const auto& wallCapPair : autoMapTopDown.GetWallCaps())
+    {
+        BindTexture(m_singleColorTexture[wallCapPair.first]);
+        Begin(Quads);
+        for (const RenderableAutoMapTopDown::pictureCoordinate& coordinate : wallCapPair.second)
+        {
+            const int16_t x = coordinate.x;
+            const int16_t y = coordinate.y;
+            TexCoord(0.0f, 1.0f); Vertex(x, (float)(y + width), 0.0f);
+            TexCoord(1.0f, 1.0f); Vertex((float)(x + width), (float)(y + width), 0.0f);
+            TexCoord(1.0f, 0.0f); Vertex((float)(x + width), y, 0.0f);
+            TexCoord(0.0f, 0.0f); Vertex(x, y, 0.0f);
+        }
+        End();
+        AddDrawBatch((uint32_t)wallCapPair.second.size() * 4);
+    }
+
+    if (autoMapTopDown.GetTileSize() == 64)
+    {
+        const egaColor playerMarkerColor = GetAutomapPlayerMarkerColor(autoMapTopDown.GetFloorTiles().GetFloorColor());
+        BindTexture(m_singleColorTexture[playerMarkerColor]);
+
+        PushMatrix();
+
+        const float playerX = (autoMapTopDown.GetPlayerX() - autoMapTopDown.GetOriginX()) * 64.0f;
+        const float playerY = (autoMapTopDown.GetPlayerY() - autoMapTopDown.GetOriginY()) * 64.0f;
+
+        Translate(m_modelView.m, playerX, playerY, CeilingZ);
+        Rotate(m_modelView.m, autoMapTopDown.GetPlayerAngle(), 0.0f, 0.0f, 1.0f);
+
+        Begin(Quads);
+        TexCoord(0.0f, 1.0f); Vertex(6.4f, 25.6f, 0.0f);
+        TexCoord(1.0f, 1.0f); Vertex(-6.4f, 25.6f, 0.0f);
+        TexCoord(1.0f, 0.0f); Vertex(-6.4f, 0.0f, 0.0f);
+        TexCoord(0.0f, 0.0f); Vertex(6.4f, 0.0f, 0.0f);
+        End();
+        AddDrawBatch(4);
+        Begin(Triangles);
+        TexCoord(0.0f, 1.0f); Vertex(25.6f, 0.0f, 0.0f);
+        TexCoord(1.0f, 1.0f); Vertex(0.0f, -25.6f, 0.0f);
+        TexCoord(1.0f, 0.0f); Vertex(-25.6f, 0.0f, 0.0f);
+        End();
+        AddDrawBatch(3);
+
+        PopMatrix();
+
+        PrepareTopDownRendering(autoMapTopDown.GetAspectRatio(), autoMapTopDown.GetOriginal3DViewArea(), textScaleFactor);
+    }
+
+    RenderText(autoMapTopDown.GetText());
+}
+
+void RendererSoftware::RenderAutoMapIso(const RenderableAutoMapIso& autoMapIso)
+{
+    PROFILE_SCOPE("RenderAutoMapIso");
+    const float xScale = PrepareIsoRendering(
+        autoMapIso.GetAspectRatio(),
+        autoMapIso.GetOriginal3DViewArea(),
+        autoMapIso.GetOriginX(),
+        autoMapIso.GetOriginY());
+
+    Render3DTiles(autoMapIso.GetFloorTiles());
+
+    Render3DWalls(autoMapIso.GetWalls());
+
+    RenderIsoWallCaps(autoMapIso.GetWallCaps());
+
+    RenderSprites(autoMapIso.GetSprites());
+
+    const egaColor playerMarkerColor = GetAutomapPlayerMarkerColor(autoMapIso.GetFloorTiles().GetFloorColor());
+    BindTexture(m_singleColorTexture[playerMarkerColor]);
+
+    const float playerX = autoMapIso.GetPlayerX();
+    const float playerY = autoMapIso.GetPlayerY();
+
+    PushMatrix();
+
+    Translate(m_modelView.m, playerX, playerY, CeilingZ);
+    Rotate(m_modelView.m, autoMapIso.GetPlayerAngle(), 0.0f, 0.0f, 1.0f);
+
+    Begin(Quads);
+    TexCoord(0.0f, 1.0f); Vertex(0.1f, 0.4f, 0.0f);
+    TexCoord(1.0f, 1.0f); Vertex(-0.1f, 0.4f, 0.0f);
+    TexCoord(1.0f, 0.0f); Vertex(-0.1f, 0.0f, 0.0f);
+    TexCoord(0.0f, 0.0f); Vertex(0.1f, 0.0f, 0.0f);
+    End();
+    AddDrawBatch(4);
+    Begin(Triangles);
+    TexCoord(0.0f, 1.0f); Vertex(0.4f, 0.0f, 0.0f);
+    TexCoord(1.0f, 1.0f); Vertex(0.0f, -0.4f, 0.0f);
+    TexCoord(1.0f, 0.0f); Vertex(-0.4f, 0.0f, 0.0f);
+    End();
+    AddDrawBatch(3);
+
+    PopMatrix();
+
+    PrepareIsoRenderingText(
+        autoMapIso.GetOriginX(),
+        autoMapIso.GetOriginY(),
+        xScale);
+
+    RenderText(autoMapIso.GetText());
+}
+
+bool RendererSoftware::IsVSyncSupported()
+{
+    return false;
+}
+
+bool RendererSoftware::IsOriginalScreenResolutionSupported()
+{
+    return true;
+}
+
+bool RendererSoftware::IsScreenCaptureOnGpuSupported()
+{
+    return false;
+}
+
+float RendererSoftware::PrepareIsoRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const float originX, const float originY)
+{
+    ViewPorts::ViewPortRect3D rect = ViewPorts::Get3D(m_windowWidth, m_windowHeight, aspectRatio, original3DViewArea);
+
+    SetViewPort(rect.left, rect.bottom, rect.width, rect.height);
+
+    m_drawState.depthTest = true;
+
+    LoadIdentity(m_projection.m);
+
+    const double x = originX + 9.0;
+    const double y = originY + 9.0;
+    const double z = -1.0;
+    // use this length so that camera is 1 unit away from origin
+    const double dist = std::sqrt(1 / 3.0);
+    const float xScale = (float)rect.width / (float)rect.height * 6.0f;
+    Ortho(m_projection.m, -xScale, xScale, -4.0f, 4.0f, -20.0f, 20.0f);
+    LookAt(m_projection.m,
+        dist + x, dist + y, z - dist,  // position of camera
+        x, y, z,   // where camera is pointing at
+        0.0, 0.0, -1.0);  // which direction is up
+    LoadIdentity(m_modelView.m);
+
+    return xScale;
+}
+
+void RendererSoftware::PrepareIsoRenderingText(const float originX, const float originY, const float xScale)
+{
+    m_drawState.depthTest = false;
+
+    LoadIdentity(m_projection.m);
+
+    const double x = (originX + 9) * 32;
+    const double y = (originY + 9) * 32;
+    const double z = -1.0;
+    // use this length so that camera is 1 unit away from origin
+    const double dist = std::sqrt(1 / 3.0);
+    Ortho(m_projection.m, -xScale * 32.0f, xScale * 32.0f, -128.0f, 128.0f, -640.0f, 640.0f);
+    LookAt(m_projection.m,
+        dist + x, dist + y, z - dist,  // position of camera
+        x, y, z,   // where camera is pointing at
+        0.0, 0.0, -1.0);  // which direction is up
+    LoadIdentity(m_modelView.m);
+
+    m_drawState.blend = true;
+}
+
+void RendererSoftware::PrepareTopDownRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const uint16_t scale)
+{
+    const ViewPorts::ViewPortRect3D rect = ViewPorts::Get3D(m_windowWidth, m_windowHeight, aspectRatio, original3DViewArea);
+
+    SetViewPort(rect.left, rect.bottom, rect.width, rect.height);
+
+    // Make sure no color is set
+    SetColor(1.0f, 1.0f, 1.0f);
+
+    // Make sure the depth test is disabled
+    m_drawState.depthTest = false;
+
+    m_drawState.blend = true;
+
+    // Create a 2D orthographic projection matrix, such that it imitates the 320x200 EGA pixel matrix.
+    LoadIdentity(m_projection.m);
+
+    const ViewPorts::ViewPortRect2D rect2D = ViewPorts::GetOrtho2D(m_windowWidth, m_windowHeight, false);
+    const double additionalMargin = (rect.left == 0) ? rect2D.right - rect2D.left - 320.0 : 0.0;
+    const double orthoRight = ((double)(original3DViewArea.width) + additionalMargin) * (double)scale;
+    const double orthoBottom = (double)(original3DViewArea.bottom * scale);
+    Ortho(m_projection.m, 0.0, orthoRight, orthoBottom, 0.0, -1.0, 1.0);
+
+    m_lighting = false;
+}
+
+void RendererSoftware::RenderIsoWallCaps(const std::map <egaColor, std::vector<RenderableAutoMapIso::quadCoordinates>>& wallCaps)
+{
+    m_drawState.cullFrontFaces = true;
+
+    for (const std::pair<const egaColor, std::vector<RenderableAutoMapIso::quadCoordinates>>& wallCap : wallCaps)
+    {
+        // Select the texture from the picture
+        BindTexture(m_singleColorTexture[wallCap.first]);
+
+        // Draw the texture as a quad
+        Begin(Quads);
+        for (const RenderableAutoMapIso::quadCoordinates& coordinate : wallCap.second)
+        {
+            TexCoord(1.0f, 1.0f); Vertex((float)coordinate.x1, (float)coordinate.y1, CeilingZ);
+            TexCoord(0.0f, 1.0f); Vertex((float)coordinate.x2, (float)coordinate.y2, CeilingZ);
+            TexCoord(0.0f, 0.0f); Vertex((float)coordinate.x3, (float)coordinate.y3, CeilingZ);
+            TexCoord(1.0f, 0.0f); Vertex((float)coordinate.x4, (float)coordinate.y4, CeilingZ);
+        }
+        End();
+        AddDrawBatch((uint32_t)wallCap.second.size() * 4);
+    }
+
+    m_drawState.cullFrontFaces = false;
+}
+
+void RendererSoftware::RenderTopDownFloorTiles(const Renderable3DTiles& tiles, const uint16_t tileSize)
+{
+    // Select the texture from the picture
+    BindTexture(m_singleColorTexture[tiles.GetFloorColor()]);
+
+    Begin(Quads);
+    const std::vector<Renderable3DTiles::tileCoordinate>& floorTiles = tiles.GetTileCoordinates();
+    for (const Renderable3DTiles::tileCoordinate& floorTile : floorTiles)
+    {
+        // Draw the texture as a quad
+        TexCoord(0.0f, 1.0f); Vertex(floorTile.x, (float)(floorTile.y + tileSize), 0.0f);
+        TexCoord(1.0f, 1.0f); Vertex((float)(floorTile.x + tileSize), (float)(floorTile.y + tileSize), 0.0f);
+        TexCoord(1.0f, 0.0f); Vertex((float)(floorTile.x + tileSize), floorTile.y, 0.0f);
+        TexCoord(0.0f, 0.0f); Vertex(floorTile.x, floorTile.y, 0.0f);
+    }
+    End();
+    AddDrawBatch((uint32_t)floorTiles.size() * 4);
+}
+
+Picture* RendererSoftware::GetScreenCapture(const unsigned int textureId)
+{
+    const uint16_t textureWidth = Picture::GetNearestPowerOfTwo(m_windowWidth);
+    const uint16_t textureHeight = Picture::GetNearestPowerOfTwo(m_windowHeight);
+    const unsigned int newTextureId = (textureId == 0) ? GenerateTextureId() : textureId;
+
+    m_rasterizer.Flush();
+
+    // The rows in the texture are bottom to top, as in the window. As with a copy into an RGB texture, the
+    // captured pixels are opaque.
+    std::vector<uint32_t> pixels((size_t)textureWidth * textureHeight, 0);
+    const uint16_t width = std::min(textureWidth, m_windowWidth);
+    const uint16_t height = std::min(textureHeight, m_windowHeight);
+    for (uint16_t y = 0; y < height; y++)
+    {
+        const uint32_t* source = &m_windowSurface.color.pixels[(size_t)y * m_windowWidth];
+        uint32_t* destination = &pixels[(size_t)y * textureWidth];
+        for (uint16_t x = 0; x < width; x++)
+        {
+            destination[x] = source[x] | 0xFF000000u;
+        }
+    }
+    StoreTexture(newTextureId, textureWidth, textureHeight, pixels);
+
+    return new Picture(newTextureId, m_windowWidth, m_windowHeight, textureWidth, textureHeight);
+}
+
+void RendererSoftware::RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime)
+{
+    PROFILE_SCOPE("RenderScreenCapture");
+    if (screenCapture == nullptr)
+    {
+        return;
+    }
+
+    // The removed pixels are discarded while rasterizing, as the fizzle fade shader of RendererOpenGL does
+    m_drawState.revealTimes = revealTimes;
+    m_drawState.revealedTime = revealedTime;
+
+    // Select the texture from the picture
+    BindTexture(screenCapture->GetTextureId());
+
+    // Draw the texture as a quad
+    Begin(Quads);
+    ViewPorts::ViewPortRect2D rect = ViewPorts::GetOrtho2D(m_windowWidth, m_windowHeight, false);
+    const float relativeImageWidth = (float)screenCapture->GetImageWidth() / (float)screenCapture->GetTextureWidth();
+    const float relativeImageHeight = (float)screenCapture->GetImageHeight() / (float)screenCapture->GetTextureHeight();
+    TexCoord(0.0f, 0.0f); Vertex((float)rect.left, (float)rect.bottom, 0.0f);
+    TexCoord(relativeImageWidth, 0.0f); Vertex((float)rect.right, (float)rect.bottom, 0.0f);
+    TexCoord(relativeImageWidth, relativeImageHeight); Vertex((float)rect.right, (float)rect.top, 0.0f);
+    TexCoord(0.0f, relativeImageHeight); Vertex((float)rect.left, (float)rect.top, 0.0f);
+    End();
+    AddDrawBatch(4);
+
+    m_drawState.revealTimes = nullptr;
+    m_drawState.revealedTime = 0;
+}
+
+uint16_t RendererSoftware::GetWindowWidth() const
+{
+    return m_windowWidth;
+}
+
+uint16_t RendererSoftware::GetWindowHeight() const
+{
+    return m_windowHeight;
+}
+
+const std::string& RendererSoftware::GetGraphicsApiVersion() const
+{
+    return m_graphicsApiVersion;
+}
+
+const std::string& RendererSoftware::GetGraphicsAdapterVendor() const
+{
+    return m_graphicsAdapterVendor;
+}
+
+const std::string& RendererSoftware::GetGraphicsAdapterModel() const
+{
+    return m_graphicsAdapterModel;
+}
+
+void RendererSoftware::SetGpuTimingEnabled(const bool /*enabled*/)
+{
+    // There is no GPU to measure
+}
+
+void RendererSoftware::EndFrameStatistics()
+{
+    m_renderStatistics.gpuTimesAvailable = false;
+    m_renderStatistics.textureBinds = m_frameStatistics.textureBinds;
+    m_renderStatistics.drawBatches = m_frameStatistics.drawBatches;
+    m_renderStatistics.vertices = m_frameStatistics.vertices;
+    m_frameStatistics.textureBinds = 0;
+    m_frameStatistics.drawBatches = 0;
+    m_frameStatistics.vertices = 0;
+}
+
+const IRenderer::RenderStatistics& RendererSoftware::GetRenderStatistics() const
+{
+    return m_renderStatistics;
+}
+
+void RendererSoftware::ReadFrame(std::vector<uint8_t>& rgbaPixels)
+{
+    m_rasterizer.Flush();
+
+    rgbaPixels.resize((size_t)m_windowWidth * m_windowHeight * 4);
+    for (uint16_t y = 0; y < m_windowHeight; y++)
+    {
+        // Flip pixels upside down
+        const uint32_t* source = &m_windowSurface.color.pixels[(size_t)(m_windowHeight - 1 - y) * m_windowWidth];
+        uint8_t* destination = &rgbaPixels[(size_t)y * m_windowWidth * 4];
+        for (uint16_t x = 0; x < m_windowWidth; x++)
+        {
+            destination[(x * 4)] = (uint8_t)(source[x] & 0xFF);
+            destination[(x * 4) + 1] = (uint8_t)((source[x] >> 8) & 0xFF);
+            destination[(x * 4) + 2] = (uint8_t)((source[x] >> 16) & 0xFF);
+            destination[(x * 4) + 3] = 255;
+        }
+    }
+}
+
+void RendererSoftware::Present(SDL_Window* window)
+{
+    PROFILE_SCOPE("Present");
+    ReadFrame(m_framePixels);
+
+    SDL_Surface* frameSurface = SDL_CreateRGBSurfaceWithFormatFrom(m_framePixels.data(), m_windowWidth, m_windowHeight, 32, m_windowWidth * 4, SDL_PIXELFORMAT_RGBA32);
+    SDL_Surface* windowSurface = SDL_GetWindowSurface(window);
+    if (frameSurface == nullptr || windowSurface == nullptr)
+    {
+        Logging::Instance().AddLogMessage("WARNING: unable to present the frame: " + std::string(SDL_GetError()));
+    }
+    else
+    {
+        SDL_BlitSurface(frameSurface, nullptr, windowSurface, nullptr);
+        SDL_UpdateWindowSurface(window);
+    }
+    SDL_FreeSurface(frameSurface);
+}
+
+void RendererSoftware::AddDrawBatch(const uint32_t numberOfVertices)
+{
+    m_frameStatistics.drawBatches++;
+    m_frameStatistics.vertices += numberOfVertices;
+}
+
+egaColor RendererSoftware::GetAutomapPlayerMarkerColor(const egaColor floorColor) const
+{
+    return (floorColor == EgaBrightWhite || floorColor == EgaBrightYellow) ? EgaDarkGray : EgaBrightYellow;
+}
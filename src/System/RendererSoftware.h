@@ -0,0 +1,194 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// RendererSoftware
+//
+// Implementation of the renderer interface that rasterizes on the CPU, for hosts without a GPU or without usable
+// OpenGL drivers. It mirrors the fixed function pipeline as RendererOpenGL uses it: the same matrices, per vertex
+// depth shading, depth test, culling, texture filtering and blending, such that both renderers produce the same
+// picture. The triangles are rasterized in parallel by a SoftwareRasterizer.
+//
+#pragma once
+
+#include "../Engine/IRenderer.h"
+#include "../Engine/SoftwareRasterizer.h"
+#include <memory>
+#include <SDL.h>
+
+class RendererSoftware: public IRenderer
+{
+public:
+    // Without a given number of threads, as many threads are used as the hardware supports.
+    RendererSoftware(const uint32_t numberOfThreads = 0);
+    ~RendererSoftware() = default;
+
+    //
+    // Screen setup
+    //
+    void Setup() override;
+    void SetWindowDimensions(const uint16_t windowWidth, const uint16_t windowHeight) override;
+    uint16_t GetWindowWidth() const override;
+    uint16_t GetWindowHeight() const override;
+    void SetFrameSettings(const FrameSettings& frameSettings) override;
+
+    //
+    // Texture creation
+    //
+    unsigned int GenerateTextureId() const override;
+    void LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const override;
+    void LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const override;
+    void DeleteTexture(const unsigned int textureId) const override;
+
+    //
+    // 2D rendering
+    //
+    void Prepare2DRendering(const bool helpWindow) override;
+    void Unprepare2DRendering() override;
+    void Render2DPicture(const Picture* picture, const int16_t offsetX, const int16_t offsetY) override;
+    void Render2DPictureSegment(const Picture* picture, const int16_t offsetX, const int16_t offsetY, const uint16_t segmentOffsetX, const uint16_t segmentOffsetY, const uint16_t segmentWidth, const uint16_t segmentHeight) override;
+    void Render2DBar(const int16_t x, const int16_t y, const uint16_t width, const uint16_t height, const egaColor colorIndex) override;
+    void RenderTiles(const RenderableTiles& renderableTiles) override;
+    void RenderText(const RenderableText& renderableText) override;
+    uint16_t GetAdditionalMarginDueToWideScreen(const float aspectRatio) override;
+
+    //
+    // 3D rendering
+    //
+    void Render3DScene(const Renderable3DScene& renderable3DScene) override;
+    void RenderAutoMapTopDown(const RenderableAutoMapTopDown& autoMapTopDown) override;
+    void RenderAutoMapIso(const RenderableAutoMapIso& autoMapIso) override;
+
+    //
+    // Screen capture
+    //
+    Picture* GetScreenCapture(const unsigned int textureId) override;
+    void RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime) override;
+
+    //
+    // Capabilities
+    //
+    const std::string& GetGraphicsApiVersion() const override;
+    const std::string& GetGraphicsAdapterVendor() const override;
+    const std::string& GetGraphicsAdapterModel() const override;
+    bool IsVSyncSupported() override;
+    bool IsOriginalScreenResolutionSupported() override;
+    bool IsScreenCaptureOnGpuSupported() override;
+
+    //
+    // Statistics
+    //
+    void SetGpuTimingEnabled(const bool enabled) override;
+    void EndFrameStatistics() override;
+    const RenderStatistics& GetRenderStatistics() const override;
+
+    //
+    // Output
+    //
+    // Copies the rendered frame into the given pixels, as RGBA rows from top to bottom.
+    void ReadFrame(std::vector<uint8_t>& rgbaPixels);
+    // Copies the rendered frame into the surface of the window.
+    void Present(SDL_Window* window);
+
+private:
+    // Column-major, as in OpenGL
+    typedef struct
+    {
+        float m[16];
+    } matrix;
+
+    enum primitiveType
+    {
+        Triangles,
+        Quads
+    };
+
+    // Vertex in clip coordinates
+    typedef struct
+    {
+        float x;
+        float y;
+        float z;
+        float w;
+        float s;
+        float t;
+        float color[4];
+        float screenX;
+        float screenY;
+    } clipVertex;
+
+    void BindTexture(unsigned int textureId);
+    void BindTexture(const SoftwareRasterizer::texture* texture);
+    void AddDrawBatch(const uint32_t numberOfVertices);
+    void StoreTexture(const unsigned int textureId, const uint32_t width, const uint32_t height, std::vector<uint32_t>& pixels) const;
+    unsigned int GenerateSingleColorTexture(const egaColor color) const;
+
+    void SetViewPort(const int32_t left, const int32_t bottom, const int32_t width, const int32_t height);
+    void SetColor(const float red, const float green, const float blue);
+    void PushMatrix();
+    void PopMatrix();
+    void Begin(const primitiveType primitive);
+    void TexCoord(const float s, const float t);
+    void Vertex(const float x, const float y, const float z);
+    void End();
+    void DrawTriangle(const clipVertex& v0, const clipVertex& v1, const clipVertex& v2);
+
+    void Prepare3DRendering(const int32_t left, const int32_t bottom, const int32_t width, const int32_t height, const double aspect, const Renderable3DScene& renderable3DScene);
+    float PrepareIsoRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const float originX, const float originY);
+    void PrepareIsoRenderingText(const float originX, const float originY, const float xScale);
+    void RenderIsoWallCaps(const std::map <egaColor, std::vector<RenderableAutoMapIso::quadCoordinates>>& wallCaps);
+    void Render3DWalls(const Renderable3DWalls& walls);
+    void Render3DTiles(const Renderable3DTiles& tiles);
+    void RenderSprites(const RenderableSprites& renderableSprites);
+    void PrepareTopDownRendering(const float aspectRatio, const ViewPorts::ViewPortRect3D original3DViewArea, const uint16_t scale);
+    void RenderTopDownFloorTiles(const Renderable3DTiles& tiles, const uint16_t tileSize);
+    void ApplyDepthShading(const Renderable3DScene& renderable3DScene);
+    egaColor GetAutomapPlayerMarkerColor(const egaColor floorColor) const;
+
+    uint16_t m_windowWidth;
+    uint16_t m_windowHeight;
+    unsigned int m_singleColorTexture[EgaRange];
+    bool m_linearFilter;
+
+    std::string m_graphicsApiVersion;
+    std::string m_graphicsAdapterVendor;
+    std::string m_graphicsAdapterModel;
+
+    // Texture ids start at 1; the texture with id n is at index n - 1.
+    mutable std::vector<std::unique_ptr<SoftwareRasterizer::texture>> m_textures;
+    // Ids of deleted textures, to be reused by GenerateTextureId
+    mutable std::vector<unsigned int> m_freeTextureIds;
+    mutable SoftwareRasterizer m_rasterizer;
+    SoftwareRasterizer::surface m_windowSurface;
+    // The 3D view in original screen resolution is rendered into this surface first
+    SoftwareRasterizer::surface m_offscreenSurface;
+    SoftwareRasterizer::drawState m_drawState;
+
+    matrix m_projection;
+    matrix m_modelView;
+    std::vector<matrix> m_modelViewStack;
+    float m_color[4];
+    bool m_lighting;
+    float m_lightPosition[3];
+
+    primitiveType m_primitive;
+    float m_texCoord[2];
+    std::vector<clipVertex> m_vertices;
+
+    std::vector<uint8_t> m_framePixels;
+
+    RenderStatistics m_frameStatistics;
+    RenderStatistics m_renderStatistics;
+};
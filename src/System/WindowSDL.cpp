@@ -15,6 +15,7 @@
 
 #include "WindowSDL.h"
 #include "RendererOpenGL.h"
+#include "RendererSoftware.h"
 #include "../Engine/Logging.h"
 #include "../Engine/EngineCore.h"
 
@@ -28,23 +29,16 @@ GLvoid ReSizeGLScene(IRenderer* renderer, GLsizei width, GLsizei height)
     renderer->SetWindowDimensions(width, height);
 }
 
-void CreateGLWindow(int width, int height, int /*bits*/, SDL_Window*& window, SDL_GLContext& context )
+static SDL_Window* CreateResizableWindow(int width, int height, const Uint32 flags)
 {
-    Logging::Instance().AddLogMessage("Initializing OpenGL renderer");
-
-    if (SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 1) != 0)
-    {
-        Logging::Instance().AddLogMessage("WARNING: call to SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE,1) failed: " + std::string(SDL_GetError()));
-    }
-
     const std::string windowTitle = "CatacombGL " + EngineCore::GetVersionInfo();
-    window = SDL_CreateWindow(
+    SDL_Window* window = SDL_CreateWindow(
         windowTitle.c_str(),                        // window title
         SDL_WINDOWPOS_UNDEFINED,                    // initial x position
         SDL_WINDOWPOS_UNDEFINED,                    // initial y position
         width,                                      // width, in pixels
         height,                                     // height, in pixels
-        SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE    // flags - see below
+        flags | SDL_WINDOW_RESIZABLE                // flags - see below
     );
 
     // Check that the window was successfully created
@@ -56,6 +50,20 @@ void CreateGLWindow(int width, int height, int /*bits*/, SDL_Window*& window, SD
 
     SDL_ShowWindow(window);
 
+    return window;
+}
+
+void CreateGLWindow(int width, int height, int /*bits*/, SDL_Window*& window, SDL_GLContext& context )
+{
+    Logging::Instance().AddLogMessage("Initializing OpenGL renderer");
+
+    if (SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 1) != 0)
+    {
+        Logging::Instance().AddLogMessage("WARNING: call to SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE,1) failed: " + std::string(SDL_GetError()));
+    }
+
+    window = CreateResizableWindow(width, height, SDL_WINDOW_OPENGL);
+
     context = SDL_GL_CreateContext(window);
     if (context == nullptr)
     {
@@ -63,12 +71,34 @@ void CreateGLWindow(int width, int height, int /*bits*/, SDL_Window*& window, SD
     }
 }
 
+void CreateSoftwareWindow(int width, int height, SDL_Window*& window)
+{
+    Logging::Instance().AddLogMessage("Initializing software renderer");
+
+    window = CreateResizableWindow(width, height, 0);
+}
+
 GLvoid KillGLWindow(SDL_Window* window, SDL_GLContext& context)
 {
-    SDL_GL_DeleteContext(context);
+    if (context != nullptr)
+    {
+        SDL_GL_DeleteContext(context);
+    }
     SDL_DestroyWindow(window);
 }
 
+void SwapWindow(SDL_Window* window, RendererSoftware* softwareRenderer)
+{
+    if (softwareRenderer != nullptr)
+    {
+        softwareRenderer->Present(window);
+    }
+    else
+    {
+        SDL_GL_SwapWindow(window);
+    }
+}
+
 [[nodiscard]] bool HandleWindowEvent(const SDL_WindowEvent * event, SDL_Window* window, IRenderer* renderer)
 {
     switch (event->event) {
@@ -23,9 +23,16 @@
 #include <GL/gl.h>
 #include <SDL.h>
 
+class RendererSoftware;
+
 void CreateGLWindow(int width, int height, int /*bits*/, SDL_Window*& window, SDL_GLContext& context );
+// Window without an OpenGL context, for the software renderer
+void CreateSoftwareWindow(int width, int height, SDL_Window*& window);
 GLvoid KillGLWindow(SDL_Window* window, SDL_GLContext& context);
 
+// Shows the rendered frame. Without a software renderer, the frame was rendered by OpenGL.
+void SwapWindow(SDL_Window* window, RendererSoftware* softwareRenderer);
+
 // Resize And Initialize The GL Window
 GLvoid ReSizeGLScene(IRenderer* renderer, GLsizei width, GLsizei height);
 void SetScreenMode(const uint8_t screenMode, SDL_Window* window);
@@ -0,0 +1,111 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AssetResidency_Test.h"
+#include "../Engine/AssetResidency.h"
+
+AssetResidency_Test::AssetResidency_Test()
+{
+
+}
+
+AssetResidency_Test::~AssetResidency_Test()
+{
+
+}
+
+TEST(AssetResidency_Test, NothingIsUnloadedWithinBudget)
+{
+    AssetResidency residency("Test", 1000);
+    residency.AddAsset(1, 400);
+    residency.AddAsset(2, 600);
+    residency.NextFrame();
+
+    EXPECT_TRUE(residency.GetAssetsToUnload().empty());
+    EXPECT_EQ(residency.GetUsageInBytes(), 1000u);
+    EXPECT_EQ(residency.GetNumberOfAssets(), 2u);
+}
+
+TEST(AssetResidency_Test, LeastRecentlyUsedAssetsAreUnloadedFirst)
+{
+    AssetResidency residency("Test", 1000);
+    residency.AddAsset(1, 400);
+    residency.AddAsset(2, 400);
+    residency.AddAsset(3, 400);
+    residency.NextFrame();
+    residency.TouchAsset(1);
+    residency.TouchAsset(3);
+    residency.NextFrame();
+    residency.TouchAsset(1);
+    residency.NextFrame();
+
+    // Asset 2 was used longest ago, and unloading it gets the usage within budget
+    const std::vector<uint32_t> assetsToUnload = residency.GetAssetsToUnload();
+    ASSERT_EQ(assetsToUnload.size(), 1u);
+    EXPECT_EQ(assetsToUnload.at(0), 2u);
+
+    residency.SetBudget(500);
+    const std::vector<uint32_t> moreAssetsToUnload = residency.GetAssetsToUnload();
+    ASSERT_EQ(moreAssetsToUnload.size(), 2u);
+    EXPECT_EQ(moreAssetsToUnload.at(0), 2u);
+    EXPECT_EQ(moreAssetsToUnload.at(1), 3u);
+}
+
+TEST(AssetResidency_Test, AssetsUsedInCurrentFrameStayLoaded)
+{
+    AssetResidency residency("Test", 100);
+    residency.AddAsset(1, 400);
+    residency.AddAsset(2, 400);
+    residency.NextFrame();
+    residency.TouchAsset(2);
+
+    const std::vector<uint32_t> assetsToUnload = residency.GetAssetsToUnload();
+    ASSERT_EQ(assetsToUnload.size(), 1u);
+    EXPECT_EQ(assetsToUnload.at(0), 1u);
+}
+
+TEST(AssetResidency_Test, UnloadsAndReloadsAreCounted)
+{
+    AssetResidency residency("Test", 1000);
+    residency.AddAsset(1, 800);
+    residency.AddAsset(2, 800);
+    residency.NextFrame();
+    residency.RemoveAsset(1);
+
+    EXPECT_FALSE(residency.IsResident(1));
+    EXPECT_TRUE(residency.IsUnloaded(1));
+    EXPECT_FALSE(residency.IsUnloaded(3));
+    EXPECT_EQ(residency.GetUsageInBytes(), 800u);
+    EXPECT_EQ(residency.GetPeakUsageInBytes(), 1600u);
+    EXPECT_EQ(residency.GetNumberOfUnloads(), 1u);
+    EXPECT_EQ(residency.GetNumberOfReloads(), 0u);
+
+    residency.AddAsset(1, 800);
+    EXPECT_TRUE(residency.IsResident(1));
+    EXPECT_FALSE(residency.IsUnloaded(1));
+    EXPECT_EQ(residency.GetNumberOfReloads(), 1u);
+    EXPECT_EQ(residency.GetUsageInBytes(), 1600u);
+}
+
+TEST(AssetResidency_Test, UsageReport)
+{
+    AssetResidency residency("Textures", 4096);
+    residency.AddAsset(1, 2048);
+    residency.AddAsset(2, 1024);
+    residency.NextFrame();
+    residency.RemoveAsset(2);
+
+    EXPECT_EQ(residency.GetUsageReport(), "Textures: 1 loaded, 2 of 4 KB (peak 3 KB), 1 unloaded, 0 reloaded");
+}
@@ -0,0 +1,75 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AsyncFileWriter_Test.h"
+#include "../Engine/AsyncFileWriter.h"
+#include <fstream>
+#include <iterator>
+
+AsyncFileWriter_Test::AsyncFileWriter_Test()
+{
+
+}
+
+AsyncFileWriter_Test::~AsyncFileWriter_Test()
+{
+
+}
+
+TEST(AsyncFileWriter_Test, LastWriteEndsUpOnDisk)
+{
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "CatacombGL_AsyncFileWriter_Test.sav";
+    std::vector<uint8_t> data(100000, 1);
+    AsyncFileWriter writer;
+    writer.Write(filename, data);
+
+    // The data was copied, so it can be changed right away
+    data.assign(50000, 2);
+    writer.Write(filename, data);
+    EXPECT_TRUE(writer.Wait());
+
+    std::ifstream file(filename, std::ios::binary);
+    const std::vector<uint8_t> fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(data, fileData);
+    file.close();
+    std::filesystem::remove(filename);
+}
+
+TEST(AsyncFileWriter_Test, FailedWriteIsReported)
+{
+    AsyncFileWriter writer;
+    writer.Write(std::filesystem::temp_directory_path() / "CatacombGL_no_such_folder" / "test.sav", std::vector<uint8_t>(10, 0));
+    EXPECT_FALSE(writer.Wait());
+}
+
+TEST(AsyncFileWriter_Test, ExistingFileIsReplacedWithoutTemporaryFileLeft)
+{
+    const std::filesystem::path filename = std::filesystem::temp_directory_path() / "CatacombGL_AsyncFileWriter_Test_Replace.sav";
+    std::filesystem::path temporaryFilename = filename;
+    temporaryFilename += ".tmp";
+    AsyncFileWriter writer;
+    writer.Write(filename, std::vector<uint8_t>(1000, 1));
+    EXPECT_TRUE(writer.Wait());
+    const std::vector<uint8_t> data(10, 2);
+    writer.Write(filename, data);
+    EXPECT_TRUE(writer.Wait());
+
+    EXPECT_FALSE(std::filesystem::exists(temporaryFilename));
+    std::ifstream file(filename, std::ios::binary);
+    const std::vector<uint8_t> fileData((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(data, fileData);
+    file.close();
+    std::filesystem::remove(filename);
+}
@@ -0,0 +1,112 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AudioMixer_Test.h"
+#include "../Engine/AudioMixer.h"
+#include <vector>
+
+AudioMixer_Test::AudioMixer_Test()
+{
+
+}
+
+AudioMixer_Test::~AudioMixer_Test()
+{
+
+}
+
+static std::vector<int16_t> CreateSamples(const uint32_t length, const uint32_t seed)
+{
+    std::vector<int16_t> samples(length);
+    uint32_t state = seed;
+    for (uint32_t i = 0; i < length; i++)
+    {
+        state = state * 1664525 + 1013904223;
+        samples[i] = (int16_t)((state >> 16) % 32768) - 16384;
+    }
+    return samples;
+}
+
+TEST(AudioMixer_Test, MixMatchesScalarReference)
+{
+    // Lengths that are not a multiple of the vector width exercise the tail of each loop
+    for (const uint32_t length : { 1u, 7u, 8u, 61u, 256u })
+    {
+        const std::vector<int16_t> opl = CreateSamples(length, 1);
+        const std::vector<int16_t> voice0 = CreateSamples(length, 2);
+        const std::vector<int16_t> voice1 = CreateSamples(length, 3);
+        const uint16_t volume0 = AudioMixer::FullVolume;
+        const uint16_t volume1 = 77;
+        const int32_t minSample = AudioMixer::MinSample;
+        const int32_t maxSample = AudioMixer::MaxSample;
+
+        std::vector<int32_t> accumulator(length);
+        std::vector<int16_t> mixed(length);
+        AudioMixer::Load(accumulator.data(), opl.data(), length);
+        AudioMixer::Add(accumulator.data(), voice0.data(), length, volume0);
+        AudioMixer::Add(accumulator.data(), voice1.data(), length, volume1);
+        AudioMixer::Store(mixed.data(), accumulator.data(), length);
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            int32_t expected = opl[i] + ((voice0[i] * volume0) >> 8) + ((voice1[i] * volume1) >> 8);
+            expected = (expected < minSample) ? minSample : (expected > maxSample) ? maxSample : expected;
+            EXPECT_EQ(mixed[i], expected);
+        }
+    }
+}
+
+TEST(AudioMixer_Test, MixIsClampedOnlyAtTheEnd)
+{
+    const uint32_t length = 16;
+    const std::vector<int16_t> loud(length, 16000);
+    const std::vector<int16_t> inverted(length, -16000);
+    std::vector<int32_t> accumulator(length);
+    std::vector<int16_t> mixed(length);
+
+    // Three loud voices exceed the range, but an inverted voice brings the sum back in range
+    AudioMixer::Load(accumulator.data(), loud.data(), length);
+    AudioMixer::Add(accumulator.data(), loud.data(), length, AudioMixer::FullVolume);
+    AudioMixer::Add(accumulator.data(), loud.data(), length, AudioMixer::FullVolume);
+    AudioMixer::Add(accumulator.data(), inverted.data(), length, AudioMixer::FullVolume);
+    AudioMixer::Add(accumulator.data(), inverted.data(), length, AudioMixer::FullVolume);
+    AudioMixer::Store(mixed.data(), accumulator.data(), length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        EXPECT_EQ(mixed[i], 16000);
+    }
+
+    const int32_t maxSample = AudioMixer::MaxSample;
+    AudioMixer::Add(accumulator.data(), loud.data(), length, AudioMixer::FullVolume);
+    AudioMixer::Store(mixed.data(), accumulator.data(), length);
+    for (uint32_t i = 0; i < length; i++)
+    {
+        EXPECT_EQ(mixed[i], maxSample);
+    }
+}
+
+TEST(AudioMixer_Test, ZeroVolumeIsSilent)
+{
+    const uint32_t length = 20;
+    const std::vector<int16_t> silence(length, 0);
+    const std::vector<int16_t> voice = CreateSamples(length, 4);
+    std::vector<int32_t> accumulator(length);
+    std::vector<int16_t> mixed(length);
+
+    AudioMixer::Load(accumulator.data(), silence.data(), length);
+    AudioMixer::Add(accumulator.data(), voice.data(), length, 0);
+    AudioMixer::Store(mixed.data(), accumulator.data(), length);
+    EXPECT_EQ(mixed, silence);
+}
@@ -0,0 +1,233 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "AudioPrerenderer_Test.h"
+#include "HuffmanFixture.h"
+#include "../Engine/AudioPrerenderer.h"
+#include "../Engine/AdlibRenderer.h"
+#include "../Engine/AdlibSound.h"
+#include "../Engine/MusicTrack.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+AudioPrerenderer_Test::AudioPrerenderer_Test()
+{
+
+}
+
+AudioPrerenderer_Test::~AudioPrerenderer_Test()
+{
+
+}
+
+// A short sound effect with a fast attack and release, in the layout of an Adlib chunk in the audio repository.
+static std::vector<uint8_t> CreateSound()
+{
+    const uint32_t length = 10;
+    const uint16_t priority = 30;
+    const uint8_t instrument[16] = { 0x01, 0x01, 0x10, 0x00, 0xF0, 0xF0, 0x77, 0x77, 0x00, 0x00, 0, 0, 0, 0, 0, 0 };
+    std::vector<uint8_t> sound;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        sound.push_back((uint8_t)(length >> (i * 8)));
+    }
+    sound.push_back((uint8_t)(priority & 0xFF));
+    sound.push_back((uint8_t)(priority >> 8));
+    sound.insert(sound.end(), instrument, instrument + 16);
+    sound.push_back(4); // Octave
+    for (uint32_t i = 0; i < length; i++)
+    {
+        sound.push_back((uint8_t)(0x80 + i * 8));
+    }
+    return sound;
+}
+
+// A music track that plays one note on the first channel and releases it again.
+static std::vector<uint8_t> CreateTrack()
+{
+    const uint8_t events[][2] = {
+        { 0x20, 0x01 }, { 0x23, 0x01 }, { 0x40, 0x10 }, { 0x43, 0x00 }, { 0x60, 0xF0 },
+        { 0x63, 0xF0 }, { 0x80, 0x77 }, { 0x83, 0x77 }, { 0xA0, 0x98 }, { 0xB0, 0x31 }, { 0xB0, 0x11 } };
+    const uint16_t numberOfEvents = sizeof(events) / sizeof(events[0]);
+    const uint16_t length = numberOfEvents * 4;
+    std::vector<uint8_t> track;
+    track.push_back((uint8_t)(length & 0xFF));
+    track.push_back((uint8_t)(length >> 8));
+    for (uint16_t i = 0; i < numberOfEvents; i++)
+    {
+        const uint16_t delay = (events[i][0] == 0xB0) ? 100 : 0;
+        track.push_back(events[i][0]);
+        track.push_back(events[i][1]);
+        track.push_back((uint8_t)(delay & 0xFF));
+        track.push_back((uint8_t)(delay >> 8));
+    }
+    return track;
+}
+
+static bool ContainsSound(const std::vector<int16_t>& samples, const size_t begin, const size_t end)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        if (samples[i] != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void WaitUntilComplete(const AudioPrerenderer& prerenderer)
+{
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (!prerenderer.IsComplete() && std::chrono::steady_clock::now() < timeout)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+TEST(AudioPrerenderer_Test, RenderSoundFadesOut)
+{
+    std::vector<uint8_t> data = CreateSound();
+    FileChunk chunk((uint32_t)data.size());
+    memcpy(chunk.GetChunk(), data.data(), data.size());
+    const AdlibSound sound(&chunk);
+
+    std::vector<int16_t> samples;
+    AdlibRenderer::RenderSound(sound, samples);
+
+    // Ten ticks at 140 Hz, followed by the release of the note
+    const size_t soundLength = 10 * AdlibRenderer::SampleRate / 140;
+    ASSERT_GT(samples.size(), soundLength);
+    EXPECT_TRUE(ContainsSound(samples, 0, soundLength));
+    EXPECT_FALSE(ContainsSound(samples, samples.size() - 100, samples.size()));
+}
+
+TEST(AudioPrerenderer_Test, RenderMusicTrackTwice)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> data = CreateTrack();
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(data);
+    MusicTrack track(huffman, compressed.data(), (uint32_t)compressed.size(), (uint32_t)data.size());
+
+    std::vector<int16_t> samples;
+    uint32_t loopStart = 0;
+    AdlibRenderer::RenderMusicTrack(track, samples, loopStart);
+
+    // The sequencer loops in the tick of the last event, so each pass takes 101 ticks of the timer as id_sd programs it
+    const double passLength = 101.0 * (1192030 / 560) * AdlibRenderer::SampleRate / 1193182;
+    EXPECT_NEAR((double)loopStart, passLength, 1.0);
+    EXPECT_NEAR((double)samples.size(), 2.0 * passLength, 2.0);
+    EXPECT_TRUE(ContainsSound(samples, 0, loopStart));
+    EXPECT_TRUE(ContainsSound(samples, loopStart, samples.size()));
+}
+
+TEST(AudioPrerenderer_Test, StoreAndLoadFromCache)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> sound = CreateSound();
+    std::vector<uint8_t> compressedSound = HuffmanFixture::Compress(sound);
+    std::vector<uint8_t> track = CreateTrack();
+    std::vector<uint8_t> compressedTrack = HuffmanFixture::Compress(track);
+    const fs::path cachePath = fs::temp_directory_path() / "CatacombGL_AudioPrerenderer_Test";
+    fs::remove_all(cachePath);
+
+    std::vector<int16_t> renderedSound;
+    std::vector<int16_t> renderedTrack;
+    {
+        AudioPrerenderer prerenderer(huffman, cachePath);
+        prerenderer.AddAdlibSound(3, compressedSound.data(), (uint32_t)compressedSound.size(), (uint32_t)sound.size());
+        prerenderer.AddMusicTrack(0, compressedTrack.data(), (uint32_t)compressedTrack.size(), (uint32_t)track.size());
+        EXPECT_EQ(prerenderer.GetAdlibSound(3), nullptr);
+        prerenderer.Start();
+        WaitUntilComplete(prerenderer);
+        ASSERT_TRUE(prerenderer.IsComplete());
+        ASSERT_NE(prerenderer.GetAdlibSound(3), nullptr);
+        ASSERT_NE(prerenderer.GetMusicTrack(0), nullptr);
+        EXPECT_EQ(prerenderer.GetAdlibSound(3)->priority, 30);
+        renderedSound = prerenderer.GetAdlibSound(3)->samples;
+        renderedTrack = prerenderer.GetMusicTrack(0)->samples;
+    }
+
+    uint32_t numberOfCacheFiles = 0;
+    for (const auto& entry : fs::directory_iterator(cachePath))
+    {
+        EXPECT_EQ(entry.path().extension(), ".pcm");
+        numberOfCacheFiles++;
+    }
+    EXPECT_EQ(numberOfCacheFiles, 2u);
+
+    {
+        AudioPrerenderer prerenderer(huffman, cachePath);
+        prerenderer.AddAdlibSound(3, compressedSound.data(), (uint32_t)compressedSound.size(), (uint32_t)sound.size());
+        prerenderer.AddMusicTrack(0, compressedTrack.data(), (uint32_t)compressedTrack.size(), (uint32_t)track.size());
+        prerenderer.Start();
+        WaitUntilComplete(prerenderer);
+        ASSERT_TRUE(prerenderer.IsComplete());
+        EXPECT_EQ(prerenderer.GetAdlibSound(3)->samples, renderedSound);
+        EXPECT_EQ(prerenderer.GetMusicTrack(0)->samples, renderedTrack);
+    }
+
+    fs::remove_all(cachePath);
+}
+
+TEST(AudioPrerenderer_Test, DamagedCacheEntryIsRenderedAgain)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> sound = CreateSound();
+    std::vector<uint8_t> compressedSound = HuffmanFixture::Compress(sound);
+    const fs::path cachePath = fs::temp_directory_path() / "CatacombGL_AudioPrerenderer_Test_Damaged";
+    fs::remove_all(cachePath);
+
+    std::vector<int16_t> renderedSound;
+    {
+        AudioPrerenderer prerenderer(huffman, cachePath);
+        prerenderer.AddAdlibSound(3, compressedSound.data(), (uint32_t)compressedSound.size(), (uint32_t)sound.size());
+        prerenderer.Start();
+        WaitUntilComplete(prerenderer);
+        ASSERT_NE(prerenderer.GetAdlibSound(3), nullptr);
+        renderedSound = prerenderer.GetAdlibSound(3)->samples;
+    }
+
+    // Claim far more samples than the cache file holds
+    for (const auto& entry : fs::directory_iterator(cachePath))
+    {
+        std::fstream file(entry.path(), std::ios::in | std::ios::out | std::ios::binary);
+        const uint32_t numberOfSamples = 0xFFFFFFF0;
+        file.seekp(10);
+        file.write((const char*)&numberOfSamples, sizeof(numberOfSamples));
+    }
+
+    {
+        AudioPrerenderer prerenderer(huffman, cachePath);
+        prerenderer.AddAdlibSound(3, compressedSound.data(), (uint32_t)compressedSound.size(), (uint32_t)sound.size());
+        prerenderer.Start();
+        WaitUntilComplete(prerenderer);
+        ASSERT_TRUE(prerenderer.IsComplete());
+        ASSERT_NE(prerenderer.GetAdlibSound(3), nullptr);
+        EXPECT_EQ(prerenderer.GetAdlibSound(3)->samples, renderedSound);
+    }
+
+    fs::remove_all(cachePath);
+}
@@ -0,0 +1,38 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+#include "Checksum_Test.h"
+#include "../Engine/Checksum.h"
+#include <string>
+
+Checksum_Test::Checksum_Test()
+{
+
+}
+
+Checksum_Test::~Checksum_Test()
+{
+
+}
+
+TEST(Checksum_Test, Crc32OfCheckString)
+{
+    const std::string check = "123456789";
+    EXPECT_EQ(0xCBF43926u, Checksum::Crc32((const uint8_t*)check.data(), check.size()));
+}
+
+TEST(Checksum_Test, Crc32OfNoData)
+{
+    EXPECT_EQ(0u, Checksum::Crc32(nullptr, 0));
+}
@@ -0,0 +1,88 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "Dbopl_Test.h"
+#include "../../ThirdParty/opl/dbopl.h"
+#include <vector>
+
+Dbopl_Test::Dbopl_Test()
+{
+
+}
+
+Dbopl_Test::~Dbopl_Test()
+{
+
+}
+
+static const Bit32u sampleRate = 49716;
+
+static uint32_t NextRandom(uint32_t& state)
+{
+    state = state * 1664525 + 1013904223;
+    return state >> 8;
+}
+
+// Writes the same random registers to two chips and compares the output of both generation paths.
+static void CompareGenerationPaths(const uint32_t seed)
+{
+    DBOPL_InitTables();
+    Chip reference;
+    Chip vectorized;
+    Chip__Chip(&reference);
+    Chip__Setup(&reference, sampleRate);
+    Chip__Chip(&vectorized);
+    Chip__Setup(&vectorized, sampleRate);
+
+    // Enable the wave form selection
+    Chip__WriteReg(&reference, 0x01, 0x20);
+    Chip__WriteReg(&vectorized, 0x01, 0x20);
+
+    uint32_t state = seed;
+    std::vector<Bit32s> referenceOutput(1024);
+    std::vector<Bit32s> vectorizedOutput(1024);
+    for (uint32_t round = 0; round < 400; round++)
+    {
+        for (uint32_t write = NextRandom(state) % 16; write > 0; write--)
+        {
+            const Bit32u reg = 0x20 + (NextRandom(state) % 0xD6);
+            Bit8u value = (Bit8u)NextRandom(state);
+            if (reg == 0xBD)
+            {
+                // Only the vibrato and tremolo depth; the games never enable the rhythm mode
+                value &= 0xC0;
+            }
+            Chip__WriteReg(&reference, reg, value);
+            Chip__WriteReg(&vectorized, reg, value);
+        }
+
+        // Lengths that are not a multiple of the vector width exercise the tail of each loop
+        const Bitu length = 1 + NextRandom(state) % 1024;
+        Chip__GenerateBlock2(&reference, length, referenceOutput.data());
+        Chip__GenerateBlock2Vectorized(&vectorized, length, vectorizedOutput.data());
+        for (Bitu i = 0; i < length; i++)
+        {
+            ASSERT_EQ(referenceOutput[i], vectorizedOutput[i]) << "round " << round << ", sample " << i;
+        }
+    }
+}
+
+TEST(Dbopl_Test, VectorizedMatchesSampleBySample)
+{
+    for (const uint32_t seed : { 1u, 2u, 3u })
+    {
+        CompareGenerationPaths(seed);
+    }
+}
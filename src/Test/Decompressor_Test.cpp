@@ -0,0 +1,162 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "Decompressor_Test.h"
+#include "../Engine/Decompressor.h"
+
+static const uint16_t rlewTag = 0xABCD;
+
+Decompressor_Test::Decompressor_Test()
+{
+
+}
+
+Decompressor_Test::~Decompressor_Test()
+{
+
+}
+
+// Carmack compressed data, starting with the expanded length in bytes. The Carmack tokens are given as words,
+// while the offset of a near back-reference is a single byte.
+class CarmackData
+{
+public:
+    CarmackData(const uint16_t expandedLengthInWords)
+    {
+        Word(expandedLengthInWords * 2);
+    }
+
+    CarmackData& Word(const uint16_t word)
+    {
+        m_data.push_back((uint8_t)(word & 0xFF));
+        m_data.push_back((uint8_t)(word >> 8));
+        return *this;
+    }
+
+    CarmackData& Byte(const uint8_t byte)
+    {
+        m_data.push_back(byte);
+        return *this;
+    }
+
+    const std::vector<uint8_t>& Get() const
+    {
+        return m_data;
+    }
+
+private:
+    std::vector<uint8_t> m_data;
+};
+
+static bool Expand(const CarmackData& data, std::vector<uint16_t>& destination)
+{
+    std::vector<uint16_t> history;
+    return Decompressor::CarmackRLEWExpand(data.Get().data(), (uint32_t)data.Get().size(), rlewTag, history, destination.data(), (uint32_t)destination.size());
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandUncompressedWords)
+{
+    CarmackData data(5);
+    data.Word(8).Word(1).Word(2).Word(3).Word(4);
+    std::vector<uint16_t> destination(4);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 1, 2, 3, 4 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandRlewRun)
+{
+    CarmackData data(6);
+    data.Word(10).Word(9).Word(rlewTag).Word(4).Word(7).Word(8);
+    std::vector<uint16_t> destination(5);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 9, 7, 7, 7, 7 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandRlewRunIsClippedToDestination)
+{
+    CarmackData data(4);
+    data.Word(6).Word(rlewTag).Word(100).Word(7);
+    std::vector<uint16_t> destination(3);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 7, 7, 7 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandNearBackReference)
+{
+    // Copying three words from one word back repeats that word
+    CarmackData data(5);
+    data.Word(8).Word(5).Word(0xA703).Byte(1);
+    std::vector<uint16_t> destination(4);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 5, 5, 5, 5 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandFarBackReference)
+{
+    CarmackData data(7);
+    data.Word(12).Word(1).Word(2).Word(3).Word(0xA803).Word(1);
+    std::vector<uint16_t> destination(6);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 1, 2, 3, 1, 2, 3 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandBackReferenceToRlewRun)
+{
+    // The back-reference copies a complete RLEW run, which is expanded after the copy
+    CarmackData data(7);
+    data.Word(12).Word(rlewTag).Word(3).Word(6).Word(0xA703).Byte(3);
+    std::vector<uint16_t> destination(6);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 6, 6, 6, 6, 6, 6 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandWordsWithTagByte)
+{
+    CarmackData data(3);
+    data.Word(4).Word(0xA700).Byte(0x12).Word(0xA800).Byte(0x34);
+    std::vector<uint16_t> destination(2);
+    EXPECT_TRUE(Expand(data, destination));
+    EXPECT_EQ(destination, std::vector<uint16_t>({ 0xA712, 0xA834 }));
+}
+
+TEST(Decompressor_Test, CarmackRLEWExpandRejectsCorruptData)
+{
+    std::vector<uint16_t> destination(4);
+
+    // Back-reference before the start of the data
+    CarmackData nearBeforeStart(5);
+    nearBeforeStart.Word(8).Word(5).Word(0xA703).Byte(3);
+    EXPECT_FALSE(Expand(nearBeforeStart, destination));
+
+    // Back-reference beyond the expanded length
+    CarmackData copyBeyondEnd(5);
+    copyBeyondEnd.Word(8).Word(5).Word(0xA710).Byte(1);
+    EXPECT_FALSE(Expand(copyBeyondEnd, destination));
+
+    // Far back-reference to data that is not expanded yet
+    CarmackData farBeyondEnd(5);
+    farBeyondEnd.Word(8).Word(5).Word(0xA802).Word(2);
+    EXPECT_FALSE(Expand(farBeyondEnd, destination));
+
+    // Truncated input
+    CarmackData truncated(5);
+    truncated.Word(8).Word(1).Word(2);
+    EXPECT_FALSE(Expand(truncated, destination));
+
+    // Expands to fewer words than the destination
+    CarmackData tooSmall(3);
+    tooSmall.Word(4).Word(1).Word(2);
+    EXPECT_FALSE(Expand(tooSmall, destination));
+}
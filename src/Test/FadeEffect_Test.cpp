@@ -0,0 +1,81 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "FadeEffect_Test.h"
+#include "../Engine/FadeEffect.h"
+
+FadeEffect_Test::FadeEffect_Test()
+{
+
+}
+
+FadeEffect_Test::~FadeEffect_Test()
+{
+
+}
+
+TEST(FadeEffect_Test, RevealTimesAreUnique)
+{
+    const std::vector<uint16_t>& revealTimes = FadeEffect::GetRevealTimes();
+    ASSERT_EQ(revealTimes.size(), 320u * 200u);
+
+    std::vector<bool> revealTimeUsed(320 * 200, false);
+    for (const uint16_t revealTime : revealTimes)
+    {
+        ASSERT_LT(revealTime, 320u * 200u);
+        EXPECT_FALSE(revealTimeUsed[revealTime]);
+        revealTimeUsed[revealTime] = true;
+    }
+}
+
+TEST(FadeEffect_Test, RevealTimesMatchFizzleFadeSequence)
+{
+    // Pixels as removed per frame by the original fizzle fade, based on Wolf4SDL
+    const std::vector<uint16_t>& revealTimes = FadeEffect::GetRevealTimes();
+    const uint32_t rndmask = 0x00012000;
+    int32_t rndval = 0;
+    uint32_t pixelsRemoved = 0;
+    std::vector<bool> removed(320 * 200, false);
+    for (uint32_t milliSec = 0; milliSec <= 1000; milliSec += 17)
+    {
+        const uint32_t pixelsToRemove = (milliSec * 320 * 200) / 1000;
+        for (uint32_t p = pixelsRemoved; p < pixelsToRemove; p++)
+        {
+            const int32_t x = rndval >> 8;
+            const int32_t y = rndval & 0xFF;
+            rndval = (rndval >> 1) ^ (rndval & 1 ? 0 : rndmask);
+            if (x >= 320 || y >= 200)
+            {
+                if (rndval == 0)
+                {
+                    break;
+                }
+                p--;
+                continue;
+            }
+            removed[(y * 320) + x] = true;
+            if (rndval == 0)
+            {
+                break;
+            }
+        }
+        pixelsRemoved = pixelsToRemove;
+
+        for (uint32_t i = 0; i < 320 * 200; i++)
+        {
+            ASSERT_EQ(removed[i], revealTimes[i] < pixelsRemoved) << "pixel " << i << " at " << milliSec << " ms";
+        }
+    }
+}
@@ -0,0 +1,125 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "FrameProfiler_Test.h"
+#include "../Engine/FrameProfiler.h"
+
+FrameProfiler_Test::FrameProfiler_Test()
+{
+
+}
+
+FrameProfiler_Test::~FrameProfiler_Test()
+{
+
+}
+
+TEST(FrameProfiler_Test, NoFramesUntilFirstFrameCompleted)
+{
+    FrameProfiler frameProfiler;
+    EXPECT_EQ(0, frameProfiler.GetNumberOfFrames());
+    frameProfiler.BeginFrame();
+    EXPECT_EQ(0, frameProfiler.GetNumberOfFrames());
+    frameProfiler.BeginFrame();
+    EXPECT_EQ(1, frameProfiler.GetNumberOfFrames());
+}
+
+TEST(FrameProfiler_Test, ScopesOutsideFrameAreIgnored)
+{
+    FrameProfiler frameProfiler;
+    frameProfiler.BeginScope("Think");
+    frameProfiler.EndScope();
+    frameProfiler.BeginFrame();
+    frameProfiler.BeginFrame();
+    EXPECT_EQ(0, frameProfiler.GetFrame(0).numberOfMarkers);
+}
+
+TEST(FrameProfiler_Test, NestedScopesAreRecordedInOrder)
+{
+    FrameProfiler frameProfiler;
+    frameProfiler.BeginFrame();
+    frameProfiler.BeginScope("Think");
+    frameProfiler.BeginScope("ThinkActors");
+    frameProfiler.EndScope();
+    frameProfiler.EndScope();
+    frameProfiler.BeginScope("DrawScene");
+    frameProfiler.EndScope();
+    frameProfiler.BeginFrame();
+
+    const FrameProfiler::Frame& frame = frameProfiler.GetFrame(0);
+    ASSERT_EQ(3, frame.numberOfMarkers);
+    EXPECT_STREQ("Think", frame.markers[0].name);
+    EXPECT_EQ(0, frame.markers[0].depth);
+    EXPECT_STREQ("ThinkActors", frame.markers[1].name);
+    EXPECT_EQ(1, frame.markers[1].depth);
+    EXPECT_STREQ("DrawScene", frame.markers[2].name);
+    EXPECT_EQ(0, frame.markers[2].depth);
+    EXPECT_LE(frame.markers[0].startInMicroseconds, frame.markers[1].startInMicroseconds);
+    EXPECT_LE(frame.markers[1].durationInMicroseconds, frame.markers[0].durationInMicroseconds);
+    EXPECT_LE(frame.markers[2].startInMicroseconds + frame.markers[2].durationInMicroseconds, frame.durationInMicroseconds);
+}
+
+TEST(FrameProfiler_Test, RingBufferKeepsMostRecentFrames)
+{
+    FrameProfiler frameProfiler;
+    const uint16_t maxFrames = FrameProfiler::MaxFrames;
+    const char* names[] = { "Even", "Odd" };
+    for (uint16_t i = 0; i < maxFrames + 11; i++)
+    {
+        frameProfiler.BeginFrame();
+        frameProfiler.BeginScope(names[i % 2]);
+        frameProfiler.EndScope();
+    }
+    frameProfiler.BeginFrame();
+
+    EXPECT_EQ(maxFrames, frameProfiler.GetNumberOfFrames());
+    EXPECT_STREQ("Even", frameProfiler.GetFrame(0).markers[0].name);
+    EXPECT_STREQ("Odd", frameProfiler.GetFrame(1).markers[0].name);
+    EXPECT_LE(frameProfiler.GetFrame(1).startInMicroseconds, frameProfiler.GetFrame(0).startInMicroseconds);
+}
+
+TEST(FrameProfiler_Test, MarkersBeyondCapacityAreDropped)
+{
+    const uint16_t maxMarkersPerFrame = FrameProfiler::MaxMarkersPerFrame;
+    FrameProfiler frameProfiler;
+    frameProfiler.BeginFrame();
+    frameProfiler.BeginScope("Outer");
+    for (uint16_t i = 0; i < maxMarkersPerFrame + 5; i++)
+    {
+        frameProfiler.BeginScope("Inner");
+        frameProfiler.EndScope();
+    }
+    frameProfiler.EndScope();
+    frameProfiler.BeginFrame();
+
+    const FrameProfiler::Frame& frame = frameProfiler.GetFrame(0);
+    EXPECT_EQ(maxMarkersPerFrame, frame.numberOfMarkers);
+    EXPECT_STREQ("Outer", frame.markers[0].name);
+    EXPECT_EQ(1, frame.markers[maxMarkersPerFrame - 1].depth);
+}
+
+TEST(FrameProfiler_Test, ChromeTraceContainsFramesAndMarkers)
+{
+    FrameProfiler frameProfiler;
+    frameProfiler.BeginFrame();
+    frameProfiler.BeginScope("Setup3DScene");
+    frameProfiler.EndScope();
+    frameProfiler.BeginFrame();
+
+    const std::string trace = frameProfiler.GetChromeTrace();
+    EXPECT_EQ(0, trace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"Frame\",\"ph\":\"X\""));
+    EXPECT_NE(std::string::npos, trace.find("{\"name\":\"Setup3DScene\",\"ph\":\"X\""));
+}
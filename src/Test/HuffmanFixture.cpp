@@ -0,0 +1,50 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "HuffmanFixture.h"
+
+void HuffmanFixture::CreateBalancedHuffmanTable(huffmanTable& table)
+{
+    for (uint16_t node = 1; node < 256; node++)
+    {
+        const uint16_t child0 = node * 2;
+        const uint16_t child1 = child0 + 1;
+        table[255 - node].bit0 = (child0 >= 256) ? child0 - 256 : 256 + 255 - child0;
+        table[255 - node].bit1 = (child1 >= 256) ? child1 - 256 : 256 + 255 - child1;
+    }
+    table[255].bit0 = 0;
+    table[255].bit1 = 0;
+}
+
+std::vector<uint8_t> HuffmanFixture::Compress(const std::vector<uint8_t>& data)
+{
+    // The decoder consumes bits from the least significant bit upwards, while the tree expects the most significant
+    // bit of a value first.
+    std::vector<uint8_t> compressed;
+    compressed.reserve(data.size());
+    for (const uint8_t value : data)
+    {
+        uint8_t reversed = 0;
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            if (value & (1 << bit))
+            {
+                reversed |= (uint8_t)(0x80 >> bit);
+            }
+        }
+        compressed.push_back(reversed);
+    }
+    return compressed;
+}
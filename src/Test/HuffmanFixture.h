@@ -0,0 +1,34 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+//
+// HuffmanFixture
+//
+// Huffman compressed data for the tests and the benchmarks, without any game data present.
+//
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "../Engine/Huffman.h"
+
+namespace HuffmanFixture
+{
+    // Balanced Huffman tree in which every byte is encoded with 8 bits, most significant bit first.
+    void CreateBalancedHuffmanTable(huffmanTable& table);
+
+    // Compresses the data with the balanced Huffman tree.
+    std::vector<uint8_t> Compress(const std::vector<uint8_t>& data);
+}
@@ -0,0 +1,97 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "InputScript_Test.h"
+#include "../Engine/InputScript.h"
+#include "../Engine/PlayerInput.h"
+
+InputScript_Test::InputScript_Test()
+{
+
+}
+
+InputScript_Test::~InputScript_Test()
+{
+
+}
+
+TEST(InputScript_Test, KeysArePressedUntilReleased)
+{
+    InputScript inputScript;
+    std::string errorMessage;
+    ASSERT_TRUE(inputScript.Parse("2 press Up\n5 release Up\n", errorMessage));
+
+    PlayerInput input;
+    for (uint32_t frameNumber = 0; frameNumber < 7; frameNumber++)
+    {
+        inputScript.ApplyToInput(frameNumber, input);
+        EXPECT_EQ(frameNumber >= 2 && frameNumber < 5, input.IsKeyPressed(SDLK_UP)) << "frame " << frameNumber;
+    }
+}
+
+TEST(InputScript_Test, TappedKeyIsReleasedInNextFrame)
+{
+    InputScript inputScript;
+    std::string errorMessage;
+    ASSERT_TRUE(inputScript.Parse("# Select the first game\n\n3 tap 1\n", errorMessage));
+    EXPECT_EQ(4, inputScript.GetLastFrame());
+
+    PlayerInput input;
+    inputScript.ApplyToInput(3, input);
+    EXPECT_TRUE(input.IsKeyJustPressed(SDLK_1));
+    inputScript.ApplyToInput(4, input);
+    EXPECT_FALSE(input.IsKeyPressed(SDLK_1));
+}
+
+TEST(InputScript_Test, MouseMotionOnlyLastsOneFrame)
+{
+    InputScript inputScript;
+    std::string errorMessage;
+    ASSERT_TRUE(inputScript.Parse("1 mouse 10 -3\n1 mouse 5 0\n", errorMessage));
+
+    PlayerInput input;
+    inputScript.ApplyToInput(1, input);
+    EXPECT_EQ(15, input.GetMouseXPos());
+    EXPECT_EQ(-3, input.GetMouseYPos());
+    inputScript.ApplyToInput(2, input);
+    EXPECT_EQ(0, input.GetMouseXPos());
+    EXPECT_EQ(0, input.GetMouseYPos());
+}
+
+TEST(InputScript_Test, CaptureAndQuitFrames)
+{
+    InputScript inputScript;
+    std::string errorMessage;
+    ASSERT_TRUE(inputScript.Parse("100 quit\r\n40 capture\r\n20 capture\r\n200 press a\r\n", errorMessage));
+    EXPECT_EQ(100, inputScript.GetLastFrame());
+    EXPECT_TRUE(inputScript.IsCaptureFrame(20));
+    EXPECT_TRUE(inputScript.IsCaptureFrame(40));
+    EXPECT_FALSE(inputScript.IsCaptureFrame(30));
+    EXPECT_FALSE(inputScript.IsCaptureFrame(200));
+}
+
+TEST(InputScript_Test, ErrorsMentionTheLine)
+{
+    InputScript inputScript;
+    std::string errorMessage;
+    EXPECT_FALSE(inputScript.Parse("1 capture\n2 jump\n", errorMessage));
+    EXPECT_EQ("Line 2: unknown command 'jump'", errorMessage);
+    EXPECT_FALSE(inputScript.Parse("x capture\n", errorMessage));
+    EXPECT_EQ("Line 1: invalid frame number x", errorMessage);
+    EXPECT_FALSE(inputScript.Parse("1 press\n", errorMessage));
+    EXPECT_EQ("Line 1: unknown key ''", errorMessage);
+    EXPECT_FALSE(inputScript.Parse("1 mouse 3\n", errorMessage));
+    EXPECT_EQ("Line 1: expected the mouse motion as <dx> <dy>", errorMessage);
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "Level_Test.h"
+#include "../Engine/Level.h"
+
+Level_Test::Level_Test()
+{
+
+}
+
+Level_Test::~Level_Test()
+{
+
+}
+
+static DecorateActor CreateDecorateActor(const uint16_t id, const uint16_t pictureIndex, const uint16_t hitSound, const uint16_t projectileId)
+{
+    DecorateActor decorateActor = {};
+    decorateActor.id = id;
+    decorateActor.states[StateIdWalk] = { { { pictureIndex, 10, ActionNone }, { (uint16_t)(pictureIndex + 1), 10, ActionNone } }, StateIdWalk };
+    decorateActor.initialState = StateIdWalk;
+    decorateActor.hitSound = hitSound;
+    decorateActor.projectileId = projectileId;
+    return decorateActor;
+}
+
+TEST(Level_Test, PicturesAndSoundsInUse)
+{
+    const LevelInfo levelInfo = { "Test", EgaBlack, EgaBlack, false, false };
+    const std::vector<WallInfo> wallsInfo =
+    {
+        { {}, {}, WTOpen },
+        { { 10 }, { 11 }, WTSolid },
+        { { 12 }, { 13 }, WTSolid }
+    };
+    const uint16_t width = 4;
+    const uint16_t height = 4;
+    uint16_t* plane0 = new uint16_t[width * height];
+    uint16_t* plane2 = new uint16_t[width * height];
+    for (uint16_t i = 0; i < width * height; i++)
+    {
+        plane0[i] = (i < width) ? 1 : 0;
+        plane2[i] = 0;
+    }
+    Level level(0, width, height, plane0, plane2, levelInfo, wallsInfo);
+
+    // The projectiles of the player fire each other, which must not keep the search going
+    std::map<uint16_t, const DecorateActor> decorateActors;
+    decorateActors.emplace(1, CreateDecorateActor(1, 20, 1, 2));
+    decorateActors.emplace(2, CreateDecorateActor(2, 30, 2, 3));
+    decorateActors.emplace(3, CreateDecorateActor(3, 40, 3, 2));
+    decorateActors.emplace(4, CreateDecorateActor(4, 50, 4, 0));
+    decorateActors.emplace(5, CreateDecorateActor(5, 60, 5, 0));
+    decorateActors.emplace(6, CreateDecorateActor(6, 70, 6, 0));
+    level.SetPlayerActor(new Actor(1.5f, 2.5f, 0, decorateActors.at(1)));
+    level.SetBlockingActor(2, 2, new Actor(2.5f, 2.5f, 0, decorateActors.at(4)));
+
+    std::set<uint16_t> pictureIndices;
+    std::set<uint16_t> soundIndices;
+    level.GetPicturesAndSoundsInUse(decorateActors, { &decorateActors.at(5) }, pictureIndices, soundIndices);
+
+    const std::set<uint16_t> expectedPictureIndices = { 10, 11, 20, 21, 30, 31, 40, 41, 50, 51, 60, 61 };
+    const std::set<uint16_t> expectedSoundIndices = { 1, 2, 3, 4, 5 };
+    EXPECT_EQ(expectedPictureIndices, pictureIndices);
+    EXPECT_EQ(expectedSoundIndices, soundIndices);
+}
@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "MemoryStreamBuffer_Test.h"
+#include "../Engine/MemoryStreamBuffer.h"
+#include <istream>
+#include <ostream>
+
+MemoryStreamBuffer_Test::MemoryStreamBuffer_Test()
+{
+
+}
+
+MemoryStreamBuffer_Test::~MemoryStreamBuffer_Test()
+{
+
+}
+
+TEST(MemoryStreamBuffer_Test, ReadsWhatWasWritten)
+{
+    std::vector<uint8_t> data;
+    {
+        MemoryStreamBuffer buffer(data);
+        std::ostream stream(&buffer);
+        const uint32_t value = 0x12345678;
+        stream.write((const char*)&value, sizeof(value));
+        stream.put('A');
+        stream.write("CATACOMBGL", 11);
+        EXPECT_TRUE(stream.good());
+    }
+    EXPECT_EQ(16u, data.size());
+
+    MemoryStreamBuffer buffer(static_cast<const std::vector<uint8_t>&>(data));
+    std::istream stream(&buffer);
+    uint32_t value = 0;
+    stream.read((char*)&value, sizeof(value));
+    EXPECT_EQ(0x12345678u, value);
+    EXPECT_EQ('A', stream.get());
+    char header[11];
+    stream.read(header, 11);
+    EXPECT_STREQ("CATACOMBGL", header);
+    EXPECT_TRUE(stream.good());
+
+    // Reading beyond the end fails, just like with a file
+    stream.read((char*)&value, sizeof(value));
+    EXPECT_TRUE(stream.fail());
+}
+
+TEST(MemoryStreamBuffer_Test, WritingKeepsExistingCapacity)
+{
+    std::vector<uint8_t> data;
+    data.reserve(1000);
+    const uint8_t* storage = data.data();
+    MemoryStreamBuffer buffer(data);
+    std::ostream stream(&buffer);
+    const std::vector<char> block(500, 'x');
+    stream.write(block.data(), block.size());
+    stream.write(block.data(), block.size());
+    EXPECT_EQ(1000u, data.size());
+    EXPECT_EQ(storage, data.data());
+}
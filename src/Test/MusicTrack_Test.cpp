@@ -0,0 +1,123 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "MusicTrack_Test.h"
+#include "HuffmanFixture.h"
+#include "../Engine/MusicTrack.h"
+#include <vector>
+
+MusicTrack_Test::MusicTrack_Test()
+{
+
+}
+
+MusicTrack_Test::~MusicTrack_Test()
+{
+
+}
+
+static std::vector<uint8_t> CreateTrack(const uint16_t numberOfEvents)
+{
+    const uint16_t length = numberOfEvents * 4;
+    std::vector<uint8_t> track;
+    track.push_back((uint8_t)(length & 0xFF));
+    track.push_back((uint8_t)(length >> 8));
+    for (uint16_t i = 0; i < numberOfEvents; i++)
+    {
+        track.push_back((uint8_t)(0x20 + (i % 0xD0)));
+        track.push_back((uint8_t)(i * 7));
+        track.push_back((uint8_t)(i & 0xFF));
+        track.push_back((uint8_t)(i >> 8));
+    }
+    return track;
+}
+
+TEST(MusicTrack_Test, DecompressStreamMatchesDecompress)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> data = CreateTrack(1000);
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(data);
+
+    FileChunk* chunk = huffman.Decompress(compressed.data(), (unsigned long)compressed.size(), (unsigned long)data.size());
+    huffmanStreamState state;
+    Huffman::ResetStreamState(state);
+    std::vector<uint8_t> streamed(data.size());
+    unsigned long decoded = 0;
+    while (decoded < data.size())
+    {
+        const unsigned long bytesLeft = (unsigned long)data.size() - decoded;
+        const unsigned long blockSize = (bytesLeft < 37) ? bytesLeft : 37;
+        EXPECT_EQ(huffman.DecompressStream(compressed.data(), (unsigned long)compressed.size(), state, &streamed[decoded], blockSize), blockSize);
+        decoded += blockSize;
+    }
+
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        EXPECT_EQ(chunk->GetChunk()[i], data[i]);
+        EXPECT_EQ(streamed[i], data[i]);
+    }
+    delete chunk;
+}
+
+TEST(MusicTrack_Test, ReadEventsAcrossBlocks)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    const uint16_t numberOfEvents = 1000;
+    std::vector<uint8_t> data = CreateTrack(numberOfEvents);
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(data);
+    ASSERT_GT(data.size(), 2u * MusicTrack::BlockSize);
+
+    MusicTrack track(huffman, compressed.data(), (uint32_t)compressed.size(), (uint32_t)data.size());
+    EXPECT_EQ(track.GetLength(), numberOfEvents * 4);
+
+    for (uint8_t pass = 0; pass < 2; pass++)
+    {
+        for (uint16_t i = 0; i < numberOfEvents; i++)
+        {
+            uint8_t reg = 0;
+            uint8_t value = 0;
+            uint16_t delay = 0;
+            track.ReadEvent(reg, value, delay);
+            EXPECT_EQ(reg, (uint8_t)(0x20 + (i % 0xD0)));
+            EXPECT_EQ(value, (uint8_t)(i * 7));
+            EXPECT_EQ(delay, i);
+        }
+        track.Rewind();
+    }
+}
+
+TEST(MusicTrack_Test, ReadBeyondEndOfTrack)
+{
+    huffmanTable table;
+    HuffmanFixture::CreateBalancedHuffmanTable(table);
+    Huffman huffman(table);
+    std::vector<uint8_t> data = CreateTrack(1);
+    std::vector<uint8_t> compressed = HuffmanFixture::Compress(data);
+
+    MusicTrack track(huffman, compressed.data(), (uint32_t)compressed.size(), (uint32_t)data.size());
+    uint8_t reg = 0;
+    uint8_t value = 0;
+    uint16_t delay = 0;
+    track.ReadEvent(reg, value, delay);
+    EXPECT_EQ(reg, 0x20);
+    track.ReadEvent(reg, value, delay);
+    EXPECT_EQ(reg, 0);
+    EXPECT_EQ(value, 0);
+    EXPECT_EQ(delay, 0);
+}
@@ -0,0 +1,79 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "OffscreenRecorder_Test.h"
+#include "../Engine/GameTimer.h"
+#include "../Engine/OffscreenRecorder.h"
+#include "../Engine/PlayerInput.h"
+#include <fstream>
+
+OffscreenRecorder_Test::OffscreenRecorder_Test()
+{
+
+}
+
+OffscreenRecorder_Test::~OffscreenRecorder_Test()
+{
+
+}
+
+TEST(OffscreenRecorder_Test, CapturesSelectedFramesAndWritesTimings)
+{
+    const std::filesystem::path outputPath = std::filesystem::temp_directory_path() / "CatacombGL_OffscreenRecorder_Test";
+    std::filesystem::remove_all(outputPath);
+    std::filesystem::create_directories(outputPath);
+
+    InputScript inputScript;
+    std::string errorMessage;
+    ASSERT_TRUE(inputScript.Parse("1 capture\n1 press Space\n3 quit\n", errorMessage));
+
+    PlayerInput input;
+    const std::vector<uint8_t> pixels(4 * 4 * 4, 0xFF);
+    {
+        OffscreenRecorder recorder(inputScript, outputPath);
+        GameTimer gameTimer;
+        gameTimer.Reset();
+        while (!recorder.IsFinished())
+        {
+            recorder.BeginFrame();
+            recorder.ApplyInput(input);
+            recorder.EndThink();
+            recorder.EndDraw();
+            recorder.EndFrame(4, 4, pixels);
+        }
+        EXPECT_EQ(4u, recorder.GetFrameNumber());
+        EXPECT_EQ(4 * OffscreenRecorder::MillisecondsPerFrame, gameTimer.GetMillisecondsForPlayer());
+        EXPECT_TRUE(input.IsKeyPressed(SDLK_SPACE));
+        EXPECT_TRUE(recorder.WriteTimings());
+        EXPECT_EQ(0u, recorder.GetTimingsSummary().find("4 frames rendered; average "));
+    }
+
+    EXPECT_FALSE(std::filesystem::exists(outputPath / "frame_00000.png"));
+    EXPECT_TRUE(std::filesystem::exists(outputPath / "frame_00001.png"));
+
+    std::ifstream timingsFile(outputPath / "timings.csv");
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(timingsFile, line))
+    {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(5u, lines.size());
+    EXPECT_EQ("frame,think_ms,draw_ms,read_ms,total_ms", lines.at(0));
+    EXPECT_EQ(0u, lines.at(4).find("3,"));
+
+    timingsFile.close();
+    std::filesystem::remove_all(outputPath);
+}
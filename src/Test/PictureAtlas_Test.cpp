@@ -0,0 +1,144 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "PictureAtlas_Test.h"
+#include "../Engine/EgaColor.h"
+#include "../Engine/Picture.h"
+#include "../Engine/PictureAtlas.h"
+
+PictureAtlas_Test::PictureAtlas_Test()
+{
+
+}
+
+PictureAtlas_Test::~PictureAtlas_Test()
+{
+
+}
+
+TEST(PictureAtlas_Test, ReserveImagesOnShelves)
+{
+    PictureAtlas atlas(64, 64, 1, 4);
+    uint16_t offsetX = 0;
+    uint16_t offsetY = 0;
+
+    // First shelf, with a height of 20 pixels including the padding
+    EXPECT_TRUE(atlas.ReserveImage(30, 18, offsetX, offsetY));
+    EXPECT_EQ(offsetX, 1);
+    EXPECT_EQ(offsetY, 1);
+    EXPECT_TRUE(atlas.ReserveImage(30, 10, offsetX, offsetY));
+    EXPECT_EQ(offsetX, 33);
+    EXPECT_EQ(offsetY, 1);
+    EXPECT_EQ(atlas.GetTextureHeight(), 32);
+
+    // Does not fit next to the others anymore, so it starts a second shelf
+    EXPECT_TRUE(atlas.ReserveImage(10, 10, offsetX, offsetY));
+    EXPECT_EQ(offsetX, 1);
+    EXPECT_EQ(offsetY, 21);
+    EXPECT_EQ(atlas.GetTextureWidth(), 64);
+    EXPECT_EQ(atlas.GetTextureHeight(), 32);
+
+    // Too high for the remaining space
+    EXPECT_FALSE(atlas.ReserveImage(10, 44, offsetX, offsetY));
+
+    // Too wide for the atlas
+    EXPECT_FALSE(atlas.ReserveImage(63, 2, offsetX, offsetY));
+}
+
+TEST(PictureAtlas_Test, StoreImageRepeatsOuterPixelsIntoPadding)
+{
+    PictureAtlas atlas(8, 8, 1, 4);
+    uint16_t offsetX = 0;
+    uint16_t offsetY = 0;
+    ASSERT_TRUE(atlas.ReserveImage(2, 2, offsetX, offsetY));
+
+    // A 2 x 2 image with pixels 1, 2 on the top row and 3, 4 on the bottom row
+    uint8_t image[2 * 2 * 4];
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        for (uint8_t b = 0; b < 4; b++)
+        {
+            image[(i * 4) + b] = i + 1;
+        }
+    }
+    atlas.StoreImage(offsetX, offsetY, 2, 2, image);
+
+    const uint8_t expectedPixels[4][4] =
+    {
+        { 1, 1, 2, 2 },
+        { 1, 1, 2, 2 },
+        { 3, 3, 4, 4 },
+        { 3, 3, 4, 4 }
+    };
+    const uint8_t* pixelData = atlas.GetTexturePixelData();
+    for (uint16_t y = 0; y < 4; y++)
+    {
+        for (uint16_t x = 0; x < 4; x++)
+        {
+            EXPECT_EQ(pixelData[((y * 8) + x) * 4], expectedPixels[y][x]);
+            EXPECT_EQ(pixelData[((y * 8) + x) * 4 + 3], expectedPixels[y][x]);
+        }
+    }
+
+    // Outside of the padding the atlas is transparent
+    EXPECT_EQ(pixelData[((0 * 8) + 4) * 4 + 3], 0);
+    EXPECT_EQ(pixelData[((4 * 8) + 0) * 4 + 3], 0);
+}
+
+TEST(PictureAtlas_Test, StorePalettizedImage)
+{
+    PictureAtlas atlas(8, 8, 1, 1);
+    uint16_t offsetX = 0;
+    uint16_t offsetY = 0;
+    ASSERT_TRUE(atlas.ReserveImage(2, 2, offsetX, offsetY));
+
+    const uint8_t image[2 * 2] = { EgaBlue, EgaGreen, EgaTransparentIndex, EgaBrightWhite };
+    atlas.StoreImage(offsetX, offsetY, 2, 2, image);
+
+    const uint8_t expectedPixels[4][4] =
+    {
+        { EgaBlue, EgaBlue, EgaGreen, EgaGreen },
+        { EgaBlue, EgaBlue, EgaGreen, EgaGreen },
+        { EgaTransparentIndex, EgaTransparentIndex, EgaBrightWhite, EgaBrightWhite },
+        { EgaTransparentIndex, EgaTransparentIndex, EgaBrightWhite, EgaBrightWhite }
+    };
+    const uint8_t* pixelData = atlas.GetTexturePixelData();
+    for (uint16_t y = 0; y < 4; y++)
+    {
+        for (uint16_t x = 0; x < 4; x++)
+        {
+            EXPECT_EQ(pixelData[(y * 8) + x], expectedPixels[y][x]);
+        }
+    }
+
+    // Outside of the padding the atlas is transparent, rather than black
+    EXPECT_EQ(pixelData[(0 * 8) + 4], EgaTransparentIndex);
+    EXPECT_EQ(pixelData[(4 * 8) + 0], EgaTransparentIndex);
+}
+
+TEST(PictureAtlas_Test, PictureInAtlas)
+{
+    const Picture picture(1, 16, 8, 64, 32, 17, 9);
+    EXPECT_FLOAT_EQ(picture.GetImageRelativeOffsetX(), 17.0f / 64.0f);
+    EXPECT_FLOAT_EQ(picture.GetImageRelativeOffsetY(), 9.0f / 32.0f);
+    EXPECT_FLOAT_EQ(picture.GetImageRelativeWidth(), 0.25f);
+    EXPECT_FLOAT_EQ(picture.GetImageRelativeHeight(), 0.25f);
+
+    const Picture ownTexture(2, 48, 20, 64, 32);
+    EXPECT_FLOAT_EQ(ownTexture.GetImageRelativeOffsetX(), 0.0f);
+    EXPECT_FLOAT_EQ(ownTexture.GetImageRelativeOffsetY(), 0.0f);
+    EXPECT_FLOAT_EQ(ownTexture.GetImageRelativeWidth(), 0.75f);
+    EXPECT_FLOAT_EQ(ownTexture.GetImageRelativeHeight(), 0.625f);
+}
@@ -0,0 +1,190 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "PngWriter_Test.h"
+#include "../Engine/PngWriter.h"
+#include "../Engine/Checksum.h"
+
+PngWriter_Test::PngWriter_Test()
+{
+
+}
+
+PngWriter_Test::~PngWriter_Test()
+{
+
+}
+
+static uint32_t ReadUInt32(const std::vector<uint8_t>& data, const size_t offset)
+{
+    return ((uint32_t)data.at(offset) << 24) | ((uint32_t)data.at(offset + 1) << 16) | ((uint32_t)data.at(offset + 2) << 8) | data.at(offset + 3);
+}
+
+// Decoder for zlib streams with fixed Huffman codes, as written by PngWriter.
+class FixedHuffmanInflater
+{
+public:
+    FixedHuffmanInflater(const std::vector<uint8_t>& data) :
+        m_data(data),
+        m_bitPosition(16)
+    {
+    }
+
+    bool Inflate(std::vector<uint8_t>& output)
+    {
+        const uint16_t lengthBase[29] = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258 };
+        const uint16_t distanceBase[30] = { 1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577 };
+
+        if (ReadBits(1) != 1 || ReadBits(2) != 1)
+        {
+            return false;
+        }
+
+        while (true)
+        {
+            const uint16_t symbol = ReadSymbol();
+            if (symbol < 256)
+            {
+                output.push_back((uint8_t)symbol);
+            }
+            else if (symbol == 256)
+            {
+                return true;
+            }
+            else
+            {
+                const uint16_t lengthCode = symbol - 257;
+                const uint8_t lengthExtraBits = (lengthCode < 8 || lengthCode == 28) ? 0 : (uint8_t)((lengthCode - 4) / 4);
+                const uint16_t length = lengthBase[lengthCode] + (uint16_t)ReadBits(lengthExtraBits);
+                const uint16_t distanceCode = (uint16_t)ReadCode(5);
+                const uint8_t distanceExtraBits = (distanceCode < 4) ? 0 : (uint8_t)((distanceCode - 2) / 2);
+                const uint32_t distance = distanceBase[distanceCode] + ReadBits(distanceExtraBits);
+                if (distance > output.size())
+                {
+                    return false;
+                }
+                for (uint16_t i = 0; i < length; i++)
+                {
+                    output.push_back(output.at(output.size() - distance));
+                }
+            }
+        }
+    }
+
+private:
+    uint32_t ReadBits(const uint8_t numberOfBits)
+    {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < numberOfBits; i++, m_bitPosition++)
+        {
+            value |= ((m_data.at(m_bitPosition / 8) >> (m_bitPosition % 8)) & 1) << i;
+        }
+        return value;
+    }
+
+    uint32_t ReadCode(const uint8_t numberOfBits)
+    {
+        uint32_t code = 0;
+        for (uint8_t i = 0; i < numberOfBits; i++)
+        {
+            code = (code << 1) | ReadBits(1);
+        }
+        return code;
+    }
+
+    uint16_t ReadSymbol()
+    {
+        uint32_t code = ReadCode(7);
+        if (code <= 0x17)
+        {
+            return (uint16_t)(256 + code);
+        }
+        code = (code << 1) | ReadBits(1);
+        if (code >= 0x30 && code <= 0xBF)
+        {
+            return (uint16_t)(code - 0x30);
+        }
+        if (code >= 0xC0 && code <= 0xC7)
+        {
+            return (uint16_t)(280 + code - 0xC0);
+        }
+        code = (code << 1) | ReadBits(1);
+        return (uint16_t)(144 + code - 0x190);
+    }
+
+    const std::vector<uint8_t>& m_data;
+    size_t m_bitPosition;
+};
+
+TEST(PngWriter_Test, ChunksHaveValidChecksums)
+{
+    const std::vector<uint8_t> pixels(3 * 2 * 4, 0x80);
+    std::vector<uint8_t> png;
+    PngWriter::Encode(3, 2, pixels, png);
+
+    const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    ASSERT_GE(png.size(), 8u);
+    EXPECT_TRUE(std::equal(signature, signature + 8, png.begin()));
+
+    std::vector<std::string> chunkTypes;
+    size_t offset = 8;
+    while (offset + 12 <= png.size())
+    {
+        const uint32_t length = ReadUInt32(png, offset);
+        chunkTypes.push_back(std::string(png.begin() + offset + 4, png.begin() + offset + 8));
+        EXPECT_EQ(ReadUInt32(png, offset + 8 + length), Checksum::Crc32(&png.at(offset + 4), length + 4)) << chunkTypes.back();
+        if (chunkTypes.back() == "IHDR")
+        {
+            EXPECT_EQ(3u, ReadUInt32(png, offset + 8));
+            EXPECT_EQ(2u, ReadUInt32(png, offset + 12));
+            EXPECT_EQ(8, png.at(offset + 16));
+            EXPECT_EQ(6, png.at(offset + 17));
+        }
+        offset += 12 + length;
+    }
+    EXPECT_EQ(png.size(), offset);
+    EXPECT_EQ(std::vector<std::string>({ "IHDR", "IDAT", "IEND" }), chunkTypes);
+}
+
+TEST(PngWriter_Test, CompressedDataInflatesToOriginal)
+{
+    // Flat areas with some noise, like a rendered frame
+    std::vector<uint8_t> data;
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < 100000; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        data.push_back(((i / 700) % 3 == 0) ? (uint8_t)(seed >> 16) : (uint8_t)(i / 5000));
+    }
+
+    std::vector<uint8_t> compressedData;
+    PngWriter::Compress(data, compressedData);
+    EXPECT_LT(compressedData.size(), data.size() / 2);
+    EXPECT_EQ(0, ((compressedData.at(0) << 8) | compressedData.at(1)) % 31);
+
+    std::vector<uint8_t> inflatedData;
+    FixedHuffmanInflater inflater(compressedData);
+    ASSERT_TRUE(inflater.Inflate(inflatedData));
+    EXPECT_EQ(data, inflatedData);
+
+    uint32_t a = 1;
+    uint32_t b = 0;
+    for (const uint8_t value : data)
+    {
+        a = (a + value) % 65521;
+        b = (b + a) % 65521;
+    }
+    EXPECT_EQ((b << 16) | a, ReadUInt32(compressedData, compressedData.size() - 4));
+}
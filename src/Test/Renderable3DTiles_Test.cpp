@@ -0,0 +1,74 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "Renderable3DTiles_Test.h"
+#include "../Engine/Renderable3DTiles.h"
+
+Renderable3DTiles_Test::Renderable3DTiles_Test()
+{
+
+}
+
+Renderable3DTiles_Test::~Renderable3DTiles_Test()
+{
+
+}
+
+TEST(Renderable3DTiles_Test, ConsecutiveTilesAreMergedIntoRows)
+{
+    Renderable3DTiles tiles;
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 2, 1 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 3, 1 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 4, 1 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 6, 1 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 7, 2 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 8, 2 });
+
+    EXPECT_EQ(tiles.GetTileCoordinates().size(), 6u);
+    const std::vector<Renderable3DTiles::tileRow>& rows = tiles.GetTileRows();
+    ASSERT_EQ(rows.size(), 3u);
+    EXPECT_EQ(rows.at(0).x, 2);
+    EXPECT_EQ(rows.at(0).y, 1);
+    EXPECT_EQ(rows.at(0).length, 3u);
+    EXPECT_EQ(rows.at(1).x, 6);
+    EXPECT_EQ(rows.at(1).length, 1u);
+    EXPECT_EQ(rows.at(2).x, 7);
+    EXPECT_EQ(rows.at(2).y, 2);
+    EXPECT_EQ(rows.at(2).length, 2u);
+}
+
+TEST(Renderable3DTiles_Test, TilesAtEndOfRowAreNotMergedWithNextRow)
+{
+    Renderable3DTiles tiles;
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 3, 1 });
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 4, 2 });
+
+    EXPECT_EQ(tiles.GetTileRows().size(), 2u);
+}
+
+TEST(Renderable3DTiles_Test, ResetClearsTilesButKeepsMapSize)
+{
+    Renderable3DTiles tiles;
+    EXPECT_EQ(tiles.GetMapWidth(), 0u);
+    EXPECT_EQ(tiles.GetMapHeight(), 0u);
+    tiles.SetMapSize(64, 32);
+    tiles.AddTile(Renderable3DTiles::tileCoordinate{ 1, 1 });
+    tiles.Reset();
+
+    EXPECT_TRUE(tiles.GetTileCoordinates().empty());
+    EXPECT_TRUE(tiles.GetTileRows().empty());
+    EXPECT_EQ(tiles.GetMapWidth(), 64u);
+    EXPECT_EQ(tiles.GetMapHeight(), 32u);
+}
@@ -0,0 +1,110 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "RenderableAutoMapIso_Test.h"
+#include "RendererStub.h"
+#include "../Engine/DefaultFont.h"
+#include "../Engine/Picture.h"
+#include "../Engine/RenderableAutoMapIso.h"
+
+RenderableAutoMapIso_Test::RenderableAutoMapIso_Test()
+{
+
+}
+
+RenderableAutoMapIso_Test::~RenderableAutoMapIso_Test()
+{
+
+}
+
+static size_t CountWallCaps(const RenderableAutoMapIso& autoMapIso, const egaColor color)
+{
+    const auto wallCaps = autoMapIso.GetWallCaps().find(color);
+    return (wallCaps == autoMapIso.GetWallCaps().end()) ? 0 : wallCaps->second.size();
+}
+
+static size_t CountWalls(const RenderableAutoMapIso& autoMapIso)
+{
+    size_t count = 0;
+    for (const auto& walls : autoMapIso.GetWalls().GetTextureToWallsMap())
+    {
+        count += walls.second.size();
+    }
+    return count;
+}
+
+TEST(RenderableAutoMapIso_Test, StaticGeometryIsKeptBetweenFrames)
+{
+    RendererStub rendererStub;
+    RenderableAutoMapIso autoMapIso(*DefaultFont::Get(rendererStub, 10), ViewPorts::ViewPortRect3D{ 0, 0, 320, 120 });
+    const Picture northWallPicture(1, 64, 64, 64, 64);
+    const Picture westWallPicture(2, 64, 64, 64, 64);
+    const RenderableAutoMapIso::staticTile floorTile = { true, true, true, false, &northWallPicture, &westWallPicture, EgaBlack, EgaBlack };
+    const RenderableAutoMapIso::staticTile wallTile = { false, false, false, true, nullptr, nullptr, EgaLightGray, EgaLightGray };
+
+    autoMapIso.ResetStaticGeometry(1, 3, 3);
+    for (uint16_t y = 0; y < 3; y++)
+    {
+        for (uint16_t x = 0; x < 3; x++)
+        {
+            autoMapIso.SetStaticTile(x, y, (x == 1 && y == 1) ? floorTile : wallTile);
+        }
+    }
+    autoMapIso.PrepareFrame(1.0f, 0.0f, 0.0f);
+    autoMapIso.FinalizeFrame();
+
+    EXPECT_EQ(autoMapIso.GetStaticGeometryId(), 1u);
+    EXPECT_EQ(autoMapIso.GetFloorTiles().GetTileCoordinates().size(), 1u);
+    EXPECT_EQ(CountWalls(autoMapIso), 2u);
+    EXPECT_EQ(CountWallCaps(autoMapIso, EgaLightGray), 8u);
+
+    // A new frame without changes keeps the geometry
+    autoMapIso.PrepareFrame(1.0f, 1.0f, 1.0f);
+    autoMapIso.FinalizeFrame();
+    EXPECT_EQ(autoMapIso.GetFloorTiles().GetTileCoordinates().size(), 1u);
+    EXPECT_EQ(CountWalls(autoMapIso), 2u);
+    EXPECT_EQ(CountWallCaps(autoMapIso, EgaLightGray), 8u);
+
+    // Changing a single tile only patches that tile
+    autoMapIso.PrepareFrame(1.0f, 1.0f, 1.0f);
+    autoMapIso.SetStaticTile(2, 1, floorTile);
+    autoMapIso.FinalizeFrame();
+    EXPECT_EQ(autoMapIso.GetFloorTiles().GetTileCoordinates().size(), 2u);
+    EXPECT_EQ(CountWalls(autoMapIso), 4u);
+    EXPECT_EQ(CountWallCaps(autoMapIso, EgaLightGray), 7u);
+
+    // Tiles outside of the level are ignored
+    autoMapIso.SetStaticTile(3, 0, floorTile);
+    autoMapIso.FinalizeFrame();
+    EXPECT_EQ(autoMapIso.GetFloorTiles().GetTileCoordinates().size(), 2u);
+}
+
+TEST(RenderableAutoMapIso_Test, ResetClearsStaticGeometry)
+{
+    RendererStub rendererStub;
+    RenderableAutoMapIso autoMapIso(*DefaultFont::Get(rendererStub, 10), ViewPorts::ViewPortRect3D{ 0, 0, 320, 120 });
+    const RenderableAutoMapIso::staticTile centerTile = { false, false, false, true, nullptr, nullptr, EgaLightGray, EgaRed };
+
+    autoMapIso.ResetStaticGeometry(1, 2, 2);
+    autoMapIso.SetStaticTile(0, 0, centerTile);
+    autoMapIso.FinalizeFrame();
+    EXPECT_EQ(CountWallCaps(autoMapIso, EgaRed), 1u);
+    EXPECT_EQ(CountWallCaps(autoMapIso, EgaLightGray), 4u);
+
+    autoMapIso.ResetStaticGeometry(2, 2, 2);
+    autoMapIso.FinalizeFrame();
+    EXPECT_EQ(autoMapIso.GetStaticGeometryId(), 2u);
+    EXPECT_TRUE(autoMapIso.GetWallCaps().empty());
+}
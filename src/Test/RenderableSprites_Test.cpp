@@ -0,0 +1,120 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "RenderableSprites_Test.h"
+#include "../Engine/RenderableSprites.h"
+
+RenderableSprites_Test::RenderableSprites_Test()
+{
+
+}
+
+RenderableSprites_Test::~RenderableSprites_Test()
+{
+
+}
+
+// With the player at the origin and looking along the angle 0, the distance to the player view screen equals the absolute Y offset.
+static void AddSprites(RenderableSprites& sprites, const std::vector<float>& offsetsY)
+{
+    sprites.Reset(0.0f, 0.0f, 0.0f);
+    for (const float offsetY : offsetsY)
+    {
+        sprites.AddSprite(nullptr, 0.0f, offsetY, RenderableSprites::RotatedTowardsPlayer);
+    }
+}
+
+static bool IsSortedBackToFront(const RenderableSprites& sprites)
+{
+    const std::vector<RenderableSprites::RenderableSprite>& sortedSprites = sprites.GetSprites();
+    for (size_t i = 1; i < sortedSprites.size(); i++)
+    {
+        if (sortedSprites.at(i - 1).distanceToPlayerViewScreen < sortedSprites.at(i).distanceToPlayerViewScreen)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+TEST(RenderableSprites_Test, SortSpritesBackToFront)
+{
+    RenderableSprites sprites;
+    AddSprites(sprites, { 3.0f, 7.0f, 1.0f, 5.0f });
+    sprites.SortSpritesBackToFront();
+
+    const std::vector<RenderableSprites::RenderableSprite>& sortedSprites = sprites.GetSprites();
+    ASSERT_EQ(sortedSprites.size(), 4u);
+    EXPECT_FLOAT_EQ(sortedSprites.at(0).offsetY, 7.0f);
+    EXPECT_FLOAT_EQ(sortedSprites.at(1).offsetY, 5.0f);
+    EXPECT_FLOAT_EQ(sortedSprites.at(2).offsetY, 3.0f);
+    EXPECT_FLOAT_EQ(sortedSprites.at(3).offsetY, 1.0f);
+}
+
+TEST(RenderableSprites_Test, SortSpritesBackToFrontOverMultipleFrames)
+{
+    RenderableSprites sprites;
+    AddSprites(sprites, { 3.0f, 7.0f, 1.0f, 5.0f });
+    sprites.SortSpritesBackToFront();
+
+    // Same sprites, of which two swapped places
+    AddSprites(sprites, { 3.0f, 4.0f, 1.0f, 6.0f });
+    sprites.SortSpritesBackToFront();
+    EXPECT_FLOAT_EQ(sprites.GetSprites().at(0).offsetY, 6.0f);
+    EXPECT_FLOAT_EQ(sprites.GetSprites().at(1).offsetY, 4.0f);
+    EXPECT_TRUE(IsSortedBackToFront(sprites));
+
+    // A sprite less than in the previous frame
+    AddSprites(sprites, { 2.0f, 8.0f, 5.0f });
+    sprites.SortSpritesBackToFront();
+    EXPECT_FLOAT_EQ(sprites.GetSprites().at(0).offsetY, 8.0f);
+    EXPECT_FLOAT_EQ(sprites.GetSprites().at(1).offsetY, 5.0f);
+    EXPECT_FLOAT_EQ(sprites.GetSprites().at(2).offsetY, 2.0f);
+}
+
+TEST(RenderableSprites_Test, SortSpritesBackToFrontAfterOrderReversed)
+{
+    const uint16_t numberOfSprites = 500;
+    std::vector<float> offsetsY;
+    for (uint16_t i = 0; i < numberOfSprites; i++)
+    {
+        offsetsY.push_back((float)i);
+    }
+
+    RenderableSprites sprites;
+    AddSprites(sprites, offsetsY);
+    sprites.SortSpritesBackToFront();
+    EXPECT_TRUE(IsSortedBackToFront(sprites));
+
+    // Each sprite is now in the opposite position compared to the previous frame
+    for (uint16_t i = 0; i < numberOfSprites; i++)
+    {
+        offsetsY.at(i) = (float)(numberOfSprites - i);
+    }
+    AddSprites(sprites, offsetsY);
+    sprites.SortSpritesBackToFront();
+    EXPECT_TRUE(IsSortedBackToFront(sprites));
+    EXPECT_EQ(sprites.GetSprites().size(), (size_t)numberOfSprites);
+}
+
+TEST(RenderableSprites_Test, MaxSpritesToRender)
+{
+    const uint16_t maxSpritesToRender = RenderableSprites::MaxSpritesToRender;
+    std::vector<float> offsetsY(maxSpritesToRender + 10, 1.0f);
+
+    RenderableSprites sprites;
+    AddSprites(sprites, offsetsY);
+    EXPECT_EQ(sprites.GetSprites().size(), (size_t)maxSpritesToRender);
+}
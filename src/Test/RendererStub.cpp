@@ -17,7 +17,8 @@
 
 static const std::string defaultString("");
 
-RendererStub::RendererStub()
+RendererStub::RendererStub() :
+    m_renderStatistics()
 {
 }
 
@@ -47,6 +48,11 @@ bool RendererStub::IsOriginalScreenResolutionSupported()
     return true;
 }
 
+bool RendererStub::IsScreenCaptureOnGpuSupported()
+{
+    return false;
+}
+
 void RendererStub::RenderText(const RenderableText& /*renderableText*/)
 {
 
@@ -98,12 +104,7 @@ Picture* RendererStub::GetScreenCapture(const unsigned int /*textureId*/)
     return nullptr;
 }
 
-void RendererStub::RemovePixelsFromScreenCapture(const std::vector<std::pair<int16_t, int16_t>>& /*coordinates*/)
-{
-
-}
-
-void RendererStub::RenderScreenCapture(Picture* /*screenCapture*/)
+void RendererStub::RenderScreenCapture(Picture* /*screenCapture*/, const uint16_t* /*revealTimes*/, const uint16_t /*revealedTime*/)
 {
 
 }
@@ -137,7 +138,28 @@ void RendererStub::LoadPixelDataIntoTexture(uint32_t /*width*/, uint32_t /*heigh
 {
 }
 
+void RendererStub::LoadIndexedPixelDataIntoTexture(uint32_t /*width*/, uint32_t /*height*/, uint8_t* /*indexedPixelData*/, unsigned int /*textureId*/) const
+{
+}
+
+void RendererStub::DeleteTexture(const unsigned int /*textureId*/) const
+{
+}
+
 unsigned int RendererStub::GenerateTextureId() const
 {
     return 0;
+}
+
+void RendererStub::SetGpuTimingEnabled(const bool /*enabled*/)
+{
+}
+
+void RendererStub::EndFrameStatistics()
+{
+}
+
+const IRenderer::RenderStatistics& RendererStub::GetRenderStatistics() const
+{
+    return m_renderStatistics;
 }
\ No newline at end of file
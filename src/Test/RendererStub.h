@@ -36,6 +36,8 @@ public:
     //
     unsigned int GenerateTextureId() const override;
     void LoadPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* pixelData, unsigned int textureId) const override;
+    void LoadIndexedPixelDataIntoTexture(uint32_t width, uint32_t height, uint8_t* indexedPixelData, unsigned int textureId) const override;
+    void DeleteTexture(const unsigned int textureId) const override;
 
     //
     // 2D rendering
@@ -60,8 +62,7 @@ public:
     // Screen capture
     //
     Picture* GetScreenCapture(const unsigned int textureId) override;
-    void RemovePixelsFromScreenCapture(const std::vector<std::pair<int16_t, int16_t>>& coordinates) override;
-    void RenderScreenCapture(Picture* screenCapture) override;
+    void RenderScreenCapture(Picture* screenCapture, const uint16_t* revealTimes, const uint16_t revealedTime) override;
 
     //
     // Capabilities
@@ -71,5 +72,16 @@ public:
     const std::string& GetGraphicsAdapterModel() const override;
     bool IsVSyncSupported() override;
     bool IsOriginalScreenResolutionSupported() override;
+    bool IsScreenCaptureOnGpuSupported() override;
+
+    //
+    // Statistics
+    //
+    void SetGpuTimingEnabled(const bool enabled) override;
+    void EndFrameStatistics() override;
+    const RenderStatistics& GetRenderStatistics() const override;
+
+private:
+    RenderStatistics m_renderStatistics;
 };
 
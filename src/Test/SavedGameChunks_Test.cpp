@@ -0,0 +1,138 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SavedGameChunks_Test.h"
+#include "../Engine/SavedGameChunks.h"
+
+SavedGameChunks_Test::SavedGameChunks_Test()
+{
+
+}
+
+SavedGameChunks_Test::~SavedGameChunks_Test()
+{
+
+}
+
+static void AddTestChunks(SavedGameChunks& chunks)
+{
+    // A tile plane with large areas of the same tile, followed by an odd number of bytes that do not repeat
+    std::vector<uint8_t>& plane = chunks.AddChunk("PLAN");
+    for (uint16_t i = 0; i < 4096; i++)
+    {
+        const uint16_t tile = (i < 3000) ? 1 : (i % 5 == 0) ? 0xABCD : i;
+        plane.push_back((uint8_t)(tile & 0xFF));
+        plane.push_back((uint8_t)(tile >> 8));
+    }
+    for (uint8_t i = 0; i < 13; i++)
+    {
+        plane.push_back(i);
+    }
+
+    chunks.AddChunk("EMPT");
+    chunks.AddChunk("TEXT") = { 'C', 'a', 't', 'a', 'c', 'o', 'm', 'b' };
+}
+
+TEST(SavedGameChunks_Test, ChunksAreReadBack)
+{
+    SavedGameChunks chunks;
+    AddTestChunks(chunks);
+
+    for (const bool compress : { false, true })
+    {
+        std::vector<uint8_t> data;
+        chunks.Serialize(data, compress);
+        EXPECT_EQ(SavedGameChunks::FormatVersion, SavedGameChunks::GetFormatVersion(data));
+
+        SavedGameChunks chunksRead;
+        ASSERT_TRUE(chunksRead.Deserialize(data));
+        for (const char* id : { "PLAN", "EMPT", "TEXT" })
+        {
+            ASSERT_NE(nullptr, chunksRead.GetChunk(id));
+            EXPECT_EQ(*chunks.GetChunk(id), *chunksRead.GetChunk(id));
+        }
+        EXPECT_EQ(nullptr, chunksRead.GetChunk("NONE"));
+    }
+}
+
+TEST(SavedGameChunks_Test, CompressionShrinksTilePlanes)
+{
+    SavedGameChunks chunks;
+    AddTestChunks(chunks);
+    std::vector<uint8_t> data;
+    chunks.Serialize(data, false);
+    std::vector<uint8_t> compressedData;
+    chunks.Serialize(compressedData, true);
+    EXPECT_LT(compressedData.size(), data.size() / 2);
+}
+
+TEST(SavedGameChunks_Test, DamagedDataIsRejected)
+{
+    SavedGameChunks chunks;
+    AddTestChunks(chunks);
+    std::vector<uint8_t> data;
+    chunks.Serialize(data, true);
+
+    std::vector<uint8_t> damagedData = data;
+    damagedData[100] ^= 0x10;
+    SavedGameChunks chunksRead;
+    EXPECT_FALSE(chunksRead.Deserialize(damagedData));
+    EXPECT_EQ(nullptr, chunksRead.GetChunk("PLAN"));
+
+    for (const size_t size : { (size_t)0, (size_t)12, (size_t)20, data.size() - 1 })
+    {
+        const std::vector<uint8_t> truncatedData(data.begin(), data.begin() + size);
+        EXPECT_FALSE(chunksRead.Deserialize(truncatedData));
+    }
+}
+
+TEST(SavedGameChunks_Test, DamagedChunkSizeIsRejected)
+{
+    SavedGameChunks chunks;
+    AddTestChunks(chunks);
+    std::vector<uint8_t> data;
+    chunks.Serialize(data, true);
+
+    // The size of the first chunk follows the header, the chunk id and the compression type
+    const size_t sizeOffset = 13 + 4 + 1;
+    for (const uint8_t sizeByte : { 0x00, 0xFF })
+    {
+        std::vector<uint8_t> damagedData = data;
+        damagedData[sizeOffset] = 0xF0;
+        damagedData[sizeOffset + 1] = 0xFF;
+        damagedData[sizeOffset + 2] = sizeByte;
+        damagedData[sizeOffset + 3] = 0xFF;
+        SavedGameChunks chunksRead;
+        EXPECT_FALSE(chunksRead.Deserialize(damagedData));
+        EXPECT_EQ(nullptr, chunksRead.GetChunk("PLAN"));
+    }
+
+    // The size is checked against the compressed data before anything is allocated
+    const uint8_t run[] = { 0xCD, 0xAB, 0xFF, 0xFF, 0x01, 0x00 };
+    std::vector<uint8_t> expandedData;
+    EXPECT_FALSE(SavedGameChunks::ExpandRLEW(run, sizeof(run), 0xFFFFFFF0, expandedData));
+    EXPECT_TRUE(expandedData.empty());
+    EXPECT_TRUE(SavedGameChunks::ExpandRLEW(run, sizeof(run), 2 * 0xFFFF, expandedData));
+    EXPECT_EQ(2u * 0xFFFF, expandedData.size());
+}
+
+TEST(SavedGameChunks_Test, OlderSavedGamesHaveFormatVersionZero)
+{
+    // Saved games from before the chunks start with the terminated string "CATACOMBGL"
+    const std::vector<uint8_t> data = { 'C', 'A', 'T', 'A', 'C', 'O', 'M', 'B', 'G', 'L', 0, 0, 5, 2, 1, 0, 0, 0 };
+    EXPECT_EQ(0, SavedGameChunks::GetFormatVersion(data));
+    const std::vector<uint8_t> noSavedGame = { 'N', 'O', 'T', ' ', 'A', ' ', 'S', 'A', 'V', 'E', 1, 0, 0 };
+    EXPECT_EQ(0, SavedGameChunks::GetFormatVersion(noSavedGame));
+}
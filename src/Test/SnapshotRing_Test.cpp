@@ -0,0 +1,120 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SnapshotRing_Test.h"
+#include "../Engine/SnapshotRing.h"
+
+SnapshotRing_Test::SnapshotRing_Test()
+{
+
+}
+
+SnapshotRing_Test::~SnapshotRing_Test()
+{
+
+}
+
+static std::vector<uint8_t> CreateSnapshot(const uint8_t step, const size_t size)
+{
+    // Mostly static data, with a few bytes that change in each step
+    std::vector<uint8_t> snapshot(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        snapshot[i] = (uint8_t)(i * 7);
+    }
+    for (size_t i = 100; i < size; i += 1000)
+    {
+        snapshot[i] = step;
+    }
+    return snapshot;
+}
+
+TEST(SnapshotRing_Test, DeltaTurnsSourceIntoTarget)
+{
+    const std::vector<uint8_t> source = CreateSnapshot(1, 5000);
+    const std::vector<std::vector<uint8_t>> targets =
+    {
+        CreateSnapshot(2, 5000),
+        CreateSnapshot(2, 4000),
+        CreateSnapshot(2, 6000),
+        std::vector<uint8_t>(),
+        source
+    };
+
+    for (const std::vector<uint8_t>& target : targets)
+    {
+        std::vector<uint8_t> delta;
+        SnapshotRing::EncodeDelta(source, target, delta);
+        std::vector<uint8_t> decoded;
+        EXPECT_TRUE(SnapshotRing::ApplyDelta(source, delta, decoded));
+        EXPECT_EQ(target, decoded);
+    }
+}
+
+TEST(SnapshotRing_Test, DeltaOfSimilarSnapshotsIsSmall)
+{
+    std::vector<uint8_t> delta;
+    SnapshotRing::EncodeDelta(CreateSnapshot(1, 20000), CreateSnapshot(2, 20000), delta);
+    EXPECT_LT(delta.size(), 100u);
+}
+
+TEST(SnapshotRing_Test, CorruptDeltaIsRejected)
+{
+    const std::vector<uint8_t> source = CreateSnapshot(1, 5000);
+    std::vector<uint8_t> delta;
+    SnapshotRing::EncodeDelta(source, CreateSnapshot(2, 5000), delta);
+    delta.pop_back();
+    std::vector<uint8_t> decoded;
+    EXPECT_FALSE(SnapshotRing::ApplyDelta(source, delta, decoded));
+}
+
+TEST(SnapshotRing_Test, PopReturnsSnapshotsFromNewToOld)
+{
+    SnapshotRing ring(10);
+    for (uint8_t step = 0; step < 5; step++)
+    {
+        ring.Push(CreateSnapshot(step, 3000 + step));
+    }
+    EXPECT_EQ(5, ring.GetSize());
+
+    for (int16_t step = 4; step >= 0; step--)
+    {
+        ASSERT_FALSE(ring.IsEmpty());
+        EXPECT_EQ(CreateSnapshot((uint8_t)step, 3000 + step), ring.GetNewest());
+        ring.Pop();
+    }
+    EXPECT_TRUE(ring.IsEmpty());
+}
+
+TEST(SnapshotRing_Test, OldestSnapshotsAreDroppedWhenFull)
+{
+    SnapshotRing ring(3);
+    for (uint8_t step = 0; step < 8; step++)
+    {
+        ring.Push(CreateSnapshot(step, 10000));
+    }
+    EXPECT_EQ(3, ring.GetSize());
+    EXPECT_LT(ring.GetMemoryUsage(), 10000u + 200u);
+
+    ring.Pop();
+    ring.Pop();
+    EXPECT_EQ(CreateSnapshot(5, 10000), ring.GetNewest());
+    ring.Pop();
+    EXPECT_TRUE(ring.IsEmpty());
+
+    ring.Push(CreateSnapshot(9, 10000));
+    EXPECT_EQ(1, ring.GetSize());
+    EXPECT_EQ(CreateSnapshot(9, 10000), ring.GetNewest());
+}
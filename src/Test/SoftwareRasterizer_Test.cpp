@@ -0,0 +1,243 @@
+// Copyright (C) 2022 Arno Ansems
+// 
+// This program is free software: you can redistribute it and/or modify 
+// it under the terms of the GNU General Public License as published by 
+// the Free Software Foundation, either version 3 of the License, or 
+// (at your option) any later version. 
+// 
+// This program is distributed in the hope that it will be useful, 
+// but WITHOUT ANY WARRANTY; without even the implied warranty of 
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the 
+// GNU General Public License for more details. 
+// 
+// You should have received a copy of the GNU General Public License 
+// along with this program.  If not, see http://www.gnu.org/licenses/ 
+
+#include "SoftwareRasterizer_Test.h"
+#include "../Engine/SoftwareRasterizer.h"
+
+static SoftwareRasterizer::texture CreateTexture(const uint32_t width, const uint32_t height, const std::vector<uint32_t>& pixels)
+{
+    SoftwareRasterizer::texture texture;
+    texture.width = width;
+    texture.height = height;
+    texture.pixels = pixels;
+    texture.isSingleColor = false;
+    return texture;
+}
+
+static SoftwareRasterizer::drawState CreateState(const SoftwareRasterizer::texture& texture, const uint32_t width, const uint32_t height)
+{
+    SoftwareRasterizer::drawState state;
+    state.boundTexture = &texture;
+    state.linearFilter = false;
+    state.depthTest = false;
+    state.depthWrite = true;
+    state.blend = false;
+    state.cullFrontFaces = false;
+    state.revealTimes = nullptr;
+    state.revealedTime = 0;
+    state.viewPortLeft = 0;
+    state.viewPortBottom = 0;
+    state.viewPortWidth = (int32_t)width;
+    state.viewPortHeight = (int32_t)height;
+    return state;
+}
+
+static SoftwareRasterizer::vertex CreateVertex(const float x, const float y, const float z, const float s, const float t)
+{
+    return { x, y, z, 1.0f, s, t, 1.0f, 1.0f, 1.0f, 1.0f, 0.0f, 0.0f };
+}
+
+static void AddQuad(SoftwareRasterizer& rasterizer, const float left, const float bottom, const float right, const float top, const float z)
+{
+    const SoftwareRasterizer::vertex v0 = CreateVertex(left, bottom, z, 0.0f, 0.0f);
+    const SoftwareRasterizer::vertex v1 = CreateVertex(right, bottom, z, 1.0f, 0.0f);
+    const SoftwareRasterizer::vertex v2 = CreateVertex(right, top, z, 1.0f, 1.0f);
+    const SoftwareRasterizer::vertex v3 = CreateVertex(left, top, z, 0.0f, 1.0f);
+    rasterizer.AddTriangle(v0, v1, v2);
+    rasterizer.AddTriangle(v0, v2, v3);
+}
+
+SoftwareRasterizer_Test::SoftwareRasterizer_Test()
+{
+
+}
+
+SoftwareRasterizer_Test::~SoftwareRasterizer_Test()
+{
+
+}
+
+TEST(SoftwareRasterizer_Test, SharedEdgeIsDrawnOnce)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 8, 8);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0xFF000000, 1.0f);
+
+    // Half transparent white, such that pixels that are drawn twice become brighter
+    const SoftwareRasterizer::texture texture = CreateTexture(1, 1, { 0x80FFFFFF });
+    SoftwareRasterizer::drawState state = CreateState(texture, 8, 8);
+    state.blend = true;
+    rasterizer.SetState(state);
+    AddQuad(rasterizer, 0.0f, 0.0f, 8.0f, 8.0f, 0.0f);
+    rasterizer.Flush();
+
+    for (const uint32_t pixel : target.color.pixels)
+    {
+        EXPECT_EQ(target.color.pixels[0], pixel);
+    }
+    EXPECT_EQ(0x80u, target.color.pixels[0] & 0xFF);
+}
+
+TEST(SoftwareRasterizer_Test, PixelsAreSampledAtTheirCenters)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 4, 4);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0, 1.0f);
+
+    const SoftwareRasterizer::texture texture = CreateTexture(1, 1, { 0xFFFFFFFF });
+    rasterizer.SetState(CreateState(texture, 4, 4));
+    // Covers the centers of the pixels in the columns 1 and 2 only
+    AddQuad(rasterizer, 0.6f, 0.0f, 2.6f, 4.0f, 0.0f);
+    rasterizer.Flush();
+
+    EXPECT_EQ(0u, target.color.pixels[0]);
+    EXPECT_EQ(0xFFFFFFFFu, target.color.pixels[1]);
+    EXPECT_EQ(0xFFFFFFFFu, target.color.pixels[2]);
+    EXPECT_EQ(0u, target.color.pixels[3]);
+}
+
+TEST(SoftwareRasterizer_Test, TextureWithoutPixelsIsNotDrawn)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 4, 4);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0, 1.0f);
+
+    // As left behind by a deleted texture
+    const SoftwareRasterizer::texture texture = CreateTexture(0, 0, {});
+    rasterizer.SetState(CreateState(texture, 4, 4));
+    AddQuad(rasterizer, 0.0f, 0.0f, 4.0f, 4.0f, 0.0f);
+    rasterizer.Flush();
+
+    for (const uint32_t pixel : target.color.pixels)
+    {
+        EXPECT_EQ(0u, pixel);
+    }
+}
+
+TEST(SoftwareRasterizer_Test, DepthTestKeepsNearestTriangle)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 4, 4);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0, 1.0f);
+
+    const SoftwareRasterizer::texture red = CreateTexture(1, 1, { 0xFF0000FF });
+    const SoftwareRasterizer::texture green = CreateTexture(1, 1, { 0xFF00FF00 });
+    SoftwareRasterizer::drawState state = CreateState(red, 4, 4);
+    state.depthTest = true;
+    rasterizer.SetState(state);
+    AddQuad(rasterizer, 0.0f, 0.0f, 4.0f, 4.0f, 0.25f);
+    state.boundTexture = &green;
+    rasterizer.SetState(state);
+    AddQuad(rasterizer, 0.0f, 0.0f, 4.0f, 4.0f, 0.75f);
+    rasterizer.Flush();
+
+    for (const uint32_t pixel : target.color.pixels)
+    {
+        EXPECT_EQ(0xFF0000FFu, pixel);
+    }
+    EXPECT_FLOAT_EQ(0.25f, target.depth[0]);
+}
+
+TEST(SoftwareRasterizer_Test, FrontFacesAreCulled)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 4, 4);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0, 1.0f);
+
+    const SoftwareRasterizer::texture texture = CreateTexture(1, 1, { 0xFFFFFFFF });
+    SoftwareRasterizer::drawState state = CreateState(texture, 4, 4);
+    state.cullFrontFaces = true;
+    rasterizer.SetState(state);
+
+    // Counter clockwise
+    rasterizer.AddTriangle(CreateVertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f), CreateVertex(4.0f, 0.0f, 0.0f, 0.0f, 0.0f), CreateVertex(0.0f, 4.0f, 0.0f, 0.0f, 0.0f));
+    rasterizer.Flush();
+    EXPECT_EQ(0u, target.color.pixels[0]);
+
+    // Clockwise
+    rasterizer.AddTriangle(CreateVertex(0.0f, 0.0f, 0.0f, 0.0f, 0.0f), CreateVertex(0.0f, 4.0f, 0.0f, 0.0f, 0.0f), CreateVertex(4.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+    rasterizer.Flush();
+    EXPECT_EQ(0xFFFFFFFFu, target.color.pixels[0]);
+}
+
+TEST(SoftwareRasterizer_Test, NearestSamplingClampsToEdge)
+{
+    SoftwareRasterizer rasterizer(1);
+    SoftwareRasterizer::surface target;
+    SoftwareRasterizer::ResizeSurface(target, 4, 1);
+    rasterizer.SetTarget(&target);
+    rasterizer.Clear(0, 1.0f);
+
+    const SoftwareRasterizer::texture texture = CreateTexture(2, 1, { 0xFF0000FF, 0xFF00FF00 });
+    rasterizer.SetState(CreateState(texture, 4, 1));
+    // The texture coordinates run from -0.5 to 1.5
+    const SoftwareRasterizer::vertex v0 = CreateVertex(0.0f, 0.0f, 0.0f, -0.5f, 0.0f);
+    const SoftwareRasterizer::vertex v1 = CreateVertex(4.0f, 0.0f, 0.0f, 1.5f, 0.0f);
+    const SoftwareRasterizer::vertex v2 = CreateVertex(4.0f, 1.0f, 0.0f, 1.5f, 1.0f);
+    const SoftwareRasterizer::vertex v3 = CreateVertex(0.0f, 1.0f, 0.0f, -0.5f, 1.0f);
+    rasterizer.AddTriangle(v0, v1, v2);
+    rasterizer.AddTriangle(v0, v2, v3);
+    rasterizer.Flush();
+
+    EXPECT_EQ(0xFF0000FFu, target.color.pixels[0]);
+    EXPECT_EQ(0xFF0000FFu, target.color.pixels[1]);
+    EXPECT_EQ(0xFF00FF00u, target.color.pixels[2]);
+    EXPECT_EQ(0xFF00FF00u, target.color.pixels[3]);
+}
+
+TEST(SoftwareRasterizer_Test, ResultDoesNotDependOnNumberOfThreads)
+{
+    std::vector<uint32_t> pixels;
+    for (uint32_t i = 0; i < 16 * 16; i++)
+    {
+        pixels.push_back(0x80000000 | (i * 0x010203));
+    }
+    const SoftwareRasterizer::texture texture = CreateTexture(16, 16, pixels);
+
+    SoftwareRasterizer::surface targets[2];
+    for (uint8_t i = 0; i < 2; i++)
+    {
+        SoftwareRasterizer rasterizer((i == 0) ? 1 : 4);
+        SoftwareRasterizer::ResizeSurface(targets[i], 300, 200);
+        rasterizer.SetTarget(&targets[i]);
+        rasterizer.Clear(0xFF000000, 1.0f);
+        SoftwareRasterizer::drawState state = CreateState(texture, 300, 200);
+        state.blend = true;
+        state.linearFilter = true;
+        rasterizer.SetState(state);
+
+        // Overlapping, blended triangles that span several tiles
+        for (uint32_t j = 0; j < 50; j++)
+        {
+            const float x = (float)((j * 37) % 250);
+            const float y = (float)((j * 53) % 150);
+            AddQuad(rasterizer, x, y, x + 70.0f, y + 90.0f, 0.0f);
+        }
+        rasterizer.Flush();
+    }
+
+    EXPECT_EQ(4u, SoftwareRasterizer(4).GetNumberOfThreads());
+    EXPECT_TRUE(targets[0].color.pixels == targets[1].color.pixels);
+}